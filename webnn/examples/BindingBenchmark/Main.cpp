@@ -0,0 +1,112 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include <webnn_native/WebnnNative.h>
+
+#include "common/Log.h"
+#include "webnn/examples/SampleUtils.h"
+
+// Measures the per-inference overhead of binding the inputs and outputs with a graph that
+// computes a single relu, so that the execution time is dominated by the memory traffic.
+
+void ShowUsage() {
+    std::cout << std::endl;
+    std::cout << "BindingBenchmark [OPTION]" << std::endl << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "    -h                      "
+              << "Print this message." << std::endl;
+    std::cout << "    -s \"<integer>\"          "
+              << "Optional. Number of float32 elements of the input and the output. The default "
+                 "value is 4194304."
+              << std::endl;
+    std::cout << "    -n \"<integer>\"          "
+              << "Optional. Number of iterations. The default value is 100." << std::endl;
+}
+
+int main(int argc, const char* argv[]) {
+    int32_t size = 4194304;
+    int nIter = 100;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp("-h", argv[i]) == 0) {
+            ShowUsage();
+            return 0;
+        }
+        if (strcmp("-s", argv[i]) == 0 && i + 1 < argc) {
+            size = atoi(argv[i + 1]);
+        } else if (strcmp("-n", argv[i]) == 0 && i + 1 < argc) {
+            nIter = atoi(argv[i + 1]);
+        }
+    }
+    if (size < 1 || nIter < 1) {
+        dawn::ErrorLog() << "Invalid options.";
+        ShowUsage();
+        return -1;
+    }
+
+    const ml::Context context = CreateCppContext();
+    context.SetUncapturedErrorCallback(
+        [](MLErrorType type, char const* message, void* userData) {
+            if (type != MLErrorType_NoError) {
+                dawn::ErrorLog() << "Error type is " << type << ", message is " << message;
+            }
+        },
+        nullptr);
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(context);
+    const ml::Operand input = utils::BuildInput(builder, "input", {1, size});
+    const ml::Operand output = builder.Relu(input);
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    if (graph == nullptr) {
+        dawn::ErrorLog() << "Failed to build the graph.";
+        return -1;
+    }
+
+    std::vector<float> inputData(size, -1.0f);
+    std::vector<float> outputData(size);
+    std::vector<std::chrono::duration<double, std::milli>> executionTimeVector;
+    for (int i = 0; i < nIter; ++i) {
+        std::chrono::time_point<std::chrono::high_resolution_clock> executionStartTime =
+            std::chrono::high_resolution_clock::now();
+        ml::ComputeGraphStatus status =
+            utils::Compute(graph, {{"input", inputData}}, {{"output", outputData}});
+        if (status != ml::ComputeGraphStatus::Success) {
+            dawn::ErrorLog() << "Failed to compute the graph.";
+            return -1;
+        }
+        executionTimeVector.push_back(std::chrono::high_resolution_clock::now() -
+                                      executionStartTime);
+    }
+    std::sort(executionTimeVector.begin(), executionTimeVector.end());
+    std::chrono::duration<double, std::milli> medianExecutionTime =
+        nIter % 2 != 0 ? executionTimeVector[nIter / 2]
+                       : (executionTimeVector[nIter / 2 - 1] + executionTimeVector[nIter / 2]) / 2;
+    const double bytes = 2.0 * size * sizeof(float);
+    dawn::InfoLog() << "Median Execution Time of " << nIter
+                    << " Iterations: " << medianExecutionTime.count() << " ms";
+    dawn::InfoLog() << "Input and output bytes per inference: " << bytes << ", "
+                    << bytes / medianExecutionTime.count() / 1e6 << " GB/s";
+    const webnn_native::ComputeCopyStats copyStats =
+        webnn_native::GetComputeCopyStats(graph.Get());
+    if (copyStats.computeCount != 0) {
+        dawn::InfoLog() << "Bytes copied per inference: "
+                        << copyStats.copiedByteLength / copyStats.computeCount;
+    } else {
+        dawn::InfoLog() << "The backend doesn't count the bytes it copies.";
+    }
+    dawn::InfoLog() << "Done.";
+}
@@ -33,14 +33,23 @@ LeNet::LeNet() {
 }
 
 ml::Graph LeNet::Build(const std::string& weigthsPath) {
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(mContext);
+    const ml::Operand output = Load(builder, weigthsPath);
+    if (!output) {
+        return nullptr;
+    }
+    return utils::Build(builder, {{"output", output}});
+}
+
+ml::Operand LeNet::Load(const ml::GraphBuilder& builder, const std::string& weigthsPath) {
     FILE* fp = fopen(weigthsPath.c_str(), "rb");
     if (!fp) {
         dawn::ErrorLog() << "Failed to open weights file at " << weigthsPath << ".";
         return nullptr;
     }
 
-    std::unique_ptr<char> weightsData(new char[WEIGHTS_LENGTH]);
-    const size_t readSize = fread(weightsData.get(), sizeof(char), WEIGHTS_LENGTH, fp);
+    mWeightsData.reset(new char[WEIGHTS_LENGTH]);
+    const size_t readSize = fread(mWeightsData.get(), sizeof(char), WEIGHTS_LENGTH, fp);
     fclose(fp);
     if (readSize != WEIGHTS_LENGTH) {
         dawn::ErrorLog() << "The expected size of weights file is " << WEIGHTS_LENGTH
@@ -48,13 +57,11 @@ ml::Graph LeNet::Build(const std::string& weigthsPath) {
         return nullptr;
     }
 
-    const ml::GraphBuilder builder = ml::CreateGraphBuilder(mContext);
-
     uint32_t byteOffset = 0;
     const ml::Operand input = utils::BuildInput(builder, "input", {1, 1, 28, 28});
 
     const std::vector<int32_t> conv2d1FilterShape = {20, 1, 5, 5};
-    const float* conv2d1FilterData = reinterpret_cast<float*>(weightsData.get() + byteOffset);
+    const float* conv2d1FilterData = reinterpret_cast<float*>(mWeightsData.get() + byteOffset);
     const uint32_t conv2d1FilterDataLength = utils::SizeOfShape(conv2d1FilterShape) * sizeof(float);
     byteOffset += conv2d1FilterDataLength;
     const ml::Operand conv2d1FilterConstant = utils::BuildConstant(
@@ -62,7 +69,7 @@ ml::Graph LeNet::Build(const std::string& weigthsPath) {
     const ml::Operand conv1 = builder.Conv2d(input, conv2d1FilterConstant);
 
     const std::vector<int32_t> add1BiasShape = {1, 20, 1, 1};
-    const float* add1BiasData = reinterpret_cast<float*>(weightsData.get() + byteOffset);
+    const float* add1BiasData = reinterpret_cast<float*>(mWeightsData.get() + byteOffset);
     const uint32_t add1BiasDataLength = utils::SizeOfShape(add1BiasShape) * sizeof(float);
     byteOffset += add1BiasDataLength;
     const ml::Operand add1BiasConstant =
@@ -75,7 +82,7 @@ ml::Graph LeNet::Build(const std::string& weigthsPath) {
     const ml::Operand pool1 = builder.MaxPool2d(add1, pool1Options.AsPtr());
 
     const std::vector<int32_t> conv2d2FilterShape = {50, 20, 5, 5};
-    const float* conv2d2FilterData = reinterpret_cast<float*>(weightsData.get() + byteOffset);
+    const float* conv2d2FilterData = reinterpret_cast<float*>(mWeightsData.get() + byteOffset);
     const uint32_t conv2d2FilterDataLength = utils::SizeOfShape(conv2d2FilterShape) * sizeof(float);
     byteOffset += conv2d2FilterDataLength;
     const ml::Operand conv2d2FilterConstant = utils::BuildConstant(
@@ -83,7 +90,7 @@ ml::Graph LeNet::Build(const std::string& weigthsPath) {
     const ml::Operand conv2 = builder.Conv2d(pool1, conv2d2FilterConstant);
 
     const std::vector<int32_t> add2BiasShape = {1, 50, 1, 1};
-    const float* add2BiasData = reinterpret_cast<float*>(weightsData.get() + byteOffset);
+    const float* add2BiasData = reinterpret_cast<float*>(mWeightsData.get() + byteOffset);
     const uint32_t add2BiasDataLength = utils::SizeOfShape(add2BiasShape) * sizeof(float);
     byteOffset += add2BiasDataLength;
     const ml::Operand add2BiasConstant =
@@ -101,7 +108,7 @@ ml::Graph LeNet::Build(const std::string& weigthsPath) {
     byteOffset += 2 * 8;
 
     const std::vector<int32_t> matmul1Shape = {500, 800};
-    const float* matmul1Data = reinterpret_cast<float*>(weightsData.get() + byteOffset);
+    const float* matmul1Data = reinterpret_cast<float*>(mWeightsData.get() + byteOffset);
     const uint32_t matmul1DataLength = utils::SizeOfShape(matmul1Shape) * sizeof(float);
     byteOffset += matmul1DataLength;
     const ml::Operand matmul1Weights =
@@ -110,7 +117,7 @@ ml::Graph LeNet::Build(const std::string& weigthsPath) {
     const ml::Operand matmul1 = builder.Matmul(reshape1, matmul1WeightsTransposed);
 
     const std::vector<int32_t> add3BiasShape = {1, 500};
-    const float* add3BiasData = reinterpret_cast<float*>(weightsData.get() + byteOffset);
+    const float* add3BiasData = reinterpret_cast<float*>(mWeightsData.get() + byteOffset);
     const uint32_t add3BiasDataLength = utils::SizeOfShape(add3BiasShape) * sizeof(float);
     byteOffset += add3BiasDataLength;
     const ml::Operand add3BiasConstant =
@@ -123,7 +130,7 @@ ml::Graph LeNet::Build(const std::string& weigthsPath) {
     const ml::Operand reshape2 = builder.Reshape(relu, newShape2.data(), newShape2.size());
 
     const std::vector<int32_t> matmul2Shape = {10, 500};
-    const float* matmul2Data = reinterpret_cast<float*>(weightsData.get() + byteOffset);
+    const float* matmul2Data = reinterpret_cast<float*>(mWeightsData.get() + byteOffset);
     const uint32_t matmul2DataLength = utils::SizeOfShape(matmul2Shape) * sizeof(float);
     byteOffset += matmul2DataLength;
     const ml::Operand matmul2Weights =
@@ -132,7 +139,7 @@ ml::Graph LeNet::Build(const std::string& weigthsPath) {
     const ml::Operand matmul2 = builder.Matmul(reshape2, matmul2WeightsTransposed);
 
     const std::vector<int32_t> add4BiasShape = {1, 10};
-    const float* add4BiasData = reinterpret_cast<float*>(weightsData.get() + byteOffset);
+    const float* add4BiasData = reinterpret_cast<float*>(mWeightsData.get() + byteOffset);
     const uint32_t add4BiasDataLength = utils::SizeOfShape(add4BiasShape) * sizeof(float);
     byteOffset += add4BiasDataLength;
     const ml::Operand add4BiasConstant =
@@ -141,5 +148,5 @@ ml::Graph LeNet::Build(const std::string& weigthsPath) {
 
     const ml::Operand softmax = builder.Softmax(add4);
 
-    return utils::Build(builder, {{"output", softmax}});
+    return softmax;
 }
@@ -26,7 +26,11 @@ class LeNet {
     ~LeNet() = default;
 
     ml::Graph Build(const std::string& weigthsPath);
+    // Builds the operands of the model with |builder|, returning its output or nullptr when the
+    // weights fail to load. The weights are kept alive until the LeNet is released.
+    ml::Operand Load(const ml::GraphBuilder& builder, const std::string& weigthsPath);
 
   private:
     ml::Context mContext;
+    std::unique_ptr<char[]> mWeightsData;
 };
@@ -68,8 +68,17 @@ bool ExampleBase::ParseAndCheckExampleOptions(int argc, const char* argv[]) {
     return true;
 }
 
+static float gAbsoluteTolerance = 0.005f;
+static float gRelativeTolerance = 0.0f;
+
 bool Expected(float output, float expected) {
-    return (fabs(output - expected) < 0.005f);
+    const float difference = fabs(output - expected);
+    return difference < gAbsoluteTolerance || difference < gRelativeTolerance * fabs(expected);
+}
+
+void SetExpectedTolerance(float absolute, float relative) {
+    gAbsoluteTolerance = absolute;
+    gRelativeTolerance = relative;
 }
 
 namespace utils {
@@ -56,6 +56,10 @@ ml::Context CreateCppContext(ml::ContextOptions const* options = nullptr);
 
 bool Expected(float output, float expected);
 
+// Relaxes Expected for the graphs computed in reduced precision, an output then passes when it is
+// within |absolute| of the expected value or within |relative| times its magnitude.
+void SetExpectedTolerance(float absolute, float relative);
+
 namespace utils {
 
     uint32_t SizeOfShape(const std::vector<int32_t>& dims);
@@ -17,13 +17,78 @@
 #include <napi.h>
 #include <webnn/webnn_proc.h>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 Napi::FunctionReference node::Context::constructor;
 
 namespace node {
 
+    namespace {
+
+        // The instance is created with the first context and shared by all the contexts of the
+        // process, so the proc table is installed and the backends are connected once. It's
+        // never released, as the contexts of the cache outlive the addon.
+        webnn_native::Instance* GetInstance() {
+            static webnn_native::Instance* instance = [] {
+                WebnnProcTable backendProcs = webnn_native::GetProcs();
+                webnnProcSetProcs(&backendProcs);
+                return new webnn_native::Instance();
+            }();
+            return instance;
+        }
+
+        using ContextKey = std::tuple<ml::DevicePreference,
+                                      ml::PowerPreference,
+                                      uint32_t,
+                                      uint32_t,
+                                      uint32_t,
+                                      ml::ThreadPinning,
+                                      ml::PrecisionHint,
+                                      bool,
+                                      std::string>;
+
+        // The contexts are cached by all their options, so that creating a context with options
+        // seen before returns the warm context, with its backend engine and thread pool, instead
+        // of creating another one.
+        ml::Context GetOrCreateContext(const ml::ContextOptions& options) {
+            static std::mutex mutex;
+            static std::map<ContextKey, ml::Context>* contexts =
+                new std::map<ContextKey, ml::Context>();
+            const ContextKey key = std::make_tuple(
+                options.devicePreference, options.powerPreference, options.threadCount,
+                options.streamCount, options.interOpThreadCount, options.threadPinning,
+                options.precisionHint, options.profiling,
+                options.cacheDirectory != nullptr ? options.cacheDirectory : "");
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto context = contexts->find(key);
+            if (context != contexts->end()) {
+                return context->second;
+            }
+            ml::Context impl = ml::Context::Acquire(GetInstance()->CreateContext(&options));
+            if (!impl) {
+                return nullptr;
+            }
+            impl.SetUncapturedErrorCallback(
+                [](MLErrorType type, char const* message, void* userData) {
+                    if (type != MLErrorType_NoError) {
+                        std::cout << "Uncaptured Error type is " << type << ", message is "
+                                  << message << std::endl;
+                    }
+                },
+                nullptr);
+            contexts->emplace(key, impl);
+            return impl;
+        }
+
+    }  // namespace
+
     Context::Context(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Context>(info) {
         ml::ContextOptions options = {ml::DevicePreference::Default, ml::PowerPreference::Default};
+        // The context copies the cache directory, so it only needs to outlive CreateContext.
+        std::string cacheDirectory;
         if (info.Length() > 0) {
             Napi::Object optionsObject = info[0].As<Napi::Object>();
             if (optionsObject.Has("powerPreference")) {
@@ -65,24 +130,94 @@ namespace node {
                     return;
                 }
             }
+
+            if (optionsObject.Has("threadCount")) {
+                if (!optionsObject.Get("threadCount").IsNumber()) {
+                    Napi::Error::New(info.Env(), "Invaild threadCount")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+                options.threadCount = optionsObject.Get("threadCount").ToNumber().Uint32Value();
+            }
+
+            if (optionsObject.Has("streamCount")) {
+                if (!optionsObject.Get("streamCount").IsNumber()) {
+                    Napi::Error::New(info.Env(), "Invaild streamCount")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+                options.streamCount = optionsObject.Get("streamCount").ToNumber().Uint32Value();
+            }
+
+            if (optionsObject.Has("interOpThreadCount")) {
+                if (!optionsObject.Get("interOpThreadCount").IsNumber()) {
+                    Napi::Error::New(info.Env(), "Invaild interOpThreadCount")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+                options.interOpThreadCount =
+                    optionsObject.Get("interOpThreadCount").ToNumber().Uint32Value();
+            }
+
+            if (optionsObject.Has("threadPinning")) {
+                if (!optionsObject.Get("threadPinning").IsString()) {
+                    Napi::Error::New(info.Env(), "Invaild threadPinning")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+                std::string threadPinning = optionsObject.Get("threadPinning").ToString();
+                if (threadPinning == "default") {
+                    options.threadPinning = ml::ThreadPinning::Default;
+                } else if (threadPinning == "none") {
+                    options.threadPinning = ml::ThreadPinning::None;
+                } else if (threadPinning == "cores") {
+                    options.threadPinning = ml::ThreadPinning::Cores;
+                } else if (threadPinning == "numa") {
+                    options.threadPinning = ml::ThreadPinning::Numa;
+                } else {
+                    Napi::Error::New(info.Env(), "Invaild threadPinning")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+            }
+
+            if (optionsObject.Has("precisionHint")) {
+                if (!optionsObject.Get("precisionHint").IsString()) {
+                    Napi::Error::New(info.Env(), "Invaild precisionHint")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+                std::string precisionHint = optionsObject.Get("precisionHint").ToString();
+                if (precisionHint == "default") {
+                    options.precisionHint = ml::PrecisionHint::Default;
+                } else if (precisionHint == "float32") {
+                    options.precisionHint = ml::PrecisionHint::Float32;
+                } else if (precisionHint == "float16") {
+                    options.precisionHint = ml::PrecisionHint::Float16;
+                } else if (precisionHint == "bfloat16") {
+                    options.precisionHint = ml::PrecisionHint::Bfloat16;
+                } else {
+                    Napi::Error::New(info.Env(), "Invaild precisionHint")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+            }
+            if (optionsObject.Has("cacheDirectory")) {
+                if (!optionsObject.Get("cacheDirectory").IsString()) {
+                    Napi::Error::New(info.Env(), "Invaild cacheDirectory")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+                cacheDirectory = optionsObject.Get("cacheDirectory").ToString();
+                options.cacheDirectory = cacheDirectory.c_str();
+            }
         }
 
-        WebnnProcTable backendProcs = webnn_native::GetProcs();
-        webnnProcSetProcs(&backendProcs);
-        instance = std::make_unique<webnn_native::Instance>();
-        mImpl = ml::Context::Acquire(instance->CreateContext(&options));
+        mImpl = GetOrCreateContext(options);
         if (!mImpl) {
             Napi::Error::New(info.Env(), "Failed to create Context").ThrowAsJavaScriptException();
             return;
         }
-        mImpl.SetUncapturedErrorCallback(
-            [](MLErrorType type, char const* message, void* userData) {
-                if (type != MLErrorType_NoError) {
-                    std::cout << "Uncaptured Error type is " << type << ", message is " << message
-                              << std::endl;
-                }
-            },
-            this);
     }
 
     ml::Context Context::GetImpl() {
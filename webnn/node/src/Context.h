@@ -32,7 +32,6 @@ namespace node {
         ml::Context GetImpl();
 
       private:
-        std::unique_ptr<webnn_native::Instance> instance;
         ml::Context mImpl;
     };
 
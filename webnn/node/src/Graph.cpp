@@ -16,6 +16,7 @@
 
 #include <iostream>
 #include <map>
+#include <vector>
 
 #include "Utils.h"
 
@@ -39,7 +40,11 @@ namespace node {
         ml::Input mInput;
     };
 
-    bool GetNamedInputs(const Napi::Value& jsValue, std::map<std::string, Input>& namedInputs) {
+    // The typed arrays of the inputs and outputs are appended to |resources| when it's set, so
+    // that they can be kept alive while a compute runs off the JavaScript thread.
+    bool GetNamedInputs(const Napi::Value& jsValue,
+                        std::map<std::string, Input>& namedInputs,
+                        std::vector<Napi::Object>* resources = nullptr) {
         if (!jsValue.IsObject()) {
             return false;
         }
@@ -82,13 +87,17 @@ namespace node {
             if (!GetArrayBufferView(jsTypedArray, input.bufferView)) {
                 return false;
             }
+            if (resources != nullptr) {
+                resources->push_back(jsTypedArray);
+            }
             namedInputs[name] = input;
         }
         return true;
     }
 
     bool GetNamedOutputs(const Napi::Value& jsValue,
-                         std::map<std::string, ml::ArrayBufferView>& namedOutputs) {
+                         std::map<std::string, ml::ArrayBufferView>& namedOutputs,
+                         std::vector<Napi::Object>* resources = nullptr) {
         if (!jsValue.IsObject()) {
             return false;
         }
@@ -102,14 +111,74 @@ namespace node {
         for (size_t i = 0; i < names.Length(); ++i) {
             ml::ArrayBufferView arrayBuffer = {};
             std::string name = names.Get(i).As<Napi::String>().Utf8Value();
-            if (!GetArrayBufferView(jsNamedOutputs.Get(name), arrayBuffer)) {
+            Napi::Value jsResource = jsNamedOutputs.Get(name);
+            if (!GetArrayBufferView(jsResource, arrayBuffer)) {
                 return false;
             }
+            if (resources != nullptr) {
+                resources->push_back(jsResource.As<Napi::Object>());
+            }
             namedOutputs[name] = arrayBuffer;
         }
         return true;
     }
 
+    // Computes a graph on a worker of the libuv thread pool, settling a promise with the status
+    // on the JavaScript thread once the compute completes.
+    class ComputeGraphWorker : public Napi::AsyncWorker {
+      public:
+        ComputeGraphWorker(Napi::Env env,
+                           Napi::Promise::Deferred deferred,
+                           const ml::Graph& graph,
+                           std::map<std::string, Input> inputs,
+                           std::map<std::string, ml::ArrayBufferView> outputs,
+                           const std::vector<Napi::Object>& resources)
+            : Napi::AsyncWorker(env),
+              mDeferred(deferred),
+              mGraph(graph),
+              mInputs(std::move(inputs)),
+              mOutputs(std::move(outputs)) {
+            // The native compute reads and writes the buffers of the typed arrays, which must not
+            // be collected before it completes.
+            for (const Napi::Object& resource : resources) {
+                mResources.push_back(Napi::Persistent(resource));
+            }
+        }
+
+        ~ComputeGraphWorker() = default;
+
+        void Execute() override {
+            ml::NamedInputs namedInputs = ml::CreateNamedInputs();
+            for (auto& input : mInputs) {
+                namedInputs.Set(input.first.data(), input.second.AsPtr());
+            }
+            ml::NamedOutputs namedOutputs = ml::CreateNamedOutputs();
+            for (auto& output : mOutputs) {
+                namedOutputs.Set(output.first.data(), &output.second);
+            }
+            mStatus = mGraph.Compute(namedInputs, namedOutputs);
+            if (mStatus != ml::ComputeGraphStatus::Success) {
+                SetError("Failed to compute the graph.");
+            }
+        }
+
+        void OnOK() override {
+            mDeferred.Resolve(Napi::Number::New(Env(), static_cast<uint32_t>(mStatus)));
+        }
+
+        void OnError(const Napi::Error& error) override {
+            mDeferred.Reject(error.Value());
+        }
+
+      private:
+        Napi::Promise::Deferred mDeferred;
+        ml::Graph mGraph;
+        std::map<std::string, Input> mInputs;
+        std::map<std::string, ml::ArrayBufferView> mOutputs;
+        std::vector<Napi::ObjectReference> mResources;
+        ml::ComputeGraphStatus mStatus = ml::ComputeGraphStatus::Error;
+    };
+
     Napi::FunctionReference Graph::constructor;
 
     Graph::Graph(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Graph>(info) {
@@ -137,10 +206,31 @@ namespace node {
         return Napi::Number::New(info.Env(), static_cast<uint32_t>(status));
     }
 
+    Napi::Value Graph::ComputeAsync(const Napi::CallbackInfo& info) {
+        // Promise<status> computeAsync(NamedInputs inputs, NamedOutputs outputs);
+        WEBNN_NODE_ASSERT(info.Length() == 2, "The number of arguments is invalid.");
+        std::vector<Napi::Object> resources;
+        std::map<std::string, Input> inputs;
+        WEBNN_NODE_ASSERT(GetNamedInputs(info[0], inputs, &resources),
+                          "The inputs parameter is invalid.");
+
+        std::map<std::string, ml::ArrayBufferView> outputs;
+        WEBNN_NODE_ASSERT(GetNamedOutputs(info[1], outputs, &resources),
+                          "The outputs parameter is invalid.");
+
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
+        ComputeGraphWorker* worker = new ComputeGraphWorker(
+            info.Env(), deferred, mImpl, std::move(inputs), std::move(outputs), resources);
+        worker->Queue();
+        return deferred.Promise();
+    }
+
     Napi::Object Graph::Initialize(Napi::Env env, Napi::Object exports) {
         Napi::HandleScope scope(env);
-        Napi::Function func = DefineClass(
-            env, "MLGraph", {InstanceMethod("compute", &Graph::Compute, napi_enumerable)});
+        Napi::Function func =
+            DefineClass(env, "MLGraph",
+                        {InstanceMethod("compute", &Graph::Compute, napi_enumerable),
+                         InstanceMethod("computeAsync", &Graph::ComputeAsync, napi_enumerable)});
         constructor = Napi::Persistent(func);
         constructor.SuppressDestruct();
         exports.Set("MLGraph", func);
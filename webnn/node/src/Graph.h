@@ -22,6 +22,7 @@
 namespace node {
 
     class BuildGraphWorker;
+    class ComputeGraphWorker;
     class GraphBuilder;
 
     class Graph : public Napi::ObjectWrap<Graph> {
@@ -34,9 +35,11 @@ namespace node {
 
       private:
         friend BuildGraphWorker;
+        friend ComputeGraphWorker;
         friend GraphBuilder;
 
         Napi::Value Compute(const Napi::CallbackInfo& info);
+        Napi::Value ComputeAsync(const Napi::CallbackInfo& info);
 
         ml::Graph mImpl;
         std::vector<std::string> mOutputNames;
@@ -19,6 +19,7 @@
 #include <webnn/webnn.h>
 #include <dawn/webnn_proc_table.h>
 #include <webnn_native/webnn_native_export.h>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -55,6 +56,109 @@ namespace webnn_native {
     // Backend-agnostic API for webnn_native
     WEBNN_NATIVE_EXPORT const WebnnProcTable& GetProcs();
 
+    // Counters of the constant pool shared by the graphs of all the contexts in the process.
+    struct ConstantPoolStats {
+        // The constants and bytes currently held by the pool.
+        uint64_t constantCount = 0;
+        uint64_t byteLength = 0;
+        // The constants and bytes found in the pool since the process started, which would
+        // otherwise have been copied again.
+        uint64_t deduplicatedCount = 0;
+        uint64_t deduplicatedByteLength = 0;
+    };
+
+    WEBNN_NATIVE_EXPORT ConstantPoolStats GetConstantPoolStats();
+
+    // Counters of the bytes the computes of a graph copied between the user buffers and the
+    // memory of the backend, which the backends binding the user buffers directly avoid.
+    struct ComputeCopyStats {
+        // The computes counted, none for the backends which don't count their copies.
+        uint64_t computeCount = 0;
+        uint64_t copiedByteLength = 0;
+    };
+
+    // Returns the copies of the computes since the graph was built, including the ones of the
+    // graphs built for other batch sizes.
+    WEBNN_NATIVE_EXPORT ComputeCopyStats GetComputeCopyStats(MLGraph graph);
+
+    // What the graph optimizer did to the operators of a graph before they were added to the
+    // backend.
+    struct GraphOptimizationStats {
+        // The operators the outputs need, with the inputs and the constants, before and after.
+        uint64_t operatorCount = 0;
+        uint64_t optimizedOperatorCount = 0;
+        // The rewrites applied to the graph, each folding or cancelling an operator.
+        uint64_t rewriteCount = 0;
+    };
+
+    WEBNN_NATIVE_EXPORT GraphOptimizationStats GetGraphOptimizationStats(MLGraph graph);
+
+    // The executions of an operator, or of a primitive into which the backend fused several
+    // operators, recorded by the computes of a graph whose context enables profiling.
+    struct OperatorProfile {
+        // The position of the operator in the execution order of the graph.
+        uint32_t index = 0;
+        std::string name;
+        // The kernel, or the implementation and memory format, chosen by the backend.
+        std::string kernel;
+        // The bytes of the tensors read and written by one execution.
+        uint64_t byteLength = 0;
+        uint64_t executionCount = 0;
+        // The wall time of all the executions in milliseconds.
+        double totalTime = 0;
+    };
+
+    // Returns the operators recorded since the graph was built, in execution order. Graphs of
+    // contexts without profiling return none.
+    WEBNN_NATIVE_EXPORT std::vector<OperatorProfile> GetOperatorProfiles(MLGraph graph);
+
+    // Returns the computes and the operators recorded since the graph was built as a JSON
+    // trace in the Chrome trace event format, which chrome://tracing and Perfetto load.
+    WEBNN_NATIVE_EXPORT std::string GetChromeTrace(MLGraph graph);
+
+    struct RequestBatcherOptions {
+        // The most items a batch computes at once. The batches are padded to the next power of
+        // two up to it, and the graph for it is built with the batcher.
+        uint32_t maxBatchSize = 8;
+        // How long the first request of a batch waits for the others, in microseconds.
+        uint32_t maxDelay = 1000;
+    };
+
+    // Histograms of the requests a batcher has seen.
+    struct RequestBatcherStats {
+        // The batches computed with each number of items, indexed by that number.
+        std::vector<uint64_t> batchSizes;
+        // The requests which found each number of requests waiting for their batch when they
+        // came, indexed by that number.
+        std::vector<uint64_t> queueDepths;
+    };
+
+    class RequestBatcherBase;
+
+    // Coalesces the computes of a graph called concurrently, e.g. by the threads serving single
+    // images, into computes of the graph for a larger batch size, and scatters the outputs back
+    // to each request. The graph must declare a symbolic batch on all its inputs, lead all its
+    // outputs with it and compute the items independently. The other graphs, and the requests
+    // whose inputs don't fit a batch, are computed on their own.
+    class WEBNN_NATIVE_EXPORT RequestBatcher {
+      public:
+        explicit RequestBatcher(MLGraph graph,
+                                const RequestBatcherOptions& options = RequestBatcherOptions());
+        ~RequestBatcher();
+
+        RequestBatcher(const RequestBatcher& other) = delete;
+        RequestBatcher& operator=(const RequestBatcher& other) = delete;
+
+        // Computes like mlGraphCompute once the batch of the request is computed, which is when
+        // it holds maxBatchSize items or maxDelay has passed since its first request came.
+        MLComputeGraphStatus Compute(MLNamedInputs inputs, MLNamedOutputs outputs);
+
+        RequestBatcherStats GetStats() const;
+
+      private:
+        RequestBatcherBase* mImpl = nullptr;
+    };
+
 }  // namespace webnn_native
 
 #endif  // WEBNN_NATIVE_WEBNN_NATIVE_H_
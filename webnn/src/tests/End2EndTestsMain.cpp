@@ -17,12 +17,30 @@
 
 int main(int argc, char** argv) {
     std::string device = "default";
+    std::string precision = "default";
     for (int i = 1; i < argc; ++i) {
         if (strcmp("-d", argv[i]) == 0 && i + 1 < argc) {
             device = argv[i + 1];
+        } else if (strcmp("-p", argv[i]) == 0 && i + 1 < argc) {
+            precision = argv[i + 1];
         }
     }
-    const ml::ContextOptions options = utils::CreateContextOptions(device);
+    ml::ContextOptions options = utils::CreateContextOptions(device);
+    // The float32 expectations are compared with tolerances matching the precision hint, which
+    // lets the backends compute convolutions and matmuls in reduced precision.
+    if (precision == "bfloat16") {
+        options.precisionHint = ml::PrecisionHint::Bfloat16;
+        SetExpectedTolerance(0.05f, 0.02f);
+    } else if (precision == "float16") {
+        options.precisionHint = ml::PrecisionHint::Float16;
+        SetExpectedTolerance(0.01f, 0.005f);
+    } else if (precision == "float32") {
+        options.precisionHint = ml::PrecisionHint::Float32;
+    } else if (precision != "default") {
+        dawn::ErrorLog() << "Invalid precision, only support \"float32\", \"float16\" and "
+                            "\"bfloat16\".";
+        return 1;
+    }
     InitWebnnEnd2EndTestEnvironment(&options);
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -25,6 +25,10 @@ const ml::Context& WebnnTest::GetContext() {
     return gTestEnv->GetContext();
 }
 
+ml::ContextOptions const* WebnnTest::GetContextOptions() const {
+    return gTestEnv->GetContextOptions();
+}
+
 void WebnnTest::SetUp() {
     const ml::Context& context = GetContext();
     context.SetUncapturedErrorCallback(ErrorCallback, this);
@@ -66,6 +70,10 @@ void WebnnTest::ErrorCallback(MLErrorType type, char const* message, void* userd
     }
 }
 
+void WebnnTestEnvironment::SetEnvironment(WebnnTestEnvironment* env) {
+    gTestEnv = env;
+}
+
 void WebnnTestEnvironment::SetUp() {
     mContext = CreateCppContext(mOptions);
     DAWN_ASSERT(mContext);
@@ -73,4 +81,8 @@ void WebnnTestEnvironment::SetUp() {
 
 const ml::Context& WebnnTestEnvironment::GetContext() {
     return mContext;
+}
+
+ml::ContextOptions const* WebnnTestEnvironment::GetContextOptions() const {
+    return mOptions;
 }
\ No newline at end of file
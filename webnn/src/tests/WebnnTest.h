@@ -26,6 +26,8 @@ class WebnnTest : public testing::Test {
     void TearDown() override;
 
     const ml::Context& GetContext();
+    // The options the shared context was created with, or null for the default ones.
+    ml::ContextOptions const* GetContextOptions() const;
     void StartExpectContextError();
     bool EndExpectContextError();
     std::string GetLastErrorMessage() const;
@@ -45,7 +47,11 @@ class WebnnTestEnvironment : public testing::Environment {
     }
     void SetUp() override;
 
+    // Makes |env| the environment whose context the tests build their graphs with.
+    static void SetEnvironment(WebnnTestEnvironment* env);
+
     const ml::Context& GetContext();
+    ml::ContextOptions const* GetContextOptions() const;
 
   protected:
     ml::ContextOptions const* mOptions;
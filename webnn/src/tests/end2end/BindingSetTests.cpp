@@ -0,0 +1,111 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/WebnnTest.h"
+
+class BindingSetTests : public WebnnTest {
+  protected:
+    void SetUp() override {
+        WebnnTest::SetUp();
+        // sum = a + b and product = a * b.
+        const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+        const ml::Operand a = utils::BuildInput(builder, "a", {2, 2});
+        const ml::Operand b = utils::BuildInput(builder, "b", {2, 2});
+        mGraph = utils::Build(builder,
+                              {{"sum", builder.Add(a, b)}, {"product", builder.Mul(a, b)}});
+    }
+
+    void SetInput(const ml::BindingSet& bindings, const char* name, std::vector<float>& data) {
+        ml::Input input = {};
+        input.resource = {data.data(), data.size() * sizeof(float)};
+        bindings.SetInput(bindings.GetInputIndex(name), &input);
+    }
+
+    void SetOutput(const ml::BindingSet& bindings, const char* name, std::vector<float>& data) {
+        ml::ArrayBufferView output = {data.data(), data.size() * sizeof(float)};
+        bindings.SetOutput(bindings.GetOutputIndex(name), &output);
+    }
+
+    ml::Graph mGraph;
+};
+
+TEST_F(BindingSetTests, GetIndices) {
+    ASSERT_TRUE(mGraph);
+    const ml::BindingSet bindings = mGraph.CreateBindingSet();
+    // The indices are in the order of the names.
+    EXPECT_EQ(bindings.GetInputIndex("a"), 0);
+    EXPECT_EQ(bindings.GetInputIndex("b"), 1);
+    EXPECT_EQ(bindings.GetInputIndex("c"), -1);
+    EXPECT_EQ(bindings.GetOutputIndex("product"), 0);
+    EXPECT_EQ(bindings.GetOutputIndex("sum"), 1);
+    EXPECT_EQ(bindings.GetOutputIndex("a"), -1);
+}
+
+TEST_F(BindingSetTests, MatchesNamedCompute) {
+    ASSERT_TRUE(mGraph);
+    std::vector<float> a = {1, 2, 3, 4};
+    std::vector<float> b = {-1, 0.5, 2, 3};
+    std::vector<float> expectedSum(4), expectedProduct(4);
+    utils::Compute(mGraph, {{"a", a}, {"b", b}},
+                   {{"sum", expectedSum}, {"product", expectedProduct}});
+
+    const ml::BindingSet bindings = mGraph.CreateBindingSet();
+    std::vector<float> sum(4), product(4);
+    SetInput(bindings, "a", a);
+    SetInput(bindings, "b", b);
+    SetOutput(bindings, "sum", sum);
+    SetOutput(bindings, "product", product);
+    EXPECT_EQ(mGraph.ComputeWithBindings(bindings), ml::ComputeGraphStatus::Success);
+    EXPECT_TRUE(utils::CheckValue(sum, expectedSum));
+    EXPECT_TRUE(utils::CheckValue(product, expectedProduct));
+}
+
+TEST_F(BindingSetTests, RebindBetweenComputes) {
+    ASSERT_TRUE(mGraph);
+    const ml::BindingSet bindings = mGraph.CreateBindingSet();
+    std::vector<float> a = {1, 2, 3, 4};
+    std::vector<float> b = {1, 1, 1, 1};
+    std::vector<float> sum(4);
+    SetInput(bindings, "a", a);
+    SetInput(bindings, "b", b);
+    // The product isn't read.
+    SetOutput(bindings, "sum", sum);
+    EXPECT_EQ(mGraph.ComputeWithBindings(bindings), ml::ComputeGraphStatus::Success);
+    EXPECT_TRUE(utils::CheckValue(sum, {2, 3, 4, 5}));
+
+    // The bound buffers are read again by the next compute.
+    a = {0, 0, 1, 1};
+    EXPECT_EQ(mGraph.ComputeWithBindings(bindings), ml::ComputeGraphStatus::Success);
+    EXPECT_TRUE(utils::CheckValue(sum, {1, 1, 2, 2}));
+
+    std::vector<float> otherSum(4), product(4);
+    std::vector<float> otherB = {2, 2, 2, 2};
+    SetInput(bindings, "b", otherB);
+    SetOutput(bindings, "sum", otherSum);
+    SetOutput(bindings, "product", product);
+    EXPECT_EQ(mGraph.ComputeWithBindings(bindings), ml::ComputeGraphStatus::Success);
+    EXPECT_TRUE(utils::CheckValue(otherSum, {2, 2, 3, 3}));
+    EXPECT_TRUE(utils::CheckValue(product, {0, 0, 2, 2}));
+    EXPECT_TRUE(utils::CheckValue(sum, {1, 1, 2, 2}));
+}
+
+TEST_F(BindingSetTests, ComputeWithMissingInput) {
+    ASSERT_TRUE(mGraph);
+    const ml::BindingSet bindings = mGraph.CreateBindingSet();
+    std::vector<float> a = {1, 2, 3, 4};
+    std::vector<float> sum(4);
+    SetInput(bindings, "a", a);
+    SetOutput(bindings, "sum", sum);
+    EXPECT_EQ(mGraph.ComputeWithBindings(bindings), ml::ComputeGraphStatus::Error);
+}
@@ -0,0 +1,173 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/WebnnTest.h"
+#include "webnn_native/WebnnNative.h"
+
+class GraphOptimizationTests : public WebnnTest {
+    void SetUp() override {
+        builder = ml::CreateGraphBuilder(GetContext());
+    }
+
+  protected:
+    // Builds conv2d + batchNorm + relu, which the optimizer folds into a single conv2d.
+    ml::Operand BuildConv2dBatchNormRelu(ml::Operand* conv2dOutput = nullptr) {
+        const ml::Operand input = utils::BuildInput(builder, "input", {1, 1, 3, 3});
+        const ml::Operand filter = utils::BuildConstant(builder, {2, 1, 2, 2}, mFilterData.data(),
+                                                        mFilterData.size() * sizeof(float));
+        ml::Conv2dOptions conv2dOptions;
+        conv2dOptions.bias = utils::BuildConstant(builder, {2}, mBiasData.data(),
+                                                  mBiasData.size() * sizeof(float));
+        const ml::Operand conv2d = builder.Conv2d(input, filter, &conv2dOptions);
+        if (conv2dOutput != nullptr) {
+            *conv2dOutput = conv2d;
+        }
+
+        const ml::Operand mean = utils::BuildConstant(builder, {2}, mMeanData.data(),
+                                                      mMeanData.size() * sizeof(float));
+        const ml::Operand variance = utils::BuildConstant(builder, {2}, mVarianceData.data(),
+                                                          mVarianceData.size() * sizeof(float));
+        ml::BatchNormOptions batchNormOptions;
+        batchNormOptions.scale = utils::BuildConstant(builder, {2}, mScaleData.data(),
+                                                      mScaleData.size() * sizeof(float));
+        batchNormOptions.bias = utils::BuildConstant(builder, {2}, mOffsetData.data(),
+                                                     mOffsetData.size() * sizeof(float));
+        const ml::Operand batchNorm = builder.BatchNorm(conv2d, mean, variance, &batchNormOptions);
+        return builder.Relu(batchNorm);
+    }
+
+    // Expects the optimizer to have taken the graph from |operatorCount| operators, with the
+    // inputs and the constants, to |optimizedOperatorCount| in |rewriteCount| rewrites. The
+    // backends fusing the operators in their own graph, like oneDNN, are left the graphs whose
+    // rewrites all fuse operators.
+    void ExpectOptimized(const ml::Graph& graph,
+                         uint64_t operatorCount,
+                         uint64_t optimizedOperatorCount,
+                         uint64_t rewriteCount,
+                         bool fusesOperators = false) {
+        const webnn_native::GraphOptimizationStats stats =
+            webnn_native::GetGraphOptimizationStats(graph.Get());
+        EXPECT_EQ(stats.operatorCount, operatorCount);
+        if (fusesOperators && stats.rewriteCount == 0) {
+            EXPECT_EQ(stats.optimizedOperatorCount, operatorCount);
+            return;
+        }
+        EXPECT_EQ(stats.optimizedOperatorCount, optimizedOperatorCount);
+        EXPECT_EQ(stats.rewriteCount, rewriteCount);
+    }
+
+    // The constants aren't copied until the graph is built.
+    const std::vector<float> mFilterData = {0.1, 0.2, 0.3, 0.4, -0.5, 0.25, 0.75, -1.0};
+    const std::vector<float> mBiasData = {0.5, -0.25};
+    const std::vector<float> mMeanData = {0.1, -0.2};
+    const std::vector<float> mVarianceData = {0.5, 2.0};
+    const std::vector<float> mScaleData = {1.5, 0.8};
+    const std::vector<float> mOffsetData = {-0.1, 0.3};
+    const std::vector<float> mInputData = {0.5, -1.0, 2.0, 1.5, 0.0, -0.5, -2.0, 1.0, 3.0};
+    const std::vector<float> mExpectedConv2d = {0.8, 0.6, 0.45, 1.9, 0.375, 1.25, -3.5, -2.625};
+    const std::vector<float> mExpectedOutput = {1.384909, 0.96065,  0.642455, 3.718338,
+                                                0.625268, 1.120242, 0.,       0.};
+    ml::GraphBuilder builder;
+};
+
+TEST_F(GraphOptimizationTests, FoldBatchNormAndReluIntoConv2d) {
+    const ml::Operand output = BuildConv2dBatchNormRelu();
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    ASSERT_TRUE(graph);
+    // The input, the filter and the bias are left of the 10 operators.
+    ExpectOptimized(graph, 10, 4, 2, true);
+    std::vector<float> result(utils::SizeOfShape({1, 2, 2, 2}));
+    utils::Compute(graph, {{"input", mInputData}}, {{"output", result}});
+    EXPECT_TRUE(utils::CheckValue(result, mExpectedOutput));
+}
+
+// The intermediate outputs are still computed when they are outputs of the graph.
+TEST_F(GraphOptimizationTests, KeepIntermediateOutputs) {
+    ml::Operand conv2d;
+    const ml::Operand output = BuildConv2dBatchNormRelu(&conv2d);
+    const ml::Graph graph = utils::Build(builder, {{"conv2d", conv2d}, {"output", output}});
+    ASSERT_TRUE(graph);
+    // Only relu is fused into batchNorm.
+    ExpectOptimized(graph, 10, 9, 1, true);
+    std::vector<float> conv2dResult(utils::SizeOfShape({1, 2, 2, 2}));
+    std::vector<float> result(utils::SizeOfShape({1, 2, 2, 2}));
+    utils::Compute(graph, {{"input", mInputData}}, {{"conv2d", conv2dResult}, {"output", result}});
+    EXPECT_TRUE(utils::CheckValue(conv2dResult, mExpectedConv2d));
+    EXPECT_TRUE(utils::CheckValue(result, mExpectedOutput));
+}
+
+TEST_F(GraphOptimizationTests, CancelTransposesAndFoldConstantTranspose) {
+    const ml::Operand a = utils::BuildInput(builder, "a", {1, 2, 3});
+    const std::vector<int32_t> permutation = {0, 2, 1};
+    ml::TransposeOptions options;
+    options.permutation = permutation.data();
+    options.permutationCount = permutation.size();
+    const ml::Operand transposed = builder.Transpose(builder.Transpose(a, &options), &options);
+    const std::vector<float> constantData = {0.5, 1, 1.5, 2, 2.5, 3};
+    const ml::Operand constant = utils::BuildConstant(builder, {3, 2}, constantData.data(),
+                                                      constantData.size() * sizeof(float));
+    const ml::Operand b = builder.Add(transposed, builder.Transpose(constant));
+    const ml::Graph graph = utils::Build(builder, {{"b", b}});
+    ASSERT_TRUE(graph);
+    // The transposes of the input cancel and the one of the constant is folded.
+    ExpectOptimized(graph, 6, 3, 2);
+    std::vector<float> result(utils::SizeOfShape({1, 2, 3}));
+    utils::Compute(graph, {{"a", {1, 2, 3, 4, 5, 6}}}, {{"b", result}});
+    EXPECT_TRUE(utils::CheckValue(result, {1.5, 3.5, 5.5, 5, 7, 9}));
+}
+
+TEST_F(GraphOptimizationTests, MergeReshapesAndFoldConstants) {
+    const ml::Operand a = utils::BuildInput(builder, "a", {2, 3});
+    const std::vector<int32_t> firstShape = {3, 2};
+    const std::vector<int32_t> secondShape = {6};
+    const ml::Operand reshaped =
+        builder.Reshape(builder.Reshape(a, firstShape.data(), firstShape.size()),
+                        secondShape.data(), secondShape.size());
+    const std::vector<float> xData = {2}, yData = {0.5};
+    const ml::Operand x = utils::BuildConstant(builder, {1}, xData.data(), sizeof(float));
+    const ml::Operand y = utils::BuildConstant(builder, {1}, yData.data(), sizeof(float));
+    const ml::Operand b = builder.Mul(reshaped, builder.Add(x, y));
+    const ml::Graph graph = utils::Build(builder, {{"b", b}});
+    ASSERT_TRUE(graph);
+    // The reshapes are merged and the sum of the constants is folded.
+    ExpectOptimized(graph, 7, 4, 2);
+    std::vector<float> result(utils::SizeOfShape({6}));
+    utils::Compute(graph, {{"a", {1, -2, 3, -4, 5, -6}}}, {{"b", result}});
+    EXPECT_TRUE(utils::CheckValue(result, {2.5, -5, 7.5, -10, 12.5, -15}));
+}
+
+// The consumers of the rewritten operators are cloned, so the operands can be built again.
+TEST_F(GraphOptimizationTests, BuildTheOperandsAgain) {
+    ml::Operand conv2d;
+    const ml::Operand relu = BuildConv2dBatchNormRelu(&conv2d);
+    const ml::Operand output = builder.Add(relu, relu);
+    std::vector<float> expectedOutput(mExpectedOutput.size());
+    for (size_t i = 0; i < expectedOutput.size(); ++i) {
+        expectedOutput[i] = 2 * mExpectedOutput[i];
+    }
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    ASSERT_TRUE(graph);
+    ExpectOptimized(graph, 11, 5, 2, true);
+    std::vector<float> result(utils::SizeOfShape({1, 2, 2, 2}));
+    utils::Compute(graph, {{"input", mInputData}}, {{"output", result}});
+    EXPECT_TRUE(utils::CheckValue(result, expectedOutput));
+
+    const ml::Graph again = utils::Build(builder, {{"conv2d", conv2d}, {"output", output}});
+    ASSERT_TRUE(again);
+    ExpectOptimized(again, 11, 10, 1, true);
+    std::vector<float> conv2dResult(utils::SizeOfShape({1, 2, 2, 2}));
+    utils::Compute(again, {{"input", mInputData}}, {{"conv2d", conv2dResult}, {"output", result}});
+    EXPECT_TRUE(utils::CheckValue(conv2dResult, mExpectedConv2d));
+    EXPECT_TRUE(utils::CheckValue(result, expectedOutput));
+}
@@ -0,0 +1,111 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <fstream>
+
+#include "tests/WebnnTest.h"
+
+class GraphSerializationTests : public WebnnTest {
+  protected:
+    void TearDown() override {
+        std::remove(mPath.c_str());
+        WebnnTest::TearDown();
+    }
+
+    bool Serialize(const ml::GraphBuilder& builder,
+                   const std::string& name,
+                   const ml::Operand& output) {
+        ml::NamedOperands namedOperands = ml::CreateNamedOperands();
+        namedOperands.Set(name.c_str(), output);
+        return builder.Serialize(namedOperands, mPath.c_str());
+    }
+
+    ml::Graph Deserialize() {
+        const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+        const ml::NamedOperands namedOperands = builder.Deserialize(mPath.c_str());
+        if (!namedOperands) {
+            return nullptr;
+        }
+        return builder.Build(namedOperands);
+    }
+
+    const std::string mPath = testing::TempDir() + "webnn_graph_serialization_test.bin";
+};
+
+// The builder and the constants are released before the graph is deserialized, so that it can
+// only read them from the file.
+TEST_F(GraphSerializationTests, Conv2dAddRelu) {
+    {
+        const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+        const std::vector<float> filterData = {0.1, 0.2, 0.3, 0.4, -0.5, 0.25, 0.75, -1.0};
+        const std::vector<float> biasData = {0.5, -0.25};
+        const std::vector<float> addendData = {0.1};
+        const ml::Operand input = utils::BuildInput(builder, "input", {1, 1, 3, 3});
+        const ml::Operand filter = utils::BuildConstant(builder, {2, 1, 2, 2}, filterData.data(),
+                                                        filterData.size() * sizeof(float));
+        ml::Conv2dOptions options;
+        options.bias = utils::BuildConstant(builder, {2}, biasData.data(),
+                                            biasData.size() * sizeof(float));
+        const ml::Operand addend =
+            utils::BuildConstant(builder, {1}, addendData.data(), sizeof(float));
+        const ml::Operand output =
+            builder.Relu(builder.Add(builder.Conv2d(input, filter, &options), addend));
+        ASSERT_TRUE(Serialize(builder, "output", output));
+    }
+
+    const ml::Graph graph = Deserialize();
+    ASSERT_TRUE(graph);
+    std::vector<float> result(utils::SizeOfShape({1, 2, 2, 2}));
+    utils::Compute(graph, {{"input", {0.5, -1.0, 2.0, 1.5, 0.0, -0.5, -2.0, 1.0, 3.0}}},
+                   {{"output", result}});
+    EXPECT_TRUE(utils::CheckValue(result, {0.9, 0.7, 0.55, 2.0, 0.475, 1.35, 0, 0}));
+}
+
+// The symbolic batch of an input is kept in the file.
+TEST_F(GraphSerializationTests, SymbolicBatch) {
+    {
+        const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+        const std::vector<float> bData = {1, 0, 0, 1, 1, 1};
+        const ml::Operand a = utils::BuildInput(builder, "a", {-1, 3});
+        const ml::Operand b =
+            utils::BuildConstant(builder, {3, 2}, bData.data(), bData.size() * sizeof(float));
+        ASSERT_TRUE(Serialize(builder, "c", builder.Gemm(a, b)));
+    }
+
+    const ml::Graph graph = Deserialize();
+    ASSERT_TRUE(graph);
+    const std::vector<float> aData = {1, 2, 3, -4, 1, 1};
+    const std::vector<int32_t> aDimensions = {2, 3};
+    ml::Input input = {};
+    input.resource = {const_cast<float*>(aData.data()), aData.size() * sizeof(float)};
+    input.dimensions = aDimensions.data();
+    input.dimensionsCount = aDimensions.size();
+    ml::NamedInputs namedInputs = ml::CreateNamedInputs();
+    namedInputs.Set("a", &input);
+    std::vector<float> result(4);
+    ml::ArrayBufferView output = {result.data(), result.size() * sizeof(float)};
+    ml::NamedOutputs namedOutputs = ml::CreateNamedOutputs();
+    namedOutputs.Set("c", &output);
+    EXPECT_EQ(graph.Compute(namedInputs, namedOutputs), ml::ComputeGraphStatus::Success);
+    EXPECT_TRUE(utils::CheckValue(result, {4, 5, -3, 2}));
+}
+
+TEST_F(GraphSerializationTests, DeserializeInvalidFile) {
+    std::ofstream(mPath, std::ios::binary) << "This isn't a serialized graph.";
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    StartExpectContextError();
+    EXPECT_FALSE(builder.Deserialize(mPath.c_str()));
+    EXPECT_TRUE(EndExpectContextError());
+}
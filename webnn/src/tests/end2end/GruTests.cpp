@@ -253,3 +253,62 @@ TEST_F(GruTests, GruWithReturnSequenceTrue) {
 
     TestGru(input, weight, recurrentWeight, steps, hiddenSize, std::move(expected), &options);
 }
+
+TEST_F(GruTests, StatefulGruStreamsChunks) {
+    const int32_t steps = 4, chunkSteps = 2, batchSize = 2, inputSize = 3, hiddenSize = 4;
+    std::vector<float> weightData(3 * hiddenSize * inputSize);
+    for (size_t i = 0; i < weightData.size(); ++i) {
+        weightData[i] = 0.05f * static_cast<float>(i % 7) - 0.15f;
+    }
+    std::vector<float> recurrentWeightData(3 * hiddenSize * hiddenSize);
+    for (size_t i = 0; i < recurrentWeightData.size(); ++i) {
+        recurrentWeightData[i] = 0.04f * static_cast<float>(i % 5) - 0.08f;
+    }
+    std::vector<float> inputData(steps * batchSize * inputSize);
+    for (size_t i = 0; i < inputData.size(); ++i) {
+        inputData[i] = 0.1f * static_cast<float>(i) - 1.0f;
+    }
+    auto buildGru = [&](int32_t gruSteps, bool stateful) {
+        const ml::GraphBuilder gruBuilder = ml::CreateGraphBuilder(GetContext());
+        const ml::Operand weight =
+            utils::BuildConstant(gruBuilder, {1, 3 * hiddenSize, inputSize}, weightData.data(),
+                                 weightData.size() * sizeof(float));
+        const ml::Operand recurrentWeight = utils::BuildConstant(
+            gruBuilder, {1, 3 * hiddenSize, hiddenSize}, recurrentWeightData.data(),
+            recurrentWeightData.size() * sizeof(float));
+        const ml::Operand input =
+            utils::BuildInput(gruBuilder, "input", {gruSteps, batchSize, inputSize});
+        ml::GruOptions options = {};
+        options.stateful = stateful;
+        const ml::OperandArray outputs =
+            gruBuilder.Gru(input, weight, recurrentWeight, gruSteps, hiddenSize, &options);
+        return utils::Build(gruBuilder, {{"hidden", outputs.GetOperand(0)}});
+    };
+    const ml::Graph wholeGraph = buildGru(steps, false);
+    ASSERT_TRUE(wholeGraph);
+    // The backends without the stateful gru fail to build the graph.
+    StartExpectContextError();
+    const ml::Graph streamGraph = buildGru(chunkSteps, true);
+    const bool buildFailed = EndExpectContextError();
+    if (!streamGraph) {
+        ASSERT_TRUE(buildFailed);
+        GTEST_SKIP() << "The backend doesn't support the stateful gru: " << GetLastErrorMessage();
+    }
+
+    const size_t chunkSize = chunkSteps * batchSize * inputSize;
+    const std::vector<float> firstChunk(inputData.begin(), inputData.begin() + chunkSize);
+    const std::vector<float> secondChunk(inputData.begin() + chunkSize, inputData.end());
+    std::vector<float> expected(batchSize * hiddenSize);
+    utils::Compute(wholeGraph, {{"input", inputData}}, {{"hidden", expected}});
+
+    // The second chunk goes on from the hidden state the first one left in the graph.
+    std::vector<float> firstHidden(batchSize * hiddenSize), hidden(batchSize * hiddenSize);
+    utils::Compute(streamGraph, {{"input", firstChunk}}, {{"hidden", firstHidden}});
+    utils::Compute(streamGraph, {{"input", secondChunk}}, {{"hidden", hidden}});
+    EXPECT_TRUE(utils::CheckValue(hidden, expected));
+
+    // A reset starts again from zeros.
+    streamGraph.ResetState();
+    utils::Compute(streamGraph, {{"input", firstChunk}}, {{"hidden", hidden}});
+    EXPECT_TRUE(utils::CheckValue(hidden, firstHidden));
+}
@@ -0,0 +1,94 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/WebnnTest.h"
+#include "webnn_native/WebnnNative.h"
+
+class InterOpTests : public WebnnTest {
+  protected:
+    ml::Context CreateContext(bool profiling = false) {
+        ml::ContextOptions options;
+        options.threadCount = 4;
+        options.interOpThreadCount = 4;
+        options.profiling = profiling;
+        return ml::Context::Acquire(mInstance.CreateContext(&options));
+    }
+
+    // Splits the input into branches of different lengths which only meet again in the concat,
+    // so that the lanes compute them at once.
+    ml::Graph BuildBranches(const ml::Context& context) {
+        const ml::GraphBuilder builder = ml::CreateGraphBuilder(context);
+        const ml::Operand input = utils::BuildInput(builder, "input", {4, 2, 3});
+        const std::vector<uint32_t> splits = {1, 1, 1, 1};
+        ml::SplitOptions splitOptions = {0};
+        const ml::OperandArray branches = builder.Split(input, splits.data(), 4, &splitOptions);
+        std::vector<ml::Operand> outputs;
+        for (size_t i = 0; i < branches.Size(); ++i) {
+            ml::Operand branch = branches.GetOperand(i);
+            for (size_t j = 0; j <= i; ++j) {
+                const ml::Operand scale = utils::BuildConstant(
+                    builder, {1}, &mScales[(i + j) % mScales.size()], sizeof(float));
+                branch = builder.Tanh(builder.Add(builder.Mul(branch, scale), branch));
+            }
+            outputs.push_back(branch);
+        }
+        const ml::Operand output = builder.Concat(outputs.size(), outputs.data(), 0);
+        const ml::Operand sum = builder.Add(outputs[0], outputs[3]);
+        return utils::Build(builder, {{"output", output}, {"sum", sum}});
+    }
+
+    webnn_native::Instance mInstance;
+    const std::vector<float> mScales = {0.5, -0.25, 2.0, -1.5};
+    const std::vector<float> mInput = {-6, -5, -4, -3, -2, -1, 0, 1, 2,  3,  4,  5,
+                                       6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16, 17};
+};
+
+TEST_F(InterOpTests, MatchesSequentialCompute) {
+    const ml::Context context = CreateContext();
+    ASSERT_TRUE(context);
+    const ml::Graph graph = BuildBranches(context);
+    ASSERT_TRUE(graph);
+    const ml::Graph sequentialGraph = BuildBranches(GetContext());
+    ASSERT_TRUE(sequentialGraph);
+
+    std::vector<float> expectedOutput(utils::SizeOfShape({4, 2, 3}));
+    std::vector<float> expectedSum(utils::SizeOfShape({1, 2, 3}));
+    utils::Compute(sequentialGraph, {{"input", mInput}},
+                   {{"output", expectedOutput}, {"sum", expectedSum}});
+    for (int i = 0; i < 3; ++i) {
+        std::vector<float> output(expectedOutput.size());
+        std::vector<float> sum(expectedSum.size());
+        utils::Compute(graph, {{"input", mInput}}, {{"output", output}, {"sum", sum}});
+        EXPECT_TRUE(utils::CheckValue(output, expectedOutput));
+        EXPECT_TRUE(utils::CheckValue(sum, expectedSum));
+    }
+}
+
+TEST_F(InterOpTests, ProfilesEveryOperator) {
+    const ml::Context context = CreateContext(true);
+    ASSERT_TRUE(context);
+    const ml::Graph graph = BuildBranches(context);
+    ASSERT_TRUE(graph);
+    std::vector<float> output(utils::SizeOfShape({4, 2, 3}));
+    std::vector<float> sum(utils::SizeOfShape({1, 2, 3}));
+    utils::Compute(graph, {{"input", mInput}}, {{"output", output}, {"sum", sum}});
+    utils::Compute(graph, {{"input", mInput}}, {{"output", output}, {"sum", sum}});
+
+    const std::vector<webnn_native::OperatorProfile> profiles =
+        webnn_native::GetOperatorProfiles(graph.Get());
+    ASSERT_FALSE(profiles.empty());
+    for (auto& profile : profiles) {
+        EXPECT_EQ(profile.executionCount, 2u);
+    }
+}
@@ -0,0 +1,122 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/WebnnTest.h"
+#include "webnn_native/WebnnNative.h"
+
+class ProfilingTests : public WebnnTest {
+  protected:
+    void SetUp() override {
+        WebnnTest::SetUp();
+        // The context of the other tests with profiling, on the device they were run with.
+        ml::ContextOptions options;
+        if (GetContextOptions() != nullptr) {
+            options = *GetContextOptions();
+        }
+        options.profiling = true;
+        mContext = ml::Context::Acquire(mInstance.CreateContext(&options));
+        ASSERT_TRUE(mContext);
+    }
+
+    ml::Graph BuildConv2dAddRelu(const ml::Context& context) {
+        const ml::GraphBuilder builder = ml::CreateGraphBuilder(context);
+        const ml::Operand input = utils::BuildInput(builder, "input", {1, 1, 3, 3});
+        const ml::Operand filter = utils::BuildConstant(builder, {1, 1, 2, 2}, mFilter.data(),
+                                                        mFilter.size() * sizeof(float));
+        const ml::Operand bias = utils::BuildConstant(builder, {1}, mBias.data(), sizeof(float));
+        const ml::Operand output = builder.Relu(builder.Add(builder.Conv2d(input, filter), bias));
+        return utils::Build(builder, {{"output", output}});
+    }
+
+    size_t Count(const std::string& text, const std::string& pattern) {
+        size_t count = 0;
+        for (size_t i = text.find(pattern); i != std::string::npos;
+             i = text.find(pattern, i + 1)) {
+            ++count;
+        }
+        return count;
+    }
+
+    webnn_native::Instance mInstance;
+    ml::Context mContext;
+    const std::vector<float> mFilter = {0.5, -0.5, 0.25, 1.0};
+    const std::vector<float> mBias = {-1.0};
+    const std::vector<float> mInput = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+};
+
+TEST_F(ProfilingTests, RecordsEveryOperatorOfEachCompute) {
+    const ml::Graph graph = BuildConv2dAddRelu(mContext);
+    ASSERT_TRUE(graph);
+    std::vector<float> result(utils::SizeOfShape({1, 1, 2, 2}));
+    for (int i = 0; i < 3; ++i) {
+        utils::Compute(graph, {{"input", mInput}}, {{"output", result}});
+    }
+
+    const std::vector<webnn_native::OperatorProfile> profiles =
+        webnn_native::GetOperatorProfiles(graph.Get());
+    if (profiles.empty()) {
+        GTEST_SKIP() << "The backend only traces the computes.";
+    }
+    for (size_t i = 0; i < profiles.size(); ++i) {
+        EXPECT_EQ(profiles[i].index, i);
+        EXPECT_FALSE(profiles[i].name.empty());
+        EXPECT_FALSE(profiles[i].kernel.empty());
+        EXPECT_GT(profiles[i].byteLength, 0u);
+        EXPECT_EQ(profiles[i].executionCount, 3u);
+        EXPECT_GE(profiles[i].totalTime, 0.0);
+    }
+}
+
+TEST_F(ProfilingTests, ExportsChromeTrace) {
+    const ml::Graph graph = BuildConv2dAddRelu(mContext);
+    ASSERT_TRUE(graph);
+    std::vector<float> result(utils::SizeOfShape({1, 1, 2, 2}));
+    utils::Compute(graph, {{"input", mInput}}, {{"output", result}});
+    utils::Compute(graph, {{"input", mInput}}, {{"output", result}});
+
+    const std::string trace = webnn_native::GetChromeTrace(graph.Get());
+    EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+    EXPECT_EQ(trace.back(), '}');
+    // A begin and an end event for each compute and each operator.
+    const size_t operatorCount = webnn_native::GetOperatorProfiles(graph.Get()).size();
+    EXPECT_EQ(Count(trace, "\"name\":\"compute\""), 4u);
+    EXPECT_EQ(Count(trace, "\"ph\":\"B\""), 2 * (operatorCount + 1));
+    EXPECT_EQ(Count(trace, "\"ph\":\"E\""), 2 * (operatorCount + 1));
+    EXPECT_EQ(Count(trace, "\"bytes\":"), 2 * operatorCount);
+}
+
+TEST_F(ProfilingTests, DisabledByDefault) {
+    const ml::Graph graph = BuildConv2dAddRelu(GetContext());
+    ASSERT_TRUE(graph);
+    std::vector<float> result(utils::SizeOfShape({1, 1, 2, 2}));
+    utils::Compute(graph, {{"input", mInput}}, {{"output", result}});
+    EXPECT_TRUE(webnn_native::GetOperatorProfiles(graph.Get()).empty());
+    EXPECT_TRUE(webnn_native::GetChromeTrace(graph.Get()).empty());
+}
+
+TEST_F(ProfilingTests, CountsCopiedBytes) {
+    const ml::Graph graph = BuildConv2dAddRelu(GetContext());
+    ASSERT_TRUE(graph);
+    std::vector<float> result(utils::SizeOfShape({1, 1, 2, 2}));
+    for (int i = 0; i < 2; ++i) {
+        utils::Compute(graph, {{"input", mInput}}, {{"output", result}});
+    }
+    const webnn_native::ComputeCopyStats stats = webnn_native::GetComputeCopyStats(graph.Get());
+    if (stats.computeCount == 0) {
+        GTEST_SKIP() << "The backend doesn't count the bytes it copies.";
+    }
+    EXPECT_EQ(stats.computeCount, 2u);
+    // At most the input and the output are copied by each compute.
+    EXPECT_LE(stats.copiedByteLength, 2 * (mInput.size() + result.size()) * sizeof(float));
+}
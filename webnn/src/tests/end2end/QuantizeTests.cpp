@@ -0,0 +1,258 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <list>
+
+#include "tests/WebnnTest.h"
+
+class QuantizeTests : public WebnnTest {
+  protected:
+    // Builds the scale and the zero point of a quantized tensor, with one value per element
+    // along the axis when there are several. The builder reads the constants until the graph is
+    // built, so the fixture keeps a copy of them.
+    template <typename T>
+    ml::Operand BuildValues(const ml::GraphBuilder& builder,
+                            const std::vector<T>& values,
+                            ml::OperandType type) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values.data());
+        mConstants.emplace_back(bytes, bytes + values.size() * sizeof(T));
+        return utils::BuildConstant(builder, {static_cast<int32_t>(values.size())},
+                                    mConstants.back().data(), mConstants.back().size(), type);
+    }
+    ml::Operand BuildScale(const ml::GraphBuilder& builder, const std::vector<float>& scales) {
+        return BuildValues(builder, scales, ml::OperandType::Float32);
+    }
+    template <typename T>
+    ml::Operand BuildZeroPoint(const ml::GraphBuilder& builder,
+                               const std::vector<T>& zeroPoints) {
+        return BuildValues(builder, zeroPoints,
+                           std::is_signed<T>::value ? ml::OperandType::Int8
+                                                    : ml::OperandType::Uint8);
+    }
+
+    // Computes |graph| with its single input named "input" and output named "output", whose
+    // types may differ.
+    template <typename Input, typename Output>
+    void Compute(const ml::Graph& graph,
+                 const std::vector<int32_t>& dimensions,
+                 const std::vector<Input>& inputData,
+                 std::vector<Output>& result) {
+        ml::Input input = {};
+        input.resource = {const_cast<Input*>(inputData.data()), inputData.size() * sizeof(Input)};
+        input.dimensions = dimensions.data();
+        input.dimensionsCount = dimensions.size();
+        ml::NamedInputs namedInputs = ml::CreateNamedInputs();
+        namedInputs.Set("input", &input);
+        ml::ArrayBufferView output = {result.data(), result.size() * sizeof(Output)};
+        ml::NamedOutputs namedOutputs = ml::CreateNamedOutputs();
+        namedOutputs.Set("output", &output);
+        EXPECT_EQ(graph.Compute(namedInputs, namedOutputs), ml::ComputeGraphStatus::Success);
+    }
+
+    std::list<std::vector<uint8_t>> mConstants;
+};
+
+TEST_F(QuantizeTests, QuantizeLinearInt8) {
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const ml::Operand input = utils::BuildInput(builder, "input", {2, 3});
+    const ml::Operand output = builder.QuantizeLinear(input, BuildScale(builder, {0.5}),
+                                                      BuildZeroPoint<int8_t>(builder, {1}));
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    ASSERT_TRUE(graph);
+    std::vector<int8_t> result(6);
+    Compute(graph, {2, 3}, std::vector<float>({-1.0, 0.0, 1.25, 2.75, 100.0, -100.0}), result);
+    // The ties round to even and the values saturate.
+    EXPECT_EQ(result, std::vector<int8_t>({-1, 1, 3, 7, 127, -128}));
+}
+
+TEST_F(QuantizeTests, QuantizeLinearUint8PerChannel) {
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const ml::Operand input = utils::BuildInput(builder, "input", {2, 2});
+    ml::QuantizeLinearOptions options = {};
+    options.axis = 1;
+    const ml::Operand output =
+        builder.QuantizeLinear(input, BuildScale(builder, {0.5, 2.0}),
+                               BuildZeroPoint<uint8_t>(builder, {128, 0}), &options);
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    ASSERT_TRUE(graph);
+    std::vector<uint8_t> result(4);
+    Compute(graph, {2, 2}, std::vector<float>({1.0, 4.0, -1.0, -3.0}), result);
+    EXPECT_EQ(result, std::vector<uint8_t>({130, 2, 126, 0}));
+}
+
+TEST_F(QuantizeTests, DequantizeLinearInt8) {
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const ml::Operand input = utils::BuildInput(builder, "input", {4}, ml::OperandType::Int8);
+    const ml::Operand output = builder.DequantizeLinear(input, BuildScale(builder, {0.1}),
+                                                        BuildZeroPoint<int8_t>(builder, {-1}));
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    ASSERT_TRUE(graph);
+    std::vector<float> result(4);
+    Compute(graph, {4}, std::vector<int8_t>({-128, -1, 0, 127}), result);
+    EXPECT_TRUE(utils::CheckValue(result, {-12.7, 0.0, 0.1, 12.8}));
+}
+
+TEST_F(QuantizeTests, DequantizeLinearUint8PerChannel) {
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const ml::Operand input = utils::BuildInput(builder, "input", {2, 2}, ml::OperandType::Uint8);
+    ml::QuantizeLinearOptions options = {};
+    options.axis = 0;
+    const ml::Operand output =
+        builder.DequantizeLinear(input, BuildScale(builder, {1.0, 0.5}),
+                                 BuildZeroPoint<uint8_t>(builder, {10, 20}), &options);
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    ASSERT_TRUE(graph);
+    std::vector<float> result(4);
+    Compute(graph, {2, 2}, std::vector<uint8_t>({0, 255, 10, 20}), result);
+    EXPECT_TRUE(utils::CheckValue(result, {-10.0, 245.0, -5.0, 0.0}));
+}
+
+// The dequantized values are read by a float32 operator.
+TEST_F(QuantizeTests, QuantizeDequantizeRelu) {
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const ml::Operand input = utils::BuildInput(builder, "input", {4});
+    const ml::Operand scale = BuildScale(builder, {0.5});
+    const ml::Operand zeroPoint = BuildZeroPoint<int8_t>(builder, {0});
+    const ml::Operand output = builder.Relu(builder.DequantizeLinear(
+        builder.QuantizeLinear(input, scale, zeroPoint), scale, zeroPoint));
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    ASSERT_TRUE(graph);
+    std::vector<float> result(4);
+    Compute(graph, {4}, std::vector<float>({0.26, -0.74, 1.1, 80.0}), result);
+    EXPECT_TRUE(utils::CheckValue(result, {0.5, 0.0, 1.0, 63.5}));
+}
+
+// The dequantized input and filter of a convolution are computed by the integer kernels.
+TEST_F(QuantizeTests, Conv2dNchw) {
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const ml::Operand input =
+        utils::BuildInput(builder, "input", {1, 1, 3, 3}, ml::OperandType::Int8);
+    const std::vector<int8_t> filterData = {1, -2, 3, 4, -1, 2, 0, 5};
+    const ml::Operand filter = utils::BuildConstant(builder, {2, 1, 2, 2}, filterData.data(),
+                                                    filterData.size(), ml::OperandType::Int8);
+    ml::QuantizeLinearOptions filterOptions = {};
+    filterOptions.axis = 0;
+    const std::vector<float> biasData = {1.0, -1.0};
+    utils::Conv2dOptions options;
+    options.bias = utils::BuildConstant(builder, {2}, biasData.data(),
+                                        biasData.size() * sizeof(float));
+    const ml::Operand output = builder.Conv2d(
+        builder.DequantizeLinear(input, BuildScale(builder, {0.5}),
+                                 BuildZeroPoint<int8_t>(builder, {1})),
+        builder.DequantizeLinear(filter, BuildScale(builder, {0.25, 0.5}),
+                                 BuildZeroPoint<int8_t>(builder, {0, 0}), &filterOptions),
+        options.AsPtr());
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    ASSERT_TRUE(graph);
+    std::vector<float> result(8);
+    Compute(graph, {1, 1, 3, 3}, std::vector<int8_t>({-3, 1, 5, 2, -1, 0, 7, 3, -2}), result);
+    EXPECT_TRUE(
+        utils::CheckValue(result, {-0.125, -1.25, 4.875, 0.25, -2.5, -0.25, 0.25, -4.75}));
+}
+
+TEST_F(QuantizeTests, Conv2dNhwcRelu) {
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const ml::Operand input =
+        utils::BuildInput(builder, "input", {1, 3, 3, 1}, ml::OperandType::Int8);
+    const std::vector<int8_t> filterData = {1, -1, -2, 2, 3, 0, 4, 5};
+    const ml::Operand filter = utils::BuildConstant(builder, {2, 2, 1, 2}, filterData.data(),
+                                                    filterData.size(), ml::OperandType::Int8);
+    ml::QuantizeLinearOptions filterOptions = {};
+    filterOptions.axis = 3;
+    const std::vector<float> biasData = {1.0, -1.0};
+    utils::Conv2dOptions options;
+    options.inputLayout = ml::InputOperandLayout::Nhwc;
+    options.filterLayout = ml::FilterOperandLayout::Hwio;
+    options.bias = utils::BuildConstant(builder, {2}, biasData.data(),
+                                        biasData.size() * sizeof(float));
+    options.activation = utils::CreateActivationOperator(builder, utils::FusedActivation::RELU);
+    const ml::Operand output = builder.Conv2d(
+        builder.DequantizeLinear(input, BuildScale(builder, {0.5}),
+                                 BuildZeroPoint<int8_t>(builder, {1})),
+        builder.DequantizeLinear(filter, BuildScale(builder, {0.25, 0.5}),
+                                 BuildZeroPoint<int8_t>(builder, {0, 0}), &filterOptions),
+        options.AsPtr());
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    ASSERT_TRUE(graph);
+    std::vector<float> result(8);
+    Compute(graph, {1, 3, 3, 1}, std::vector<int8_t>({-3, 1, 5, 2, -1, 0, 7, 3, -2}), result);
+    EXPECT_TRUE(utils::CheckValue(result, {0.0, 0.0, 0.0, 0.0, 4.875, 0.25, 0.25, 0.0}));
+}
+
+TEST_F(QuantizeTests, Gemm) {
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const ml::Operand a = utils::BuildInput(builder, "input", {2, 3}, ml::OperandType::Int8);
+    const std::vector<int8_t> bData = {2, -4, 6, 8, -10, 12};
+    const ml::Operand b = utils::BuildConstant(builder, {3, 2}, bData.data(), bData.size(),
+                                               ml::OperandType::Int8);
+    ml::QuantizeLinearOptions bOptions = {};
+    bOptions.axis = 1;
+    const std::vector<float> cData = {1.0};
+    ml::GemmOptions options = {};
+    options.c = utils::BuildConstant(builder, {1}, cData.data(), sizeof(float));
+    options.alpha = 2.0;
+    options.beta = 0.5;
+    const ml::Operand output = builder.Gemm(
+        builder.DequantizeLinear(a, BuildScale(builder, {0.1}),
+                                 BuildZeroPoint<int8_t>(builder, {0})),
+        builder.DequantizeLinear(b, BuildScale(builder, {0.5, 0.25}),
+                                 BuildZeroPoint<int8_t>(builder, {0, 0}), &bOptions),
+        &options);
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    ASSERT_TRUE(graph);
+    std::vector<float> result(4);
+    Compute(graph, {2, 3}, std::vector<int8_t>({10, -20, 30, 5, 0, -5}), result);
+    EXPECT_TRUE(utils::CheckValue(result, {-39.5, 8.5, 6.5, -3.5}));
+}
+
+TEST_F(QuantizeTests, GemmTransposeB) {
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const ml::Operand a = utils::BuildInput(builder, "input", {2, 3}, ml::OperandType::Int8);
+    const std::vector<int8_t> bData = {2, 6, -10, -4, 8, 12};
+    const ml::Operand b = utils::BuildConstant(builder, {2, 3}, bData.data(), bData.size(),
+                                               ml::OperandType::Int8);
+    ml::QuantizeLinearOptions bOptions = {};
+    bOptions.axis = 0;
+    ml::GemmOptions options = {};
+    options.bTranspose = true;
+    const ml::Operand output = builder.Gemm(
+        builder.DequantizeLinear(a, BuildScale(builder, {0.1}),
+                                 BuildZeroPoint<int8_t>(builder, {0})),
+        builder.DequantizeLinear(b, BuildScale(builder, {0.5, 0.25}),
+                                 BuildZeroPoint<int8_t>(builder, {0, 0}), &bOptions),
+        &options);
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    ASSERT_TRUE(graph);
+    std::vector<float> result(4);
+    Compute(graph, {2, 3}, std::vector<int8_t>({10, -20, 30, 5, 0, -5}), result);
+    EXPECT_TRUE(utils::CheckValue(result, {-20.0, 4.0, 3.0, -2.0}));
+}
+
+TEST_F(QuantizeTests, MatMulUint8) {
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const ml::Operand a = utils::BuildInput(builder, "input", {2, 3}, ml::OperandType::Uint8);
+    const std::vector<int8_t> bData = {2, -4, 6, 8, -10, 12};
+    const ml::Operand b = utils::BuildConstant(builder, {3, 2}, bData.data(), bData.size(),
+                                               ml::OperandType::Int8);
+    const ml::Operand output = builder.Matmul(
+        builder.DequantizeLinear(a, BuildScale(builder, {0.1}),
+                                 BuildZeroPoint<uint8_t>(builder, {128})),
+        builder.DequantizeLinear(b, BuildScale(builder, {0.25}),
+                                 BuildZeroPoint<int8_t>(builder, {0})));
+    const ml::Graph graph = utils::Build(builder, {{"output", output}});
+    ASSERT_TRUE(graph);
+    std::vector<float> result(4);
+    Compute(graph, {2, 3}, std::vector<uint8_t>({138, 108, 158, 133, 128, 123}), result);
+    EXPECT_TRUE(utils::CheckValue(result, {-10.0, 4.0, 1.5, -2.0}));
+}
@@ -0,0 +1,156 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <thread>
+
+#include "tests/WebnnTest.h"
+#include "webnn_native/WebnnNative.h"
+
+class RequestBatcherTests : public WebnnTest {
+  protected:
+    // relu(gemm(a, b)) with a of shape [batch, 3], where b adds the last column to the others.
+    ml::Graph BuildGraph(int32_t batchSize) {
+        const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+        const ml::Operand a = utils::BuildInput(builder, "a", {batchSize, 3});
+        const std::vector<float> bData = {1, 0, 0, 1, 1, 1};
+        const ml::Operand b =
+            utils::BuildConstant(builder, {3, 2}, bData.data(), bData.size() * sizeof(float));
+        return utils::Build(builder, {{"c", builder.Relu(builder.Gemm(a, b))}});
+    }
+
+    MLComputeGraphStatus Compute(webnn_native::RequestBatcher& batcher,
+                                 const std::vector<float>& aData,
+                                 std::vector<float>& result,
+                                 const std::vector<int32_t>& aDimensions = {}) {
+        ml::Input input = {};
+        input.resource = {const_cast<float*>(aData.data()), aData.size() * sizeof(float)};
+        if (!aDimensions.empty()) {
+            input.dimensions = aDimensions.data();
+            input.dimensionsCount = aDimensions.size();
+        }
+        ml::NamedInputs namedInputs = ml::CreateNamedInputs();
+        namedInputs.Set("a", &input);
+        ml::ArrayBufferView output = {result.data(), result.size() * sizeof(float)};
+        ml::NamedOutputs namedOutputs = ml::CreateNamedOutputs();
+        namedOutputs.Set("c", &output);
+        return batcher.Compute(namedInputs.Get(), namedOutputs.Get());
+    }
+};
+
+TEST_F(RequestBatcherTests, BatchConcurrentRequests) {
+    const ml::Graph graph = BuildGraph(-1);
+    ASSERT_TRUE(graph);
+    // The batch is only computed once full.
+    webnn_native::RequestBatcherOptions options;
+    options.maxBatchSize = 4;
+    options.maxDelay = 60000000;
+    webnn_native::RequestBatcher batcher(graph.Get(), options);
+
+    std::vector<std::vector<float>> results(4, std::vector<float>(2));
+    std::vector<MLComputeGraphStatus> statuses(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i]() {
+            const float value = static_cast<float>(i);
+            statuses[i] = Compute(batcher, {value, -value, 1}, results[i]);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(statuses[i], MLComputeGraphStatus_Success);
+        EXPECT_TRUE(utils::CheckValue(results[i], {static_cast<float>(i) + 1,
+                                                   std::max(1 - static_cast<float>(i), 0.0f)}));
+    }
+
+    const webnn_native::RequestBatcherStats stats = batcher.GetStats();
+    EXPECT_EQ(stats.batchSizes, std::vector<uint64_t>({0, 0, 0, 0, 1}));
+    EXPECT_EQ(stats.queueDepths, std::vector<uint64_t>({1, 1, 1, 1}));
+}
+
+TEST_F(RequestBatcherTests, ComputeAfterMaxDelay) {
+    const ml::Graph graph = BuildGraph(-1);
+    ASSERT_TRUE(graph);
+    webnn_native::RequestBatcherOptions options;
+    options.maxDelay = 100;
+    webnn_native::RequestBatcher batcher(graph.Get(), options);
+    std::vector<float> result(2);
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_EQ(Compute(batcher, {1, 2, 3}, result), MLComputeGraphStatus_Success);
+        EXPECT_TRUE(utils::CheckValue(result, {4, 5}));
+    }
+    const webnn_native::RequestBatcherStats stats = batcher.GetStats();
+    EXPECT_EQ(stats.batchSizes, std::vector<uint64_t>({0, 2}));
+    EXPECT_EQ(stats.queueDepths, std::vector<uint64_t>({2}));
+}
+
+TEST_F(RequestBatcherTests, PadBatchToPowerOfTwo) {
+    // The 3 items are computed in the graph for 4 with an item of zeros.
+    const ml::Graph graph = BuildGraph(-1);
+    ASSERT_TRUE(graph);
+    webnn_native::RequestBatcherOptions options;
+    options.maxBatchSize = 4;
+    options.maxDelay = 100;
+    webnn_native::RequestBatcher batcher(graph.Get(), options);
+    std::vector<float> result(6);
+    EXPECT_EQ(Compute(batcher, {1, 2, 3, -1, -2, 1, 0, 0, 0}, result, {3, 3}),
+              MLComputeGraphStatus_Success);
+    EXPECT_TRUE(utils::CheckValue(result, {4, 5, 0, 0, 0, 0}));
+    EXPECT_EQ(batcher.GetStats().batchSizes, std::vector<uint64_t>({0, 0, 0, 1}));
+}
+
+TEST_F(RequestBatcherTests, ComputeFixedBatchAlone) {
+    // The graph has no symbolic batch to compute the requests with a larger one.
+    const ml::Graph graph = BuildGraph(1);
+    ASSERT_TRUE(graph);
+    webnn_native::RequestBatcherOptions options;
+    options.maxDelay = 60000000;
+    webnn_native::RequestBatcher batcher(graph.Get(), options);
+    std::vector<float> result(2);
+    EXPECT_EQ(Compute(batcher, {1, 2, 3}, result), MLComputeGraphStatus_Success);
+    EXPECT_TRUE(utils::CheckValue(result, {4, 5}));
+    EXPECT_TRUE(batcher.GetStats().batchSizes.empty());
+}
+
+TEST_F(RequestBatcherTests, ComputeStatefulGraphAlone) {
+    // The items of a batch would share the hidden state of the gru.
+    const int32_t hiddenSize = 2;
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const ml::Operand input = utils::BuildInput(builder, "a", {-1, 1, 3});
+    const std::vector<float> weightData(3 * hiddenSize * 3, 0.1f);
+    const ml::Operand weight = utils::BuildConstant(
+        builder, {1, 3 * hiddenSize, 3}, weightData.data(), weightData.size() * sizeof(float));
+    const std::vector<float> recurrentWeightData(3 * hiddenSize * hiddenSize, 0.1f);
+    const ml::Operand recurrentWeight = utils::BuildConstant(
+        builder, {1, 3 * hiddenSize, hiddenSize}, recurrentWeightData.data(),
+        recurrentWeightData.size() * sizeof(float));
+    ml::GruOptions gruOptions = {};
+    gruOptions.stateful = true;
+    const ml::OperandArray outputs =
+        builder.Gru(input, weight, recurrentWeight, 1, hiddenSize, &gruOptions);
+    StartExpectContextError();
+    const ml::Graph graph = utils::Build(builder, {{"c", outputs.GetOperand(0)}});
+    EndExpectContextError();
+    if (!graph) {
+        GTEST_SKIP() << "The backend doesn't support the stateful gru.";
+    }
+    webnn_native::RequestBatcherOptions options;
+    options.maxDelay = 60000000;
+    webnn_native::RequestBatcher batcher(graph.Get(), options);
+    std::vector<float> result(hiddenSize);
+    EXPECT_EQ(Compute(batcher, {1, 2, 3}, result), MLComputeGraphStatus_Success);
+    EXPECT_TRUE(batcher.GetStats().batchSizes.empty());
+}
@@ -0,0 +1,133 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <future>
+
+#include "tests/WebnnTest.h"
+
+class SymbolicBatchTests : public WebnnTest {
+  protected:
+    void SetUp() override {
+        WebnnTest::SetUp();
+        // relu(gemm(a, b)) with a of shape [-1, 3], where b adds the last column to the others.
+        const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+        const ml::Operand a = utils::BuildInput(builder, "a", {-1, 3});
+        const std::vector<float> bData = {1, 0, 0, 1, 1, 1};
+        const ml::Operand b =
+            utils::BuildConstant(builder, {3, 2}, bData.data(), bData.size() * sizeof(float));
+        mGraph = utils::Build(builder, {{"c", builder.Relu(builder.Gemm(a, b))}});
+    }
+
+    ml::ComputeGraphStatus ComputeWithDimensions(const std::vector<float>& aData,
+                                                 const std::vector<int32_t>& aDimensions,
+                                                 std::vector<float>& result) {
+        ml::Input input = {};
+        input.resource = {const_cast<float*>(aData.data()), aData.size() * sizeof(float)};
+        input.dimensions = aDimensions.data();
+        input.dimensionsCount = aDimensions.size();
+        ml::NamedInputs namedInputs = ml::CreateNamedInputs();
+        namedInputs.Set("a", &input);
+        ml::ArrayBufferView output = {result.data(), result.size() * sizeof(float)};
+        ml::NamedOutputs namedOutputs = ml::CreateNamedOutputs();
+        namedOutputs.Set("c", &output);
+        return mGraph.Compute(namedInputs, namedOutputs);
+    }
+
+    ml::Graph mGraph;
+};
+
+TEST_F(SymbolicBatchTests, ComputeWithoutDimensions) {
+    ASSERT_TRUE(mGraph);
+    std::vector<float> result(2);
+    utils::Compute(mGraph, {{"a", {1, 2, 3}}}, {{"c", result}});
+    EXPECT_TRUE(utils::CheckValue(result, {4, 5}));
+}
+
+TEST_F(SymbolicBatchTests, ComputeWithSeveralBatchSizes) {
+    ASSERT_TRUE(mGraph);
+    std::vector<float> result(6);
+    EXPECT_EQ(ComputeWithDimensions({1, 2, 3, -4, 1, 1, 0, -1, 0}, {3, 3}, result),
+              ml::ComputeGraphStatus::Success);
+    EXPECT_TRUE(utils::CheckValue(result, {4, 5, 0, 2, 0, 0}));
+
+    result.resize(4);
+    EXPECT_EQ(ComputeWithDimensions({0.5, 1, 1, 2, 2, -3}, {2, 3}, result),
+              ml::ComputeGraphStatus::Success);
+    EXPECT_TRUE(utils::CheckValue(result, {1.5, 2, 0, 0}));
+
+    result.resize(2);
+    EXPECT_EQ(ComputeWithDimensions({1, 2, 3}, {1, 3}, result), ml::ComputeGraphStatus::Success);
+    EXPECT_TRUE(utils::CheckValue(result, {4, 5}));
+
+    // The graph compiled for a batch size of 3 is reused.
+    result.resize(6);
+    EXPECT_EQ(ComputeWithDimensions({1, 1, 1, 2, 2, 2, 3, 3, 3}, {3, 3}, result),
+              ml::ComputeGraphStatus::Success);
+    EXPECT_TRUE(utils::CheckValue(result, {2, 2, 4, 4, 6, 6}));
+}
+
+// The graph for a new batch size is built by the asynchronous compute.
+TEST_F(SymbolicBatchTests, ComputeAsyncWithNewBatchSize) {
+    ASSERT_TRUE(mGraph);
+    const std::vector<float> aData = {1, 2, 3, -4, 1, 1};
+    const std::vector<int32_t> aDimensions = {2, 3};
+    ml::Input input = {};
+    input.resource = {const_cast<float*>(aData.data()), aData.size() * sizeof(float)};
+    input.dimensions = aDimensions.data();
+    input.dimensionsCount = aDimensions.size();
+    ml::NamedInputs namedInputs = ml::CreateNamedInputs();
+    namedInputs.Set("a", &input);
+    std::vector<float> result(4);
+    ml::ArrayBufferView output = {result.data(), result.size() * sizeof(float)};
+    ml::NamedOutputs namedOutputs = ml::CreateNamedOutputs();
+    namedOutputs.Set("c", &output);
+
+    std::promise<MLComputeGraphStatus> promise;
+    std::future<MLComputeGraphStatus> future = promise.get_future();
+    mGraph.ComputeAsync(
+        namedInputs, namedOutputs,
+        [](MLComputeGraphStatus status, const char*, void* userdata) {
+            static_cast<std::promise<MLComputeGraphStatus>*>(userdata)->set_value(status);
+        },
+        &promise);
+    EXPECT_EQ(future.get(), MLComputeGraphStatus_Success);
+    EXPECT_TRUE(utils::CheckValue(result, {4, 5, 0, 2}));
+}
+
+TEST_F(SymbolicBatchTests, ComputeWithMismatchedDimensions) {
+    ASSERT_TRUE(mGraph);
+    std::vector<float> result(4);
+    StartExpectContextError();
+    EXPECT_EQ(ComputeWithDimensions({1, 2, 3, 4, 5, 6, 7, 8}, {2, 4}, result),
+              ml::ComputeGraphStatus::Error);
+    EXPECT_TRUE(EndExpectContextError());
+}
+
+// The reshapes the graph optimizer merges keep the symbolic batch.
+TEST_F(SymbolicBatchTests, ComputeMergedReshapes) {
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const ml::Operand a = utils::BuildInput(builder, "a", {-1, 2, 2});
+    const std::vector<int32_t> firstShape = {-1, 4};
+    const std::vector<int32_t> secondShape = {-1, 1, 4};
+    const ml::Operand reshaped =
+        builder.Reshape(builder.Reshape(a, firstShape.data(), firstShape.size()),
+                        secondShape.data(), secondShape.size());
+    mGraph = utils::Build(builder, {{"c", builder.Relu(reshaped)}});
+    ASSERT_TRUE(mGraph);
+    std::vector<float> result(12);
+    EXPECT_EQ(ComputeWithDimensions({1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 11, -12}, {3, 2, 2},
+                                    result),
+              ml::ComputeGraphStatus::Success);
+    EXPECT_TRUE(utils::CheckValue(result, {1, 0, 3, 0, 5, 0, 7, 0, 9, 0, 11, 0}));
+}
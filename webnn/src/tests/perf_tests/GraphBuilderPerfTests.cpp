@@ -0,0 +1,114 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+#include "tests/perf_tests/WebnnPerfTest.h"
+
+namespace {
+
+    // The allocations of the whole process, counted by the replaced operator new below.
+    std::atomic<uint64_t> gAllocationCount(0);
+
+}  // namespace
+
+void* operator new(size_t size) {
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        std::abort();
+    }
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+namespace {
+
+    struct GraphBuilderParams {
+        const char* name;
+        uint32_t operatorCount;
+    };
+
+    std::string GetParamName(const testing::TestParamInfo<GraphBuilderParams>& info) {
+        return info.param.name;
+    }
+
+    double GetElapsedTime(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    constexpr int32_t kWidth = 8;
+    // A layer is made of the constant weight and bias, the matmul, the add of the bias, the relu
+    // and the residual add.
+    constexpr uint32_t kOperatorsPerLayer = 6;
+
+}  // namespace
+
+class GraphBuilderPerfTests : public WebnnPerfTest,
+                              public testing::WithParamInterface<GraphBuilderParams> {
+  protected:
+    GraphBuilderPerfTests() : WebnnPerfTest(0) {
+    }
+};
+
+// Builds a deep stack of small transformer-like layers, which measures what the builder, the
+// sort and the optimizer cost for each operator rather than what computing them costs.
+TEST_P(GraphBuilderPerfTests, Build) {
+    const uint32_t layerCount = GetParam().operatorCount / kOperatorsPerLayer;
+    const std::vector<float> weight(kWidth * kWidth, 0.01);
+    const std::vector<float> bias(kWidth, 0.1);
+
+    uint64_t allocationCount = gAllocationCount.load();
+    auto start = std::chrono::steady_clock::now();
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    ml::Operand x = utils::BuildInput(builder, "input", {1, kWidth});
+    for (uint32_t i = 0; i < layerCount; ++i) {
+        const ml::Operand w = utils::BuildConstant(builder, {kWidth, kWidth}, weight.data(),
+                                                   weight.size() * sizeof(float));
+        const ml::Operand b =
+            utils::BuildConstant(builder, {kWidth}, bias.data(), bias.size() * sizeof(float));
+        x = builder.Add(builder.Relu(builder.Add(builder.Matmul(x, w), b)), x);
+    }
+    const double buildTime = GetElapsedTime(start);
+    const uint64_t buildAllocations = gAllocationCount.load() - allocationCount;
+
+    allocationCount = gAllocationCount.load();
+    start = std::chrono::steady_clock::now();
+    const ml::Graph graph = utils::Build(builder, {{"output", x}});
+    const double compileTime = GetElapsedTime(start);
+    const uint64_t compileAllocations = gAllocationCount.load() - allocationCount;
+    ASSERT_TRUE(graph);
+
+    ReportResult("build_time", buildTime, "ms", true);
+    ReportResult("build_allocations", buildAllocations, "count");
+    ReportResult("compile_time", compileTime, "ms");
+    ReportResult("compile_allocations", compileAllocations, "count");
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         GraphBuilderPerfTests,
+                         testing::Values(GraphBuilderParams{"Operators10k", 10000},
+                                         GraphBuilderParams{"Operators100k", 100000}),
+                         GetParamName);
@@ -0,0 +1,117 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fstream>
+
+#include "tests/perf_tests/WebnnPerfTest.h"
+#include "webnn/examples/LeNet/LeNet.h"
+#include "webnn/examples/MobileNetV2/MobileNetV2.h"
+#include "webnn/examples/ResNet/ResNet.h"
+#include "webnn/examples/SqueezeNet/SqueezeNet.h"
+
+static const std::string kModelPath = WEBNN_END2END_TEST_MODEL_PATH;
+static const std::string kLeNetWeightsPath = WEBNN_PERF_TEST_LENET_WEIGHTS_PATH;
+
+class ModelPerfTests : public WebnnPerfTest {
+  protected:
+    ModelPerfTests() : WebnnPerfTest(kStepsToRun) {
+    }
+
+    // Benchmarks |model| loaded by |load| from the weights of |modelDirectory| in the test data
+    // models, computing the first input of its test data set.
+    void TestModel(ExampleBase& model,
+                   const std::string& modelDirectory,
+                   const std::function<ml::Operand(const ml::GraphBuilder&)>& load,
+                   int32_t outputSize) {
+        const std::string path = kModelPath + "/" + modelDirectory + "/";
+        const std::string inputFile = path + "test_data_set/0/input_0.npy";
+        if (!std::ifstream(inputFile).good()) {
+            GTEST_SKIP() << "Skipped because " << inputFile << " is missing.";
+        }
+        model.mWeightsPath = path + "weights/";
+        const std::vector<float> input = cnpy::npy_load(inputFile).as_vec<float>();
+        std::vector<float> result(utils::SizeOfShape({1, outputSize}));
+        RunTest(
+            [&](const ml::GraphBuilder& builder) -> std::vector<utils::NamedOperand> {
+                return {{"output", load(builder)}};
+            },
+            {{"input", input}}, {{"output", result}});
+    }
+
+  private:
+    static constexpr unsigned int kStepsToRun = 20;
+};
+
+TEST_F(ModelPerfTests, LeNet) {
+    if (!std::ifstream(kLeNetWeightsPath).good()) {
+        GTEST_SKIP() << "Skipped because " << kLeNetWeightsPath << " is missing.";
+    }
+    LeNet lenet;
+    const std::vector<float> input(utils::SizeOfShape({1, 1, 28, 28}), 0.5);
+    std::vector<float> result(utils::SizeOfShape({1, 10}));
+    RunTest(
+        [&](const ml::GraphBuilder& builder) -> std::vector<utils::NamedOperand> {
+            return {{"output", lenet.Load(builder, kLeNetWeightsPath)}};
+        },
+        {{"input", input}}, {{"output", result}});
+}
+
+TEST_F(ModelPerfTests, SqueezeNetNchw) {
+    SqueezeNet squeezenet;
+    TestModel(
+        squeezenet, "squeezenet1.1_nchw",
+        [&](const ml::GraphBuilder& builder) { return squeezenet.LoadNCHW(builder, false); },
+        1000);
+}
+
+TEST_F(ModelPerfTests, SqueezeNetNhwc) {
+    SqueezeNet squeezenet;
+    squeezenet.mLayout = "nhwc";
+    TestModel(
+        squeezenet, "squeezenet1.0_nhwc",
+        [&](const ml::GraphBuilder& builder) { return squeezenet.LoadNHWC(builder, false); },
+        1001);
+}
+
+TEST_F(ModelPerfTests, MobileNetV2Nchw) {
+    MobileNetV2 mobilenetv2;
+    TestModel(
+        mobilenetv2, "mobilenetv2_nchw",
+        [&](const ml::GraphBuilder& builder) { return mobilenetv2.LoadNCHW(builder, false); },
+        1000);
+}
+
+TEST_F(ModelPerfTests, MobileNetV2Nhwc) {
+    MobileNetV2 mobilenetv2;
+    mobilenetv2.mLayout = "nhwc";
+    TestModel(
+        mobilenetv2, "mobilenetv2_nhwc",
+        [&](const ml::GraphBuilder& builder) { return mobilenetv2.LoadNHWC(builder, false); },
+        1001);
+}
+
+TEST_F(ModelPerfTests, ResNetNchw) {
+    ResNet resnet;
+    TestModel(
+        resnet, "resnet50v2_nchw",
+        [&](const ml::GraphBuilder& builder) { return resnet.LoadNCHW(builder, false); }, 1000);
+}
+
+TEST_F(ModelPerfTests, ResNetNhwc) {
+    ResNet resnet;
+    resnet.mLayout = "nhwc";
+    TestModel(
+        resnet, "resnet101v2_nhwc",
+        [&](const ml::GraphBuilder& builder) { return resnet.LoadNHWC(builder, false); }, 1001);
+}
@@ -0,0 +1,291 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/WebnnPerfTest.h"
+
+namespace {
+
+    constexpr unsigned int kStepsToRun = 100;
+
+    template <typename Params>
+    std::string GetParamName(const testing::TestParamInfo<Params>& info) {
+        return info.param.name;
+    }
+
+    // The shape of a 4-D tensor of |layout| with the given dimensions.
+    std::vector<int32_t> GetShape(ml::InputOperandLayout layout,
+                                  int32_t batch,
+                                  int32_t channels,
+                                  int32_t height,
+                                  int32_t width) {
+        if (layout == ml::InputOperandLayout::Nhwc) {
+            return {batch, height, width, channels};
+        }
+        return {batch, channels, height, width};
+    }
+
+    template <typename Params>
+    class OperatorPerfTest : public WebnnPerfTest, public testing::WithParamInterface<Params> {
+      protected:
+        OperatorPerfTest() : WebnnPerfTest(kStepsToRun) {
+        }
+    };
+
+}  // namespace
+
+struct Conv2dParams {
+    const char* name;
+    ml::InputOperandLayout layout;
+    int32_t channels;
+    int32_t size;
+    int32_t outputChannels;
+    int32_t kernel;
+    int32_t stride;
+    int32_t groups;
+};
+
+class Conv2dPerfTests : public OperatorPerfTest<Conv2dParams> {};
+
+// Convolves a square input with a square filter padded to keep the size when the stride is 1,
+// the nhwc convolutions taking an ohwi filter.
+TEST_P(Conv2dPerfTests, Run) {
+    const Conv2dParams& params = GetParam();
+    const int32_t inputChannels = params.channels / params.groups;
+    const std::vector<int32_t> inputShape =
+        GetShape(params.layout, 1, params.channels, params.size, params.size);
+    const std::vector<int32_t> filterShape =
+        params.layout == ml::InputOperandLayout::Nhwc
+            ? std::vector<int32_t>{params.outputChannels, params.kernel, params.kernel,
+                                   inputChannels}
+            : std::vector<int32_t>{params.outputChannels, inputChannels, params.kernel,
+                                   params.kernel};
+    const int32_t padding = (params.kernel - 1) / 2;
+    const int32_t outputSize = (params.size + 2 * padding - params.kernel) / params.stride + 1;
+
+    const std::vector<float> input(utils::SizeOfShape(inputShape), 0.5);
+    const std::vector<float> filter(utils::SizeOfShape(filterShape), 0.01);
+    const std::vector<float> bias(params.outputChannels, 0.1);
+    std::vector<float> result(
+        utils::SizeOfShape({1, params.outputChannels, outputSize, outputSize}));
+    RunTest(
+        [&](const ml::GraphBuilder& builder) -> std::vector<utils::NamedOperand> {
+            utils::Conv2dOptions options;
+            options.padding = {padding, padding, padding, padding};
+            options.strides = {params.stride, params.stride};
+            options.groups = params.groups;
+            options.inputLayout = params.layout;
+            if (params.layout == ml::InputOperandLayout::Nhwc) {
+                options.filterLayout = ml::FilterOperandLayout::Ohwi;
+            }
+            options.bias = utils::BuildConstant(builder, {params.outputChannels}, bias.data(),
+                                                bias.size() * sizeof(float));
+            const ml::Operand x = utils::BuildInput(builder, "input", inputShape);
+            const ml::Operand w = utils::BuildConstant(builder, filterShape, filter.data(),
+                                                       filter.size() * sizeof(float));
+            return {{"output", builder.Conv2d(x, w, options.AsPtr())}};
+        },
+        {{"input", input}}, {{"output", result}});
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    Conv2dPerfTests,
+    testing::Values(
+        Conv2dParams{"nchw_3x3", ml::InputOperandLayout::Nchw, 64, 56, 64, 3, 1, 1},
+        Conv2dParams{"nhwc_3x3", ml::InputOperandLayout::Nhwc, 64, 56, 64, 3, 1, 1},
+        Conv2dParams{"nchw_1x1", ml::InputOperandLayout::Nchw, 256, 28, 64, 1, 1, 1},
+        Conv2dParams{"nhwc_1x1", ml::InputOperandLayout::Nhwc, 256, 28, 64, 1, 1, 1},
+        Conv2dParams{"nchw_3x3_stride2", ml::InputOperandLayout::Nchw, 64, 56, 128, 3, 2, 1},
+        Conv2dParams{"nhwc_3x3_stride2", ml::InputOperandLayout::Nhwc, 64, 56, 128, 3, 2, 1},
+        Conv2dParams{"nchw_3x3_groups4", ml::InputOperandLayout::Nchw, 64, 56, 64, 3, 1, 4},
+        Conv2dParams{"nchw_depthwise_3x3", ml::InputOperandLayout::Nchw, 128, 56, 128, 3, 1,
+                     128},
+        Conv2dParams{"nhwc_depthwise_3x3", ml::InputOperandLayout::Nhwc, 128, 56, 128, 3, 1,
+                     128}),
+    GetParamName<Conv2dParams>);
+
+struct GemmParams {
+    const char* name;
+    int32_t m;
+    int32_t k;
+    int32_t n;
+    bool bTranspose;
+};
+
+class GemmPerfTests : public OperatorPerfTest<GemmParams> {};
+
+// Multiplies an input by a constant, as the fully connected layers of the models do.
+TEST_P(GemmPerfTests, Run) {
+    const GemmParams& params = GetParam();
+    const std::vector<int32_t> bShape =
+        params.bTranspose ? std::vector<int32_t>{params.n, params.k}
+                          : std::vector<int32_t>{params.k, params.n};
+    const std::vector<float> a(params.m * params.k, 0.5);
+    const std::vector<float> b(params.k * params.n, 0.01);
+    const std::vector<float> c(params.n, 0.1);
+    std::vector<float> result(params.m * params.n);
+    RunTest(
+        [&](const ml::GraphBuilder& builder) -> std::vector<utils::NamedOperand> {
+            ml::GemmOptions options;
+            options.c = utils::BuildConstant(builder, {params.n}, c.data(),
+                                             c.size() * sizeof(float));
+            options.bTranspose = params.bTranspose;
+            const ml::Operand x = utils::BuildInput(builder, "a", {params.m, params.k});
+            const ml::Operand y =
+                utils::BuildConstant(builder, bShape, b.data(), b.size() * sizeof(float));
+            return {{"c", builder.Gemm(x, y, &options)}};
+        },
+        {{"a", a}}, {{"c", result}}, params.m);
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         GemmPerfTests,
+                         testing::Values(GemmParams{"1x1024x1000", 1, 1024, 1000, false},
+                                         GemmParams{"1x1024x1000_transposed", 1, 1024, 1000, true},
+                                         GemmParams{"64x512x512", 64, 512, 512, false},
+                                         GemmParams{"256x1024x1024", 256, 1024, 1024, false}),
+                         GetParamName<GemmParams>);
+
+struct Pool2dParams {
+    const char* name;
+    bool average;
+    ml::InputOperandLayout layout;
+    int32_t channels;
+    int32_t size;
+    int32_t window;
+    int32_t stride;
+};
+
+class Pool2dPerfTests : public OperatorPerfTest<Pool2dParams> {};
+
+TEST_P(Pool2dPerfTests, Run) {
+    const Pool2dParams& params = GetParam();
+    const std::vector<int32_t> inputShape =
+        GetShape(params.layout, 1, params.channels, params.size, params.size);
+    const int32_t outputSize = (params.size - params.window) / params.stride + 1;
+    const std::vector<float> input(utils::SizeOfShape(inputShape), 0.5);
+    std::vector<float> result(utils::SizeOfShape({1, params.channels, outputSize, outputSize}));
+    RunTest(
+        [&](const ml::GraphBuilder& builder) -> std::vector<utils::NamedOperand> {
+            utils::Pool2dOptions options;
+            options.windowDimensions = {params.window, params.window};
+            options.strides = {params.stride, params.stride};
+            options.layout = params.layout;
+            const ml::Operand x = utils::BuildInput(builder, "input", inputShape);
+            return {{"output", params.average ? builder.AveragePool2d(x, options.AsPtr())
+                                              : builder.MaxPool2d(x, options.AsPtr())}};
+        },
+        {{"input", input}}, {{"output", result}});
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    Pool2dPerfTests,
+    testing::Values(
+        Pool2dParams{"max_nchw_3x3_stride2", false, ml::InputOperandLayout::Nchw, 64, 112, 3, 2},
+        Pool2dParams{"max_nhwc_3x3_stride2", false, ml::InputOperandLayout::Nhwc, 64, 112, 3, 2},
+        Pool2dParams{"average_nchw_global", true, ml::InputOperandLayout::Nchw, 1280, 7, 7, 1},
+        Pool2dParams{"average_nhwc_global", true, ml::InputOperandLayout::Nhwc, 1280, 7, 7, 1}),
+    GetParamName<Pool2dParams>);
+
+struct GruParams {
+    const char* name;
+    int32_t steps;
+    int32_t batchSize;
+    int32_t inputSize;
+    int32_t hiddenSize;
+};
+
+class GruPerfTests : public OperatorPerfTest<GruParams> {};
+
+TEST_P(GruPerfTests, Run) {
+    const GruParams& params = GetParam();
+    const std::vector<int32_t> inputShape = {params.steps, params.batchSize, params.inputSize};
+    const std::vector<int32_t> weightShape = {1, 3 * params.hiddenSize, params.inputSize};
+    const std::vector<int32_t> recurrentWeightShape = {1, 3 * params.hiddenSize,
+                                                       params.hiddenSize};
+    const std::vector<float> input(utils::SizeOfShape(inputShape), 0.5);
+    const std::vector<float> weight(utils::SizeOfShape(weightShape), 0.01);
+    const std::vector<float> recurrentWeight(utils::SizeOfShape(recurrentWeightShape), 0.01);
+    std::vector<float> result(params.batchSize * params.hiddenSize);
+    RunTest(
+        [&](const ml::GraphBuilder& builder) -> std::vector<utils::NamedOperand> {
+            const ml::Operand x = utils::BuildInput(builder, "input", inputShape);
+            const ml::Operand w = utils::BuildConstant(builder, weightShape, weight.data(),
+                                                       weight.size() * sizeof(float));
+            const ml::Operand r =
+                utils::BuildConstant(builder, recurrentWeightShape, recurrentWeight.data(),
+                                     recurrentWeight.size() * sizeof(float));
+            const ml::OperandArray outputs =
+                builder.Gru(x, w, r, params.steps, params.hiddenSize);
+            return {{"output", outputs.GetOperand(0)}};
+        },
+        {{"input", input}}, {{"output", result}}, params.batchSize);
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         GruPerfTests,
+                         testing::Values(GruParams{"steps10_batch1_128x256", 10, 1, 128, 256},
+                                         GruParams{"steps32_batch8_256x256", 32, 8, 256, 256}),
+                         GetParamName<GruParams>);
+
+struct Resample2dParams {
+    const char* name;
+    ml::InterpolationMode mode;
+    ml::InputOperandLayout layout;
+    int32_t channels;
+    int32_t size;
+    float scale;
+};
+
+class Resample2dPerfTests : public OperatorPerfTest<Resample2dParams> {};
+
+TEST_P(Resample2dPerfTests, Run) {
+    const Resample2dParams& params = GetParam();
+    const std::vector<int32_t> inputShape =
+        GetShape(params.layout, 1, params.channels, params.size, params.size);
+    const int32_t outputSize = static_cast<int32_t>(params.size * params.scale);
+    const std::vector<float> input(utils::SizeOfShape(inputShape), 0.5);
+    std::vector<float> result(utils::SizeOfShape({1, params.channels, outputSize, outputSize}));
+    RunTest(
+        [&](const ml::GraphBuilder& builder) -> std::vector<utils::NamedOperand> {
+            const std::vector<float> scales = {params.scale, params.scale};
+            const std::vector<int32_t> axes =
+                params.layout == ml::InputOperandLayout::Nhwc ? std::vector<int32_t>{1, 2}
+                                                              : std::vector<int32_t>{2, 3};
+            ml::Resample2dOptions options;
+            options.mode = params.mode;
+            options.scalesCount = scales.size();
+            options.scales = scales.data();
+            options.axesCount = axes.size();
+            options.axes = axes.data();
+            const ml::Operand x = utils::BuildInput(builder, "input", inputShape);
+            return {{"output", builder.Resample2d(x, &options)}};
+        },
+        {{"input", input}}, {{"output", result}});
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         Resample2dPerfTests,
+                         testing::Values(Resample2dParams{"nearest_nchw_x2",
+                                                          ml::InterpolationMode::NearestNeighbor,
+                                                          ml::InputOperandLayout::Nchw, 64, 56, 2},
+                                         Resample2dParams{"linear_nchw_x2",
+                                                          ml::InterpolationMode::Linear,
+                                                          ml::InputOperandLayout::Nchw, 64, 56, 2},
+                                         Resample2dParams{"linear_nhwc_x2",
+                                                          ml::InterpolationMode::Linear,
+                                                          ml::InputOperandLayout::Nhwc, 64, 56,
+                                                          2}),
+                         GetParamName<Resample2dParams>);
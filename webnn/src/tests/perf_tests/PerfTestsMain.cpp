@@ -0,0 +1,42 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/WebnnPerfTest.h"
+
+int main(int argc, char** argv) {
+    std::string device = "default";
+    std::string precision = "default";
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp("-d", argv[i]) == 0 && i + 1 < argc) {
+            device = argv[i + 1];
+        } else if (strcmp("-p", argv[i]) == 0 && i + 1 < argc) {
+            precision = argv[i + 1];
+        }
+    }
+    ml::ContextOptions options = utils::CreateContextOptions(device);
+    if (precision == "bfloat16") {
+        options.precisionHint = ml::PrecisionHint::Bfloat16;
+    } else if (precision == "float16") {
+        options.precisionHint = ml::PrecisionHint::Float16;
+    } else if (precision == "float32") {
+        options.precisionHint = ml::PrecisionHint::Float32;
+    } else if (precision != "default") {
+        dawn::ErrorLog() << "Invalid precision, only support \"float32\", \"float16\" and "
+                            "\"bfloat16\".";
+        return 1;
+    }
+    InitWebnnPerfTestEnvironment(argc, argv, &options);
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,261 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/WebnnPerfTest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include "common/Log.h"
+
+namespace {
+
+    WebnnPerfTestEnvironment* gTestEnv = nullptr;
+
+    const char* GetBackendName() {
+#if defined(WEBNN_ENABLE_BACKEND_DML)
+        return "dml";
+#elif defined(WEBNN_ENABLE_BACKEND_OPENVINO)
+        return "openvino";
+#elif defined(WEBNN_ENABLE_BACKEND_ONEDNN)
+        return "onednn";
+#elif defined(WEBNN_ENABLE_BACKEND_CPU)
+        return "cpu";
+#else
+        return "null";
+#endif
+    }
+
+    const char* GetDeviceName(ml::DevicePreference device) {
+        switch (device) {
+            case ml::DevicePreference::Gpu:
+                return "gpu";
+            case ml::DevicePreference::Cpu:
+                return "cpu";
+            default:
+                return "default";
+        }
+    }
+
+    const char* GetPrecisionName(ml::PrecisionHint precision) {
+        switch (precision) {
+            case ml::PrecisionHint::Float32:
+                return "float32";
+            case ml::PrecisionHint::Float16:
+                return "float16";
+            case ml::PrecisionHint::Bfloat16:
+                return "bfloat16";
+            default:
+                return "default";
+        }
+    }
+
+    void WriteJsonString(std::ofstream& stream, const std::string& value) {
+        stream << '"';
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                stream << '\\';
+            }
+            stream << c;
+        }
+        stream << '"';
+    }
+
+    double GetElapsedTime(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    // The nearest-rank percentile of the sorted |times|.
+    double GetPercentile(const std::vector<double>& times, double percentile) {
+        const size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * times.size()));
+        return times[std::max<size_t>(rank, 1) - 1];
+    }
+
+}  // namespace
+
+void InitWebnnPerfTestEnvironment(int argc, char** argv, ml::ContextOptions const* options) {
+    gTestEnv = new WebnnPerfTestEnvironment(argc, argv, options);
+    WebnnTestEnvironment::SetEnvironment(gTestEnv);
+    testing::AddGlobalTestEnvironment(gTestEnv);
+}
+
+WebnnPerfTestEnvironment::WebnnPerfTestEnvironment(int argc,
+                                                   char** argv,
+                                                   ml::ContextOptions const* options)
+    : WebnnTestEnvironment(options) {
+    size_t argLen = 0;  // Set when parsing --arg=X arguments
+    for (int i = 1; i < argc; ++i) {
+        constexpr const char kOverrideStepsArg[] = "--override-steps=";
+        argLen = sizeof(kOverrideStepsArg) - 1;
+        if (strncmp(argv[i], kOverrideStepsArg, argLen) == 0) {
+            const char* overrideSteps = argv[i] + argLen;
+            if (overrideSteps[0] != '\0') {
+                mOverrideStepsToRun = strtoul(overrideSteps, nullptr, 0);
+            }
+            continue;
+        }
+
+        constexpr const char kWarmupStepsArg[] = "--warmup-steps=";
+        argLen = sizeof(kWarmupStepsArg) - 1;
+        if (strncmp(argv[i], kWarmupStepsArg, argLen) == 0) {
+            const char* warmupSteps = argv[i] + argLen;
+            if (warmupSteps[0] != '\0') {
+                mWarmupSteps = strtoul(warmupSteps, nullptr, 0);
+            }
+            continue;
+        }
+
+        constexpr const char kResultsFileArg[] = "--results-file=";
+        argLen = sizeof(kResultsFileArg) - 1;
+        if (strncmp(argv[i], kResultsFileArg, argLen) == 0) {
+            mResultsFile = argv[i] + argLen;
+            continue;
+        }
+
+        if (strcmp("-h", argv[i]) == 0 || strcmp("--help", argv[i]) == 0) {
+            dawn::InfoLog()
+                << "Additional flags:"
+                << " [-d device] [-p precision] [--override-steps=x] [--warmup-steps=x]"
+                   " [--results-file=file]\n"
+                << "  -d: The device preference of the context, \"cpu\", \"gpu\" or "
+                   "\"default\".\n"
+                << "  -p: The precision hint of the context, \"float32\", \"float16\" or "
+                   "\"bfloat16\".\n"
+                << "  --override-steps: Set a fixed number of measured steps for each test.\n"
+                << "  --warmup-steps: Set the number of steps run before measuring, 5 by "
+                   "default.\n"
+                << "  --results-file: The file to write the results to as JSON.\n";
+            continue;
+        }
+    }
+}
+
+void WebnnPerfTestEnvironment::TearDown() {
+    if (!mResultsFile.empty()) {
+        std::ofstream outFile(mResultsFile);
+        outFile << "{\"backend\":\"" << GetBackendName() << "\",\"device\":\""
+                << GetDeviceName(mOptions != nullptr ? mOptions->devicePreference
+                                                     : ml::DevicePreference::Default)
+                << "\",\"precision\":\""
+                << GetPrecisionName(mOptions != nullptr ? mOptions->precisionHint
+                                                        : ml::PrecisionHint::Default)
+                << "\",\"results\":[";
+        for (size_t i = 0; i < mResults.size(); ++i) {
+            const Result& result = mResults[i];
+            outFile << (i == 0 ? "" : ",") << "{\"story\":";
+            WriteJsonString(outFile, result.story);
+            outFile << ",\"metric\":";
+            WriteJsonString(outFile, result.metric);
+            outFile << ",\"value\":" << result.value << ",\"units\":";
+            WriteJsonString(outFile, result.units);
+            outFile << "}";
+        }
+        outFile << "]}" << std::endl;
+        if (!outFile) {
+            dawn::ErrorLog() << "Failed to write the results to " << mResultsFile << ".";
+        }
+    }
+
+    WebnnTestEnvironment::TearDown();
+}
+
+unsigned int WebnnPerfTestEnvironment::OverrideStepsToRun() const {
+    return mOverrideStepsToRun;
+}
+
+unsigned int WebnnPerfTestEnvironment::WarmupSteps() const {
+    return mWarmupSteps;
+}
+
+void WebnnPerfTestEnvironment::AddResult(const std::string& story,
+                                         const std::string& metric,
+                                         double value,
+                                         const std::string& units) {
+    mResults.push_back({story, metric, value, units});
+}
+
+WebnnPerfTest::WebnnPerfTest(unsigned int stepsToRun) : mStepsToRun(stepsToRun) {
+}
+
+void WebnnPerfTest::RunTest(const BuildGraphFunction& buildGraph,
+                            const std::vector<utils::NamedInput<float>>& inputs,
+                            const std::vector<utils::NamedOutput<float>>& outputs,
+                            uint32_t batchSize) {
+    auto start = std::chrono::steady_clock::now();
+    const ml::GraphBuilder builder = ml::CreateGraphBuilder(GetContext());
+    const std::vector<utils::NamedOperand> namedOperands = buildGraph(builder);
+    const double buildTime = GetElapsedTime(start);
+    ASSERT_FALSE(namedOperands.empty());
+
+    start = std::chrono::steady_clock::now();
+    const ml::Graph graph = utils::Build(builder, namedOperands);
+    const double compileTime = GetElapsedTime(start);
+    ASSERT_TRUE(graph);
+
+    start = std::chrono::steady_clock::now();
+    ASSERT_EQ(utils::Compute(graph, inputs, outputs), ml::ComputeGraphStatus::Success);
+    const double firstInferenceTime = GetElapsedTime(start);
+
+    for (unsigned int i = 0; i < gTestEnv->WarmupSteps(); ++i) {
+        ASSERT_EQ(utils::Compute(graph, inputs, outputs), ml::ComputeGraphStatus::Success);
+    }
+
+    const unsigned int stepsToRun = gTestEnv->OverrideStepsToRun() != 0
+                                        ? gTestEnv->OverrideStepsToRun()
+                                        : mStepsToRun;
+    std::vector<double> times;
+    times.reserve(stepsToRun);
+    for (unsigned int i = 0; i < stepsToRun; ++i) {
+        start = std::chrono::steady_clock::now();
+        ASSERT_EQ(utils::Compute(graph, inputs, outputs), ml::ComputeGraphStatus::Success);
+        times.push_back(GetElapsedTime(start));
+    }
+    ASSERT_FALSE(times.empty());
+    double totalTime = 0;
+    for (double time : times) {
+        totalTime += time;
+    }
+    std::sort(times.begin(), times.end());
+
+    ReportResult("build_time", buildTime, "ms");
+    ReportResult("compile_time", compileTime, "ms");
+    ReportResult("first_inference", firstInferenceTime, "ms");
+    ReportResult("latency_p50", GetPercentile(times, 50), "ms", true);
+    ReportResult("latency_p99", GetPercentile(times, 99), "ms");
+    ReportResult("latency_mean", totalTime / times.size(), "ms");
+    ReportResult("throughput", batchSize * times.size() * 1000.0 / totalTime, "samples/s");
+}
+
+void WebnnPerfTest::ReportResult(const std::string& trace,
+                                 double value,
+                                 const std::string& units,
+                                 bool important) const {
+    const ::testing::TestInfo* const testInfo =
+        ::testing::UnitTest::GetInstance()->current_test_info();
+
+    const std::string metric = std::string(testInfo->test_suite_name()) + "." + trace;
+
+    std::string story = testInfo->name();
+    std::replace(story.begin(), story.end(), '/', '_');
+
+    // The results are printed in the format of the Dawn perf tests, which follows
+    // [chromium]//src/tools/perf/generate_legacy_perf_dashboard_json.py
+    dawn::InfoLog() << (important ? "*" : "") << "RESULT " << metric << ": " << story << "= "
+                    << value << " " << units;
+    gTestEnv->AddResult(story, metric, value, units);
+}
@@ -0,0 +1,86 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TESTS_PERFTESTS_WEBNN_PERF_TEST_H_
+#define TESTS_PERFTESTS_WEBNN_PERF_TEST_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "tests/WebnnTest.h"
+
+void InitWebnnPerfTestEnvironment(int argc, char** argv, ml::ContextOptions const* options);
+
+class WebnnPerfTestEnvironment : public WebnnTestEnvironment {
+  public:
+    WebnnPerfTestEnvironment(int argc, char** argv, ml::ContextOptions const* options);
+    ~WebnnPerfTestEnvironment() override = default;
+
+    void TearDown() override;
+
+    // The number of measured steps a test runs instead of its own, 0 when not overridden.
+    unsigned int OverrideStepsToRun() const;
+    unsigned int WarmupSteps() const;
+
+    // Records a result to be written to the results file when the tests end.
+    void AddResult(const std::string& story,
+                   const std::string& metric,
+                   double value,
+                   const std::string& units);
+
+  private:
+    struct Result {
+        std::string story;
+        std::string metric;
+        double value;
+        std::string units;
+    };
+
+    unsigned int mOverrideStepsToRun = 0;
+    unsigned int mWarmupSteps = 5;
+    std::string mResultsFile;
+    std::vector<Result> mResults;
+};
+
+// The base of the benchmarks, which builds a graph and computes it for a number of steps,
+// reporting how long each phase takes.
+class WebnnPerfTest : public WebnnTest {
+  protected:
+    using BuildGraphFunction =
+        std::function<std::vector<utils::NamedOperand>(const ml::GraphBuilder& builder)>;
+
+    explicit WebnnPerfTest(unsigned int stepsToRun);
+    ~WebnnPerfTest() override = default;
+
+    // Reports the time taken by |buildGraph| to build the graph, by the context to compile it,
+    // by its first compute, and the percentiles of the computes of the measured steps. The
+    // throughput counts |batchSize| samples per compute.
+    void RunTest(const BuildGraphFunction& buildGraph,
+                 const std::vector<utils::NamedInput<float>>& inputs,
+                 const std::vector<utils::NamedOutput<float>>& outputs,
+                 uint32_t batchSize = 1);
+
+    // Prints |value| of the metric |trace| of the current test and records it for the results
+    // file.
+    void ReportResult(const std::string& trace,
+                      double value,
+                      const std::string& units,
+                      bool important = false) const;
+
+  private:
+    const unsigned int mStepsToRun;
+};
+
+#endif  // TESTS_PERFTESTS_WEBNN_PERF_TEST_H_
@@ -0,0 +1,66 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "webnn_native/ConstantPool.h"
+
+using namespace webnn_native;
+
+// Test that the same bytes with the same descriptor are only stored once.
+TEST(ConstantPool, Deduplicate) {
+    ConstantPool* pool = ConstantPool::Get();
+    const ConstantPoolStats before = pool->GetStats();
+    const std::vector<float> data = {1, 2, 3, 4};
+    const size_t byteLength = data.size() * sizeof(float);
+    auto a = pool->Acquire(ml::OperandType::Float32, {2, 2}, data.data(), byteLength);
+    auto b = pool->Acquire(ml::OperandType::Float32, {2, 2}, data.data(), byteLength);
+    ASSERT_EQ(a, b);
+    ASSERT_NE(a->GetData(), static_cast<const void*>(data.data()));
+    ASSERT_EQ(memcmp(a->GetData(), data.data(), byteLength), 0);
+
+    const ConstantPoolStats after = pool->GetStats();
+    ASSERT_EQ(after.constantCount, before.constantCount + 1);
+    ASSERT_EQ(after.byteLength, before.byteLength + byteLength);
+    ASSERT_EQ(after.deduplicatedCount, before.deduplicatedCount + 1);
+    ASSERT_EQ(after.deduplicatedByteLength, before.deduplicatedByteLength + byteLength);
+}
+
+// Test that different bytes or a different shape are stored apart.
+TEST(ConstantPool, Distinct) {
+    ConstantPool* pool = ConstantPool::Get();
+    const std::vector<float> data = {1, 2, 3, 4};
+    const std::vector<float> other = {1, 2, 3, 5};
+    const size_t byteLength = data.size() * sizeof(float);
+    auto a = pool->Acquire(ml::OperandType::Float32, {2, 2}, data.data(), byteLength);
+    auto b = pool->Acquire(ml::OperandType::Float32, {2, 2}, other.data(), byteLength);
+    auto c = pool->Acquire(ml::OperandType::Float32, {4}, data.data(), byteLength);
+    ASSERT_NE(a, b);
+    ASSERT_NE(a, c);
+}
+
+// Test that the bytes are freed with their last reference.
+TEST(ConstantPool, Release) {
+    ConstantPool* pool = ConstantPool::Get();
+    const ConstantPoolStats before = pool->GetStats();
+    const std::vector<float> data = {7, 8};
+    {
+        auto a = pool->Acquire(ml::OperandType::Float32, {2}, data.data(), sizeof(float) * 2);
+        ASSERT_EQ(pool->GetStats().constantCount, before.constantCount + 1);
+    }
+    ASSERT_EQ(pool->GetStats().constantCount, before.constantCount);
+    ASSERT_EQ(pool->GetStats().byteLength, before.byteLength);
+}
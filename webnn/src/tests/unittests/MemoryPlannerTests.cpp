@@ -0,0 +1,73 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "webnn_native/MemoryPlanner.h"
+
+using namespace webnn_native;
+
+// Test that the buffers of a chain only keep two of them alive at a time.
+TEST(MemoryPlanner, Chain) {
+    MemoryPlanner planner(1);
+    for (size_t i = 0; i < 4; ++i) {
+        planner.AddBuffer(100, i, i + 1);
+    }
+    planner.Plan();
+    ASSERT_EQ(planner.GetTotalSize(), 400u);
+    ASSERT_EQ(planner.GetArenaSize(), 200u);
+    ASSERT_NE(planner.GetOffset(0), planner.GetOffset(1));
+    ASSERT_EQ(planner.GetOffset(0), planner.GetOffset(2));
+    ASSERT_EQ(planner.GetOffset(1), planner.GetOffset(3));
+}
+
+// Test that the buffers live at the same step never overlap.
+TEST(MemoryPlanner, Overlap) {
+    MemoryPlanner planner(1);
+    size_t a = planner.AddBuffer(300, 0, 1);
+    size_t b = planner.AddBuffer(100, 1, 2);
+    size_t c = planner.AddBuffer(200, 2, 3);
+    planner.UseBuffer(a, 2);
+    planner.Plan();
+    ASSERT_EQ(planner.GetArenaSize(), 600u);
+    ASSERT_EQ(planner.GetOffset(a), 0u);
+    ASSERT_GE(planner.GetOffset(b), 300u);
+    ASSERT_GE(planner.GetOffset(c), 300u);
+    ASSERT_TRUE(planner.GetOffset(b) + 100 <= planner.GetOffset(c) ||
+                planner.GetOffset(c) + 200 <= planner.GetOffset(b));
+}
+
+// Test that a freed gap is reused by a smaller buffer.
+TEST(MemoryPlanner, ReuseGap) {
+    MemoryPlanner planner(1);
+    size_t a = planner.AddBuffer(100, 0, 1);
+    size_t b = planner.AddBuffer(100, 0, 3);
+    size_t c = planner.AddBuffer(50, 2, 3);
+    planner.Plan();
+    ASSERT_EQ(planner.GetArenaSize(), 200u);
+    ASSERT_EQ(planner.GetOffset(c), planner.GetOffset(a));
+    ASSERT_NE(planner.GetOffset(b), planner.GetOffset(a));
+}
+
+// Test that the buffer sizes are rounded up to the alignment.
+TEST(MemoryPlanner, Alignment) {
+    MemoryPlanner planner(64);
+    size_t a = planner.AddBuffer(1, 0, 1);
+    size_t b = planner.AddBuffer(65, 0, 1);
+    planner.Plan();
+    ASSERT_EQ(planner.GetTotalSize(), 192u);
+    ASSERT_EQ(planner.GetArenaSize(), 192u);
+    ASSERT_EQ(planner.GetOffset(a) % 64, 0u);
+    ASSERT_EQ(planner.GetOffset(b) % 64, 0u);
+}
@@ -0,0 +1,107 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include <future>
+
+using namespace testing;
+
+class ComputeAsyncValidationTest : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+        std::vector<int32_t> shape = {2, 2};
+        ml::OperandDescriptor inputDesc = {ml::OperandType::Float32, shape.data(),
+                                           (uint32_t)shape.size()};
+        ml::Operand a = mBuilder.Input("input", &inputDesc);
+        ml::Operand output = mBuilder.Relu(a);
+        ml::NamedOperands namedOperands = ml::CreateNamedOperands();
+        namedOperands.Set("output", output);
+        mGraph = mBuilder.Build(namedOperands);
+        ASSERT_TRUE(mGraph != nullptr);
+    }
+
+    static void ComputeCallback(MLComputeGraphStatus status, const char*, void* userdata) {
+        static_cast<std::promise<MLComputeGraphStatus>*>(userdata)->set_value(status);
+    }
+
+    ml::Graph mGraph;
+};
+
+// Test that the callback is called with the status of the computation.
+TEST_F(ComputeAsyncValidationTest, ComputeAsyncSuccess) {
+    std::vector<float> inputData(4, 1);
+    ml::Input input = {{inputData.data(), inputData.size() * sizeof(float)}};
+    ml::NamedInputs namedInputs = ml::CreateNamedInputs();
+    namedInputs.Set("input", &input);
+    std::vector<float> outputData(4);
+    ml::ArrayBufferView output = {outputData.data(), outputData.size() * sizeof(float)};
+    ml::NamedOutputs namedOutputs = ml::CreateNamedOutputs();
+    namedOutputs.Set("output", &output);
+
+    std::promise<MLComputeGraphStatus> promise;
+    std::future<MLComputeGraphStatus> future = promise.get_future();
+    mGraph.ComputeAsync(namedInputs, namedOutputs, ComputeCallback, &promise);
+    ASSERT_EQ(future.get(), MLComputeGraphStatus_Success);
+}
+
+// Test that several computations can be in flight on one graph.
+TEST_F(ComputeAsyncValidationTest, ComputeAsyncConcurrently) {
+    std::vector<float> inputData(4, 1);
+    ml::Input input = {{inputData.data(), inputData.size() * sizeof(float)}};
+    ml::NamedInputs namedInputs = ml::CreateNamedInputs();
+    namedInputs.Set("input", &input);
+    std::vector<float> outputData(4);
+    ml::ArrayBufferView output = {outputData.data(), outputData.size() * sizeof(float)};
+    ml::NamedOutputs namedOutputs = ml::CreateNamedOutputs();
+    namedOutputs.Set("output", &output);
+
+    std::vector<std::promise<MLComputeGraphStatus>> promises(4);
+    for (auto& promise : promises) {
+        mGraph.ComputeAsync(namedInputs, namedOutputs, ComputeCallback, &promise);
+    }
+    for (auto& promise : promises) {
+        ASSERT_EQ(promise.get_future().get(), MLComputeGraphStatus_Success);
+    }
+}
+
+// Test that the callback is called with an error for null records.
+TEST_F(ComputeAsyncValidationTest, ComputeAsyncNullRecords) {
+    std::promise<MLComputeGraphStatus> promise;
+    std::future<MLComputeGraphStatus> future = promise.get_future();
+    mGraph.ComputeAsync(nullptr, nullptr, ComputeCallback, &promise);
+    ASSERT_EQ(future.get(), MLComputeGraphStatus_Error);
+}
+
+// Test that the Input and ArrayBufferView structs may be released once the call returns.
+TEST_F(ComputeAsyncValidationTest, ComputeAsyncCopiesRecords) {
+    std::vector<float> inputData(4, 1);
+    std::vector<float> outputData(4);
+    std::promise<MLComputeGraphStatus> promise;
+    std::future<MLComputeGraphStatus> future = promise.get_future();
+    {
+        std::vector<int32_t> dimensions = {2, 2};
+        ml::Input input = {{inputData.data(), inputData.size() * sizeof(float)},
+                           dimensions.data(),
+                           static_cast<uint32_t>(dimensions.size())};
+        ml::NamedInputs namedInputs = ml::CreateNamedInputs();
+        namedInputs.Set("input", &input);
+        ml::ArrayBufferView output = {outputData.data(), outputData.size() * sizeof(float)};
+        ml::NamedOutputs namedOutputs = ml::CreateNamedOutputs();
+        namedOutputs.Set("output", &output);
+        mGraph.ComputeAsync(namedInputs, namedOutputs, ComputeCallback, &promise);
+    }
+    ASSERT_EQ(future.get(), MLComputeGraphStatus_Success);
+}
@@ -0,0 +1,96 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/Arena.h"
+
+#include <new>
+
+namespace webnn_native {
+
+    namespace {
+
+        constexpr size_t kAlignment = alignof(std::max_align_t);
+        constexpr size_t kBlockSize = 64 * 1024;
+        // An allocation starts with the arena it comes from, or nullptr when it comes from the
+        // heap, padded so that the object stays aligned.
+        constexpr size_t kHeaderSize = kAlignment;
+        static_assert(kHeaderSize >= sizeof(Arena*), "The header must hold the arena");
+
+        void* WriteHeader(void* allocation, Arena* arena) {
+            *static_cast<Arena**>(allocation) = arena;
+            return static_cast<char*>(allocation) + kHeaderSize;
+        }
+
+    }  // anonymous namespace
+
+    void* Arena::Allocate(size_t size) {
+        size = (size + kAlignment - 1) & ~(kAlignment - 1);
+        std::lock_guard<std::mutex> lock(mMutex);
+        // The large allocations get a block of their own, so that the current block isn't
+        // given up for them.
+        if (size > kBlockSize / 4) {
+            mBlocks.emplace_back(new char[size]);
+            return mBlocks.back().get();
+        }
+        if (size > mRemaining) {
+            mBlocks.emplace_back(new char[kBlockSize]);
+            mCursor = mBlocks.back().get();
+            mRemaining = kBlockSize;
+        }
+        void* allocation = mCursor;
+        mCursor += size;
+        mRemaining -= size;
+        return allocation;
+    }
+
+    size_t Arena::GetBlockCount() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mBlocks.size();
+    }
+
+    // static
+    void* ArenaAllocated::operator new(size_t size) {
+        return WriteHeader(::operator new(kHeaderSize + size), nullptr);
+    }
+
+    // static
+    void* ArenaAllocated::operator new(size_t size, Arena* arena) {
+        if (arena == nullptr) {
+            return operator new(size);
+        }
+        // The reference is released when the object is deleted.
+        arena->Reference();
+        return WriteHeader(arena->Allocate(kHeaderSize + size), arena);
+    }
+
+    // static
+    void ArenaAllocated::operator delete(void* pointer) {
+        if (pointer == nullptr) {
+            return;
+        }
+        void* allocation = static_cast<char*>(pointer) - kHeaderSize;
+        Arena* arena = *static_cast<Arena**>(allocation);
+        if (arena == nullptr) {
+            ::operator delete(allocation);
+        } else {
+            arena->Release();
+        }
+    }
+
+    // static
+    void ArenaAllocated::operator delete(void* pointer, Arena*) {
+        operator delete(pointer);
+    }
+
+}  // namespace webnn_native
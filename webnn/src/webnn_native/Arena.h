@@ -0,0 +1,60 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_ARENA_H_
+#define WEBNN_NATIVE_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/RefCounted.h"
+
+namespace webnn_native {
+
+    // Hands out memory from large blocks which are only freed together with the arena, so that
+    // building a graph of many operators doesn't go through malloc for each of them. Every
+    // object allocated from the arena holds a reference to it.
+    class Arena : public RefCounted {
+      public:
+        Arena() = default;
+
+        // Returns |size| bytes aligned for any type.
+        void* Allocate(size_t size);
+        size_t GetBlockCount();
+
+      private:
+        ~Arena() override = default;
+
+        std::mutex mMutex;
+        std::vector<std::unique_ptr<char[]>> mBlocks;
+        char* mCursor = nullptr;
+        size_t mRemaining = 0;
+    };
+
+    // The base of the objects that a graph builder allocates from its arena with
+    // new (arena) T(...). They may still be allocated from the heap with new T(...), e.g. the
+    // errors, and are deleted the same way in both cases.
+    class ArenaAllocated {
+      public:
+        static void* operator new(size_t size);
+        static void* operator new(size_t size, Arena* arena);
+        static void operator delete(void* pointer);
+        static void operator delete(void* pointer, Arena* arena);
+    };
+
+}  // namespace webnn_native
+
+#endif  // WEBNN_NATIVE_ARENA_H_
@@ -0,0 +1,91 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/BindingSet.h"
+
+#include <algorithm>
+
+#include "webnn_native/Context.h"
+#include "webnn_native/Error.h"
+#include "webnn_native/Graph.h"
+
+namespace webnn_native {
+
+    namespace {
+
+        // The index of |name| among the sorted |names|, or -1.
+        int32_t FindName(const std::vector<std::string>& names, const std::string& name) {
+            auto found = std::lower_bound(names.begin(), names.end(), name);
+            if (found == names.end() || *found != name) {
+                return -1;
+            }
+            return static_cast<int32_t>(found - names.begin());
+        }
+
+    }  // anonymous namespace
+
+    BindingSetBase::BindingSetBase(GraphBase* graph)
+        : ObjectBase(graph->GetContext()),
+          mGraph(graph),
+          mInputs(graph->GetInputNames().size()),
+          mBoundInputs(graph->GetInputNames().size(), nullptr),
+          mOutputs(graph->GetOutputNames().size()),
+          mBoundOutputs(graph->GetOutputNames().size(), nullptr) {
+    }
+
+    int32_t BindingSetBase::APIGetInputIndex(char const* name) const {
+        return FindName(mGraph->GetInputNames(), name);
+    }
+
+    int32_t BindingSetBase::APIGetOutputIndex(char const* name) const {
+        return FindName(mGraph->GetOutputNames(), name);
+    }
+
+    void BindingSetBase::APISetInput(uint32_t index, Input const* input) {
+        if (index >= mInputs.size()) {
+            GetContext()->ConsumedError(DAWN_VALIDATION_ERROR("The input index is out of range."));
+            return;
+        }
+        if (input == nullptr) {
+            GetContext()->ConsumedError(DAWN_VALIDATION_ERROR("The input must be set."));
+            return;
+        }
+        mInputs[index] = *input;
+        mBoundInputs[index] = &mInputs[index];
+    }
+
+    void BindingSetBase::APISetOutput(uint32_t index, ArrayBufferView const* resource) {
+        if (index >= mOutputs.size()) {
+            GetContext()->ConsumedError(
+                DAWN_VALIDATION_ERROR("The output index is out of range."));
+            return;
+        }
+        if (resource == nullptr) {
+            GetContext()->ConsumedError(DAWN_VALIDATION_ERROR("The output must be set."));
+            return;
+        }
+        mOutputs[index] = *resource;
+        mBoundOutputs[index] = &mOutputs[index];
+    }
+
+    GraphBase* BindingSetBase::GetGraph() const {
+        return mGraph.Get();
+    }
+
+    const Input* BindingSetBase::GetInput(const std::string& name) const {
+        const int32_t index = FindName(mGraph->GetInputNames(), name);
+        return index < 0 ? nullptr : mBoundInputs[index];
+    }
+
+}  // namespace webnn_native
@@ -0,0 +1,66 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_BINDING_SET_H_
+#define WEBNN_NATIVE_BINDING_SET_H_
+
+#include <string>
+#include <vector>
+
+#include "common/RefCounted.h"
+#include "webnn_native/Forward.h"
+#include "webnn_native/ObjectBase.h"
+#include "webnn_native/webnn_platform.h"
+
+namespace webnn_native {
+
+    // The resources of the inputs and the outputs of a graph bound by their index, which is
+    // resolved from their name once, so that computing the graph again only rebinds the
+    // buffers. The indices follow the order of the names, see GraphBase::GetInputNames. The
+    // inputs are copied when they are set, but their buffers and dimensions must stay alive
+    // until the graph is computed. A binding set isn't synchronized, so it must not be changed
+    // while it is computed.
+    class BindingSetBase : public ObjectBase {
+      public:
+        explicit BindingSetBase(GraphBase* graph);
+        ~BindingSetBase() override = default;
+
+        // WebNN API
+        int32_t APIGetInputIndex(char const* name) const;
+        int32_t APIGetOutputIndex(char const* name) const;
+        void APISetInput(uint32_t index, Input const* input);
+        void APISetOutput(uint32_t index, ArrayBufferView const* resource);
+
+        GraphBase* GetGraph() const;
+        // The bound resources by index, null for the ones that aren't set.
+        const std::vector<const Input*>& GetInputs() const {
+            return mBoundInputs;
+        }
+        const std::vector<const ArrayBufferView*>& GetOutputs() const {
+            return mBoundOutputs;
+        }
+        // The input named |name|, or null if the graph has no such input or it isn't set.
+        const Input* GetInput(const std::string& name) const;
+
+      private:
+        Ref<GraphBase> mGraph;
+        std::vector<Input> mInputs;
+        std::vector<const Input*> mBoundInputs;
+        std::vector<ArrayBufferView> mOutputs;
+        std::vector<const ArrayBufferView*> mBoundOutputs;
+    };
+
+}  // namespace webnn_native
+
+#endif  // WEBNN_NATIVE_BINDING_SET_H_
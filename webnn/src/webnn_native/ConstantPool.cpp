@@ -0,0 +1,128 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/ConstantPool.h"
+
+#include <cstring>
+
+#include "common/Assert.h"
+#include "common/HashUtils.h"
+#include "webnn_native/GraphContentHasher.h"
+
+namespace webnn_native {
+
+    namespace {
+
+        uint64_t HashConstant(ml::OperandType type,
+                              const std::vector<int32_t>& dimensions,
+                              const void* data,
+                              size_t byteLength) {
+            size_t hash = Hash(static_cast<uint32_t>(type));
+            for (auto dimension : dimensions) {
+                HashCombine(&hash, dimension);
+            }
+            HashCombine(&hash, GraphContentHasher::HashBytes(data, byteLength));
+            return hash;
+        }
+
+    }  // anonymous namespace
+
+    PooledConstant::PooledConstant(ml::OperandType type,
+                                   std::vector<int32_t> dimensions,
+                                   const void* data,
+                                   size_t byteLength)
+        : mType(type),
+          mDimensions(std::move(dimensions)),
+          mData(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + byteLength) {
+    }
+
+    bool PooledConstant::Equals(ml::OperandType type,
+                                const std::vector<int32_t>& dimensions,
+                                const void* data,
+                                size_t byteLength) const {
+        return mType == type && mDimensions == dimensions && mData.size() == byteLength &&
+               memcmp(mData.data(), data, byteLength) == 0;
+    }
+
+    // The pool is never destroyed, so that the graphs released by static destructors still find
+    // it.
+    ConstantPool* ConstantPool::Get() {
+        static ConstantPool* pool = new ConstantPool();
+        return pool;
+    }
+
+    std::shared_ptr<const PooledConstant> ConstantPool::Acquire(
+        ml::OperandType type,
+        const std::vector<int32_t>& dimensions,
+        const void* data,
+        size_t byteLength) {
+        // The bytes are hashed and compared outside of the lock, which is only held to look up
+        // and insert the entries.
+        const uint64_t hash = HashConstant(type, dimensions, data, byteLength);
+        std::vector<std::shared_ptr<const PooledConstant>> candidates;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto range = mEntries.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it) {
+                // An entry whose last reference was just dropped is removed by its deleter.
+                std::shared_ptr<const PooledConstant> candidate = it->second.reference.lock();
+                if (candidate != nullptr) {
+                    candidates.push_back(std::move(candidate));
+                }
+            }
+        }
+        for (auto& candidate : candidates) {
+            if (candidate->Equals(type, dimensions, data, byteLength)) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStats.deduplicatedCount++;
+                mStats.deduplicatedByteLength += byteLength;
+                return candidate;
+            }
+        }
+
+        // Two graphs adding the same new constant at once may both copy it, in which case the
+        // pool keeps both until they are released.
+        PooledConstant* constant = new PooledConstant(type, dimensions, data, byteLength);
+        std::shared_ptr<const PooledConstant> reference(
+            constant, [this, hash](const PooledConstant* pooled) {
+                Remove(hash, pooled);
+                delete pooled;
+            });
+        std::lock_guard<std::mutex> lock(mMutex);
+        mEntries.insert({hash, {constant, reference}});
+        mStats.constantCount++;
+        mStats.byteLength += byteLength;
+        return reference;
+    }
+
+    void ConstantPool::Remove(uint64_t hash, const PooledConstant* constant) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto range = mEntries.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.constant == constant) {
+                mStats.constantCount--;
+                mStats.byteLength -= constant->GetByteLength();
+                mEntries.erase(it);
+                return;
+            }
+        }
+        UNREACHABLE();
+    }
+
+    ConstantPoolStats ConstantPool::GetStats() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStats;
+    }
+
+}  // namespace webnn_native
@@ -0,0 +1,89 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_CONSTANT_POOL_H_
+#define WEBNN_NATIVE_CONSTANT_POOL_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "webnn_native/WebnnNative.h"
+#include "webnn_native/webnn_platform.h"
+
+namespace webnn_native {
+
+    // The immutable bytes of a constant, shared by all the graphs holding the same constant.
+    class PooledConstant {
+      public:
+        PooledConstant(ml::OperandType type,
+                       std::vector<int32_t> dimensions,
+                       const void* data,
+                       size_t byteLength);
+
+        const void* GetData() const {
+            return mData.data();
+        }
+        size_t GetByteLength() const {
+            return mData.size();
+        }
+
+        bool Equals(ml::OperandType type,
+                    const std::vector<int32_t>& dimensions,
+                    const void* data,
+                    size_t byteLength) const;
+
+      private:
+        ml::OperandType mType;
+        std::vector<int32_t> mDimensions;
+        std::vector<uint8_t> mData;
+    };
+
+    // A process-wide pool of the constants keyed by the hash of their bytes and descriptor, so
+    // that the graphs of every context built from the same weights, or from the same weights
+    // packed the same way by a backend, share one copy. The pool only holds weak references,
+    // the bytes are freed with the last graph using them.
+    class ConstantPool {
+      public:
+        static ConstantPool* Get();
+
+        // Returns the pooled copy of |data|, which is copied into the pool when no graph holds
+        // the same bytes.
+        std::shared_ptr<const PooledConstant> Acquire(ml::OperandType type,
+                                                      const std::vector<int32_t>& dimensions,
+                                                      const void* data,
+                                                      size_t byteLength);
+
+        ConstantPoolStats GetStats();
+
+      private:
+        ConstantPool() = default;
+
+        // Called when the last reference of the constant hashed to |hash| is dropped.
+        void Remove(uint64_t hash, const PooledConstant* constant);
+
+        std::mutex mMutex;
+        struct Entry {
+            const PooledConstant* constant;
+            std::weak_ptr<const PooledConstant> reference;
+        };
+        std::unordered_multimap<uint64_t, Entry> mEntries;
+        ConstantPoolStats mStats;
+    };
+
+}  // namespace webnn_native
+
+#endif  // WEBNN_NATIVE_CONSTANT_POOL_H_
@@ -16,6 +16,7 @@
 
 #include <sstream>
 
+#include "dawn_platform/DawnPlatform.h"
 #include "webnn_native/ValidationUtils_autogen.h"
 #include "webnn_native/webnn_platform.h"
 
@@ -25,13 +26,27 @@ namespace webnn_native {
         if (options != nullptr) {
             mContextOptions = *options;
         }
+        if (mContextOptions.cacheDirectory != nullptr) {
+            mCacheDirectory = mContextOptions.cacheDirectory;
+            mContextOptions.cacheDirectory = mCacheDirectory.c_str();
+        }
         mErrorScopeStack = std::make_unique<ErrorScopeStack>();
     }
 
+    ContextBase::~ContextBase() = default;
+
     GraphBase* ContextBase::CreateGraph() {
         return CreateGraphImpl();
     }
 
+    dawn_platform::WorkerTaskPool* ContextBase::GetWorkerTaskPool() {
+        std::lock_guard<std::mutex> lock(mWorkerTaskPoolMutex);
+        if (mWorkerTaskPool == nullptr) {
+            mWorkerTaskPool = dawn_platform::Platform().CreateWorkerTaskPool();
+        }
+        return mWorkerTaskPool.get();
+    }
+
     void ContextBase::APIPushErrorScope(ml::ErrorFilter filter) {
         if (ConsumedError(ValidateErrorFilter(filter))) {
             return;
@@ -15,18 +15,26 @@
 #ifndef DAWN_NATIVE_WEBNN_CONTEXT_H_
 #define DAWN_NATIVE_WEBNN_CONTEXT_H_
 
+#include <memory>
+#include <mutex>
+#include <string>
+
 #include "common/RefCounted.h"
 #include "webnn_native/Error.h"
 #include "webnn_native/ErrorScope.h"
 #include "webnn_native/Graph.h"
 #include "webnn_native/webnn_platform.h"
 
+namespace dawn_platform {
+    class WorkerTaskPool;
+}  // namespace dawn_platform
+
 namespace webnn_native {
 
     class ContextBase : public RefCounted {
       public:
         explicit ContextBase(ContextOptions const* options = nullptr);
-        virtual ~ContextBase() = default;
+        virtual ~ContextBase();
 
         bool ConsumedError(MaybeError maybeError) {
             if (DAWN_UNLIKELY(maybeError.IsError())) {
@@ -45,6 +53,12 @@ namespace webnn_native {
         ContextOptions GetContextOptions() {
             return mContextOptions;
         }
+        // The directory where the backends persist the compiled graphs, or empty.
+        const std::string& GetCacheDirectory() const {
+            return mCacheDirectory;
+        }
+        // The pool that runs the asynchronous computations of the graphs.
+        dawn_platform::WorkerTaskPool* GetWorkerTaskPool();
 
       private:
         // Create concrete model.
@@ -62,6 +76,11 @@ namespace webnn_native {
         std::unique_ptr<ErrorScopeStack> mErrorScopeStack;
 
         ContextOptions mContextOptions;
+        // Owns the string of mContextOptions.cacheDirectory.
+        std::string mCacheDirectory;
+
+        std::mutex mWorkerTaskPoolMutex;
+        std::unique_ptr<dawn_platform::WorkerTaskPool> mWorkerTaskPool;
     };
 
 }  // namespace webnn_native
@@ -23,6 +23,7 @@ class Ref;
 
 namespace webnn_native {
 
+    class BindingSetBase;
     class ContextBase;
     class GraphBase;
     class GraphBuilderBase;
@@ -14,15 +14,357 @@
 
 #include "webnn_native/Graph.h"
 
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "common/Assert.h"
 #include "common/Log.h"
 #include "common/RefCounted.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+#include "webnn_native/BindingSet.h"
+#include "webnn_native/GraphSerialization.h"
+#include "webnn_native/NamedInputs.h"
+#include "webnn_native/NamedOutputs.h"
+#include "webnn_native/ops/Input.h"
 
 namespace webnn_native {
 
+    namespace {
+
+        size_t GetByteLength(const OperandBase* operand) {
+            size_t elementSize = 4;
+            switch (operand->Type()) {
+                case ml::OperandType::Float16:
+                    elementSize = 2;
+                    break;
+                case ml::OperandType::Int8:
+                case ml::OperandType::Uint8:
+                    elementSize = 1;
+                    break;
+                default:
+                    break;
+            }
+            size_t count = 1;
+            for (int32_t dimension : operand->Shape()) {
+                count *= dimension;
+            }
+            return count * elementSize;
+        }
+
+        // Named records owning a copy of the structs of the caller, for the computes which
+        // outlive the call.
+        class NamedInputsCopy final : public NamedInputsBase {
+          public:
+            explicit NamedInputsCopy(const NamedInputsBase* inputs) {
+                // The nodes of the maps don't move, so the records can point to them.
+                for (auto& record : inputs->GetRecords()) {
+                    Input& input = mInputs[record.first];
+                    input = *record.second;
+                    if (input.dimensions != nullptr) {
+                        std::vector<int32_t>& dimensions = mDimensions[record.first];
+                        dimensions.assign(input.dimensions,
+                                          input.dimensions + input.dimensionsCount);
+                        input.dimensions = dimensions.data();
+                    }
+                    APISet(record.first.c_str(), &input);
+                }
+            }
+
+          private:
+            std::map<std::string, Input> mInputs;
+            std::map<std::string, std::vector<int32_t>> mDimensions;
+        };
+
+        class NamedOutputsCopy final : public NamedOutputsBase {
+          public:
+            explicit NamedOutputsCopy(const NamedOutputsBase* outputs) {
+                for (auto& record : outputs->GetRecords()) {
+                    ArrayBufferView& output = mOutputs[record.first];
+                    output = *record.second;
+                    APISet(record.first.c_str(), &output);
+                }
+            }
+
+          private:
+            std::map<std::string, ArrayBufferView> mOutputs;
+        };
+
+        // Returns the graph of |batchGraph| once it is built, or null while it is built.
+        GraphBase* GetIfBuilt(const std::shared_future<Ref<GraphBase>>& batchGraph) {
+            if (batchGraph.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return nullptr;
+            }
+            return batchGraph.get().Get();
+        }
+
+    }  // namespace
+
     GraphBase::GraphBase(ContextBase* context) : ObjectBase(context) {
+        if (context->GetContextOptions().profiling) {
+            mProfiler = std::make_shared<Profiler>();
+        }
+    }
+
+    GraphBase::~GraphBase() = default;
+
+    bool GraphBase::SupportsFusedOperators() const {
+        return true;
+    }
+
+    bool GraphBase::SupportsFusedActivation(FusionType type) const {
+        return type != FusionType::Tanh;
+    }
+
+    bool GraphBase::CachesCompiledGraph() const {
+        return false;
+    }
+
+    bool GraphBase::HasContentHash() const {
+        return mIsContentHashInitialized;
+    }
+
+    size_t GraphBase::GetContentHash() const {
+        ASSERT(mIsContentHashInitialized);
+        return mContentHash;
+    }
+
+    void GraphBase::SetContentHash(size_t contentHash) {
+        ASSERT(!mIsContentHashInitialized);
+        mContentHash = contentHash;
+        mIsContentHashInitialized = true;
+    }
+
+    void GraphBase::SetSerializedGraph(Ref<GraphSerializer> serializedGraph) {
+        mSerializedGraph = std::move(serializedGraph);
+    }
+
+    const GraphSerializer* GraphBase::GetSerializedGraph() const {
+        return mSerializedGraph.Get();
+    }
+
+    void GraphBase::SetSymbolicBatch(std::unique_ptr<SymbolicBatchGraph> symbolicBatch) {
+        mSymbolicBatch = std::move(symbolicBatch);
+
+        // The layout is recorded now since the operands change shape while the graph is built
+        // for another batch size.
+        std::unique_ptr<BatchItemLayout> layout(new BatchItemLayout());
+        for (auto input : mSymbolicBatch->inputs) {
+            const OperandBase* operand = input->PrimaryOutput();
+            layout->inputShapes[input->GetName()] = operand->Shape();
+            layout->inputByteLengths[input->GetName()] = GetByteLength(operand);
+        }
+        if (layout->inputShapes.size() != mInputNames.size()) {
+            return;
+        }
+        for (auto& output : mSymbolicBatch->outputs) {
+            const OperandBase* operand = output.second.Get();
+            if (operand->Shape().empty() || operand->Shape()[0] != 1) {
+                return;
+            }
+            layout->outputByteLengths[output.first] = GetByteLength(operand);
+        }
+        mBatchItemLayout = std::move(layout);
+    }
+
+    const BatchItemLayout* GraphBase::GetBatchItemLayout() const {
+        return mBatchItemLayout.get();
+    }
+
+    void GraphBase::SetStateful() {
+        mIsStateful = true;
+    }
+
+    bool GraphBase::IsStateful() const {
+        return mIsStateful;
+    }
+
+    MaybeError GraphBase::GetBoundBatchSize(
+        const std::function<const Input*(const std::string& name)>& getInput,
+        int32_t* batchSize) const {
+        *batchSize = 1;
+        if (mSymbolicBatch == nullptr) {
+            return {};
+        }
+
+        // The inputs without dimensions are computed with the batch size of the others.
+        bool isBatchSizeBound = false;
+        for (auto& inputShape : mSymbolicBatch->inputShapes) {
+            const Input* input = getInput(inputShape.first);
+            if (input == nullptr || input->dimensions == nullptr) {
+                continue;
+            }
+            const std::vector<int32_t>& shape = inputShape.second;
+            if (input->dimensionsCount != shape.size() || input->dimensions[0] <= 0 ||
+                !std::equal(shape.begin() + 1, shape.end(), input->dimensions + 1)) {
+                return DAWN_VALIDATION_ERROR("The dimensions of input " + inputShape.first +
+                                             " don't match its operand.");
+            }
+            if (isBatchSizeBound && input->dimensions[0] != *batchSize) {
+                return DAWN_VALIDATION_ERROR("The inputs are bound to different batch sizes.");
+            }
+            *batchSize = input->dimensions[0];
+            isBatchSizeBound = true;
+        }
+        return {};
+    }
+
+    MaybeError GraphBase::GetGraphForBatchSize(
+        const std::function<const Input*(const std::string& name)>& getInput,
+        GraphBase** graph) {
+        int32_t batchSize;
+        DAWN_TRY(GetBoundBatchSize(getInput, &batchSize));
+        return GetGraphForBatchSize(batchSize, graph);
+    }
+
+    GraphBase* GraphBase::FindGraphForBatchSize(int32_t batchSize) {
+        if (mSymbolicBatch == nullptr || batchSize == 1) {
+            return this;
+        }
+        std::lock_guard<std::mutex> lock(mBatchGraphsMutex);
+        auto entry = mBatchGraphs.find(batchSize);
+        return entry != mBatchGraphs.end() ? GetIfBuilt(entry->second) : nullptr;
+    }
+
+    MaybeError GraphBase::GetGraphForBatchSize(int32_t batchSize, GraphBase** graph) {
+        *graph = this;
+        if (mSymbolicBatch == nullptr || batchSize == 1) {
+            return {};
+        }
+
+        // The graph is built outside of the lock, so the computes of the other batch sizes and
+        // the resets go on meanwhile, and those of the same batch size wait for its future.
+        std::promise<Ref<GraphBase>> promise;
+        std::shared_future<Ref<GraphBase>> batchGraph;
+        bool isBuilder = false;
+        {
+            std::lock_guard<std::mutex> lock(mBatchGraphsMutex);
+            auto entry = mBatchGraphs.find(batchSize);
+            if (entry == mBatchGraphs.end()) {
+                batchGraph = promise.get_future().share();
+                mBatchGraphs.emplace(batchSize, batchGraph);
+                isBuilder = true;
+            } else {
+                batchGraph = entry->second;
+            }
+        }
+        if (isBuilder) {
+            Ref<GraphBase> newGraph = AcquireRef(GetContext()->CreateGraph());
+            MaybeError maybeError =
+                mSymbolicBatch->builder->BuildForBatchSize(*mSymbolicBatch, batchSize,
+                                                           newGraph.Get());
+            if (maybeError.IsError()) {
+                // The next compute of the batch size tries to build it again.
+                {
+                    std::lock_guard<std::mutex> lock(mBatchGraphsMutex);
+                    mBatchGraphs.erase(batchSize);
+                }
+                promise.set_value(Ref<GraphBase>());
+                return maybeError;
+            }
+            newGraph->mProfiler = mProfiler;
+            promise.set_value(std::move(newGraph));
+        }
+        *graph = batchGraph.get().Get();
+        if (*graph == nullptr) {
+            return DAWN_VALIDATION_ERROR("Failed to build the graph for a batch size of " +
+                                         std::to_string(batchSize) + ".");
+        }
+        return {};
+    }
+
+    MaybeError GraphBase::PrepareBatchSize(int32_t batchSize) {
+        GraphBase* graph;
+        return GetGraphForBatchSize(batchSize, &graph);
+    }
+
+    Profiler* GraphBase::GetProfiler() const {
+        return mProfiler.get();
+    }
+
+    void GraphBase::RecordCopiedBytes(uint64_t byteLength) {
+        mCopiedByteLength += byteLength;
+        ++mComputeCount;
+    }
+
+    ComputeCopyStats GraphBase::GetComputeCopyStats() {
+        ComputeCopyStats stats;
+        stats.computeCount = mComputeCount;
+        stats.copiedByteLength = mCopiedByteLength;
+        std::lock_guard<std::mutex> lock(mBatchGraphsMutex);
+        for (auto& batchGraph : mBatchGraphs) {
+            GraphBase* graph = GetIfBuilt(batchGraph.second);
+            if (graph != nullptr) {
+                stats.computeCount += graph->mComputeCount;
+                stats.copiedByteLength += graph->mCopiedByteLength;
+            }
+        }
+        return stats;
+    }
+
+    void GraphBase::SetOptimizationStats(const GraphOptimizationStats& stats) {
+        mOptimizationStats = stats;
+    }
+
+    const GraphOptimizationStats& GraphBase::GetOptimizationStats() const {
+        return mOptimizationStats;
+    }
+
+    void GraphBase::SetInputOutputNames(std::vector<std::string> inputNames,
+                                        std::vector<std::string> outputNames) {
+        // Several inputs may have the same name, they are bound to the same resource.
+        std::sort(inputNames.begin(), inputNames.end());
+        inputNames.erase(std::unique(inputNames.begin(), inputNames.end()), inputNames.end());
+        std::sort(outputNames.begin(), outputNames.end());
+        mInputNames = std::move(inputNames);
+        mOutputNames = std::move(outputNames);
+    }
+
+    const std::vector<std::string>& GraphBase::GetInputNames() const {
+        return mInputNames;
+    }
+
+    const std::vector<std::string>& GraphBase::GetOutputNames() const {
+        return mOutputNames;
+    }
+
+    MLComputeGraphStatus GraphBase::Compute(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
+        if (mProfiler == nullptr) {
+            return ComputeImpl(inputs, outputs);
+        }
+        TRACE_EVENT0(mProfiler.get(), General, "compute");
+        return ComputeImpl(inputs, outputs);
+    }
+
+    MLComputeGraphStatus GraphBase::ComputeWithBindings(const BindingSetBase* bindings) {
+        if (mProfiler == nullptr) {
+            return ComputeWithBindingsImpl(bindings);
+        }
+        TRACE_EVENT0(mProfiler.get(), General, "compute");
+        return ComputeWithBindingsImpl(bindings);
+    }
+
+    MLComputeGraphStatus GraphBase::ComputeWithBindingsImpl(const BindingSetBase* bindings) {
+        // The names are the ones of the graph the bindings were created for, which the graphs
+        // built for other batch sizes share.
+        const GraphBase* graph = bindings->GetGraph();
+        Ref<NamedInputsBase> inputs = AcquireRef(new NamedInputsBase());
+        for (size_t i = 0; i < bindings->GetInputs().size(); ++i) {
+            if (bindings->GetInputs()[i] != nullptr) {
+                inputs->APISet(graph->mInputNames[i].c_str(), bindings->GetInputs()[i]);
+            }
+        }
+        Ref<NamedOutputsBase> outputs = AcquireRef(new NamedOutputsBase());
+        for (size_t i = 0; i < bindings->GetOutputs().size(); ++i) {
+            if (bindings->GetOutputs()[i] != nullptr) {
+                outputs->APISet(graph->mOutputNames[i].c_str(), bindings->GetOutputs()[i]);
+            }
+        }
+        return ComputeImpl(inputs.Get(), outputs.Get());
     }
 
     MaybeError GraphBase::AddConstant(const op::Constant* constant) {
@@ -113,12 +455,19 @@ namespace webnn_native {
         return DAWN_UNIMPLEMENTED_ERROR("AddInstanceNorm");
     }
 
+    MaybeError GraphBase::AddQuantize(const op::Quantize* quantize) {
+        return DAWN_UNIMPLEMENTED_ERROR("AddQuantize");
+    }
+
     MaybeError GraphBase::Finish() {
         UNREACHABLE();
     }
 
     MaybeError GraphBase::Compile() {
-        return CompileImpl();
+        MaybeError result = CompileImpl();
+        // The caller may release the constants it points to once the graph is built.
+        mSerializedGraph = nullptr;
+        return result;
     }
 
     MLComputeGraphStatus GraphBase::APICompute(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
@@ -126,7 +475,135 @@ namespace webnn_native {
             return MLComputeGraphStatus_Error;
         }
 
-        return ComputeImpl(inputs, outputs);
+        auto getInput = [inputs](const std::string& name) -> const Input* {
+            return inputs->APIGet(name.c_str());
+        };
+        GraphBase* graph;
+        if (GetContext()->ConsumedError(GetGraphForBatchSize(getInput, &graph))) {
+            return MLComputeGraphStatus_Error;
+        }
+        return graph->Compute(inputs, outputs);
+    }
+
+    BindingSetBase* GraphBase::APICreateBindingSet() {
+        return new BindingSetBase(this);
+    }
+
+    MLComputeGraphStatus GraphBase::APIComputeWithBindings(BindingSetBase* bindings) {
+        if (bindings == nullptr) {
+            return MLComputeGraphStatus_Error;
+        }
+        if (bindings->GetGraph() != this) {
+            GetContext()->ConsumedError(
+                DAWN_VALIDATION_ERROR("The bindings were created for another graph."));
+            return MLComputeGraphStatus_Error;
+        }
+
+        auto getInput = [bindings](const std::string& name) { return bindings->GetInput(name); };
+        GraphBase* graph;
+        if (GetContext()->ConsumedError(GetGraphForBatchSize(getInput, &graph))) {
+            return MLComputeGraphStatus_Error;
+        }
+        return graph->ComputeWithBindings(bindings);
+    }
+
+    void GraphBase::APIResetState() {
+        ResetStateImpl();
+        // The graphs still being built start from their initial state anyway.
+        std::lock_guard<std::mutex> lock(mBatchGraphsMutex);
+        for (auto& batchGraph : mBatchGraphs) {
+            GraphBase* graph = GetIfBuilt(batchGraph.second);
+            if (graph != nullptr) {
+                graph->ResetStateImpl();
+            }
+        }
+    }
+
+    void GraphBase::ResetStateImpl() {
+    }
+
+    void GraphBase::APIComputeAsync(NamedInputsBase* inputs,
+                                    NamedOutputsBase* outputs,
+                                    ml::ComputeGraphCallback callback,
+                                    void* userdata) {
+        if (callback == nullptr) {
+            dawn::ErrorLog() << "The callback of computeAsync must be set.";
+            return;
+        }
+        if (inputs == nullptr || outputs == nullptr) {
+            callback(MLComputeGraphStatus_Error, "The inputs and outputs must be set.", userdata);
+            return;
+        }
+
+        auto getInput = [inputs](const std::string& name) -> const Input* {
+            return inputs->APIGet(name.c_str());
+        };
+        int32_t batchSize;
+        if (GetContext()->ConsumedError(GetBoundBatchSize(getInput, &batchSize))) {
+            callback(MLComputeGraphStatus_Error, "Failed to bind the batch size.", userdata);
+            return;
+        }
+        Ref<NamedInputsBase> inputsCopy = AcquireRef(new NamedInputsCopy(inputs));
+        Ref<NamedOutputsBase> outputsCopy = AcquireRef(new NamedOutputsCopy(outputs));
+        GraphBase* graph = FindGraphForBatchSize(batchSize);
+        if (graph != nullptr) {
+            graph->ComputeAsyncImpl(inputsCopy.Get(), outputsCopy.Get(), callback, userdata);
+            return;
+        }
+
+        // The graph for a new batch size is built on the worker task pool rather than on the
+        // calling thread, and computes once it is.
+        struct BuildAsyncTask {
+            Ref<GraphBase> graph;
+            int32_t batchSize;
+            Ref<NamedInputsBase> inputs;
+            Ref<NamedOutputsBase> outputs;
+            ml::ComputeGraphCallback callback;
+            void* userdata;
+        };
+        BuildAsyncTask* task =
+            new BuildAsyncTask{this, batchSize, inputsCopy, outputsCopy, callback, userdata};
+        GetContext()->GetWorkerTaskPool()->PostWorkerTask(
+            [](void* userdata) {
+                std::unique_ptr<BuildAsyncTask> task(static_cast<BuildAsyncTask*>(userdata));
+                GraphBase* graph;
+                if (task->graph->GetContext()->ConsumedError(
+                        task->graph->GetGraphForBatchSize(task->batchSize, &graph))) {
+                    task->callback(MLComputeGraphStatus_Error,
+                                   "Failed to build the graph for the batch size.",
+                                   task->userdata);
+                    return;
+                }
+                graph->ComputeAsyncImpl(task->inputs.Get(), task->outputs.Get(), task->callback,
+                                        task->userdata);
+            },
+            task);
+    }
+
+    void GraphBase::ComputeAsyncImpl(NamedInputsBase* inputs,
+                                     NamedOutputsBase* outputs,
+                                     ml::ComputeGraphCallback callback,
+                                     void* userdata) {
+        // The task keeps the graph and the copies of the named records alive until the callback
+        // is called.
+        struct ComputeAsyncTask {
+            Ref<GraphBase> graph;
+            Ref<NamedInputsBase> inputs;
+            Ref<NamedOutputsBase> outputs;
+            ml::ComputeGraphCallback callback;
+            void* userdata;
+        };
+        ComputeAsyncTask* task = new ComputeAsyncTask{this, inputs, outputs, callback, userdata};
+        GetContext()->GetWorkerTaskPool()->PostWorkerTask(
+            [](void* userdata) {
+                std::unique_ptr<ComputeAsyncTask> task(static_cast<ComputeAsyncTask*>(userdata));
+                MLComputeGraphStatus status =
+                    task->graph->Compute(task->inputs.Get(), task->outputs.Get());
+                const char* message =
+                    status == MLComputeGraphStatus_Success ? "" : "Failed to compute the graph.";
+                task->callback(status, message, task->userdata);
+            },
+            task);
     }
 
 }  // namespace webnn_native
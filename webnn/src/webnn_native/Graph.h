@@ -15,17 +15,30 @@
 #ifndef WEBNN_NATIVE_GRAPH_H_
 #define WEBNN_NATIVE_GRAPH_H_
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "common/RefCounted.h"
 #include "webnn_native/Context.h"
 #include "webnn_native/Error.h"
 #include "webnn_native/Forward.h"
+#include "webnn_native/FusionOperator.h"
 #include "webnn_native/GraphBuilder.h"
 #include "webnn_native/ObjectBase.h"
 #include "webnn_native/Operand.h"
+#include "webnn_native/Profiler.h"
 #include "webnn_native/webnn_platform.h"
 
 namespace webnn_native {
 
+    class GraphSerializer;
+
     namespace op {
         class Constant;
         class Input;
@@ -48,12 +61,34 @@ namespace webnn_native {
         class Gemm;
         class Clamp;
         class InstanceNorm;
+        class Quantize;
     }  // namespace op
 
+    // What a graph whose inputs have a symbolic batch needs to build its operators again for
+    // another batch size.
+    struct SymbolicBatchGraph {
+        Ref<GraphBuilderBase> builder;
+        std::vector<Ref<OperatorBase>> sortedOperators;
+        std::map<std::string, Ref<OperandBase>> outputs;
+        // The inputs with a symbolic batch and their shapes for a batch size of 1.
+        std::vector<op::Input*> inputs;
+        std::map<std::string, std::vector<int32_t>> inputShapes;
+    };
+
+    // The items of a graph whose inputs all have a symbolic batch and whose outputs all lead
+    // with it, which the computes of separate items can be batched along.
+    struct BatchItemLayout {
+        // The shapes of the inputs for a batch size of 1.
+        std::map<std::string, std::vector<int32_t>> inputShapes;
+        // The bytes of one item of each input and output.
+        std::map<std::string, size_t> inputByteLengths;
+        std::map<std::string, size_t> outputByteLengths;
+    };
+
     class GraphBase : public ObjectBase {
       public:
         explicit GraphBase(ContextBase* context);
-        virtual ~GraphBase() = default;
+        virtual ~GraphBase();
 
         virtual MaybeError AddConstant(const op::Constant* constant);
         virtual MaybeError AddInput(const op::Input* input);
@@ -77,16 +112,138 @@ namespace webnn_native {
         virtual MaybeError AddGemm(const op::Gemm* gemm);
         virtual MaybeError AddClamp(const op::Clamp* clamp);
         virtual MaybeError AddInstanceNorm(const op::InstanceNorm* instanceNorm);
+        virtual MaybeError AddQuantize(const op::Quantize* quantize);
         virtual MaybeError Finish();
         virtual MaybeError Compile();
 
+        // Whether the backend computes the bias operand and the fused activation of conv2d and
+        // batchNorm, which the graph optimizer produces when it folds operators into them.
+        virtual bool SupportsFusedOperators() const;
+        // Whether the backend computes |type| as the fused activation of conv2d and batchNorm.
+        // By default, the activations the API lets callers fuse.
+        virtual bool SupportsFusedActivation(FusionType type) const;
+        // Whether the backend keys the compiled graph in the cache directory of the context by
+        // the content hash.
+        virtual bool CachesCompiledGraph() const;
+
+        // The hash of the operators, their options and the constants, which keys the compiled
+        // artifacts of the graph. Hashing reads all the constants, so it is only computed when
+        // the context has a cache directory and the backend caches the compiled graph.
+        bool HasContentHash() const;
+        size_t GetContentHash() const;
+        void SetContentHash(size_t contentHash);
+        // The graph the content hash was computed from, serialized with the constants it reads
+        // until the graph is compiled. Different graphs may have the same hash, so the backends
+        // store it beside the compiled graph and only load the one of an identical graph.
+        void SetSerializedGraph(Ref<GraphSerializer> serializedGraph);
+        const GraphSerializer* GetSerializedGraph() const;
+
+        // Lets the inputs of the graph be computed with another batch size, for which the
+        // operators are built again into a graph of the same backend on first use.
+        void SetSymbolicBatch(std::unique_ptr<SymbolicBatchGraph> symbolicBatch);
+        // Returns null unless the computes of separate items can be batched. The outputs of the
+        // items are only separable if the operators don't mix the items, which is up to the
+        // caller batching them.
+        const BatchItemLayout* GetBatchItemLayout() const;
+        // Whether an operator keeps a state between the computes, which then can't be batched
+        // with the computes of unrelated requests.
+        void SetStateful();
+        bool IsStateful() const;
+        // Builds the graph for |batchSize| ahead of the first compute binding it.
+        MaybeError PrepareBatchSize(int32_t batchSize);
+
+        // The platform tracing the computes when the context enables profiling, or null. The
+        // backends trace each operator they execute to it.
+        Profiler* GetProfiler() const;
+
+        // The backends counting the bytes they copy between the user buffers and their memory
+        // record them once per compute, which may run concurrently.
+        void RecordCopiedBytes(uint64_t byteLength);
+        ComputeCopyStats GetComputeCopyStats();
+
+        void SetOptimizationStats(const GraphOptimizationStats& stats);
+        const GraphOptimizationStats& GetOptimizationStats() const;
+
+        // The sorted names of the inputs and the outputs, whose positions are the indices of the
+        // binding sets. The backends keying their inputs and outputs by name in an ordered map
+        // find them in the same order.
+        void SetInputOutputNames(std::vector<std::string> inputNames,
+                                 std::vector<std::string> outputNames);
+        const std::vector<std::string>& GetInputNames() const;
+        const std::vector<std::string>& GetOutputNames() const;
+
         // Webnn API
         MLComputeGraphStatus APICompute(NamedInputsBase* inputs, NamedOutputsBase* outputs);
+        // The Input and ArrayBufferView structs of the records are copied before it returns,
+        // but the buffers they point to are only read and written by the compute, so they must
+        // stay alive until |callback| is called.
+        void APIComputeAsync(NamedInputsBase* inputs,
+                             NamedOutputsBase* outputs,
+                             ml::ComputeGraphCallback callback,
+                             void* userdata);
+        BindingSetBase* APICreateBindingSet();
+        MLComputeGraphStatus APIComputeWithBindings(BindingSetBase* bindings);
+        // Starts the stateful operators again from their initial state, here and in the graphs
+        // built for other batch sizes.
+        void APIResetState();
 
       private:
+        // Finds the batch size bound by the dimensions of the inputs, which |getInput| returns by
+        // name, or null when they aren't set.
+        MaybeError GetBoundBatchSize(
+            const std::function<const Input*(const std::string& name)>& getInput,
+            int32_t* batchSize) const;
+        // Finds the graph compiled for the bound batch size, which is built on first use.
+        MaybeError GetGraphForBatchSize(
+            const std::function<const Input*(const std::string& name)>& getInput,
+            GraphBase** graph);
+        MaybeError GetGraphForBatchSize(int32_t batchSize, GraphBase** graph);
+        // Returns the graph for |batchSize| if it doesn't need to be built first, or null.
+        GraphBase* FindGraphForBatchSize(int32_t batchSize);
+        // Runs ComputeImpl in a trace event when profiling.
+        MLComputeGraphStatus Compute(NamedInputsBase* inputs, NamedOutputsBase* outputs);
+        MLComputeGraphStatus ComputeWithBindings(const BindingSetBase* bindings);
+
         virtual MaybeError CompileImpl() = 0;
+        // Backends must allow ComputeImpl to be called from several threads at once, either by
+        // serializing the computations or by running them on separate resources.
         virtual MLComputeGraphStatus ComputeImpl(NamedInputsBase* inputs,
                                                  NamedOutputsBase* outputs) = 0;
+        // Runs ComputeImpl on the worker task pool of the context and calls |callback| from the
+        // worker thread. Backends with a native asynchronous execution may override it.
+        virtual void ComputeAsyncImpl(NamedInputsBase* inputs,
+                                      NamedOutputsBase* outputs,
+                                      ml::ComputeGraphCallback callback,
+                                      void* userdata);
+        // Computes with the resources of |bindings|, which are in the order of GetInputNames and
+        // GetOutputNames. By default they are named for ComputeImpl, the backends which resolve
+        // the order of their inputs and outputs when they compile override it to skip that.
+        virtual MLComputeGraphStatus ComputeWithBindingsImpl(const BindingSetBase* bindings);
+        // The backends keeping the state of the stateful gru between the computes clear it. It
+        // may be called while another thread computes.
+        virtual void ResetStateImpl();
+
+        size_t mContentHash = 0;
+        bool mIsContentHashInitialized = false;
+        Ref<GraphSerializer> mSerializedGraph;
+        bool mIsStateful = false;
+
+        // Shared with the graphs built for other batch sizes.
+        std::shared_ptr<Profiler> mProfiler;
+
+        std::atomic<uint64_t> mComputeCount{0};
+        std::atomic<uint64_t> mCopiedByteLength{0};
+
+        GraphOptimizationStats mOptimizationStats;
+
+        std::vector<std::string> mInputNames;
+        std::vector<std::string> mOutputNames;
+
+        std::unique_ptr<SymbolicBatchGraph> mSymbolicBatch;
+        std::unique_ptr<BatchItemLayout> mBatchItemLayout;
+        // The graphs built for other batch sizes, or being built.
+        std::map<int32_t, std::shared_future<Ref<GraphBase>>> mBatchGraphs;
+        std::mutex mBatchGraphsMutex;
     };
 }  // namespace webnn_native
 
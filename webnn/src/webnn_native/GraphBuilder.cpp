@@ -14,9 +14,10 @@
 
 #include "webnn_native/GraphBuilder.h"
 
-#include <stack>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 #include "common/Assert.h"
@@ -24,6 +25,9 @@
 #include "common/RefCounted.h"
 #include "webnn_native/Context.h"
 #include "webnn_native/Graph.h"
+#include "webnn_native/GraphContentHasher.h"
+#include "webnn_native/GraphOptimizer.h"
+#include "webnn_native/GraphSerialization.h"
 #include "webnn_native/Operand.h"
 #include "webnn_native/OperandArray.h"
 #include "webnn_native/Operator.h"
@@ -40,6 +44,7 @@
 #include "webnn_native/ops/LeakyRelu.h"
 #include "webnn_native/ops/Pad.h"
 #include "webnn_native/ops/Pool2d.h"
+#include "webnn_native/ops/Quantize.h"
 #include "webnn_native/ops/Reduce.h"
 #include "webnn_native/ops/Resample2d.h"
 #include "webnn_native/ops/Reshape.h"
@@ -50,6 +55,7 @@
 #include "webnn_native/ops/Unary.h"
 
 #define DAWN_VALIDATE(ptr, objectBase)                 \
+    std::lock_guard<std::mutex> lock(mMutex);          \
     Ref<OperatorBase> op = AcquireRef(ptr);            \
     if (GetContext()->ConsumedError(op->ValidateAndInferOutputInfo())) { \
         return objectBase::MakeError(this);            \
@@ -66,31 +72,33 @@
 
 namespace webnn_native {
 
-    GraphBuilderBase::GraphBuilderBase(ContextBase* context) : ObjectBase(context) {
+    GraphBuilderBase::GraphBuilderBase(ContextBase* context)
+        : ObjectBase(context), mArena(AcquireRef(new Arena())) {
     }
 
     OperandBase* GraphBuilderBase::APIAbs(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kAbs, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kAbs, input));
     }
 
     OperandBase* GraphBuilderBase::APIAdd(OperandBase* a, OperandBase* b) {
-        VALIDATE_FOR_OPERAND(new op::Binary(this, op::BinaryOpType::kAdd, a, b));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Binary(this, op::BinaryOpType::kAdd, a, b));
     }
 
     OperandBase* GraphBuilderBase::APIAveragePool2d(OperandBase* input,
                                                     Pool2dOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Pool2d(this, op::Pool2dType::kAveragePool2d, input, options));
+        VALIDATE_FOR_OPERAND(
+            new (GetArena()) op::Pool2d(this, op::Pool2dType::kAveragePool2d, input, options));
     }
 
     OperandBase* GraphBuilderBase::APIBatchNorm(OperandBase* input,
                                                 OperandBase* mean,
                                                 OperandBase* variance,
                                                 BatchNormOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::BatchNorm(this, input, mean, variance, options));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::BatchNorm(this, input, mean, variance, options));
     }
 
     OperandBase* GraphBuilderBase::APIClamp(OperandBase* input, ClampOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Clamp(this, input, options));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Clamp(this, input, options));
     }
 
     FusionOperatorBase* GraphBuilderBase::APIClampOperator(ClampOptions const* options) {
@@ -98,7 +106,7 @@ namespace webnn_native {
     }
 
     OperandBase* GraphBuilderBase::APICeil(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kCeil, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kCeil, input));
     }
 
     OperandBase* GraphBuilderBase::APIConcat(uint32_t inputsCount,
@@ -109,40 +117,48 @@ namespace webnn_native {
         for (uint32_t i = 0; i < inputsCount; ++i) {
             operandInputs.push_back(inputs[i]);
         }
-        VALIDATE_FOR_OPERAND(new op::Concat(this, std::move(operandInputs), axis));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Concat(this, std::move(operandInputs), axis));
     }
 
     OperandBase* GraphBuilderBase::APIConstant(OperandDescriptor const* desc,
                                                ArrayBufferView const* arrayBuffer) {
-        VALIDATE_FOR_OPERAND(new op::Constant(this, desc, arrayBuffer));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Constant(this, desc, arrayBuffer));
     }
 
     OperandBase* GraphBuilderBase::APIConv2d(OperandBase* input,
                                              OperandBase* filter,
                                              Conv2dOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Conv2d(this, input, filter, options));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Conv2d(this, input, filter, options));
     }
 
     OperandBase* GraphBuilderBase::APICos(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kCos, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kCos, input));
+    }
+
+    OperandBase* GraphBuilderBase::APIDequantizeLinear(OperandBase* input,
+                                                       OperandBase* scale,
+                                                       OperandBase* zeroPoint,
+                                                       QuantizeLinearOptions const* options) {
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Quantize(
+            this, op::QuantizeType::kDequantizeLinear, input, scale, zeroPoint, options));
     }
 
     OperandBase* GraphBuilderBase::APIDiv(OperandBase* a, OperandBase* b) {
-        VALIDATE_FOR_OPERAND(new op::Binary(this, op::BinaryOpType::kDiv, a, b));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Binary(this, op::BinaryOpType::kDiv, a, b));
     }
 
     OperandBase* GraphBuilderBase::APIExp(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kExp, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kExp, input));
     }
 
     OperandBase* GraphBuilderBase::APIFloor(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kFloor, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kFloor, input));
     }
 
     OperandBase* GraphBuilderBase::APIGemm(OperandBase* a,
                                            OperandBase* b,
                                            GemmOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Gemm(this, a, b, options));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Gemm(this, a, b, options));
     }
 
     OperandArrayBase* GraphBuilderBase::APIGru(OperandBase* input,
@@ -151,12 +167,12 @@ namespace webnn_native {
                                                int32_t steps,
                                                int32_t hiddenSize,
                                                GruOptions const* options) {
-        VALIDATE_ARRAY_OPERAND(
-            new op::Gru(this, input, weight, recurrentWeight, steps, hiddenSize, options));
+        VALIDATE_ARRAY_OPERAND(new (GetArena()) op::Gru(this, input, weight, recurrentWeight, steps,
+                                                        hiddenSize, options));
     }
 
     OperandBase* GraphBuilderBase::APIHardSwish(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kHardSwish, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kHardSwish, input));
     }
 
     FusionOperatorBase* GraphBuilderBase::APIHardSwishOperator() {
@@ -164,17 +180,17 @@ namespace webnn_native {
     }
 
     OperandBase* GraphBuilderBase::APIInput(char const* name, OperandDescriptor const* desc) {
-        VALIDATE_FOR_OPERAND(new op::Input(this, std::string(name), desc));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Input(this, std::string(name), desc));
     }
 
     OperandBase* GraphBuilderBase::APIInstanceNorm(OperandBase* input,
                                                    InstanceNormOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::InstanceNorm(this, input, options));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::InstanceNorm(this, input, options));
     }
 
     OperandBase* GraphBuilderBase::APILeakyRelu(OperandBase* input,
                                                 LeakyReluOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::LeakyRelu(this, input, options));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::LeakyRelu(this, input, options));
     }
 
     FusionOperatorBase* GraphBuilderBase::APILeakyReluOperator(LeakyReluOptions const* options) {
@@ -182,78 +198,95 @@ namespace webnn_native {
     }
 
     OperandBase* GraphBuilderBase::APILog(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kLog, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kLog, input));
     }
 
     OperandBase* GraphBuilderBase::APIL2Pool2d(OperandBase* input, Pool2dOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Pool2d(this, op::Pool2dType::kL2Pool2d, input, options));
+        VALIDATE_FOR_OPERAND(
+            new (GetArena()) op::Pool2d(this, op::Pool2dType::kL2Pool2d, input, options));
     }
 
     OperandBase* GraphBuilderBase::APIMatmul(OperandBase* a, OperandBase* b) {
-        VALIDATE_FOR_OPERAND(new op::Binary(this, op::BinaryOpType::kMatMul, a, b));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Binary(this, op::BinaryOpType::kMatMul, a, b));
     }
 
     OperandBase* GraphBuilderBase::APIMax(OperandBase* a, OperandBase* b) {
-        VALIDATE_FOR_OPERAND(new op::Binary(this, op::BinaryOpType::kMax, a, b));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Binary(this, op::BinaryOpType::kMax, a, b));
     }
 
     OperandBase* GraphBuilderBase::APIMaxPool2d(OperandBase* input, Pool2dOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Pool2d(this, op::Pool2dType::kMaxPool2d, input, options));
+        VALIDATE_FOR_OPERAND(
+            new (GetArena()) op::Pool2d(this, op::Pool2dType::kMaxPool2d, input, options));
     }
 
     OperandBase* GraphBuilderBase::APIMin(OperandBase* a, OperandBase* b) {
-        VALIDATE_FOR_OPERAND(new op::Binary(this, op::BinaryOpType::kMin, a, b));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Binary(this, op::BinaryOpType::kMin, a, b));
     }
 
     OperandBase* GraphBuilderBase::APIMul(OperandBase* a, OperandBase* b) {
-        VALIDATE_FOR_OPERAND(new op::Binary(this, op::BinaryOpType::kMul, a, b));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Binary(this, op::BinaryOpType::kMul, a, b));
     }
 
     OperandBase* GraphBuilderBase::APINeg(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kNeg, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kNeg, input));
     }
 
     OperandBase* GraphBuilderBase::APIPad(OperandBase* input,
                                           OperandBase* padding,
                                           PadOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Pad(this, input, padding, options));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Pad(this, input, padding, options));
     }
 
     OperandBase* GraphBuilderBase::APIPow(OperandBase* a, OperandBase* b) {
-        VALIDATE_FOR_OPERAND(new op::Binary(this, op::BinaryOpType::kPower, a, b));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Binary(this, op::BinaryOpType::kPower, a, b));
+    }
+
+    OperandBase* GraphBuilderBase::APIQuantizeLinear(OperandBase* input,
+                                                     OperandBase* scale,
+                                                     OperandBase* zeroPoint,
+                                                     QuantizeLinearOptions const* options) {
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Quantize(
+            this, op::QuantizeType::kQuantizeLinear, input, scale, zeroPoint, options));
     }
 
     OperandBase* GraphBuilderBase::APIReduceL2(OperandBase* input, ReduceOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Reduce(this, op::ReduceType::kReduceL2, input, options));
+        VALIDATE_FOR_OPERAND(
+            new (GetArena()) op::Reduce(this, op::ReduceType::kReduceL2, input, options));
     }
 
     OperandBase* GraphBuilderBase::APIReduceL1(OperandBase* input, ReduceOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Reduce(this, op::ReduceType::kReduceL1, input, options));
+        VALIDATE_FOR_OPERAND(
+            new (GetArena()) op::Reduce(this, op::ReduceType::kReduceL1, input, options));
     }
 
     OperandBase* GraphBuilderBase::APIReduceMax(OperandBase* input, ReduceOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Reduce(this, op::ReduceType::kReduceMax, input, options));
+        VALIDATE_FOR_OPERAND(
+            new (GetArena()) op::Reduce(this, op::ReduceType::kReduceMax, input, options));
     }
 
     OperandBase* GraphBuilderBase::APIReduceMean(OperandBase* input, ReduceOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Reduce(this, op::ReduceType::kReduceMean, input, options));
+        VALIDATE_FOR_OPERAND(
+            new (GetArena()) op::Reduce(this, op::ReduceType::kReduceMean, input, options));
     }
 
     OperandBase* GraphBuilderBase::APIReduceMin(OperandBase* input, ReduceOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Reduce(this, op::ReduceType::kReduceMin, input, options));
+        VALIDATE_FOR_OPERAND(
+            new (GetArena()) op::Reduce(this, op::ReduceType::kReduceMin, input, options));
     }
 
     OperandBase* GraphBuilderBase::APIReduceProduct(OperandBase* input,
                                                     ReduceOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Reduce(this, op::ReduceType::kReduceProduct, input, options));
+        VALIDATE_FOR_OPERAND(
+            new (GetArena()) op::Reduce(this, op::ReduceType::kReduceProduct, input, options));
     }
 
     OperandBase* GraphBuilderBase::APIReduceSum(OperandBase* input, ReduceOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Reduce(this, op::ReduceType::kReduceSum, input, options));
+        VALIDATE_FOR_OPERAND(
+            new (GetArena()) op::Reduce(this, op::ReduceType::kReduceSum, input, options));
     }
 
     OperandBase* GraphBuilderBase::APIRelu(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kRelu, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kRelu, input));
     }
 
     FusionOperatorBase* GraphBuilderBase::APIReluOperator() {
@@ -261,17 +294,17 @@ namespace webnn_native {
     }
 
     OperandBase* GraphBuilderBase::APIResample2d(OperandBase* input, Resample2dOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Resample2d(this, input, options));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Resample2d(this, input, options));
     }
 
     OperandBase* GraphBuilderBase::APIReshape(OperandBase* input,
                                               int32_t const* new_shape,
                                               size_t new_shape_count) {
-        VALIDATE_FOR_OPERAND(new op::Reshape(this, input, new_shape, new_shape_count));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Reshape(this, input, new_shape, new_shape_count));
     }
 
     OperandBase* GraphBuilderBase::APISigmoid(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kSigmoid, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kSigmoid, input));
     }
 
     FusionOperatorBase* GraphBuilderBase::APISigmoidOperator() {
@@ -279,7 +312,7 @@ namespace webnn_native {
     }
 
     OperandBase* GraphBuilderBase::APISin(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kSin, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kSin, input));
     }
 
     OperandBase* GraphBuilderBase::APISlice(OperandBase* input,
@@ -288,35 +321,36 @@ namespace webnn_native {
                                             int32_t const* sizes,
                                             uint32_t sizesCount,
                                             SliceOptions const* options) {
-        VALIDATE_FOR_OPERAND(
-            new op::Slice(this, input, starts, startsCount, sizes, sizesCount, options));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Slice(this, input, starts, startsCount, sizes,
+                                                        sizesCount, options));
     }
 
     OperandBase* GraphBuilderBase::APISoftmax(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kSoftmax, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kSoftmax, input));
     }
 
     OperandArrayBase* GraphBuilderBase::APISplit(OperandBase* input,
                                                  uint32_t const* splits,
                                                  uint32_t splitsCount,
                                                  SplitOptions const* options) {
-        VALIDATE_ARRAY_OPERAND(new op::Split(this, input, splits, splitsCount, options));
+        VALIDATE_ARRAY_OPERAND(
+            new (GetArena()) op::Split(this, input, splits, splitsCount, options));
     }
 
     OperandBase* GraphBuilderBase::APISqueeze(OperandBase* input, SqueezeOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Squeeze(this, input, options));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Squeeze(this, input, options));
     }
 
     OperandBase* GraphBuilderBase::APISub(OperandBase* a, OperandBase* b) {
-        VALIDATE_FOR_OPERAND(new op::Binary(this, op::BinaryOpType::kSub, a, b));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Binary(this, op::BinaryOpType::kSub, a, b));
     }
 
     OperandBase* GraphBuilderBase::APITan(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kTan, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kTan, input));
     }
 
     OperandBase* GraphBuilderBase::APITanh(OperandBase* input) {
-        VALIDATE_FOR_OPERAND(new op::Unary(this, op::UnaryOpType::kTanh, input));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Unary(this, op::UnaryOpType::kTanh, input));
     }
 
     FusionOperatorBase* GraphBuilderBase::APITanhOperator() {
@@ -325,7 +359,7 @@ namespace webnn_native {
 
     OperandBase* GraphBuilderBase::APITranspose(OperandBase* input,
                                                 TransposeOptions const* options) {
-        VALIDATE_FOR_OPERAND(new op::Transpose(this, input, options));
+        VALIDATE_FOR_OPERAND(new (GetArena()) op::Transpose(this, input, options));
     }
 
     GraphBase* GraphBuilderBase::APIBuild(NamedOperandsBase const* namedOperands) {
@@ -334,29 +368,61 @@ namespace webnn_native {
             return nullptr;
         }
 
-        std::vector<const OperandBase*> outputs;
         if (namedOperands->GetRecords().empty()) {
             dawn::ErrorLog() << "The output named operands are empty.";
             return nullptr;
         }
-        for (auto& namedOutput : namedOperands->GetRecords()) {
-            outputs.push_back(namedOutput.second);
-        }
-        std::vector<const OperatorBase*> sorted_operands = TopologicalSort(outputs);
+        std::lock_guard<std::mutex> lock(mMutex);
         Ref<GraphBase> graph = AcquireRef(GetContext()->CreateGraph());
+        // The optimizer owns the operators it builds, so it lives until the graph is compiled.
+        GraphOptimizer optimizer(this, namedOperands, graph.Get());
+        optimizer.Run();
+        graph->SetOptimizationStats(optimizer.GetStats());
+        const std::vector<const OperatorBase*>& sorted_operands = optimizer.GetSortedOperators();
+        // Hashing reads all the constants, so it is only done when the hash keys a cache. The
+        // serialized graph tells the graphs with the same hash apart.
+        if (graph->CachesCompiledGraph() && !GetContext()->GetCacheDirectory().empty()) {
+            Ref<GraphContentHasher> hasher = AcquireRef(new GraphContentHasher(GetContext()));
+            Ref<GraphSerializer> serializer = AcquireRef(new GraphSerializer(GetContext()));
+            for (auto& op : sorted_operands) {
+                if (op->IsError() || GetContext()->ConsumedError(op->AddToGraph(hasher.Get())) ||
+                    GetContext()->ConsumedError(op->AddToGraph(serializer.Get()))) {
+                    dawn::ErrorLog() << "Failed to hash the operand when building graph.";
+                    return nullptr;
+                }
+            }
+            for (auto& namedOutput : optimizer.GetOutputs()) {
+                IgnoreErrors(hasher->AddOutput(namedOutput.first, namedOutput.second));
+                IgnoreErrors(serializer->AddOutput(namedOutput.first, namedOutput.second));
+            }
+            graph->SetContentHash(hasher->GetContentHash());
+            graph->SetSerializedGraph(std::move(serializer));
+        }
         for (auto& op : sorted_operands) {
             if (op->IsError() || GetContext()->ConsumedError(op->AddToGraph(graph.Get()))) {
                 dawn::ErrorLog() << "Failed to add the operand when building graph.";
                 return nullptr;
             }
+            if (op->IsStateful()) {
+                graph->SetStateful();
+            }
         }
-        for (auto& namedOutput : namedOperands->GetRecords()) {
+        for (auto& namedOutput : optimizer.GetOutputs()) {
             if (GetContext()->ConsumedError(
                     graph->AddOutput(namedOutput.first, namedOutput.second))) {
                 dawn::ErrorLog() << "Failed to add output when building graph.";
                 return nullptr;
             }
         }
+        std::vector<std::string> inputNames;
+        for (auto input : optimizer.GetInputs()) {
+            inputNames.push_back(input->GetName());
+        }
+        std::vector<std::string> outputNames;
+        for (auto& namedOutput : optimizer.GetOutputs()) {
+            outputNames.push_back(namedOutput.first);
+        }
+        graph->SetInputOutputNames(std::move(inputNames), std::move(outputNames));
         if (GetContext()->ConsumedError(graph->Finish())) {
             dawn::ErrorLog() << "Failed to finish building graph.";
             return nullptr;
@@ -367,9 +433,113 @@ namespace webnn_native {
             return nullptr;
         }
 
+        std::vector<op::Input*> symbolicInputs;
+        for (auto input : optimizer.GetInputs()) {
+            if (input->HasSymbolicBatch()) {
+                symbolicInputs.push_back(input);
+            }
+        }
+        if (!symbolicInputs.empty()) {
+            std::unique_ptr<SymbolicBatchGraph> symbolicBatch(new SymbolicBatchGraph());
+            symbolicBatch->builder = this;
+            for (auto& op : sorted_operands) {
+                symbolicBatch->sortedOperators.push_back(const_cast<OperatorBase*>(op));
+            }
+            for (auto& namedOutput : optimizer.GetOutputs()) {
+                symbolicBatch->outputs[namedOutput.first] =
+                    const_cast<OperandBase*>(namedOutput.second);
+            }
+            for (auto input : symbolicInputs) {
+                symbolicBatch->inputShapes[input->GetName()] = input->PrimaryOutput()->Shape();
+            }
+            symbolicBatch->inputs = std::move(symbolicInputs);
+            // The graph is built again after the caller may have released the constants.
+            for (auto constant : optimizer.GetConstants()) {
+                constant->RetainBuffer();
+            }
+            graph->SetSymbolicBatch(std::move(symbolicBatch));
+        }
+
         return graph.Detach();
     }
 
+    bool GraphBuilderBase::APISerialize(NamedOperandsBase const* namedOperands, char const* path) {
+        if (DAWN_UNLIKELY(this->IsError())) {
+            dawn::ErrorLog() << "This Graph object is an error";
+            return false;
+        }
+
+        if (namedOperands->GetRecords().empty()) {
+            dawn::ErrorLog() << "The output named operands are empty.";
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        // The operators are written as they were built, and optimized again once they are read.
+        std::vector<const OperandBase*> outputs;
+        for (auto& namedOutput : namedOperands->GetRecords()) {
+            outputs.push_back(namedOutput.second);
+        }
+        Ref<GraphSerializer> serializer = AcquireRef(new GraphSerializer(GetContext()));
+        for (auto& op : TopologicalSort(outputs)) {
+            if (op->IsError() || GetContext()->ConsumedError(op->AddToGraph(serializer.Get()))) {
+                dawn::ErrorLog() << "Failed to serialize the operand.";
+                return false;
+            }
+        }
+        for (auto& namedOutput : namedOperands->GetRecords()) {
+            IgnoreErrors(serializer->AddOutput(namedOutput.first, namedOutput.second));
+        }
+        if (GetContext()->ConsumedError(serializer->WriteToFile(path))) {
+            dawn::ErrorLog() << "Failed to write the serialized graph.";
+            return false;
+        }
+        return true;
+    }
+
+    NamedOperandsBase* GraphBuilderBase::APIDeserialize(char const* path) {
+        if (DAWN_UNLIKELY(this->IsError())) {
+            dawn::ErrorLog() << "This Graph object is an error";
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        Ref<NamedOperandsBase> namedOperands = AcquireRef(new NamedOperandsBase());
+        if (GetContext()->ConsumedError(DeserializeGraph(this, path, namedOperands.Get()))) {
+            dawn::ErrorLog() << "Failed to deserialize the graph.";
+            return nullptr;
+        }
+        return namedOperands.Detach();
+    }
+
+    MaybeError GraphBuilderBase::BuildForBatchSize(const SymbolicBatchGraph& symbolicBatch,
+                                                   int32_t batchSize,
+                                                   GraphBase* graph) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto inferOutputInfo = [&symbolicBatch](int32_t size) -> MaybeError {
+            for (auto input : symbolicBatch.inputs) {
+                input->SetBatchSize(size);
+            }
+            for (auto& op : symbolicBatch.sortedOperators) {
+                DAWN_TRY(op->ValidateAndInferOutputInfo());
+            }
+            return {};
+        };
+        MaybeError maybeError = [&]() -> MaybeError {
+            DAWN_TRY(inferOutputInfo(batchSize));
+            for (auto& op : symbolicBatch.sortedOperators) {
+                DAWN_TRY(op->AddToGraph(graph));
+            }
+            for (auto& namedOutput : symbolicBatch.outputs) {
+                DAWN_TRY(graph->AddOutput(namedOutput.first, namedOutput.second.Get()));
+            }
+            DAWN_TRY(graph->Finish());
+            return graph->Compile();
+        }();
+        // The operands go back to the shapes they were built with, which can't fail.
+        GetContext()->ConsumedError(inferOutputInfo(1));
+        return maybeError;
+    }
+
     // The implementation derives from nGraph topological_sort in
     // https://github.com/openvinotoolkit/openvino/blob/master/ngraph/core/include/ngraph/graph_util.hpp
     //
@@ -388,32 +558,54 @@ namespace webnn_native {
     // See the License for the specific language governing permissions and
     // limitations under the License.
     //*****************************************************************************
+    // The operators reached by a sort are numbered in the order they are found, so that their
+    // state lives in flat arrays indexed by that number. The visit is a depth-first one going
+    // through the roots and the inputs backwards, which gives the same order as the stack of
+    // operators to do it replaces.
     std::vector<const OperatorBase*> GraphBuilderBase::TopologicalSort(
         std::vector<const OperandBase*>& rootNodes) {
-        std::stack<const OperatorBase*> nodesToDo;
-        std::unordered_set<const OperatorBase*> nodesDone;
-        std::vector<const OperatorBase*> result;
+        static std::atomic<uint64_t> sLastEpoch(0);
+        const uint64_t epoch = ++sLastEpoch;
+        enum class State : uint8_t { kFound, kVisiting, kDone };
+        std::vector<const OperatorBase*> nodes;
+        std::vector<State> states;
+        auto indexOf = [&](const OperatorBase* node) -> uint32_t {
+            if (node->mSortEpoch != epoch) {
+                node->mSortEpoch = epoch;
+                node->mSortIndex = static_cast<uint32_t>(nodes.size());
+                nodes.push_back(node);
+                states.push_back(State::kFound);
+            }
+            return node->mSortIndex;
+        };
 
-        for (auto node : rootNodes) {
-            nodesToDo.push(const_cast<OperandBase*>(node)->Operator());
-        }
-        while (nodesToDo.size() > 0) {
-            const OperatorBase* node = nodesToDo.top();
-            if (nodesDone.count(node) == 0) {
-                bool can_add = true;
-                for (auto& dep : node->Inputs()) {
-                    if (nodesDone.count(dep->Operator()) == 0) {
-                        can_add = false;
-                        nodesToDo.push(dep->Operator());
-                    }
-                }
-                if (can_add) {
+        std::vector<const OperatorBase*> result;
+        // The operators being visited with the number of their inputs left to visit.
+        std::vector<std::pair<uint32_t, size_t>> stack;
+        for (auto root = rootNodes.rbegin(); root != rootNodes.rend(); ++root) {
+            const uint32_t rootIndex = indexOf((*root)->Operator());
+            if (states[rootIndex] != State::kFound) {
+                continue;
+            }
+            states[rootIndex] = State::kVisiting;
+            stack.emplace_back(rootIndex, nodes[rootIndex]->Inputs().size());
+            while (!stack.empty()) {
+                const uint32_t index = stack.back().first;
+                const OperatorBase* node = nodes[index];
+                size_t& inputsLeft = stack.back().second;
+                if (inputsLeft == 0) {
+                    states[index] = State::kDone;
                     result.push_back(node);
-                    nodesToDo.pop();
-                    nodesDone.insert(node);
+                    stack.pop_back();
+                    continue;
+                }
+                const uint32_t inputIndex = indexOf(node->Inputs()[--inputsLeft]->Operator());
+                // The graph is acyclic, so an input is never one of the operators being visited.
+                DAWN_ASSERT(states[inputIndex] != State::kVisiting);
+                if (states[inputIndex] == State::kFound) {
+                    states[inputIndex] = State::kVisiting;
+                    stack.emplace_back(inputIndex, nodes[inputIndex]->Inputs().size());
                 }
-            } else {
-                nodesToDo.pop();
             }
         }
         return result;
@@ -16,16 +16,21 @@
 #define WEBNN_NATIVE_MODEL_BUILDER_H_
 
 #include "common/RefCounted.h"
+#include "webnn_native/Arena.h"
+#include "webnn_native/Error.h"
 #include "webnn_native/Forward.h"
 #include "webnn_native/NamedOperands.h"
 #include "webnn_native/ObjectBase.h"
 #include "webnn_native/webnn_platform.h"
 
 #include <functional>
+#include <mutex>
 #include <vector>
 
 namespace webnn_native {
 
+    struct SymbolicBatchGraph;
+
     class GraphBuilderBase : public ObjectBase {
       public:
         GraphBuilderBase(ContextBase* context);
@@ -46,6 +51,10 @@ namespace webnn_native {
         OperandBase* APIConstant(OperandDescriptor const* desc, ArrayBufferView const* arrayBuffer);
         OperandBase* APIConv2d(OperandBase*, OperandBase*, Conv2dOptions const* options);
         OperandBase* APICos(OperandBase*);
+        OperandBase* APIDequantizeLinear(OperandBase*,
+                                         OperandBase*,
+                                         OperandBase*,
+                                         QuantizeLinearOptions const* options);
         OperandBase* APIDiv(OperandBase*, OperandBase*);
         OperandBase* APIExp(OperandBase*);
         OperandBase* APIFloor(OperandBase*);
@@ -72,6 +81,10 @@ namespace webnn_native {
         OperandBase* APINeg(OperandBase*);
         OperandBase* APIPad(OperandBase*, OperandBase*, PadOptions const* options);
         OperandBase* APIPow(OperandBase*, OperandBase*);
+        OperandBase* APIQuantizeLinear(OperandBase*,
+                                       OperandBase*,
+                                       OperandBase*,
+                                       QuantizeLinearOptions const* options);
         OperandBase* APIReduceL1(OperandBase*, ReduceOptions const* options);
         OperandBase* APIReduceL2(OperandBase*, ReduceOptions const* options);
         OperandBase* APIReduceMax(OperandBase*, ReduceOptions const* options);
@@ -105,15 +118,34 @@ namespace webnn_native {
         OperandBase* APITranspose(OperandBase*, TransposeOptions const* options);
 
         GraphBase* APIBuild(NamedOperandsBase const* namedOperands);
+        bool APISerialize(NamedOperandsBase const* namedOperands, char const* path);
+        NamedOperandsBase* APIDeserialize(char const* path);
 
         static GraphBuilderBase* Create(ContextBase* context) {
             return new GraphBuilderBase(context);
         }
 
-      private:
+        // The operators and the operands created by the builder are allocated from its arena.
+        Arena* GetArena() const {
+            return mArena.Get();
+        }
+
         // Topological sort of nodes needed to compute rootNodes
-        std::vector<const OperatorBase*> TopologicalSort(
+        static std::vector<const OperatorBase*> TopologicalSort(
             std::vector<const OperandBase*>& rootNodes);
+
+        // Builds the operators of |symbolicBatch| into |graph| with the symbolic batch of the
+        // inputs bound to |batchSize|.
+        MaybeError BuildForBatchSize(const SymbolicBatchGraph& symbolicBatch,
+                                     int32_t batchSize,
+                                     GraphBase* graph);
+
+      private:
+        // Building a graph for another batch size infers the shapes of the operands again, which
+        // may happen on the thread of a compute, so the operators are only created and built
+        // under the lock.
+        std::mutex mMutex;
+        Ref<Arena> mArena;
     };
 
 }  // namespace webnn_native
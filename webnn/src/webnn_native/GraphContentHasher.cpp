@@ -0,0 +1,325 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/GraphContentHasher.h"
+
+#include <cstring>
+#include <vector>
+
+#include "webnn_native/FusionOperator.h"
+#include "webnn_native/OperatorArray.h"
+#include "webnn_native/ops/BatchNorm.h"
+#include "webnn_native/ops/Binary.h"
+#include "webnn_native/ops/Clamp.h"
+#include "webnn_native/ops/Concat.h"
+#include "webnn_native/ops/Constant.h"
+#include "webnn_native/ops/Conv2d.h"
+#include "webnn_native/ops/Gemm.h"
+#include "webnn_native/ops/Gru.h"
+#include "webnn_native/ops/Input.h"
+#include "webnn_native/ops/InstanceNorm.h"
+#include "webnn_native/ops/LeakyRelu.h"
+#include "webnn_native/ops/Pad.h"
+#include "webnn_native/ops/Pool2d.h"
+#include "webnn_native/ops/Quantize.h"
+#include "webnn_native/ops/Reduce.h"
+#include "webnn_native/ops/Resample2d.h"
+#include "webnn_native/ops/Reshape.h"
+#include "webnn_native/ops/Slice.h"
+#include "webnn_native/ops/Split.h"
+#include "webnn_native/ops/Squeeze.h"
+#include "webnn_native/ops/Transpose.h"
+#include "webnn_native/ops/Unary.h"
+
+namespace webnn_native {
+
+    namespace {
+        std::vector<int32_t> ToVector(int32_t const* values, uint32_t count) {
+            return values == nullptr ? std::vector<int32_t>() :
+                                       std::vector<int32_t>(values, values + count);
+        }
+    }  // anonymous namespace
+
+    GraphContentHasher::GraphContentHasher(ContextBase* context) : GraphBase(context) {
+    }
+
+    // MurmurHash64A by Austin Appleby, which is in the public domain.
+    uint64_t GraphContentHasher::HashBytes(const void* data, size_t byteLength) {
+        const uint64_t m = 0xc6a4a7935bd1e995ull;
+        const int r = 47;
+        uint64_t hash = 0x8445d61a4e774912ull ^ (byteLength * m);
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        const uint8_t* end = bytes + (byteLength & ~size_t(7));
+        for (; bytes != end; bytes += 8) {
+            uint64_t k;
+            memcpy(&k, bytes, sizeof(k));
+            k *= m;
+            k ^= k >> r;
+            k *= m;
+            hash ^= k;
+            hash *= m;
+        }
+        size_t remaining = byteLength & 7;
+        if (remaining != 0) {
+            uint64_t k = 0;
+            memcpy(&k, bytes, remaining);
+            hash ^= k;
+            hash *= m;
+        }
+
+        hash ^= hash >> r;
+        hash *= m;
+        hash ^= hash >> r;
+        return hash;
+    }
+
+    size_t GraphContentHasher::GetContentHash() const {
+        return mRecorder.GetContentHash();
+    }
+
+    void GraphContentHasher::RecordOperand(const OperandBase* operand) {
+        // The operands are produced before they are used in topological order.
+        DAWN_ASSERT(mOperandIds.find(operand) != mOperandIds.end());
+        mRecorder.Record(mOperandIds.at(operand));
+    }
+
+    void GraphContentHasher::RecordOperator(const char* name, const OperatorBase* op) {
+        RecordString(name);
+        mRecorder.Record(op->Inputs().size(), op->Outputs().size());
+        for (auto& input : op->Inputs()) {
+            RecordOperand(input.Get());
+        }
+        for (auto output : op->Outputs()) {
+            size_t id = mOperandIds.size();
+            mOperandIds[output] = id;
+            mRecorder.Record(output->Type());
+            RecordVector(output->Shape());
+        }
+    }
+
+    void GraphContentHasher::RecordString(const std::string& value) {
+        mRecorder.Record(value.size());
+        mRecorder.Record(value);
+    }
+
+    void GraphContentHasher::RecordActivation(const FusionOperatorBase* activation) {
+        if (activation == nullptr) {
+            mRecorder.Record(false);
+            return;
+        }
+        mRecorder.Record(true, activation->GetFusionType());
+        switch (activation->GetFusionType()) {
+            case FusionType::Clamp: {
+                auto clamp = static_cast<const op::FusionClamp*>(activation);
+                mRecorder.Record(clamp->GetMinValue(), clamp->GetMaxValue());
+                break;
+            }
+            case FusionType::LeakyRelu:
+                mRecorder.Record(static_cast<const op::FusionLeakyRelu*>(activation)->GetAlpha());
+                break;
+            default:
+                break;
+        }
+    }
+
+    MaybeError GraphContentHasher::AddConstant(const op::Constant* constant) {
+        RecordOperator("constant", constant);
+        mRecorder.Record(constant->GetByteLength(),
+                         HashBytes(constant->GetBuffer(), constant->GetByteLength()));
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddInput(const op::Input* input) {
+        RecordOperator("input", input);
+        RecordString(input->GetName());
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddOutput(const std::string& name, const OperandBase* output) {
+        RecordString("output");
+        RecordString(name);
+        RecordOperand(output);
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddBatchNorm(const op::BatchNorm* batchNorm) {
+        RecordOperator("batchNorm", batchNorm);
+        auto options = batchNorm->GetOptions();
+        mRecorder.Record(options->scale != nullptr, options->bias != nullptr, options->axis,
+                         options->epsilon);
+        RecordActivation(options->activation);
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddBinary(const op::Binary* binary) {
+        RecordOperator("binary", binary);
+        mRecorder.Record(binary->GetType());
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddConv2d(const op::Conv2d* conv2d) {
+        RecordOperator("conv2d", conv2d);
+        auto options = conv2d->GetOptions();
+        RecordVector(ToVector(options->padding, options->paddingCount));
+        RecordVector(ToVector(options->strides, options->stridesCount));
+        RecordVector(ToVector(options->dilations, options->dilationsCount));
+        RecordVector(ToVector(options->outputPadding, options->outputPaddingCount));
+        RecordVector(ToVector(options->outputSizes, options->outputSizesCount));
+        mRecorder.Record(options->autoPad, options->transpose, options->groups,
+                         options->inputLayout, options->filterLayout, options->bias != nullptr);
+        RecordActivation(options->activation);
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddGru(const op::Gru* gru) {
+        RecordOperator("gru", gru);
+        auto options = gru->GetOptions();
+        mRecorder.Record(gru->GetSteps(), gru->GetHiddenSize(), options->bias != nullptr,
+                         options->recurrentBias != nullptr,
+                         options->initialHiddenState != nullptr, options->resetAfter,
+                         options->returnSequence, options->stateful, options->direction,
+                         options->layout);
+        Ref<OperatorArrayBase> activations = gru->GetActivations();
+        mRecorder.Record(activations->APISize());
+        for (size_t i = 0; i < activations->APISize(); ++i) {
+            RecordActivation(activations->APIGetOperator(i));
+        }
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddPad(const op::Pad* pad) {
+        RecordOperator("pad", pad);
+        mRecorder.Record(pad->GetOptions()->mode, pad->GetOptions()->value);
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddPool2d(const op::Pool2d* pool2d) {
+        RecordOperator("pool2d", pool2d);
+        auto options = pool2d->GetOptions();
+        mRecorder.Record(pool2d->GetType(), options->autoPad, options->layout);
+        RecordVector(ToVector(options->windowDimensions, options->windowDimensionsCount));
+        RecordVector(ToVector(options->padding, options->paddingCount));
+        RecordVector(ToVector(options->strides, options->stridesCount));
+        RecordVector(ToVector(options->dilations, options->dilationsCount));
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddReduce(const op::Reduce* reduce) {
+        RecordOperator("reduce", reduce);
+        auto options = reduce->GetOptions();
+        mRecorder.Record(reduce->GetType(), options->keepDimensions);
+        RecordVector(ToVector(options->axes, options->axesCount));
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddResample2d(const op::Resample2d* resample2d) {
+        // The sizes are recorded through the shape of the output.
+        RecordOperator("resample2d", resample2d);
+        mRecorder.Record(resample2d->GetOptions()->mode);
+        RecordVector(resample2d->GetScales());
+        RecordVector(resample2d->GetAxes());
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddReshape(const op::Reshape* reshape) {
+        RecordOperator("reshape", reshape);
+        RecordVector(reshape->GetNewShape());
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddSqueeze(const op::Squeeze* squeeze) {
+        RecordOperator("squeeze", squeeze);
+        RecordVector(squeeze->GetAxes());
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddSlice(const op::Slice* slice) {
+        RecordOperator("slice", slice);
+        RecordVector(slice->GetStarts());
+        RecordVector(slice->GetSizes());
+        RecordVector(slice->GetAxes());
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddSplit(const op::Split* split) {
+        RecordOperator("split", split);
+        mRecorder.Record(split->GetAxis());
+        RecordVector(split->GetSplits());
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddTranspose(const op::Transpose* transpose) {
+        RecordOperator("transpose", transpose);
+        RecordVector(transpose->GetPermutation());
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddUnary(const op::Unary* unary) {
+        RecordOperator("unary", unary);
+        mRecorder.Record(unary->GetType());
+        if (unary->GetType() == op::UnaryOpType::kLeakyRelu) {
+            mRecorder.Record(static_cast<const op::LeakyRelu*>(unary)->GetAlpha());
+        }
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddConcat(const op::Concat* concat) {
+        RecordOperator("concat", concat);
+        mRecorder.Record(concat->GetAxis());
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddGemm(const op::Gemm* gemm) {
+        // The optional c operand is told apart by the number of inputs.
+        RecordOperator("gemm", gemm);
+        auto options = gemm->GetOptions();
+        mRecorder.Record(options->alpha, options->beta, options->aTranspose, options->bTranspose);
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddClamp(const op::Clamp* clamp) {
+        RecordOperator("clamp", clamp);
+        mRecorder.Record(clamp->GetMinValue(), clamp->GetMaxValue());
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddInstanceNorm(const op::InstanceNorm* instanceNorm) {
+        RecordOperator("instanceNorm", instanceNorm);
+        auto options = instanceNorm->GetOptions();
+        mRecorder.Record(options->scale != nullptr, options->bias != nullptr, options->epsilon,
+                         options->layout);
+        return {};
+    }
+
+    MaybeError GraphContentHasher::AddQuantize(const op::Quantize* quantize) {
+        RecordOperator("quantize", quantize);
+        mRecorder.Record(quantize->GetType(), quantize->GetOptions()->axis);
+        return {};
+    }
+
+    MaybeError GraphContentHasher::Finish() {
+        return {};
+    }
+
+    MaybeError GraphContentHasher::CompileImpl() {
+        return DAWN_INTERNAL_ERROR("The content hasher can't be compiled.");
+    }
+
+    MLComputeGraphStatus GraphContentHasher::ComputeImpl(NamedInputsBase* inputs,
+                                                         NamedOutputsBase* outputs) {
+        return MLComputeGraphStatus_Error;
+    }
+
+}  // namespace webnn_native
@@ -0,0 +1,90 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_GRAPH_CONTENT_HASHER_H_
+#define WEBNN_NATIVE_GRAPH_CONTENT_HASHER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "dawn_native/ObjectContentHasher.h"
+#include "webnn_native/Graph.h"
+
+namespace webnn_native {
+
+    class FusionOperatorBase;
+
+    // Hashes the operators added to it, their options, the shapes and types of the operands and
+    // the bytes of the constants, so that two graphs built from the same calls get the same hash.
+    // The operands are recorded by the order they are produced in rather than by address.
+    class GraphContentHasher final : public GraphBase {
+      public:
+        explicit GraphContentHasher(ContextBase* context);
+        ~GraphContentHasher() override = default;
+
+        MaybeError AddConstant(const op::Constant* constant) override;
+        MaybeError AddInput(const op::Input* input) override;
+        MaybeError AddOutput(const std::string& name, const OperandBase* output) override;
+        MaybeError AddBatchNorm(const op::BatchNorm* batchNorm) override;
+        MaybeError AddBinary(const op::Binary* binary) override;
+        MaybeError AddConv2d(const op::Conv2d* conv2d) override;
+        MaybeError AddGru(const op::Gru* gru) override;
+        MaybeError AddPad(const op::Pad* pad) override;
+        MaybeError AddPool2d(const op::Pool2d* pool2d) override;
+        MaybeError AddReduce(const op::Reduce* reduce) override;
+        MaybeError AddResample2d(const op::Resample2d* resample2d) override;
+        MaybeError AddReshape(const op::Reshape* reshape) override;
+        MaybeError AddSqueeze(const op::Squeeze* squeeze) override;
+        MaybeError AddSlice(const op::Slice* slice) override;
+        MaybeError AddSplit(const op::Split* split) override;
+        MaybeError AddTranspose(const op::Transpose* transpose) override;
+        MaybeError AddUnary(const op::Unary* unary) override;
+        MaybeError AddConcat(const op::Concat* concat) override;
+        MaybeError AddGemm(const op::Gemm* gemm) override;
+        MaybeError AddClamp(const op::Clamp* clamp) override;
+        MaybeError AddInstanceNorm(const op::InstanceNorm* instanceNorm) override;
+        MaybeError AddQuantize(const op::Quantize* quantize) override;
+        MaybeError Finish() override;
+
+        size_t GetContentHash() const;
+
+        // A 64-bit hash of |byteLength| bytes, also used for the constants of the graph.
+        static uint64_t HashBytes(const void* data, size_t byteLength);
+
+      private:
+        MaybeError CompileImpl() override;
+        MLComputeGraphStatus ComputeImpl(NamedInputsBase* inputs,
+                                         NamedOutputsBase* outputs) override;
+
+        // Records the kind of the operator with its inputs and outputs.
+        void RecordOperator(const char* name, const OperatorBase* op);
+        void RecordOperand(const OperandBase* operand);
+        void RecordActivation(const FusionOperatorBase* activation);
+        // The lengths are recorded too, so that the neighbouring values can't be swapped
+        // between two sequences with the same hash.
+        void RecordString(const std::string& value);
+        template <typename T>
+        void RecordVector(const std::vector<T>& values) {
+            mRecorder.Record(values.size());
+            mRecorder.Record(values);
+        }
+
+        dawn_native::ObjectContentHasher mRecorder;
+        std::map<const OperandBase*, size_t> mOperandIds;
+    };
+
+}  // namespace webnn_native
+
+#endif  // WEBNN_NATIVE_GRAPH_CONTENT_HASHER_H_
@@ -0,0 +1,800 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/GraphOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <set>
+#include <utility>
+
+#include "common/Assert.h"
+#include "common/Log.h"
+#include "dawn_native/ErrorData.h"
+#include "webnn_native/Context.h"
+#include "webnn_native/FusionOperator.h"
+#include "webnn_native/Graph.h"
+#include "webnn_native/GraphBuilder.h"
+#include "webnn_native/ops/BatchNorm.h"
+#include "webnn_native/ops/Binary.h"
+#include "webnn_native/ops/Clamp.h"
+#include "webnn_native/ops/Constant.h"
+#include "webnn_native/ops/Conv2d.h"
+#include "webnn_native/ops/Input.h"
+#include "webnn_native/ops/LeakyRelu.h"
+#include "webnn_native/ops/Reshape.h"
+#include "webnn_native/ops/Squeeze.h"
+#include "webnn_native/ops/Transpose.h"
+#include "webnn_native/ops/Unary.h"
+
+namespace webnn_native {
+
+    namespace {
+        size_t GetElementCount(const std::vector<int32_t>& shape) {
+            size_t count = 1;
+            for (auto dimension : shape) {
+                count *= dimension;
+            }
+            return count;
+        }
+
+        // The strides of |shape| in the elements of |outputShape| it is broadcast to, which are
+        // zero along the broadcast dimensions.
+        std::vector<size_t> GetBroadcastStrides(const std::vector<int32_t>& shape,
+                                                const std::vector<int32_t>& outputShape) {
+            DAWN_ASSERT(shape.size() <= outputShape.size());
+            std::vector<size_t> strides(outputShape.size(), 0);
+            size_t stride = 1;
+            for (size_t i = 1; i <= shape.size(); ++i) {
+                int32_t dimension = shape[shape.size() - i];
+                strides[outputShape.size() - i] = dimension == 1 ? 0 : stride;
+                stride *= dimension;
+            }
+            return strides;
+        }
+
+        // Steps |index| to the next element of a tensor of |shape| in row-major order.
+        void NextIndex(std::vector<int32_t>& index, const std::vector<int32_t>& shape) {
+            for (size_t i = shape.size(); i > 0; --i) {
+                if (++index[i - 1] < shape[i - 1]) {
+                    return;
+                }
+                index[i - 1] = 0;
+            }
+        }
+
+        size_t GetOffset(const std::vector<int32_t>& index, const std::vector<size_t>& strides) {
+            size_t offset = 0;
+            for (size_t i = 0; i < index.size(); ++i) {
+                offset += index[i] * strides[i];
+            }
+            return offset;
+        }
+
+        const op::Constant* GetConstant(const OperandBase* operand) {
+            return static_cast<const op::Constant*>(operand->Operator());
+        }
+
+        // The user buffers of the constants aren't necessarily aligned to floats.
+        std::vector<float> GetFloat32Values(const OperandBase* operand) {
+            const op::Constant* constant = GetConstant(operand);
+            std::vector<float> values(constant->GetByteLength() / sizeof(float));
+            memcpy(values.data(), constant->GetBuffer(), values.size() * sizeof(float));
+            return values;
+        }
+
+        std::vector<int8_t> ToBytes(const std::vector<float>& values) {
+            std::vector<int8_t> bytes(values.size() * sizeof(float));
+            memcpy(bytes.data(), values.data(), bytes.size());
+            return bytes;
+        }
+
+        bool IsIdentity(const std::vector<int32_t>& permutation) {
+            for (size_t i = 0; i < permutation.size(); ++i) {
+                if (permutation[i] != static_cast<int32_t>(i)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }  // anonymous namespace
+
+    // Finds the type of the operators through the hooks the backends use to add them.
+    class GraphOptimizer::TypeCollector final : public GraphBase {
+      public:
+        explicit TypeCollector(ContextBase* context) : GraphBase(context) {
+        }
+
+        OperatorType GetType(const OperatorBase* op) {
+            mType = OperatorType::Other;
+            if (!op->IsError()) {
+                IgnoreErrors(op->AddToGraph(this));
+            }
+            return mType;
+        }
+
+        MaybeError AddConstant(const op::Constant*) override {
+            return Record(OperatorType::Constant);
+        }
+        MaybeError AddInput(const op::Input*) override {
+            return Record(OperatorType::Input);
+        }
+        MaybeError AddBatchNorm(const op::BatchNorm*) override {
+            return Record(OperatorType::BatchNorm);
+        }
+        MaybeError AddBinary(const op::Binary*) override {
+            return Record(OperatorType::Binary);
+        }
+        MaybeError AddClamp(const op::Clamp*) override {
+            return Record(OperatorType::Clamp);
+        }
+        MaybeError AddConv2d(const op::Conv2d*) override {
+            return Record(OperatorType::Conv2d);
+        }
+        MaybeError AddReshape(const op::Reshape*) override {
+            return Record(OperatorType::Reshape);
+        }
+        MaybeError AddSqueeze(const op::Squeeze*) override {
+            return Record(OperatorType::Squeeze);
+        }
+        MaybeError AddTranspose(const op::Transpose*) override {
+            return Record(OperatorType::Transpose);
+        }
+        MaybeError AddUnary(const op::Unary*) override {
+            return Record(OperatorType::Unary);
+        }
+        MaybeError AddGru(const op::Gru*) override {
+            return Record(OperatorType::Other);
+        }
+        MaybeError AddPad(const op::Pad*) override {
+            return Record(OperatorType::Other);
+        }
+        MaybeError AddPool2d(const op::Pool2d*) override {
+            return Record(OperatorType::Other);
+        }
+        MaybeError AddReduce(const op::Reduce*) override {
+            return Record(OperatorType::Other);
+        }
+        MaybeError AddResample2d(const op::Resample2d*) override {
+            return Record(OperatorType::Other);
+        }
+        MaybeError AddSlice(const op::Slice*) override {
+            return Record(OperatorType::Other);
+        }
+        MaybeError AddSplit(const op::Split*) override {
+            return Record(OperatorType::Other);
+        }
+        MaybeError AddLeakyRelu(const op::LeakyRelu*) override {
+            return Record(OperatorType::Other);
+        }
+        MaybeError AddConcat(const op::Concat*) override {
+            return Record(OperatorType::Other);
+        }
+        MaybeError AddGemm(const op::Gemm*) override {
+            return Record(OperatorType::Other);
+        }
+        MaybeError AddInstanceNorm(const op::InstanceNorm*) override {
+            return Record(OperatorType::Other);
+        }
+        MaybeError AddQuantize(const op::Quantize*) override {
+            return Record(OperatorType::Other);
+        }
+
+      private:
+        MaybeError Record(OperatorType type) {
+            mType = type;
+            return {};
+        }
+        MaybeError CompileImpl() override {
+            return DAWN_INTERNAL_ERROR("The type collector can't be compiled.");
+        }
+        MLComputeGraphStatus ComputeImpl(NamedInputsBase*, NamedOutputsBase*) override {
+            return MLComputeGraphStatus_Error;
+        }
+
+        OperatorType mType = OperatorType::Other;
+    };
+
+    GraphOptimizer::GraphOptimizer(GraphBuilderBase* builder,
+                                   NamedOperandsBase const* namedOperands,
+                                   const GraphBase* graph)
+        : mBuilder(builder), mGraph(graph), mFuseOperators(graph->SupportsFusedOperators()) {
+        for (auto& namedOutput : namedOperands->GetRecords()) {
+            mOutputs[namedOutput.first] = namedOutput.second;
+        }
+    }
+
+    void GraphOptimizer::Run() {
+        // The passes that fold operators into others run first, so that the activations are
+        // fused into the result.
+        const Pass passes[] = {&GraphOptimizer::FoldConstants,
+                               &GraphOptimizer::CancelLayoutOperators,
+                               &GraphOptimizer::FoldBatchNormIntoConv2d,
+                               &GraphOptimizer::FuseActivation};
+        Analyze();
+        mOperatorCount = mSortedOperators.size();
+        // A sweep tries the passes on every operator of the graph as it was analyzed, and the
+        // graph is only analyzed again once the rewrites of the sweep are applied. Each applied
+        // rewrite removes an operator other than a constant, and the sweeps stop when none of
+        // them could be applied, but they are capped in case a pass undoes another.
+        constexpr size_t kMaxSweepCount = 16;
+        size_t sweepCount = 0;
+        while (sweepCount < kMaxSweepCount) {
+            for (auto op : mSortedOperators) {
+                // An operator reading an operand replaced in this sweep is rewritten in the next
+                // one, once it reads the replacement.
+                bool readsReplacedOperand = false;
+                for (auto& input : op->Inputs()) {
+                    readsReplacedOperand |= mReplacements.find(input.Get()) != mReplacements.end();
+                }
+                if (readsReplacedOperand) {
+                    continue;
+                }
+                for (auto pass : passes) {
+                    if ((this->*pass)(op)) {
+                        break;
+                    }
+                }
+            }
+            if (mReplacements.empty()) {
+                break;
+            }
+            const size_t rewriteCount = ApplyReplacements();
+            Analyze();
+            ++sweepCount;
+            if (rewriteCount == 0) {
+                break;
+            }
+            mRewriteCount += rewriteCount;
+        }
+        if (mRewriteCount != 0) {
+            dawn::DebugLog() << "The graph optimizer made " << mRewriteCount << " rewrites in "
+                             << sweepCount << " sweeps, which took the graph from "
+                             << mOperatorCount << " to " << mSortedOperators.size()
+                             << " operators.";
+        }
+    }
+
+    GraphOptimizationStats GraphOptimizer::GetStats() const {
+        GraphOptimizationStats stats;
+        stats.operatorCount = mOperatorCount;
+        stats.optimizedOperatorCount = mSortedOperators.size();
+        stats.rewriteCount = mRewriteCount;
+        return stats;
+    }
+
+    // The passes only read the operators, but the builder that owns them may change them.
+    std::vector<op::Input*> GraphOptimizer::GetInputs() const {
+        std::vector<op::Input*> inputs;
+        for (auto op : mSortedOperators) {
+            if (mOperatorTypes.at(op) == OperatorType::Input) {
+                inputs.push_back(static_cast<op::Input*>(const_cast<OperatorBase*>(op)));
+            }
+        }
+        return inputs;
+    }
+
+    std::vector<op::Constant*> GraphOptimizer::GetConstants() const {
+        std::vector<op::Constant*> constants;
+        for (auto op : mSortedOperators) {
+            if (mOperatorTypes.at(op) == OperatorType::Constant) {
+                constants.push_back(static_cast<op::Constant*>(const_cast<OperatorBase*>(op)));
+            }
+        }
+        return constants;
+    }
+
+    void GraphOptimizer::Analyze() {
+        std::vector<const OperandBase*> outputs;
+        for (auto& output : mOutputs) {
+            outputs.push_back(output.second);
+        }
+        mSortedOperators = GraphBuilderBase::TopologicalSort(outputs);
+
+        mOperatorTypes.clear();
+        mConsumers.clear();
+        mSymbolicBatchOperators.clear();
+        Ref<TypeCollector> collector = AcquireRef(new TypeCollector(mBuilder->GetContext()));
+        for (auto op : mSortedOperators) {
+            OperatorType type = collector->GetType(op);
+            mOperatorTypes[op] = type;
+            bool symbolicBatch = type == OperatorType::Input &&
+                                 static_cast<const op::Input*>(op)->HasSymbolicBatch();
+            for (auto& input : op->Inputs()) {
+                mConsumers[input.Get()].push_back(op);
+                symbolicBatch |= HasSymbolicBatch(input.Get());
+            }
+            if (symbolicBatch) {
+                mSymbolicBatchOperators.insert(op);
+            }
+        }
+    }
+
+    size_t GraphOptimizer::ApplyReplacements() {
+        // Sorts the operators the outputs need once the replaced operands are read through their
+        // replacements, which the operators built by the passes may need as well.
+        std::vector<const OperatorBase*> sorted;
+        std::set<const OperatorBase*> visited;
+        std::vector<std::pair<const OperatorBase*, size_t>> stack;
+        for (auto& output : mOutputs) {
+            const OperatorBase* root = Resolve(output.second)->Operator();
+            if (!visited.insert(root).second) {
+                continue;
+            }
+            stack.push_back({root, 0});
+            while (!stack.empty()) {
+                const OperatorBase* op = stack.back().first;
+                const size_t index = stack.back().second++;
+                if (index == op->Inputs().size()) {
+                    sorted.push_back(op);
+                    stack.pop_back();
+                    continue;
+                }
+                const OperatorBase* producer = Resolve(op->Inputs()[index].Get())->Operator();
+                if (visited.insert(producer).second) {
+                    stack.push_back({producer, 0});
+                }
+            }
+        }
+
+        // The rewrites of the passes, which are only applied once an operator or an output reads
+        // their replacement.
+        std::set<const OperandBase*> rewrites;
+        for (auto& replacement : mReplacements) {
+            rewrites.insert(replacement.first);
+        }
+        std::set<const OperandBase*> applied;
+
+        // The consumers are cloned in that order, so the consumers of the clones are cloned too.
+        for (auto op : sorted) {
+            std::vector<Ref<OperandBase>> inputs;
+            bool replaced = false;
+            for (auto& input : op->Inputs()) {
+                auto replacement = mReplacements.find(input.Get());
+                replaced |= replacement != mReplacements.end();
+                inputs.push_back(replacement != mReplacements.end() ? replacement->second
+                                                                      : input.Get());
+            }
+            if (!replaced) {
+                continue;
+            }
+            // The operator keeps reading the replaced operands if it can't be cloned, which
+            // compute the same values.
+            OperatorBase* clone = op->Clone(mBuilder, inputs);
+            if (clone == nullptr || AddOperator(clone) == nullptr) {
+                continue;
+            }
+            for (auto& input : op->Inputs()) {
+                if (rewrites.find(input.Get()) != rewrites.end()) {
+                    applied.insert(input.Get());
+                }
+            }
+            for (size_t i = 0; i < op->Outputs().size(); ++i) {
+                mReplacements[op->Outputs()[i]] = clone->Outputs()[i];
+            }
+        }
+        for (auto& output : mOutputs) {
+            if (rewrites.find(output.second) != rewrites.end()) {
+                applied.insert(output.second);
+            }
+            output.second = Resolve(output.second);
+        }
+        mReplacements.clear();
+        return applied.size();
+    }
+
+    OperandBase* GraphOptimizer::Resolve(const OperandBase* operand) const {
+        auto replacement = mReplacements.find(operand);
+        return replacement != mReplacements.end() ? replacement->second
+                                                  : const_cast<OperandBase*>(operand);
+    }
+
+    GraphOptimizer::OperatorType GraphOptimizer::GetType(const OperandBase* operand) const {
+        auto type = mOperatorTypes.find(operand->Operator());
+        return type == mOperatorTypes.end() ? OperatorType::Other : type->second;
+    }
+
+    bool GraphOptimizer::HasSymbolicBatch(const OperandBase* operand) const {
+        return mSymbolicBatchOperators.find(operand->Operator()) != mSymbolicBatchOperators.end();
+    }
+
+    bool GraphOptimizer::IsOutput(const OperandBase* operand) const {
+        for (auto& output : mOutputs) {
+            if (output.second == operand) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool GraphOptimizer::HasSingleUse(const OperandBase* operand) const {
+        auto consumers = mConsumers.find(operand);
+        return consumers != mConsumers.end() && consumers->second.size() == 1 &&
+               !IsOutput(operand);
+    }
+
+    bool GraphOptimizer::IsFloat32Constant(const OperandBase* operand) const {
+        return GetType(operand) == OperatorType::Constant &&
+               operand->Type() == ml::OperandType::Float32;
+    }
+
+    OperandBase* GraphOptimizer::AddOperator(OperatorBase* op) {
+        Ref<OperatorBase> ref = AcquireRef(op);
+        // The outputs are created with a reference, which is taken over here.
+        for (auto output : op->Outputs()) {
+            mOperands.push_back(AcquireRef(output));
+        }
+        MaybeError maybeError = op->ValidateAndInferOutputInfo();
+        if (maybeError.IsError()) {
+            dawn::WarningLog() << "The graph optimizer built an invalid operator: "
+                               << maybeError.AcquireError()->GetMessage();
+            return nullptr;
+        }
+        return op->PrimaryOutput();
+    }
+
+    OperandBase* GraphOptimizer::AddConstant(ml::OperandType type,
+                                             const std::vector<int32_t>& shape,
+                                             std::vector<int8_t> buffer) {
+        OperandDescriptor desc;
+        desc.type = type;
+        desc.dimensions = shape.data();
+        desc.dimensionsCount = shape.size();
+        OperandBase* output = AddOperator(new op::Constant(mBuilder, &desc, std::move(buffer)));
+        if (output != nullptr) {
+            mOperatorTypes[output->Operator()] = OperatorType::Constant;
+        }
+        return output;
+    }
+
+    bool GraphOptimizer::Replace(const OperandBase* from, OperandBase* to) {
+        if (to == nullptr) {
+            return false;
+        }
+        // The operands upstream of the rewritten operator are replaced before it in a sweep, so
+        // a replaced one is never read instead of another.
+        if (mReplacements.find(to) != mReplacements.end()) {
+            return false;
+        }
+        // The backends expect the outputs to be computed by an operator of their own.
+        if (IsOutput(from)) {
+            OperatorType type = GetType(to);
+            if (IsOutput(to) || type == OperatorType::Constant || type == OperatorType::Input) {
+                return false;
+            }
+        }
+        mReplacements[from] = to;
+        return true;
+    }
+
+    // Computes the operators that only read constants into a constant.
+    bool GraphOptimizer::FoldConstants(const OperatorBase* op) {
+        const OperandBase* output = op->PrimaryOutput();
+        if (op->Inputs().empty() || op->Outputs().size() != 1 || IsOutput(output)) {
+            return false;
+        }
+        for (auto& input : op->Inputs()) {
+            if (GetType(input.Get()) != OperatorType::Constant) {
+                return false;
+            }
+        }
+        const OperandBase* input = op->Inputs()[0].Get();
+        const op::Constant* constant = GetConstant(input);
+        const int8_t* bytes = static_cast<const int8_t*>(constant->GetBuffer());
+        switch (mOperatorTypes.at(op)) {
+            case OperatorType::Reshape:
+            case OperatorType::Squeeze: {
+                std::vector<int8_t> buffer(bytes, bytes + constant->GetByteLength());
+                return Replace(output,
+                               AddConstant(output->Type(), output->Shape(), std::move(buffer)));
+            }
+            case OperatorType::Transpose: {
+                std::vector<int32_t> permutation =
+                    static_cast<const op::Transpose*>(op)->GetPermutation();
+                std::vector<int32_t> outputShape = output->Shape();
+                size_t count = GetElementCount(outputShape);
+                if (count == 0) {
+                    return false;
+                }
+                // The strides of the input along the dimensions of the output.
+                std::vector<size_t> inputStrides = GetBroadcastStrides(input->Shape(),
+                                                                       input->Shape());
+                std::vector<size_t> strides(permutation.size());
+                for (size_t i = 0; i < permutation.size(); ++i) {
+                    strides[i] = inputStrides[permutation[i]];
+                }
+                size_t elementSize = constant->GetByteLength() / count;
+                std::vector<int8_t> buffer(constant->GetByteLength());
+                std::vector<int32_t> index(outputShape.size(), 0);
+                for (size_t i = 0; i < count; ++i) {
+                    size_t offset = GetOffset(index, strides) * elementSize;
+                    memcpy(&buffer[i * elementSize], bytes + offset, elementSize);
+                    NextIndex(index, outputShape);
+                }
+                return Replace(output,
+                               AddConstant(output->Type(), outputShape, std::move(buffer)));
+            }
+            case OperatorType::Binary: {
+                auto binary = static_cast<const op::Binary*>(op);
+                const OperandBase* b = op->Inputs()[1].Get();
+                if (binary->GetType() == op::BinaryOpType::kMatMul || !IsFloat32Constant(input) ||
+                    !IsFloat32Constant(b)) {
+                    return false;
+                }
+                std::vector<int32_t> outputShape = output->Shape();
+                std::vector<size_t> aStrides = GetBroadcastStrides(input->Shape(), outputShape);
+                std::vector<size_t> bStrides = GetBroadcastStrides(b->Shape(), outputShape);
+                std::vector<float> aValues = GetFloat32Values(input);
+                std::vector<float> bValues = GetFloat32Values(b);
+                std::vector<float> values(GetElementCount(outputShape));
+                std::vector<int32_t> index(outputShape.size(), 0);
+                for (auto& value : values) {
+                    float x = aValues[GetOffset(index, aStrides)];
+                    float y = bValues[GetOffset(index, bStrides)];
+                    switch (binary->GetType()) {
+                        case op::BinaryOpType::kAdd:
+                            value = x + y;
+                            break;
+                        case op::BinaryOpType::kSub:
+                            value = x - y;
+                            break;
+                        case op::BinaryOpType::kMul:
+                            value = x * y;
+                            break;
+                        case op::BinaryOpType::kDiv:
+                            value = x / y;
+                            break;
+                        case op::BinaryOpType::kMax:
+                            value = std::max(x, y);
+                            break;
+                        case op::BinaryOpType::kMin:
+                            value = std::min(x, y);
+                            break;
+                        case op::BinaryOpType::kPower:
+                            value = std::pow(x, y);
+                            break;
+                        default:
+                            DAWN_UNREACHABLE();
+                    }
+                    NextIndex(index, outputShape);
+                }
+                return Replace(output, AddConstant(output->Type(), outputShape, ToBytes(values)));
+            }
+            default:
+                return false;
+        }
+    }
+
+    // Merges the transposes and the reshapes that follow each other and drops the ones that
+    // don't change their input.
+    bool GraphOptimizer::CancelLayoutOperators(const OperatorBase* op) {
+        OperatorType type = mOperatorTypes.at(op);
+        if (type != OperatorType::Transpose && type != OperatorType::Reshape &&
+            type != OperatorType::Squeeze) {
+            return false;
+        }
+        OperandBase* output = op->PrimaryOutput();
+        OperandBase* input = op->Inputs()[0].Get();
+        switch (type) {
+            case OperatorType::Transpose: {
+                std::vector<int32_t> permutation =
+                    static_cast<const op::Transpose*>(op)->GetPermutation();
+                OperandBase* source = input;
+                if (GetType(input) == OperatorType::Transpose) {
+                    std::vector<int32_t> first =
+                        static_cast<const op::Transpose*>(input->Operator())->GetPermutation();
+                    for (auto& axis : permutation) {
+                        axis = first[axis];
+                    }
+                    source = input->Operator()->Inputs()[0].Get();
+                }
+                if (IsIdentity(permutation)) {
+                    return Replace(output, source);
+                }
+                if (source == input || !HasSingleUse(input)) {
+                    return false;
+                }
+                TransposeOptions options;
+                options.permutation = permutation.data();
+                options.permutationCount = permutation.size();
+                return Replace(output, AddOperator(new op::Transpose(mBuilder, source, &options)));
+            }
+            case OperatorType::Reshape:
+            case OperatorType::Squeeze: {
+                OperandBase* source = input;
+                OperatorType inputType = GetType(input);
+                if (inputType == OperatorType::Reshape || inputType == OperatorType::Squeeze) {
+                    source = input->Operator()->Inputs()[0].Get();
+                }
+                // The shapes fed by a symbolic batch are inferred with a batch size of 1, so only
+                // the new shape of the last reshape, which may hold -1, fits every batch size.
+                if (HasSymbolicBatch(output)) {
+                    if (type != OperatorType::Reshape || source == input || !HasSingleUse(input)) {
+                        return false;
+                    }
+                    std::vector<int32_t> newShape =
+                        static_cast<const op::Reshape*>(op)->GetNewShape();
+                    return Replace(output, AddOperator(new op::Reshape(mBuilder, source,
+                                                                       newShape.data(),
+                                                                       newShape.size())));
+                }
+                std::vector<int32_t> newShape = output->Shape();
+                if (source->Shape() == newShape) {
+                    return Replace(output, source);
+                }
+                if (source == input || !HasSingleUse(input)) {
+                    return false;
+                }
+                return Replace(output, AddOperator(new op::Reshape(mBuilder, source,
+                                                                   newShape.data(),
+                                                                   newShape.size())));
+            }
+            default:
+                return false;
+        }
+    }
+
+    // Scales the filter of a convolution and computes its bias from the batchNorm after it.
+    bool GraphOptimizer::FoldBatchNormIntoConv2d(const OperatorBase* op) {
+        if (!mFuseOperators || mOperatorTypes.at(op) != OperatorType::BatchNorm) {
+            return false;
+        }
+        const OperandBase* input = op->Inputs()[0].Get();
+        if (GetType(input) != OperatorType::Conv2d || !HasSingleUse(input)) {
+            return false;
+        }
+        auto conv2d = static_cast<const op::Conv2d*>(input->Operator());
+        Conv2dOptions const* conv2dOptions = conv2d->GetOptions();
+        BatchNormOptions const* options = static_cast<const op::BatchNorm*>(op)->GetOptions();
+        const uint32_t channelAxis =
+            conv2dOptions->inputLayout == ml::InputOperandLayout::Nchw ? 1 : 3;
+        if (conv2dOptions->transpose || conv2dOptions->activation != nullptr ||
+            options->axis != channelAxis || input->Type() != ml::OperandType::Float32) {
+            return false;
+        }
+        const size_t channels = input->Shape()[channelAxis];
+        for (size_t i = 1; i < op->Inputs().size(); ++i) {
+            const OperandBase* operand = op->Inputs()[i].Get();
+            if (!IsFloat32Constant(operand) || GetElementCount(operand->Shape()) != channels) {
+                return false;
+            }
+        }
+        const OperandBase* filter = conv2d->Inputs()[1].Get();
+        if (!IsFloat32Constant(filter)) {
+            return false;
+        }
+        const bool hasBias = conv2d->Inputs().size() > 2;
+        if (hasBias && (!IsFloat32Constant(conv2d->Inputs()[2].Get()) ||
+                        GetElementCount(conv2d->Inputs()[2]->Shape()) != channels)) {
+            return false;
+        }
+        // The output channels are the outermost dimension of the filter or the innermost one.
+        std::vector<int32_t> filterShape = filter->Shape();
+        const bool outputChannelsFirst =
+            conv2dOptions->filterLayout == ml::FilterOperandLayout::Oihw ||
+            conv2dOptions->filterLayout == ml::FilterOperandLayout::Ohwi;
+        if (filterShape[outputChannelsFirst ? 0 : 3] != static_cast<int32_t>(channels)) {
+            return false;
+        }
+
+        std::vector<float> mean = GetFloat32Values(op->Inputs()[1].Get());
+        std::vector<float> variance = GetFloat32Values(op->Inputs()[2].Get());
+        size_t index = 3;
+        std::vector<float> scale = options->scale != nullptr
+                                       ? GetFloat32Values(op->Inputs()[index++].Get())
+                                       : std::vector<float>(channels, 1);
+        std::vector<float> bias = options->bias != nullptr
+                                      ? GetFloat32Values(op->Inputs()[index++].Get())
+                                      : std::vector<float>(channels, 0);
+        std::vector<float> newBias = hasBias ? GetFloat32Values(conv2d->Inputs()[2].Get())
+                                             : std::vector<float>(channels, 0);
+        std::vector<float> multipliers(channels);
+        for (size_t c = 0; c < channels; ++c) {
+            multipliers[c] = scale[c] / std::sqrt(variance[c] + options->epsilon);
+            newBias[c] = (newBias[c] - mean[c]) * multipliers[c] + bias[c];
+        }
+        std::vector<float> newFilter = GetFloat32Values(filter);
+        const size_t channelStride = outputChannelsFirst ? newFilter.size() / channels : 1;
+        for (size_t i = 0; i < newFilter.size(); ++i) {
+            newFilter[i] *= multipliers[(i / channelStride) % channels];
+        }
+
+        Conv2dOptions newOptions = *conv2dOptions;
+        newOptions.bias = AddConstant(ml::OperandType::Float32,
+                                      {static_cast<int32_t>(channels)}, ToBytes(newBias));
+        newOptions.activation = options->activation;
+        OperandBase* filterOperand =
+            AddConstant(ml::OperandType::Float32, filterShape, ToBytes(newFilter));
+        if (newOptions.bias == nullptr || filterOperand == nullptr) {
+            return false;
+        }
+        return Replace(op->PrimaryOutput(),
+                       AddOperator(new op::Conv2d(mBuilder, conv2d->Inputs()[0].Get(),
+                                                  filterOperand, &newOptions)));
+    }
+
+    // Moves the activation that follows a conv2d or a batchNorm into their options.
+    bool GraphOptimizer::FuseActivation(const OperatorBase* op) {
+        OperatorType type = mOperatorTypes.at(op);
+        if (!mFuseOperators || (type != OperatorType::Clamp && type != OperatorType::Unary)) {
+            return false;
+        }
+        const OperandBase* input = op->Inputs()[0].Get();
+        OperatorType inputType = GetType(input);
+        if ((inputType != OperatorType::Conv2d && inputType != OperatorType::BatchNorm) ||
+            !HasSingleUse(input)) {
+            return false;
+        }
+        const OperatorBase* producer = input->Operator();
+        if (inputType == OperatorType::Conv2d
+                ? static_cast<const op::Conv2d*>(producer)->GetOptions()->activation != nullptr
+                : static_cast<const op::BatchNorm*>(producer)->GetOptions()->activation !=
+                      nullptr) {
+            return false;
+        }
+
+        Ref<FusionOperatorBase> activation;
+        if (type == OperatorType::Clamp) {
+            auto clamp = static_cast<const op::Clamp*>(op);
+            ClampOptions options;
+            options.minValue = clamp->GetMinValue();
+            options.maxValue = clamp->GetMaxValue();
+            activation = AcquireRef(new op::FusionClamp(mBuilder, &options));
+        } else {
+            auto unary = static_cast<const op::Unary*>(op);
+            switch (unary->GetType()) {
+                case op::UnaryOpType::kHardSwish:
+                    activation = AcquireRef(new op::FusionUnary(mBuilder, FusionType::HardSwish));
+                    break;
+                case op::UnaryOpType::kLeakyRelu: {
+                    LeakyReluOptions options;
+                    options.alpha = static_cast<const op::LeakyRelu*>(unary)->GetAlpha();
+                    activation = AcquireRef(new op::FusionLeakyRelu(mBuilder, &options));
+                    break;
+                }
+                case op::UnaryOpType::kRelu:
+                    activation = AcquireRef(new op::FusionUnary(mBuilder, FusionType::Relu));
+                    break;
+                case op::UnaryOpType::kSigmoid:
+                    activation = AcquireRef(new op::FusionUnary(mBuilder, FusionType::Sigmoid));
+                    break;
+                case op::UnaryOpType::kTanh:
+                    activation = AcquireRef(new op::FusionUnary(mBuilder, FusionType::Tanh));
+                    break;
+                default:
+                    return false;
+            }
+        }
+        if (!mGraph->SupportsFusedActivation(activation->GetFusionType())) {
+            return false;
+        }
+
+        const std::vector<Ref<OperandBase>>& inputs = producer->Inputs();
+        OperandBase* fused;
+        if (inputType == OperatorType::Conv2d) {
+            Conv2dOptions options = *static_cast<const op::Conv2d*>(producer)->GetOptions();
+            options.activation = activation.Get();
+            fused = AddOperator(
+                new op::Conv2d(mBuilder, inputs[0].Get(), inputs[1].Get(), &options));
+        } else {
+            BatchNormOptions options = *static_cast<const op::BatchNorm*>(producer)->GetOptions();
+            options.activation = activation.Get();
+            fused = AddOperator(new op::BatchNorm(mBuilder, inputs[0].Get(), inputs[1].Get(),
+                                                  inputs[2].Get(), &options));
+        }
+        return Replace(op->PrimaryOutput(), fused);
+    }
+
+}  // namespace webnn_native
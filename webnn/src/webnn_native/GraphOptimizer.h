@@ -0,0 +1,128 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_GRAPH_OPTIMIZER_H_
+#define WEBNN_NATIVE_GRAPH_OPTIMIZER_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "common/RefCounted.h"
+#include "webnn_native/Forward.h"
+#include "webnn_native/NamedOperands.h"
+#include "webnn_native/Operand.h"
+#include "webnn_native/WebnnNative.h"
+
+namespace webnn_native {
+
+    // Rewrites the graph before its operators are added to the backend. A rewrite builds new
+    // operators that compute the same values as an operand and replaces the operand by their
+    // output. At the end of a sweep the consumers of the replaced operands are cloned to read
+    // the replacements, and so are the consumers of the clones, so the operators that aren't
+    // needed anymore drop out of the sorted operators. The operators of the builder are never
+    // changed, so they can still be built into another graph or serialized.
+    class GraphOptimizer {
+      public:
+        // The passes that produce conv2d with a bias operand and the fused activation of conv2d
+        // and batchNorm only run when |graph| supports them.
+        GraphOptimizer(GraphBuilderBase* builder,
+                       NamedOperandsBase const* namedOperands,
+                       const GraphBase* graph);
+
+        // Runs sweeps of the passes until none of them changes the graph, or up to a limit.
+        void Run();
+
+        const std::vector<const OperatorBase*>& GetSortedOperators() const {
+            return mSortedOperators;
+        }
+        GraphOptimizationStats GetStats() const;
+        const std::map<std::string, const OperandBase*>& GetOutputs() const {
+            return mOutputs;
+        }
+        // The inputs and the constants among the sorted operators.
+        std::vector<op::Input*> GetInputs() const;
+        std::vector<op::Constant*> GetConstants() const;
+
+      private:
+        enum class OperatorType {
+            BatchNorm,
+            Binary,
+            Clamp,
+            Constant,
+            Conv2d,
+            Input,
+            Reshape,
+            Squeeze,
+            Transpose,
+            Unary,
+            Other,
+        };
+        class TypeCollector;
+
+        // A pass tries to rewrite the operator and returns whether it did.
+        using Pass = bool (GraphOptimizer::*)(const OperatorBase* op);
+        bool FoldConstants(const OperatorBase* op);
+        bool CancelLayoutOperators(const OperatorBase* op);
+        bool FoldBatchNormIntoConv2d(const OperatorBase* op);
+        bool FuseActivation(const OperatorBase* op);
+
+        // Sorts the operators needed by the outputs, which drops the dead ones, and finds the
+        // type and the consumers of each of them.
+        void Analyze();
+        // Clones the consumers of the operands replaced in the sweep and points the outputs to
+        // their replacements. Returns the number of rewrites it applied, without those whose
+        // consumers couldn't be cloned.
+        size_t ApplyReplacements();
+        OperandBase* Resolve(const OperandBase* operand) const;
+        OperatorType GetType(const OperandBase* operand) const;
+        // Whether the operand is computed from an input with a symbolic batch.
+        bool HasSymbolicBatch(const OperandBase* operand) const;
+        bool IsOutput(const OperandBase* operand) const;
+        // Whether the operand is only read by one operator, so its producer can be rewritten.
+        bool HasSingleUse(const OperandBase* operand) const;
+        bool IsFloat32Constant(const OperandBase* operand) const;
+
+        // Validates the new operator and returns its output, or nullptr if it is invalid. The
+        // operators of the passes come from the heap rather than the arena of the builder, so
+        // they are freed with the graph they were built for.
+        OperandBase* AddOperator(OperatorBase* op);
+        OperandBase* AddConstant(ml::OperandType type,
+                                 const std::vector<int32_t>& shape,
+                                 std::vector<int8_t> buffer);
+        // Records that |to| replaces |from| at the end of the sweep. Returns false if |from| is an
+        // output that can't be computed by |to| or |to| is replaced itself.
+        bool Replace(const OperandBase* from, OperandBase* to);
+
+        GraphBuilderBase* mBuilder;
+        const GraphBase* mGraph;
+        bool mFuseOperators;
+        std::map<std::string, const OperandBase*> mOutputs;
+        std::vector<const OperatorBase*> mSortedOperators;
+        std::map<const OperatorBase*, OperatorType> mOperatorTypes;
+        std::map<const OperandBase*, std::vector<const OperatorBase*>> mConsumers;
+        std::set<const OperatorBase*> mSymbolicBatchOperators;
+        // The operands replaced in the current sweep.
+        std::map<const OperandBase*, OperandBase*> mReplacements;
+        // The outputs of the operators built by the passes and of the clones.
+        std::vector<Ref<OperandBase>> mOperands;
+        // The operators before the first sweep and the rewrites applied to the graph.
+        size_t mOperatorCount = 0;
+        size_t mRewriteCount = 0;
+    };
+
+}  // namespace webnn_native
+
+#endif  // WEBNN_NATIVE_GRAPH_OPTIMIZER_H_
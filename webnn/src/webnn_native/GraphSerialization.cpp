@@ -0,0 +1,1010 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/GraphSerialization.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include "webnn_native/FusionOperator.h"
+#include "webnn_native/GraphBuilder.h"
+#include "webnn_native/GraphContentHasher.h"
+#include "webnn_native/MappedFile.h"
+#include "webnn_native/NamedOperands.h"
+#include "webnn_native/OperatorArray.h"
+#include "webnn_native/ops/BatchNorm.h"
+#include "webnn_native/ops/Binary.h"
+#include "webnn_native/ops/Clamp.h"
+#include "webnn_native/ops/Concat.h"
+#include "webnn_native/ops/Constant.h"
+#include "webnn_native/ops/Conv2d.h"
+#include "webnn_native/ops/Gemm.h"
+#include "webnn_native/ops/Gru.h"
+#include "webnn_native/ops/Input.h"
+#include "webnn_native/ops/InstanceNorm.h"
+#include "webnn_native/ops/LeakyRelu.h"
+#include "webnn_native/ops/Pad.h"
+#include "webnn_native/ops/Pool2d.h"
+#include "webnn_native/ops/Quantize.h"
+#include "webnn_native/ops/Reduce.h"
+#include "webnn_native/ops/Resample2d.h"
+#include "webnn_native/ops/Reshape.h"
+#include "webnn_native/ops/Slice.h"
+#include "webnn_native/ops/Split.h"
+#include "webnn_native/ops/Squeeze.h"
+#include "webnn_native/ops/Transpose.h"
+#include "webnn_native/ops/Unary.h"
+
+namespace webnn_native {
+
+    namespace {
+
+        constexpr char kMagic[8] = {'W', 'N', 'N', 'G', 'R', 'A', 'P', 'H'};
+        // Bumped whenever the layout of the records changes.
+        constexpr uint32_t kVersion = 2;
+        // The constants are aligned for the vector loads of the backends.
+        constexpr uint64_t kConstantAlignment = 64;
+
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t reserved;
+            uint64_t recordsOffset;
+            uint64_t recordsSize;
+            uint64_t recordsHash;
+            uint64_t constantsOffset;
+            uint64_t constantsSize;
+        };
+
+        // The values are stored in files, so new types are only appended.
+        enum class RecordType : uint32_t {
+            Constant = 0,
+            Input,
+            Output,
+            BatchNorm,
+            Binary,
+            Clamp,
+            Concat,
+            Conv2d,
+            Gemm,
+            Gru,
+            InstanceNorm,
+            Pad,
+            Pool2d,
+            Reduce,
+            Resample2d,
+            Reshape,
+            Slice,
+            Split,
+            Squeeze,
+            Transpose,
+            Unary,
+            Quantize,
+        };
+
+        uint64_t AlignOffset(uint64_t offset) {
+            return (offset + kConstantAlignment - 1) & ~(kConstantAlignment - 1);
+        }
+
+        // Reads the records of a mapped file, failing rather than reading past their end.
+        class RecordReader {
+          public:
+            RecordReader(const uint8_t* data, size_t size) : mData(data), mSize(size) {
+            }
+
+            bool IsEnd() const {
+                return mOffset == mSize;
+            }
+
+            template <typename T>
+            MaybeError Read(T* value) {
+                if (mSize - mOffset < sizeof(T)) {
+                    return DAWN_VALIDATION_ERROR("The serialized graph is truncated.");
+                }
+                memcpy(value, mData + mOffset, sizeof(T));
+                mOffset += sizeof(T);
+                return {};
+            }
+
+            // Any other byte than 0 or 1 isn't a valid bool, so the byte is checked before it is
+            // assigned.
+            MaybeError Read(bool* value) {
+                uint8_t raw = 0;
+                DAWN_TRY(Read(&raw));
+                if (raw > 1) {
+                    return DAWN_VALIDATION_ERROR("The serialized graph has an invalid bool.");
+                }
+                *value = raw == 1;
+                return {};
+            }
+
+            template <typename T>
+            MaybeError ReadVector(std::vector<T>* values) {
+                uint32_t count = 0;
+                DAWN_TRY(Read(&count));
+                if ((mSize - mOffset) / sizeof(T) < count) {
+                    return DAWN_VALIDATION_ERROR("The serialized graph is truncated.");
+                }
+                values->resize(count);
+                memcpy(values->data(), mData + mOffset, count * sizeof(T));
+                mOffset += count * sizeof(T);
+                return {};
+            }
+
+            MaybeError ReadString(std::string* value) {
+                std::vector<char> chars;
+                DAWN_TRY(ReadVector(&chars));
+                value->assign(chars.begin(), chars.end());
+                return {};
+            }
+
+            // The values of the enumerations are checked before they are cast.
+            template <typename T>
+            MaybeError ReadEnum(T* value, uint32_t last) {
+                uint32_t raw = 0;
+                DAWN_TRY(Read(&raw));
+                if (raw > last) {
+                    return DAWN_VALIDATION_ERROR("The serialized graph has an invalid enum.");
+                }
+                *value = static_cast<T>(raw);
+                return {};
+            }
+            template <typename T>
+            MaybeError ReadEnum(T* value, T last) {
+                return ReadEnum(value, static_cast<uint32_t>(last));
+            }
+
+            MaybeError ReadDescriptor(OperandDescriptor* desc, std::vector<int32_t>* dimensions) {
+                DAWN_TRY(ReadEnum(&desc->type, ml::OperandType::Uint8));
+                DAWN_TRY(ReadVector(dimensions));
+                desc->dimensions = dimensions->data();
+                desc->dimensionsCount = dimensions->size();
+                return {};
+            }
+
+          private:
+            const uint8_t* mData;
+            size_t mSize;
+            size_t mOffset = 0;
+        };
+
+        // The bytes of an operand of |desc|, or 0 when a dimension isn't positive or they
+        // overflow.
+        uint64_t GetByteLength(const OperandDescriptor* desc) {
+            uint64_t byteLength = 4;
+            if (desc->type == ml::OperandType::Float16) {
+                byteLength = 2;
+            } else if (desc->type == ml::OperandType::Int8 ||
+                       desc->type == ml::OperandType::Uint8) {
+                byteLength = 1;
+            }
+            for (uint32_t i = 0; i < desc->dimensionsCount; ++i) {
+                const int32_t dimension = desc->dimensions[i];
+                if (dimension <= 0 ||
+                    byteLength > std::numeric_limits<uint64_t>::max() / dimension) {
+                    return 0;
+                }
+                byteLength *= dimension;
+            }
+            return byteLength;
+        }
+
+        MaybeError ReadActivation(RecordReader* reader,
+                                  GraphBuilderBase* builder,
+                                  Ref<FusionOperatorBase>* activation) {
+            bool hasActivation;
+            DAWN_TRY(reader->Read(&hasActivation));
+            if (!hasActivation) {
+                return {};
+            }
+            FusionType type = FusionType::Clamp;
+            DAWN_TRY(reader->ReadEnum(&type, FusionType::Tanh));
+            switch (type) {
+                case FusionType::Clamp: {
+                    ClampOptions options;
+                    DAWN_TRY(reader->Read(&options.minValue));
+                    DAWN_TRY(reader->Read(&options.maxValue));
+                    *activation = AcquireRef(new op::FusionClamp(builder, &options));
+                    break;
+                }
+                case FusionType::LeakyRelu: {
+                    LeakyReluOptions options;
+                    DAWN_TRY(reader->Read(&options.alpha));
+                    *activation = AcquireRef(new op::FusionLeakyRelu(builder, &options));
+                    break;
+                }
+                default:
+                    *activation = AcquireRef(new op::FusionUnary(builder, type));
+                    break;
+            }
+            return {};
+        }
+
+        // The optional operands of the options follow the required inputs in this order.
+        OperandBase* NextOptionalInput(bool present,
+                                       const std::vector<OperandBase*>& inputs,
+                                       size_t* index) {
+            return present ? inputs[(*index)++] : nullptr;
+        }
+
+        MaybeError ReadOperator(RecordReader* reader,
+                                GraphBuilderBase* builder,
+                                RecordType type,
+                                const std::vector<OperandBase*>& inputs,
+                                const Ref<MappedFile>& file,
+                                const FileHeader& header,
+                                OperatorBase** op) {
+            Arena* arena = builder->GetArena();
+            auto checkInputs = [&inputs](size_t count) -> MaybeError {
+                if (inputs.size() != count) {
+                    return DAWN_VALIDATION_ERROR(
+                        "The serialized operator has a wrong number of inputs.");
+                }
+                return {};
+            };
+            switch (type) {
+                case RecordType::Constant: {
+                    DAWN_TRY(checkInputs(0));
+                    OperandDescriptor desc;
+                    std::vector<int32_t> dimensions;
+                    DAWN_TRY(reader->ReadDescriptor(&desc, &dimensions));
+                    uint64_t offset = 0, byteLength = 0;
+                    DAWN_TRY(reader->Read(&offset));
+                    DAWN_TRY(reader->Read(&byteLength));
+                    if (offset > header.constantsSize ||
+                        byteLength > header.constantsSize - offset) {
+                        return DAWN_VALIDATION_ERROR("The serialized constant is out of range.");
+                    }
+                    // The backends read all the bytes of the type and the dimensions.
+                    if (byteLength == 0 || byteLength != GetByteLength(&desc)) {
+                        return DAWN_VALIDATION_ERROR(
+                            "The serialized constant doesn't match its dimensions.");
+                    }
+                    ArrayBufferView view = {};
+                    view.buffer = const_cast<uint8_t*>(file->GetData() + header.constantsOffset);
+                    view.byteOffset = offset;
+                    view.byteLength = byteLength;
+                    *op = new (arena) op::Constant(builder, &desc, &view, file);
+                    return {};
+                }
+                case RecordType::Input: {
+                    DAWN_TRY(checkInputs(0));
+                    std::string name;
+                    DAWN_TRY(reader->ReadString(&name));
+                    OperandDescriptor desc;
+                    std::vector<int32_t> dimensions;
+                    DAWN_TRY(reader->ReadDescriptor(&desc, &dimensions));
+                    *op = new (arena) op::Input(builder, name, &desc);
+                    return {};
+                }
+                case RecordType::BatchNorm: {
+                    BatchNormOptions options;
+                    bool hasScale, hasBias;
+                    DAWN_TRY(reader->Read(&hasScale));
+                    DAWN_TRY(reader->Read(&hasBias));
+                    DAWN_TRY(reader->Read(&options.axis));
+                    DAWN_TRY(reader->Read(&options.epsilon));
+                    Ref<FusionOperatorBase> activation;
+                    DAWN_TRY(ReadActivation(reader, builder, &activation));
+                    DAWN_TRY(checkInputs(3 + hasScale + hasBias));
+                    size_t index = 3;
+                    options.scale = NextOptionalInput(hasScale, inputs, &index);
+                    options.bias = NextOptionalInput(hasBias, inputs, &index);
+                    options.activation = activation.Get();
+                    *op = new (arena)
+                        op::BatchNorm(builder, inputs[0], inputs[1], inputs[2], &options);
+                    return {};
+                }
+                case RecordType::Binary: {
+                    DAWN_TRY(checkInputs(2));
+                    op::BinaryOpType opType = {};
+                    DAWN_TRY(reader->ReadEnum(&opType, op::BinaryOpType::kPower));
+                    *op = new (arena) op::Binary(builder, opType, inputs[0], inputs[1]);
+                    return {};
+                }
+                case RecordType::Clamp: {
+                    DAWN_TRY(checkInputs(1));
+                    ClampOptions options;
+                    DAWN_TRY(reader->Read(&options.minValue));
+                    DAWN_TRY(reader->Read(&options.maxValue));
+                    *op = new (arena) op::Clamp(builder, inputs[0], &options);
+                    return {};
+                }
+                case RecordType::Concat: {
+                    uint32_t axis;
+                    DAWN_TRY(reader->Read(&axis));
+                    if (inputs.empty()) {
+                        return DAWN_VALIDATION_ERROR("The serialized concat has no inputs.");
+                    }
+                    std::vector<Ref<OperandBase>> operands(inputs.begin(), inputs.end());
+                    *op = new (arena) op::Concat(builder, std::move(operands), axis);
+                    return {};
+                }
+                case RecordType::Conv2d: {
+                    std::vector<int32_t> padding, strides, dilations, outputPadding, outputSizes;
+                    DAWN_TRY(reader->ReadVector(&padding));
+                    DAWN_TRY(reader->ReadVector(&strides));
+                    DAWN_TRY(reader->ReadVector(&dilations));
+                    DAWN_TRY(reader->ReadVector(&outputPadding));
+                    DAWN_TRY(reader->ReadVector(&outputSizes));
+                    Conv2dOptions options;
+                    options.padding = padding.data();
+                    options.paddingCount = padding.size();
+                    options.strides = strides.data();
+                    options.stridesCount = strides.size();
+                    options.dilations = dilations.data();
+                    options.dilationsCount = dilations.size();
+                    options.outputPadding = outputPadding.data();
+                    options.outputPaddingCount = outputPadding.size();
+                    if (!outputSizes.empty()) {
+                        options.outputSizes = outputSizes.data();
+                        options.outputSizesCount = outputSizes.size();
+                    }
+                    bool hasBias;
+                    DAWN_TRY(reader->ReadEnum(&options.autoPad, ml::AutoPad::SameLower));
+                    DAWN_TRY(reader->Read(&options.transpose));
+                    DAWN_TRY(reader->Read(&options.groups));
+                    DAWN_TRY(reader->ReadEnum(&options.inputLayout, ml::InputOperandLayout::Nhwc));
+                    DAWN_TRY(
+                        reader->ReadEnum(&options.filterLayout, ml::FilterOperandLayout::Ihwo));
+                    DAWN_TRY(reader->Read(&hasBias));
+                    Ref<FusionOperatorBase> activation;
+                    DAWN_TRY(ReadActivation(reader, builder, &activation));
+                    DAWN_TRY(checkInputs(2 + hasBias));
+                    options.bias = hasBias ? inputs[2] : nullptr;
+                    options.activation = activation.Get();
+                    *op = new (arena) op::Conv2d(builder, inputs[0], inputs[1], &options);
+                    return {};
+                }
+                case RecordType::Gemm: {
+                    GemmOptions options;
+                    DAWN_TRY(reader->Read(&options.alpha));
+                    DAWN_TRY(reader->Read(&options.beta));
+                    DAWN_TRY(reader->Read(&options.aTranspose));
+                    DAWN_TRY(reader->Read(&options.bTranspose));
+                    if (inputs.size() != 2 && inputs.size() != 3) {
+                        return DAWN_VALIDATION_ERROR(
+                            "The serialized operator has a wrong number of inputs.");
+                    }
+                    options.c = inputs.size() == 3 ? inputs[2] : nullptr;
+                    *op = new (arena) op::Gemm(builder, inputs[0], inputs[1], &options);
+                    return {};
+                }
+                case RecordType::Gru: {
+                    int32_t steps, hiddenSize;
+                    bool hasBias, hasRecurrentBias, hasInitialHiddenState;
+                    GruOptions options;
+                    DAWN_TRY(reader->Read(&steps));
+                    DAWN_TRY(reader->Read(&hiddenSize));
+                    DAWN_TRY(reader->Read(&hasBias));
+                    DAWN_TRY(reader->Read(&hasRecurrentBias));
+                    DAWN_TRY(reader->Read(&hasInitialHiddenState));
+                    DAWN_TRY(reader->Read(&options.resetAfter));
+                    DAWN_TRY(reader->Read(&options.returnSequence));
+                    DAWN_TRY(reader->Read(&options.stateful));
+                    DAWN_TRY(reader->ReadEnum(&options.direction,
+                                              ml::RecurrentNetworkDirection::Both));
+                    DAWN_TRY(
+                        reader->ReadEnum(&options.layout, ml::RecurrentNetworkWeightLayout::Rzn));
+                    uint32_t activationCount;
+                    DAWN_TRY(reader->Read(&activationCount));
+                    Ref<OperatorArrayBase> activations = AcquireRef(new OperatorArrayBase());
+                    for (uint32_t i = 0; i < activationCount; ++i) {
+                        Ref<FusionOperatorBase> activation;
+                        DAWN_TRY(ReadActivation(reader, builder, &activation));
+                        if (activation == nullptr) {
+                            return DAWN_VALIDATION_ERROR("The serialized gru has no activation.");
+                        }
+                        activations->APISet(activation.Get());
+                    }
+                    DAWN_TRY(checkInputs(3 + hasBias + hasRecurrentBias + hasInitialHiddenState));
+                    size_t index = 3;
+                    options.bias = NextOptionalInput(hasBias, inputs, &index);
+                    options.recurrentBias = NextOptionalInput(hasRecurrentBias, inputs, &index);
+                    options.initialHiddenState =
+                        NextOptionalInput(hasInitialHiddenState, inputs, &index);
+                    options.activations = activations.Get();
+                    *op = new (arena) op::Gru(builder, inputs[0], inputs[1], inputs[2], steps,
+                                              hiddenSize, &options);
+                    return {};
+                }
+                case RecordType::InstanceNorm: {
+                    InstanceNormOptions options;
+                    bool hasScale, hasBias;
+                    DAWN_TRY(reader->Read(&hasScale));
+                    DAWN_TRY(reader->Read(&hasBias));
+                    DAWN_TRY(reader->Read(&options.epsilon));
+                    DAWN_TRY(reader->ReadEnum(&options.layout, ml::InputOperandLayout::Nhwc));
+                    DAWN_TRY(checkInputs(1 + hasScale + hasBias));
+                    size_t index = 1;
+                    options.scale = NextOptionalInput(hasScale, inputs, &index);
+                    options.bias = NextOptionalInput(hasBias, inputs, &index);
+                    *op = new (arena) op::InstanceNorm(builder, inputs[0], &options);
+                    return {};
+                }
+                case RecordType::Pad: {
+                    DAWN_TRY(checkInputs(2));
+                    PadOptions options;
+                    DAWN_TRY(reader->ReadEnum(&options.mode, ml::PaddingMode::Symmetric));
+                    DAWN_TRY(reader->Read(&options.value));
+                    *op = new (arena) op::Pad(builder, inputs[0], inputs[1], &options);
+                    return {};
+                }
+                case RecordType::Pool2d: {
+                    DAWN_TRY(checkInputs(1));
+                    op::Pool2dType opType = {};
+                    Pool2dOptions options;
+                    DAWN_TRY(reader->ReadEnum(&opType, op::Pool2dType::kMaxPool2d));
+                    DAWN_TRY(reader->ReadEnum(&options.autoPad, ml::AutoPad::SameLower));
+                    DAWN_TRY(reader->ReadEnum(&options.layout, ml::InputOperandLayout::Nhwc));
+                    std::vector<int32_t> windowDimensions, padding, strides, dilations;
+                    DAWN_TRY(reader->ReadVector(&windowDimensions));
+                    DAWN_TRY(reader->ReadVector(&padding));
+                    DAWN_TRY(reader->ReadVector(&strides));
+                    DAWN_TRY(reader->ReadVector(&dilations));
+                    if (!windowDimensions.empty()) {
+                        options.windowDimensions = windowDimensions.data();
+                        options.windowDimensionsCount = windowDimensions.size();
+                    }
+                    options.padding = padding.data();
+                    options.paddingCount = padding.size();
+                    options.strides = strides.data();
+                    options.stridesCount = strides.size();
+                    options.dilations = dilations.data();
+                    options.dilationsCount = dilations.size();
+                    *op = new (arena) op::Pool2d(builder, opType, inputs[0], &options);
+                    return {};
+                }
+                case RecordType::Reduce: {
+                    DAWN_TRY(checkInputs(1));
+                    op::ReduceType opType = {};
+                    ReduceOptions options;
+                    std::vector<int32_t> axes;
+                    DAWN_TRY(reader->ReadEnum(&opType, op::ReduceType::kReduceSum));
+                    DAWN_TRY(reader->Read(&options.keepDimensions));
+                    DAWN_TRY(reader->ReadVector(&axes));
+                    options.axes = axes.data();
+                    options.axesCount = axes.size();
+                    *op = new (arena) op::Reduce(builder, opType, inputs[0], &options);
+                    return {};
+                }
+                case RecordType::Resample2d: {
+                    DAWN_TRY(checkInputs(1));
+                    Resample2dOptions options;
+                    std::vector<float> scales;
+                    std::vector<int32_t> sizes, axes;
+                    DAWN_TRY(reader->ReadEnum(&options.mode, ml::InterpolationMode::Linear));
+                    DAWN_TRY(reader->ReadVector(&scales));
+                    DAWN_TRY(reader->ReadVector(&sizes));
+                    DAWN_TRY(reader->ReadVector(&axes));
+                    options.scales = scales.data();
+                    options.scalesCount = scales.size();
+                    if (!sizes.empty()) {
+                        options.sizes = sizes.data();
+                        options.sizesCount = sizes.size();
+                    }
+                    options.axes = axes.data();
+                    options.axesCount = axes.size();
+                    *op = new (arena) op::Resample2d(builder, inputs[0], &options);
+                    return {};
+                }
+                case RecordType::Reshape: {
+                    DAWN_TRY(checkInputs(1));
+                    std::vector<int32_t> newShape;
+                    DAWN_TRY(reader->ReadVector(&newShape));
+                    *op = new (arena)
+                        op::Reshape(builder, inputs[0], newShape.data(), newShape.size());
+                    return {};
+                }
+                case RecordType::Slice: {
+                    DAWN_TRY(checkInputs(1));
+                    std::vector<int32_t> starts, sizes, axes;
+                    DAWN_TRY(reader->ReadVector(&starts));
+                    DAWN_TRY(reader->ReadVector(&sizes));
+                    DAWN_TRY(reader->ReadVector(&axes));
+                    SliceOptions options;
+                    if (!axes.empty()) {
+                        options.axes = axes.data();
+                        options.axesCount = axes.size();
+                    }
+                    *op = new (arena) op::Slice(builder, inputs[0], starts.data(), starts.size(),
+                                                sizes.data(), sizes.size(), &options);
+                    return {};
+                }
+                case RecordType::Split: {
+                    DAWN_TRY(checkInputs(1));
+                    SplitOptions options;
+                    std::vector<uint32_t> splits;
+                    DAWN_TRY(reader->Read(&options.axis));
+                    DAWN_TRY(reader->ReadVector(&splits));
+                    if (splits.empty()) {
+                        return DAWN_VALIDATION_ERROR("The serialized split has no splits.");
+                    }
+                    *op = new (arena)
+                        op::Split(builder, inputs[0], splits.data(), splits.size(), &options);
+                    return {};
+                }
+                case RecordType::Squeeze: {
+                    DAWN_TRY(checkInputs(1));
+                    std::vector<int32_t> axes;
+                    DAWN_TRY(reader->ReadVector(&axes));
+                    SqueezeOptions options;
+                    if (!axes.empty()) {
+                        options.axes = axes.data();
+                        options.axesCount = axes.size();
+                    }
+                    *op = new (arena) op::Squeeze(builder, inputs[0], &options);
+                    return {};
+                }
+                case RecordType::Transpose: {
+                    DAWN_TRY(checkInputs(1));
+                    std::vector<int32_t> permutation;
+                    DAWN_TRY(reader->ReadVector(&permutation));
+                    TransposeOptions options;
+                    options.permutation = permutation.data();
+                    options.permutationCount = permutation.size();
+                    *op = new (arena) op::Transpose(builder, inputs[0], &options);
+                    return {};
+                }
+                case RecordType::Unary: {
+                    DAWN_TRY(checkInputs(1));
+                    op::UnaryOpType opType = {};
+                    DAWN_TRY(reader->ReadEnum(&opType, op::UnaryOpType::kTanh));
+                    if (opType == op::UnaryOpType::kLeakyRelu) {
+                        LeakyReluOptions options;
+                        DAWN_TRY(reader->Read(&options.alpha));
+                        *op = new (arena) op::LeakyRelu(builder, inputs[0], &options);
+                    } else {
+                        *op = new (arena) op::Unary(builder, opType, inputs[0]);
+                    }
+                    return {};
+                }
+                case RecordType::Quantize: {
+                    DAWN_TRY(checkInputs(3));
+                    op::QuantizeType opType = {};
+                    QuantizeLinearOptions options;
+                    DAWN_TRY(reader->ReadEnum(&opType, op::QuantizeType::kDequantizeLinear));
+                    DAWN_TRY(reader->Read(&options.axis));
+                    *op = new (arena) op::Quantize(builder, opType, inputs[0], inputs[1], inputs[2],
+                                                   &options);
+                    return {};
+                }
+                default:
+                    return DAWN_VALIDATION_ERROR("The serialized graph has an unknown record.");
+            }
+        }
+
+    }  // anonymous namespace
+
+    GraphSerializer::GraphSerializer(ContextBase* context) : GraphBase(context) {
+    }
+
+    void GraphSerializer::WriteString(const std::string& value) {
+        WriteVector(std::vector<char>(value.begin(), value.end()));
+    }
+
+    void GraphSerializer::WriteOperator(uint32_t type, const OperatorBase* op) {
+        Write(type);
+        Write(static_cast<uint32_t>(op->Inputs().size()));
+        for (auto& input : op->Inputs()) {
+            // The operands are produced before they are used in topological order.
+            DAWN_ASSERT(mOperandIds.find(input.Get()) != mOperandIds.end());
+            Write(mOperandIds.at(input.Get()));
+        }
+        Write(static_cast<uint32_t>(op->Outputs().size()));
+        for (auto output : op->Outputs()) {
+            uint32_t id = mOperandIds.size();
+            mOperandIds[output] = id;
+        }
+    }
+
+    void GraphSerializer::WriteDescriptor(const OperandDescriptor* desc, bool symbolicBatch) {
+        Write(desc->type);
+        std::vector<int32_t> dimensions(desc->dimensions, desc->dimensions + desc->dimensionsCount);
+        if (symbolicBatch) {
+            dimensions[0] = -1;
+        }
+        WriteVector(dimensions);
+    }
+
+    void GraphSerializer::WriteActivation(const FusionOperatorBase* activation) {
+        Write(activation != nullptr);
+        if (activation == nullptr) {
+            return;
+        }
+        Write(activation->GetFusionType());
+        switch (activation->GetFusionType()) {
+            case FusionType::Clamp: {
+                auto clamp = static_cast<const op::FusionClamp*>(activation);
+                Write(clamp->GetMinValue());
+                Write(clamp->GetMaxValue());
+                break;
+            }
+            case FusionType::LeakyRelu:
+                Write(static_cast<const op::FusionLeakyRelu*>(activation)->GetAlpha());
+                break;
+            default:
+                break;
+        }
+    }
+
+    MaybeError GraphSerializer::AddConstant(const op::Constant* constant) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Constant), constant);
+        WriteDescriptor(constant->GetOperandDescriptor());
+        // Only the bytes of the operand are written, the buffer may be larger.
+        const uint64_t byteLength = std::min(static_cast<uint64_t>(constant->GetByteLength()),
+                                             GetByteLength(constant->GetOperandDescriptor()));
+        uint64_t offset = AlignOffset(mConstantsSize);
+        Write(offset);
+        Write(byteLength);
+        mConstants.push_back({constant->GetBuffer(), static_cast<size_t>(byteLength)});
+        mConstantsSize = offset + byteLength;
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddInput(const op::Input* input) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Input), input);
+        WriteString(input->GetName());
+        WriteDescriptor(input->GetOperandDescriptor(), input->HasSymbolicBatch());
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddOutput(const std::string& name, const OperandBase* output) {
+        DAWN_ASSERT(mOperandIds.find(output) != mOperandIds.end());
+        Write(static_cast<uint32_t>(RecordType::Output));
+        WriteString(name);
+        Write(mOperandIds.at(output));
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddBatchNorm(const op::BatchNorm* batchNorm) {
+        WriteOperator(static_cast<uint32_t>(RecordType::BatchNorm), batchNorm);
+        auto options = batchNorm->GetOptions();
+        Write(options->scale != nullptr);
+        Write(options->bias != nullptr);
+        Write(options->axis);
+        Write(options->epsilon);
+        WriteActivation(options->activation);
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddBinary(const op::Binary* binary) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Binary), binary);
+        Write(static_cast<uint32_t>(binary->GetType()));
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddConv2d(const op::Conv2d* conv2d) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Conv2d), conv2d);
+        auto options = conv2d->GetOptions();
+        auto toVector = [](int32_t const* values, uint32_t count) {
+            return values == nullptr ? std::vector<int32_t>()
+                                     : std::vector<int32_t>(values, values + count);
+        };
+        WriteVector(toVector(options->padding, options->paddingCount));
+        WriteVector(toVector(options->strides, options->stridesCount));
+        WriteVector(toVector(options->dilations, options->dilationsCount));
+        WriteVector(toVector(options->outputPadding, options->outputPaddingCount));
+        WriteVector(toVector(options->outputSizes, options->outputSizesCount));
+        Write(options->autoPad);
+        Write(options->transpose);
+        Write(options->groups);
+        Write(options->inputLayout);
+        Write(options->filterLayout);
+        Write(options->bias != nullptr);
+        WriteActivation(options->activation);
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddGru(const op::Gru* gru) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Gru), gru);
+        auto options = gru->GetOptions();
+        Write(static_cast<int32_t>(gru->GetSteps()));
+        Write(static_cast<int32_t>(gru->GetHiddenSize()));
+        Write(options->bias != nullptr);
+        Write(options->recurrentBias != nullptr);
+        Write(options->initialHiddenState != nullptr);
+        Write(options->resetAfter);
+        Write(options->returnSequence);
+        Write(options->stateful);
+        Write(options->direction);
+        Write(options->layout);
+        Ref<OperatorArrayBase> activations = gru->GetActivations();
+        Write(static_cast<uint32_t>(activations->APISize()));
+        for (size_t i = 0; i < activations->APISize(); ++i) {
+            WriteActivation(activations->APIGetOperator(i));
+        }
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddPad(const op::Pad* pad) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Pad), pad);
+        Write(pad->GetOptions()->mode);
+        Write(pad->GetOptions()->value);
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddPool2d(const op::Pool2d* pool2d) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Pool2d), pool2d);
+        auto options = pool2d->GetOptions();
+        Write(static_cast<uint32_t>(pool2d->GetType()));
+        Write(options->autoPad);
+        Write(options->layout);
+        auto toVector = [](int32_t const* values, uint32_t count) {
+            return values == nullptr ? std::vector<int32_t>()
+                                     : std::vector<int32_t>(values, values + count);
+        };
+        WriteVector(toVector(options->windowDimensions, options->windowDimensionsCount));
+        WriteVector(toVector(options->padding, options->paddingCount));
+        WriteVector(toVector(options->strides, options->stridesCount));
+        WriteVector(toVector(options->dilations, options->dilationsCount));
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddReduce(const op::Reduce* reduce) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Reduce), reduce);
+        auto options = reduce->GetOptions();
+        Write(static_cast<uint32_t>(reduce->GetType()));
+        Write(options->keepDimensions);
+        WriteVector(std::vector<int32_t>(options->axes, options->axes + options->axesCount));
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddResample2d(const op::Resample2d* resample2d) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Resample2d), resample2d);
+        Write(resample2d->GetOptions()->mode);
+        WriteVector(resample2d->GetScales());
+        WriteVector(resample2d->GetSizes());
+        WriteVector(resample2d->GetAxes());
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddReshape(const op::Reshape* reshape) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Reshape), reshape);
+        WriteVector(reshape->GetNewShape());
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddSqueeze(const op::Squeeze* squeeze) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Squeeze), squeeze);
+        WriteVector(squeeze->GetAxes());
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddSlice(const op::Slice* slice) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Slice), slice);
+        WriteVector(slice->GetStarts());
+        WriteVector(slice->GetSizes());
+        WriteVector(slice->GetAxes());
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddSplit(const op::Split* split) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Split), split);
+        Write(split->GetAxis());
+        WriteVector(split->GetSplits());
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddTranspose(const op::Transpose* transpose) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Transpose), transpose);
+        WriteVector(transpose->GetPermutation());
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddUnary(const op::Unary* unary) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Unary), unary);
+        Write(static_cast<uint32_t>(unary->GetType()));
+        if (unary->GetType() == op::UnaryOpType::kLeakyRelu) {
+            Write(static_cast<const op::LeakyRelu*>(unary)->GetAlpha());
+        }
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddConcat(const op::Concat* concat) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Concat), concat);
+        Write(concat->GetAxis());
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddGemm(const op::Gemm* gemm) {
+        // The optional c operand is told apart by the number of inputs.
+        WriteOperator(static_cast<uint32_t>(RecordType::Gemm), gemm);
+        auto options = gemm->GetOptions();
+        Write(options->alpha);
+        Write(options->beta);
+        Write(options->aTranspose);
+        Write(options->bTranspose);
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddClamp(const op::Clamp* clamp) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Clamp), clamp);
+        Write(clamp->GetMinValue());
+        Write(clamp->GetMaxValue());
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddInstanceNorm(const op::InstanceNorm* instanceNorm) {
+        WriteOperator(static_cast<uint32_t>(RecordType::InstanceNorm), instanceNorm);
+        auto options = instanceNorm->GetOptions();
+        Write(options->scale != nullptr);
+        Write(options->bias != nullptr);
+        Write(options->epsilon);
+        Write(options->layout);
+        return {};
+    }
+
+    MaybeError GraphSerializer::AddQuantize(const op::Quantize* quantize) {
+        WriteOperator(static_cast<uint32_t>(RecordType::Quantize), quantize);
+        Write(static_cast<uint32_t>(quantize->GetType()));
+        Write(quantize->GetOptions()->axis);
+        return {};
+    }
+
+    MaybeError GraphSerializer::Finish() {
+        return {};
+    }
+
+    void GraphSerializer::WriteChunks(
+        const std::function<void(const void* data, size_t size)>& write) const {
+        FileHeader header = {};
+        memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.recordsOffset = sizeof(FileHeader);
+        header.recordsSize = mRecords.size();
+        header.recordsHash = GraphContentHasher::HashBytes(mRecords.data(), mRecords.size());
+        header.constantsOffset = AlignOffset(header.recordsOffset + header.recordsSize);
+        header.constantsSize = mConstantsSize;
+
+        const std::vector<char> padding(kConstantAlignment, 0);
+        write(&header, sizeof(header));
+        write(mRecords.data(), mRecords.size());
+        uint64_t offset = header.recordsOffset + header.recordsSize;
+        write(padding.data(), header.constantsOffset - offset);
+        offset = 0;
+        for (auto& constant : mConstants) {
+            uint64_t alignedOffset = AlignOffset(offset);
+            write(padding.data(), alignedOffset - offset);
+            write(constant.buffer, constant.byteLength);
+            offset = alignedOffset + constant.byteLength;
+        }
+    }
+
+    MaybeError GraphSerializer::WriteToFile(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return DAWN_VALIDATION_ERROR("Failed to open the file to serialize the graph to.");
+        }
+        WriteChunks([&file](const void* data, size_t size) {
+            file.write(static_cast<const char*>(data), size);
+        });
+        file.flush();
+        if (!file) {
+            return DAWN_VALIDATION_ERROR("Failed to write the serialized graph.");
+        }
+        return {};
+    }
+
+    bool GraphSerializer::MatchesFile(const std::string& path) const {
+        Ref<MappedFile> file = AcquireRef(new MappedFile());
+        std::string error;
+        if (!file->Open(path, &error)) {
+            return false;
+        }
+        size_t offset = 0;
+        bool matches = true;
+        WriteChunks([&](const void* data, size_t size) {
+            matches = matches && size <= file->GetSize() - offset &&
+                      memcmp(file->GetData() + offset, data, size) == 0;
+            offset += size;
+        });
+        return matches && offset == file->GetSize();
+    }
+
+    MaybeError GraphSerializer::CompileImpl() {
+        return DAWN_INTERNAL_ERROR("The serializer can't be compiled.");
+    }
+
+    MLComputeGraphStatus GraphSerializer::ComputeImpl(NamedInputsBase* inputs,
+                                                      NamedOutputsBase* outputs) {
+        return MLComputeGraphStatus_Error;
+    }
+
+    MaybeError DeserializeGraph(GraphBuilderBase* builder,
+                                const std::string& path,
+                                NamedOperandsBase* namedOperands) {
+        Ref<MappedFile> file = AcquireRef(new MappedFile());
+        std::string error;
+        if (!file->Open(path, &error)) {
+            return DAWN_VALIDATION_ERROR(error.c_str());
+        }
+
+        FileHeader header;
+        if (file->GetSize() < sizeof(header)) {
+            return DAWN_VALIDATION_ERROR("The file is too small to be a serialized graph.");
+        }
+        memcpy(&header, file->GetData(), sizeof(header));
+        if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+            return DAWN_VALIDATION_ERROR("The file isn't a serialized graph.");
+        }
+        if (header.version != kVersion) {
+            return DAWN_VALIDATION_ERROR("The version of the serialized graph isn't supported.");
+        }
+        const uint64_t size = file->GetSize();
+        if (header.recordsOffset > size || header.recordsSize > size - header.recordsOffset ||
+            header.constantsOffset > size || header.constantsSize > size - header.constantsOffset ||
+            header.constantsOffset % kConstantAlignment != 0) {
+            return DAWN_VALIDATION_ERROR("The sections of the serialized graph are out of range.");
+        }
+        const uint8_t* records = file->GetData() + header.recordsOffset;
+        if (GraphContentHasher::HashBytes(records, header.recordsSize) != header.recordsHash) {
+            return DAWN_VALIDATION_ERROR("The serialized graph is corrupted.");
+        }
+
+        // The operands keep their operators, and so the rest of the graph, alive.
+        std::vector<Ref<OperandBase>> operands;
+        RecordReader reader(records, header.recordsSize);
+        bool hasOutputs = false;
+        while (!reader.IsEnd()) {
+            RecordType type;
+            DAWN_TRY(reader.Read(&type));
+            if (type == RecordType::Output) {
+                std::string name;
+                uint32_t id;
+                DAWN_TRY(reader.ReadString(&name));
+                DAWN_TRY(reader.Read(&id));
+                if (id >= operands.size()) {
+                    return DAWN_VALIDATION_ERROR("The serialized output is undefined.");
+                }
+                namedOperands->APISet(name.c_str(), operands[id].Get());
+                namedOperands->Retain(operands[id]);
+                hasOutputs = true;
+                continue;
+            }
+
+            uint32_t inputCount, outputCount;
+            DAWN_TRY(reader.Read(&inputCount));
+            std::vector<OperandBase*> inputs;
+            for (uint32_t i = 0; i < inputCount; ++i) {
+                uint32_t id;
+                DAWN_TRY(reader.Read(&id));
+                if (id >= operands.size()) {
+                    return DAWN_VALIDATION_ERROR("The serialized operand is undefined.");
+                }
+                inputs.push_back(operands[id].Get());
+            }
+            DAWN_TRY(reader.Read(&outputCount));
+
+            OperatorBase* op = nullptr;
+            DAWN_TRY(ReadOperator(&reader, builder, type, inputs, file, header, &op));
+            // The operator and its outputs are created with a reference, which is taken over.
+            Ref<OperatorBase> ref = AcquireRef(op);
+            for (auto output : op->Outputs()) {
+                operands.push_back(AcquireRef(output));
+            }
+            if (op->Outputs().size() != outputCount) {
+                return DAWN_VALIDATION_ERROR(
+                    "The serialized operator has a wrong number of outputs.");
+            }
+            DAWN_TRY(op->ValidateAndInferOutputInfo());
+        }
+        if (!hasOutputs) {
+            return DAWN_VALIDATION_ERROR("The serialized graph has no outputs.");
+        }
+        return {};
+    }
+
+}  // namespace webnn_native
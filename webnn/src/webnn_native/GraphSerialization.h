@@ -0,0 +1,114 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_GRAPH_SERIALIZATION_H_
+#define WEBNN_NATIVE_GRAPH_SERIALIZATION_H_
+
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "webnn_native/Graph.h"
+
+namespace webnn_native {
+
+    class FusionOperatorBase;
+
+    // Writes the operators added to it, their options and the constants into one versioned file
+    // in the byte order of the host. The records of the operators come first and the constants
+    // follow, aligned so that the backends can read them in place once the file is mapped.
+    class GraphSerializer final : public GraphBase {
+      public:
+        explicit GraphSerializer(ContextBase* context);
+        ~GraphSerializer() override = default;
+
+        MaybeError AddConstant(const op::Constant* constant) override;
+        MaybeError AddInput(const op::Input* input) override;
+        MaybeError AddOutput(const std::string& name, const OperandBase* output) override;
+        MaybeError AddBatchNorm(const op::BatchNorm* batchNorm) override;
+        MaybeError AddBinary(const op::Binary* binary) override;
+        MaybeError AddConv2d(const op::Conv2d* conv2d) override;
+        MaybeError AddGru(const op::Gru* gru) override;
+        MaybeError AddPad(const op::Pad* pad) override;
+        MaybeError AddPool2d(const op::Pool2d* pool2d) override;
+        MaybeError AddReduce(const op::Reduce* reduce) override;
+        MaybeError AddResample2d(const op::Resample2d* resample2d) override;
+        MaybeError AddReshape(const op::Reshape* reshape) override;
+        MaybeError AddSqueeze(const op::Squeeze* squeeze) override;
+        MaybeError AddSlice(const op::Slice* slice) override;
+        MaybeError AddSplit(const op::Split* split) override;
+        MaybeError AddTranspose(const op::Transpose* transpose) override;
+        MaybeError AddUnary(const op::Unary* unary) override;
+        MaybeError AddConcat(const op::Concat* concat) override;
+        MaybeError AddGemm(const op::Gemm* gemm) override;
+        MaybeError AddClamp(const op::Clamp* clamp) override;
+        MaybeError AddInstanceNorm(const op::InstanceNorm* instanceNorm) override;
+        MaybeError AddQuantize(const op::Quantize* quantize) override;
+        MaybeError Finish() override;
+
+        MaybeError WriteToFile(const std::string& path) const;
+        // Whether the file at |path| holds the same serialized graph, byte for byte.
+        bool MatchesFile(const std::string& path) const;
+
+      private:
+        MaybeError CompileImpl() override;
+        MLComputeGraphStatus ComputeImpl(NamedInputsBase* inputs,
+                                         NamedOutputsBase* outputs) override;
+
+        // Calls |write| with the bytes of the file in order.
+        void WriteChunks(const std::function<void(const void* data, size_t size)>& write) const;
+
+        template <typename T>
+        void Write(const T& value) {
+            size_t offset = mRecords.size();
+            mRecords.resize(offset + sizeof(T));
+            memcpy(mRecords.data() + offset, &value, sizeof(T));
+        }
+        void Write(bool value) {
+            Write(static_cast<uint8_t>(value));
+        }
+        template <typename T>
+        void WriteVector(const std::vector<T>& values) {
+            Write(static_cast<uint32_t>(values.size()));
+            size_t offset = mRecords.size();
+            mRecords.resize(offset + values.size() * sizeof(T));
+            memcpy(mRecords.data() + offset, values.data(), values.size() * sizeof(T));
+        }
+        void WriteString(const std::string& value);
+        // Writes the type of the record with the ids of the inputs and assigns the outputs theirs.
+        void WriteOperator(uint32_t type, const OperatorBase* op);
+        void WriteDescriptor(const OperandDescriptor* desc, bool symbolicBatch = false);
+        void WriteActivation(const FusionOperatorBase* activation);
+
+        std::vector<uint8_t> mRecords;
+        std::map<const OperandBase*, uint32_t> mOperandIds;
+        struct ConstantData {
+            const void* buffer;
+            size_t byteLength;
+        };
+        std::vector<ConstantData> mConstants;
+        uint64_t mConstantsSize = 0;
+    };
+
+    // Creates the operators of a serialized graph with |builder| and sets its outputs to
+    // |namedOperands|. The constants point into the mapping of the file, which they keep alive.
+    MaybeError DeserializeGraph(GraphBuilderBase* builder,
+                                const std::string& path,
+                                NamedOperandsBase* namedOperands);
+
+}  // namespace webnn_native
+
+#endif  // WEBNN_NATIVE_GRAPH_SERIALIZATION_H_
@@ -44,6 +44,11 @@ namespace webnn_native {
         BackendConnection* Connect(InstanceBase* instance);
     }
 #endif  // defined(WEBNN_ENABLE_BACKEND_ONEDNN)
+#if defined(WEBNN_ENABLE_BACKEND_CPU)
+    namespace cpu {
+        BackendConnection* Connect(InstanceBase* instance);
+    }
+#endif  // defined(WEBNN_ENABLE_BACKEND_CPU)
 
     namespace {
 
@@ -61,6 +66,9 @@ namespace webnn_native {
 #if defined(WEBNN_ENABLE_BACKEND_ONEDNN)
             enabledBackends.set(ml::BackendType::OneDNN);
 #endif  // defined(WEBNN_ENABLE_BACKEND_ONEDNN)
+#if defined(WEBNN_ENABLE_BACKEND_CPU)
+            enabledBackends.set(ml::BackendType::CPU);
+#endif  // defined(WEBNN_ENABLE_BACKEND_CPU)
             return enabledBackends;
         }
 
@@ -119,6 +127,12 @@ namespace webnn_native {
                 break;
 #endif  // defined(WEBNN_ENABLE_BACKEND_ONEDNN)
 
+#if defined(WEBNN_ENABLE_BACKEND_CPU)
+            case ml::BackendType::CPU:
+                Register(cpu::Connect(this), ml::BackendType::CPU);
+                break;
+#endif  // defined(WEBNN_ENABLE_BACKEND_CPU)
+
             default:
                 UNREACHABLE();
         }
@@ -136,6 +150,8 @@ namespace webnn_native {
             return mBackends[ml::BackendType::OpenVINO]->CreateContext(options);
         } else if (mBackends.find(ml::BackendType::OneDNN) != mBackends.end()) {
             return mBackends[ml::BackendType::OneDNN]->CreateContext(options);
+        } else if (mBackends.find(ml::BackendType::CPU) != mBackends.end()) {
+            return mBackends[ml::BackendType::CPU]->CreateContext(options);
         }
         UNREACHABLE();
         return nullptr;
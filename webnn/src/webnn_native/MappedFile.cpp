@@ -0,0 +1,98 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/MappedFile.h"
+
+#include "common/Assert.h"
+#include "common/Platform.h"
+
+#if DAWN_PLATFORM_WINDOWS
+#    include "common/windows_with_undefs.h"
+#elif DAWN_PLATFORM_POSIX
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#else
+#    error "Unsupported platform for MappedFile"
+#endif
+
+namespace webnn_native {
+
+    MappedFile::~MappedFile() {
+        if (mData == nullptr) {
+            return;
+        }
+#if DAWN_PLATFORM_WINDOWS
+        UnmapViewOfFile(mData);
+#elif DAWN_PLATFORM_POSIX
+        munmap(const_cast<uint8_t*>(mData), mSize);
+#endif
+    }
+
+    bool MappedFile::Open(const std::string& path, std::string* error) {
+        ASSERT(mData == nullptr);
+#if DAWN_PLATFORM_WINDOWS
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            *error = "Windows Error: " + std::to_string(GetLastError());
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            *error = "The file is empty.";
+            CloseHandle(file);
+            return false;
+        }
+        // The view keeps the mapping alive after the handles are closed.
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr) {
+            *error = "Windows Error: " + std::to_string(GetLastError());
+            return false;
+        }
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (data == nullptr) {
+            *error = "Windows Error: " + std::to_string(GetLastError());
+            return false;
+        }
+        mSize = static_cast<size_t>(size.QuadPart);
+#elif DAWN_PLATFORM_POSIX
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            *error = "Failed to open " + path + ".";
+            return false;
+        }
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+            *error = "The file is empty.";
+            close(fd);
+            return false;
+        }
+        // The mapping stays valid after the descriptor is closed.
+        void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            *error = "Failed to map " + path + ".";
+            return false;
+        }
+        mSize = static_cast<size_t>(fileStat.st_size);
+#endif
+        mData = static_cast<const uint8_t*>(data);
+        return true;
+    }
+
+}  // namespace webnn_native
@@ -0,0 +1,49 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_MAPPED_FILE_H_
+#define WEBNN_NATIVE_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "common/RefCounted.h"
+
+namespace webnn_native {
+
+    // A read-only mapping of a whole file. The pages are read by the OS when they are first
+    // accessed and are shared with the page cache, so pointing into them costs no copy.
+    class MappedFile : public RefCounted {
+      public:
+        MappedFile() = default;
+        ~MappedFile() override;
+
+        bool Open(const std::string& path, std::string* error);
+
+        const uint8_t* GetData() const {
+            return mData;
+        }
+        size_t GetSize() const {
+            return mSize;
+        }
+
+      private:
+        const uint8_t* mData = nullptr;
+        size_t mSize = 0;
+    };
+
+}  // namespace webnn_native
+
+#endif  // WEBNN_NATIVE_MAPPED_FILE_H_
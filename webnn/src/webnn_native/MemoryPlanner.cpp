@@ -0,0 +1,105 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/MemoryPlanner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+#include "common/Assert.h"
+
+namespace webnn_native {
+
+    MemoryPlanner::MemoryPlanner(size_t alignment) : mAlignment(alignment) {
+        DAWN_ASSERT(alignment != 0);
+    }
+
+    size_t MemoryPlanner::AddBuffer(size_t byteLength, size_t firstUse, size_t lastUse) {
+        DAWN_ASSERT(firstUse <= lastUse);
+        size_t alignedLength = (byteLength + mAlignment - 1) / mAlignment * mAlignment;
+        mBuffers.push_back({alignedLength, firstUse, lastUse, 0});
+        return mBuffers.size() - 1;
+    }
+
+    void MemoryPlanner::UseBuffer(size_t id, size_t use) {
+        DAWN_ASSERT(id < mBuffers.size());
+        Buffer& buffer = mBuffers[id];
+        buffer.firstUse = std::min(buffer.firstUse, use);
+        buffer.lastUse = std::max(buffer.lastUse, use);
+    }
+
+    void MemoryPlanner::Plan() {
+        std::vector<size_t> order(mBuffers.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+            return mBuffers[a].byteLength > mBuffers[b].byteLength;
+        });
+
+        mArenaSize = 0;
+        std::vector<const Buffer*> placed;
+        std::vector<const Buffer*> live;
+        for (size_t id : order) {
+            Buffer& buffer = mBuffers[id];
+            live.clear();
+            for (const Buffer* other : placed) {
+                if (other->firstUse <= buffer.lastUse && buffer.firstUse <= other->lastUse) {
+                    live.push_back(other);
+                }
+            }
+            std::sort(live.begin(), live.end(),
+                      [](const Buffer* a, const Buffer* b) { return a->offset < b->offset; });
+
+            // Take the smallest gap that fits, or the end of the live buffers.
+            size_t bestOffset = 0;
+            size_t bestGap = SIZE_MAX;
+            size_t current = 0;
+            for (const Buffer* other : live) {
+                if (other->offset >= current) {
+                    size_t gap = other->offset - current;
+                    if (gap >= buffer.byteLength && gap < bestGap) {
+                        bestGap = gap;
+                        bestOffset = current;
+                    }
+                }
+                current = std::max(current, other->offset + other->byteLength);
+            }
+            buffer.offset = bestGap == SIZE_MAX ? current : bestOffset;
+            mArenaSize = std::max(mArenaSize, buffer.offset + buffer.byteLength);
+            placed.push_back(&buffer);
+        }
+    }
+
+    size_t MemoryPlanner::GetOffset(size_t id) const {
+        DAWN_ASSERT(id < mBuffers.size());
+        return mBuffers[id].offset;
+    }
+
+    size_t MemoryPlanner::GetBufferCount() const {
+        return mBuffers.size();
+    }
+
+    size_t MemoryPlanner::GetArenaSize() const {
+        return mArenaSize;
+    }
+
+    size_t MemoryPlanner::GetTotalSize() const {
+        size_t total = 0;
+        for (auto& buffer : mBuffers) {
+            total += buffer.byteLength;
+        }
+        return total;
+    }
+
+}  // namespace webnn_native
@@ -0,0 +1,62 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_MEMORY_PLANNER_H_
+#define WEBNN_NATIVE_MEMORY_PLANNER_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace webnn_native {
+
+    // Places the intermediate buffers of a graph into one arena. Each buffer is live from the
+    // step that first writes it to the step that last reads it, steps being the positions of the
+    // operations in execution order. Buffers whose live ranges don't overlap may share memory.
+    class MemoryPlanner {
+      public:
+        explicit MemoryPlanner(size_t alignment = 64);
+
+        // Returns the id of the new buffer, used to query its offset after Plan().
+        size_t AddBuffer(size_t byteLength, size_t firstUse, size_t lastUse);
+        // Extends the live range of |id| so that it contains |use|.
+        void UseBuffer(size_t id, size_t use);
+
+        // Assigns the offsets greedily by decreasing size, each buffer taking the smallest gap
+        // it fits in between the already placed buffers it is live together with, or else the
+        // end of them.
+        void Plan();
+
+        size_t GetOffset(size_t id) const;
+        size_t GetBufferCount() const;
+        // The arena size, that is the planned peak memory of the intermediates.
+        size_t GetArenaSize() const;
+        // The memory needed when every buffer has its own allocation.
+        size_t GetTotalSize() const;
+
+      private:
+        struct Buffer {
+            size_t byteLength;
+            size_t firstUse;
+            size_t lastUse;
+            size_t offset;
+        };
+
+        size_t mAlignment;
+        std::vector<Buffer> mBuffers;
+        size_t mArenaSize = 0;
+    };
+
+}  // namespace webnn_native
+
+#endif  // WEBNN_NATIVE_MEMORY_PLANNER_H_
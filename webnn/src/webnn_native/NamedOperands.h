@@ -17,8 +17,10 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "webnn_native/NamedRecords.h"
+#include "webnn_native/ObjectBase.h"
 
 namespace webnn_native {
 
@@ -27,6 +29,15 @@ namespace webnn_native {
         static NamedOperandsBase* Create() {
             return new NamedOperandsBase();
         }
+
+        // Keeps an operand alive when no one else holds it, like the outputs of a deserialized
+        // graph.
+        void Retain(Ref<ObjectBase> operand) {
+            mRetainedOperands.push_back(std::move(operand));
+        }
+
+      private:
+        std::vector<Ref<ObjectBase>> mRetainedOperands;
     };
 
 }  // namespace webnn_native
@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "webnn_native/Arena.h"
 #include "webnn_native/Forward.h"
 #include "webnn_native/Graph.h"
 #include "webnn_native/ObjectBase.h"
@@ -26,12 +27,12 @@
 
 namespace webnn_native {
 
-    class OperandBase : public ObjectBase {
+    class OperandBase : public ObjectBase, public ArenaAllocated {
       public:
         OperandBase(GraphBuilderBase*, OperatorBase*);
         virtual ~OperandBase() = default;
 
-        const OperatorBase* Operator() {
+        const OperatorBase* Operator() const {
             return mOperator.Get();
         }
 
@@ -41,7 +42,7 @@ namespace webnn_native {
         void SetType(ml::OperandType type) {
             mType = type;
         }
-        std::vector<int32_t> Shape() const {
+        const std::vector<int32_t>& Shape() const {
             return mShape;
         }
 
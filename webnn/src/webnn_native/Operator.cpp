@@ -26,7 +26,7 @@ namespace webnn_native {
         : ObjectBase(graphBuilder->GetContext()), mInputs(std::move(inputs)) {
         mOutputs.reserve(outputSize);
         for (size_t i = 0; i < outputSize; ++i) {
-            mOutputs.push_back(new OperandBase(graphBuilder, this));
+            mOutputs.push_back(new (graphBuilder->GetArena()) OperandBase(graphBuilder, this));
         }
     }
 
@@ -46,6 +46,11 @@ namespace webnn_native {
         return mOutputs[0];
     }
 
+    OperatorBase* OperatorBase::Clone(GraphBuilderBase* graphBuilder,
+                                      const std::vector<Ref<OperandBase>>& inputs) const {
+        return nullptr;
+    }
+
     MaybeError OperatorBase::AddToGraph(GraphBase* graph) const {
         DAWN_UNREACHABLE();
     }
@@ -15,13 +15,14 @@
 #ifndef WEBNN_NATIVE_OPERATOR_H_
 #define WEBNN_NATIVE_OPERATOR_H_
 
+#include "webnn_native/Arena.h"
 #include "webnn_native/Forward.h"
 #include "webnn_native/ObjectBase.h"
 #include "webnn_native/Operand.h"
 
 namespace webnn_native {
 
-    class OperatorBase : public ObjectBase {
+    class OperatorBase : public ObjectBase, public ArenaAllocated {
       public:
         explicit OperatorBase(GraphBuilderBase* GraphBuilder,
                               std::vector<Ref<OperandBase>> inputs = {},
@@ -31,16 +32,32 @@ namespace webnn_native {
         const std::vector<Ref<OperandBase>>& Inputs() const;
         const std::vector<OperandBase*>& Outputs() const;
         OperandBase* PrimaryOutput() const;
+        // Returns a new operator computing the same values as this one from |inputs|, which
+        // stand for its inputs in order, or nullptr for the operators without inputs. The graph
+        // optimizer clones the consumers of the operands it replaces instead of changing them.
+        virtual OperatorBase* Clone(GraphBuilderBase* builder,
+                                    const std::vector<Ref<OperandBase>>& inputs) const;
 
         // Add the operand to model for specific backend.
         virtual MaybeError AddToGraph(GraphBase* graph) const;
         virtual MaybeError ValidateAndInferOutputInfo();
+        // Whether the outputs depend on the previous computes of the graph, which keeps a state.
+        virtual bool IsStateful() const {
+            return false;
+        }
 
         static OperatorBase* MakeError(GraphBuilderBase* graphBuilder);
 
       private:
         OperatorBase(GraphBuilderBase* graphBuilder, ObjectBase::ErrorTag tag);
 
+        // The number given to the operator by the last sort that reached it, which indexes the
+        // state of the sort instead of a hash set. The sorts of a builder are serialized by its
+        // lock.
+        friend class GraphBuilderBase;
+        mutable uint64_t mSortEpoch = 0;
+        mutable uint32_t mSortIndex = 0;
+
       protected:
         // The input operands of operator.
         std::vector<Ref<OperandBase>> mInputs;
@@ -0,0 +1,203 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/Profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <tuple>
+
+#include "dawn_platform/tracing/TraceEvent.h"
+
+namespace webnn_native {
+
+    namespace {
+
+        void WriteJsonString(std::ostringstream& stream, const std::string& value) {
+            stream << '"';
+            for (char c : value) {
+                if (c == '"' || c == '\\') {
+                    stream << '\\' << c;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    stream << escaped;
+                } else {
+                    stream << c;
+                }
+            }
+            stream << '"';
+        }
+
+    }  // namespace
+
+    const unsigned char* Profiler::GetTraceCategoryEnabledFlag(
+        dawn_platform::TraceCategory category) {
+        static unsigned char enabled = 1;
+        return &enabled;
+    }
+
+    double Profiler::MonotonicallyIncreasingTime() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    uint64_t Profiler::AddTraceEvent(char phase,
+                                     const unsigned char* categoryGroupEnabled,
+                                     const char* name,
+                                     uint64_t id,
+                                     double timestamp,
+                                     int numArgs,
+                                     const char** argNames,
+                                     const unsigned char* argTypes,
+                                     const uint64_t* argValues,
+                                     unsigned char flags) {
+        Event event = {phase, name, timestamp, 0, (flags & TRACE_EVENT_FLAG_HAS_ID) != 0, id, {}};
+        for (int i = 0; i < numArgs; ++i) {
+            Argument argument = {argNames[i], argTypes[i], argValues[i], {}};
+            if (argTypes[i] == TRACE_VALUE_TYPE_STRING ||
+                argTypes[i] == TRACE_VALUE_TYPE_COPY_STRING) {
+                argument.string = reinterpret_cast<const char*>(argValues[i]);
+            }
+            event.arguments.push_back(std::move(argument));
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto threadId = mThreadIds.emplace(std::this_thread::get_id(), mThreadIds.size());
+        event.threadId = threadId.first->second;
+        mEvents.push_back(std::move(event));
+        return mEvents.size();
+    }
+
+    void Profiler::BeginOperator(uint64_t index, const char* kernel, uint64_t byteLength) {
+        const char* argNames[2] = {"kernel", "bytes"};
+        const unsigned char argTypes[2] = {TRACE_VALUE_TYPE_STRING, TRACE_VALUE_TYPE_UINT};
+        const uint64_t argValues[2] = {reinterpret_cast<uint64_t>(kernel), byteLength};
+        AddTraceEvent(TRACE_EVENT_PHASE_BEGIN,
+                      GetTraceCategoryEnabledFlag(dawn_platform::TraceCategory::General), kernel,
+                      index, MonotonicallyIncreasingTime(), 2, argNames, argTypes, argValues,
+                      TRACE_EVENT_FLAG_HAS_ID);
+    }
+
+    void Profiler::EndOperator(uint64_t index, const char* kernel) {
+        AddTraceEvent(TRACE_EVENT_PHASE_END,
+                      GetTraceCategoryEnabledFlag(dawn_platform::TraceCategory::General), kernel,
+                      index, MonotonicallyIncreasingTime(), 0, nullptr, nullptr, nullptr,
+                      TRACE_EVENT_FLAG_HAS_ID);
+    }
+
+    std::vector<OperatorProfile> Profiler::GetOperatorProfiles() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        // The events of a thread nest, a compute opening the outer level and its operators the
+        // level below, unless they are traced with their index on another thread.
+        struct ThreadState {
+            std::vector<const Event*> openEvents;
+            uint32_t operatorIndex = 0;
+        };
+        std::map<uint32_t, ThreadState> threads;
+        std::map<std::tuple<uint32_t, std::string, std::string, uint64_t>, OperatorProfile>
+            profiles;
+        for (const Event& event : mEvents) {
+            ThreadState& thread = threads[event.threadId];
+            if (event.phase == TRACE_EVENT_PHASE_BEGIN) {
+                if (thread.openEvents.empty()) {
+                    thread.operatorIndex = 0;
+                }
+                thread.openEvents.push_back(&event);
+                continue;
+            }
+            if (event.phase != TRACE_EVENT_PHASE_END || thread.openEvents.empty()) {
+                continue;
+            }
+            const Event* begin = thread.openEvents.back();
+            thread.openEvents.pop_back();
+            if (!begin->hasId && thread.openEvents.size() != 1) {
+                continue;
+            }
+            OperatorProfile profile;
+            profile.index =
+                begin->hasId ? static_cast<uint32_t>(begin->id) : thread.operatorIndex++;
+            profile.name = begin->name;
+            for (const Argument& argument : begin->arguments) {
+                if (argument.name == "kernel") {
+                    profile.kernel = argument.string;
+                } else if (argument.name == "bytes") {
+                    profile.byteLength = argument.value;
+                }
+            }
+            auto key =
+                std::make_tuple(profile.index, profile.name, profile.kernel, profile.byteLength);
+            auto entry = profiles.emplace(key, std::move(profile)).first;
+            entry->second.executionCount++;
+            entry->second.totalTime += (event.timestamp - begin->timestamp) * 1000.0;
+        }
+
+        std::vector<OperatorProfile> result;
+        for (auto& profile : profiles) {
+            result.push_back(std::move(profile.second));
+        }
+        return result;
+    }
+
+    std::string Profiler::GetChromeTrace() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::ostringstream stream;
+        stream.precision(3);
+        stream << std::fixed << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (size_t i = 0; i < mEvents.size(); ++i) {
+            const Event& event = mEvents[i];
+            stream << (i == 0 ? "" : ",") << "{\"name\":";
+            WriteJsonString(stream, event.name);
+            stream << ",\"cat\":\"webnn\",\"ph\":\"" << event.phase
+                   << "\",\"ts\":" << event.timestamp * 1e6 << ",\"pid\":0,\"tid\":"
+                   << event.threadId << ",\"args\":{";
+            for (size_t j = 0; j < event.arguments.size(); ++j) {
+                const Argument& argument = event.arguments[j];
+                stream << (j == 0 ? "" : ",");
+                WriteJsonString(stream, argument.name);
+                stream << ":";
+                switch (argument.type) {
+                    case TRACE_VALUE_TYPE_BOOL:
+                        stream << (argument.value != 0 ? "true" : "false");
+                        break;
+                    case TRACE_VALUE_TYPE_UINT:
+                        stream << argument.value;
+                        break;
+                    case TRACE_VALUE_TYPE_INT:
+                        stream << static_cast<int64_t>(argument.value);
+                        break;
+                    case TRACE_VALUE_TYPE_DOUBLE: {
+                        double value;
+                        memcpy(&value, &argument.value, sizeof(value));
+                        stream << value;
+                        break;
+                    }
+                    case TRACE_VALUE_TYPE_STRING:
+                    case TRACE_VALUE_TYPE_COPY_STRING:
+                        WriteJsonString(stream, argument.string);
+                        break;
+                    default:
+                        stream << "null";
+                        break;
+                }
+            }
+            stream << "}}";
+        }
+        stream << "]}";
+        return stream.str();
+    }
+
+}  // namespace webnn_native
@@ -0,0 +1,93 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_PROFILER_H_
+#define WEBNN_NATIVE_PROFILER_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dawn_platform/DawnPlatform.h"
+#include "webnn_native/WebnnNative.h"
+
+namespace webnn_native {
+
+    // The platform receiving the trace events of the computes of a graph whose context enables
+    // profiling. GraphBase traces each compute and the backends trace each operator they execute
+    // inside it with the TRACE_EVENT macros, naming the kernel in a "kernel" argument and the
+    // bytes it touches in a "bytes" argument.
+    //
+    // The events are kept until the graph is released, so profiling is meant for measuring a
+    // bounded number of computes.
+    class Profiler : public dawn_platform::Platform {
+      public:
+        Profiler() = default;
+        ~Profiler() override = default;
+
+        // The macros cache the flag of their call site, so all the profilers return the same
+        // flag, which is always enabled. Call sites must only trace to a non-null profiler.
+        const unsigned char* GetTraceCategoryEnabledFlag(
+            dawn_platform::TraceCategory category) override;
+        double MonotonicallyIncreasingTime() override;
+        uint64_t AddTraceEvent(char phase,
+                               const unsigned char* categoryGroupEnabled,
+                               const char* name,
+                               uint64_t id,
+                               double timestamp,
+                               int numArgs,
+                               const char** argNames,
+                               const unsigned char* argTypes,
+                               const uint64_t* argValues,
+                               unsigned char flags) override;
+
+        // Traces the operator at |index| of a compute, which may run on another thread than the
+        // compute, e.g. on an inter-op lane of the CPU backend, where its position among the
+        // events of its thread doesn't tell it. |kernel| must outlive the profiler.
+        void BeginOperator(uint64_t index, const char* kernel, uint64_t byteLength);
+        void EndOperator(uint64_t index, const char* kernel);
+
+        // Sums the events of each operator over the computes, an operator being known by its
+        // index when traced with one, or else by its position in the compute enclosing it.
+        std::vector<OperatorProfile> GetOperatorProfiles();
+        std::string GetChromeTrace();
+
+      private:
+        struct Argument {
+            std::string name;
+            unsigned char type;
+            uint64_t value;
+            std::string string;
+        };
+        struct Event {
+            char phase;
+            std::string name;
+            double timestamp;
+            uint32_t threadId;
+            bool hasId;
+            uint64_t id;
+            std::vector<Argument> arguments;
+        };
+
+        std::mutex mMutex;
+        std::vector<Event> mEvents;
+        std::map<std::thread::id, uint32_t> mThreadIds;
+    };
+
+}  // namespace webnn_native
+
+#endif  // WEBNN_NATIVE_PROFILER_H_
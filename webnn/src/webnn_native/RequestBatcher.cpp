@@ -0,0 +1,242 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/RequestBatcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include "common/Assert.h"
+
+namespace webnn_native {
+
+    RequestBatcherBase::RequestBatcherBase(GraphBase* graph, const RequestBatcherOptions& options)
+        : mGraph(graph), mLayout(graph->GetBatchItemLayout()), mOptions(options) {
+        mOptions.maxBatchSize = std::max(mOptions.maxBatchSize, 1u);
+        // The full batches are the most common under load, so their graph is built now rather
+        // than by the first of them.
+        if (mLayout != nullptr && !mGraph->IsStateful()) {
+            mGraph->GetContext()->ConsumedError(
+                mGraph->PrepareBatchSize(static_cast<int32_t>(mOptions.maxBatchSize)));
+        }
+    }
+
+    MLComputeGraphStatus RequestBatcherBase::Compute(NamedInputsBase* inputs,
+                                                     NamedOutputsBase* outputs) {
+        if (inputs == nullptr || outputs == nullptr) {
+            return MLComputeGraphStatus_Error;
+        }
+        const int32_t batchSize = GetBatchSize(inputs, outputs);
+        if (batchSize == 0) {
+            return mGraph->APICompute(inputs, outputs);
+        }
+
+        Request request = {inputs, outputs, batchSize, 0, MLComputeGraphStatus_Success, false};
+        const int32_t maxBatchSize = static_cast<int32_t>(mOptions.maxBatchSize);
+        std::unique_lock<std::mutex> lock(mMutex);
+        Record(&mStats.queueDepths, mWaitingCount);
+        ++mWaitingCount;
+        if (mOpenBatch != nullptr) {
+            if (mOpenBatch->batchSize + batchSize <= maxBatchSize) {
+                request.offset = mOpenBatch->batchSize;
+                mOpenBatch->requests.push_back(&request);
+                mOpenBatch->batchSize += batchSize;
+                if (mOpenBatch->batchSize == maxBatchSize) {
+                    CloseBatch(mOpenBatch);
+                }
+                mCondition.wait(lock, [&request] { return request.done; });
+                return request.status;
+            }
+            // The open batch is computed now, the request starts the next one.
+            CloseBatch(mOpenBatch);
+        }
+
+        Batch batch;
+        batch.requests.push_back(&request);
+        batch.batchSize = batchSize;
+        mOpenBatch = &batch;
+        if (batchSize == maxBatchSize) {
+            CloseBatch(&batch);
+        }
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::microseconds(mOptions.maxDelay);
+        mCondition.wait_until(lock, deadline, [&batch] { return batch.closed; });
+        if (!batch.closed) {
+            CloseBatch(&batch);
+        }
+        mWaitingCount -= batch.requests.size();
+        Record(&mStats.batchSizes, batch.batchSize);
+        lock.unlock();
+
+        ComputeBatch(&batch);
+
+        lock.lock();
+        for (Request* batchRequest : batch.requests) {
+            batchRequest->done = true;
+        }
+        mCondition.notify_all();
+        return request.status;
+    }
+
+    RequestBatcherStats RequestBatcherBase::GetStats() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStats;
+    }
+
+    int32_t RequestBatcherBase::GetBatchSize(NamedInputsBase* inputs,
+                                             NamedOutputsBase* outputs) const {
+        // The items of a stateful graph would share the state of unrelated requests.
+        if (mLayout == nullptr || mGraph->IsStateful() ||
+            inputs->GetRecords().size() != mLayout->inputShapes.size()) {
+            return 0;
+        }
+        // The inputs without dimensions have the batch size of the others like in a compute.
+        int32_t batchSize = 1;
+        for (auto& inputShape : mLayout->inputShapes) {
+            const Input* input = inputs->APIGet(inputShape.first.c_str());
+            if (input == nullptr) {
+                return 0;
+            }
+            if (input->dimensions == nullptr) {
+                continue;
+            }
+            const std::vector<int32_t>& shape = inputShape.second;
+            if (input->dimensionsCount != shape.size() || input->dimensions[0] <= 0 ||
+                !std::equal(shape.begin() + 1, shape.end(), input->dimensions + 1)) {
+                return 0;
+            }
+            batchSize = input->dimensions[0];
+        }
+        if (batchSize > static_cast<int32_t>(mOptions.maxBatchSize)) {
+            return 0;
+        }
+        for (auto& input : inputs->GetRecords()) {
+            if ((input.second->dimensions != nullptr && input.second->dimensions[0] != batchSize) ||
+                input.second->resource.byteLength <
+                    batchSize * mLayout->inputByteLengths.at(input.first)) {
+                return 0;
+            }
+        }
+        if (outputs->GetRecords().empty()) {
+            return 0;
+        }
+        for (auto& output : outputs->GetRecords()) {
+            auto itemByteLength = mLayout->outputByteLengths.find(output.first);
+            if (itemByteLength == mLayout->outputByteLengths.end() ||
+                output.second->byteLength < batchSize * itemByteLength->second) {
+                return 0;
+            }
+        }
+        return batchSize;
+    }
+
+    int32_t RequestBatcherBase::GetPaddedBatchSize(int32_t batchSize) const {
+        const int32_t maxBatchSize = static_cast<int32_t>(mOptions.maxBatchSize);
+        int32_t paddedBatchSize = 1;
+        while (paddedBatchSize < batchSize && paddedBatchSize < maxBatchSize) {
+            paddedBatchSize *= 2;
+        }
+        return std::min(paddedBatchSize, maxBatchSize);
+    }
+
+    void RequestBatcherBase::ComputeBatch(Batch* batch) {
+        const int32_t paddedBatchSize = GetPaddedBatchSize(batch->batchSize);
+        if (batch->requests.size() == 1 && batch->batchSize == paddedBatchSize) {
+            Request* request = batch->requests[0];
+            request->status = mGraph->APICompute(request->inputs, request->outputs);
+            return;
+        }
+
+        // Gather the items of the requests into the inputs of the batch, the padding items are
+        // zeros whose outputs are dropped.
+        const size_t inputCount = mLayout->inputShapes.size();
+        std::vector<std::vector<int8_t>> inputBuffers(inputCount);
+        std::vector<std::vector<int32_t>> inputDimensions(inputCount);
+        std::vector<Input> batchInputs(inputCount);
+        Ref<NamedInputsBase> namedInputs = AcquireRef(new NamedInputsBase());
+        size_t index = 0;
+        for (auto& inputShape : mLayout->inputShapes) {
+            const std::string& name = inputShape.first;
+            const size_t itemByteLength = mLayout->inputByteLengths.at(name);
+            std::vector<int8_t>& buffer = inputBuffers[index];
+            buffer.resize(paddedBatchSize * itemByteLength);
+            for (Request* request : batch->requests) {
+                const ArrayBufferView& resource = request->inputs->APIGet(name.c_str())->resource;
+                memcpy(buffer.data() + request->offset * itemByteLength,
+                       static_cast<int8_t*>(resource.buffer) + resource.byteOffset,
+                       request->batchSize * itemByteLength);
+            }
+            inputDimensions[index] = inputShape.second;
+            inputDimensions[index][0] = paddedBatchSize;
+            Input& input = batchInputs[index];
+            input.resource = {buffer.data(), buffer.size()};
+            input.dimensions = inputDimensions[index].data();
+            input.dimensionsCount = inputDimensions[index].size();
+            namedInputs->APISet(name.c_str(), &input);
+            ++index;
+        }
+
+        // All the outputs are computed and scattered to the requests reading them.
+        const size_t outputCount = mLayout->outputByteLengths.size();
+        std::vector<std::vector<int8_t>> outputBuffers(outputCount);
+        std::vector<ArrayBufferView> batchOutputs(outputCount);
+        Ref<NamedOutputsBase> namedOutputs = AcquireRef(new NamedOutputsBase());
+        index = 0;
+        for (auto& itemByteLength : mLayout->outputByteLengths) {
+            outputBuffers[index].resize(paddedBatchSize * itemByteLength.second);
+            batchOutputs[index] = {outputBuffers[index].data(), outputBuffers[index].size()};
+            namedOutputs->APISet(itemByteLength.first.c_str(), &batchOutputs[index]);
+            ++index;
+        }
+
+        const MLComputeGraphStatus status =
+            mGraph->APICompute(namedInputs.Get(), namedOutputs.Get());
+        for (Request* request : batch->requests) {
+            request->status = status;
+            if (status != MLComputeGraphStatus_Success) {
+                continue;
+            }
+            index = 0;
+            for (auto& itemByteLength : mLayout->outputByteLengths) {
+                const ArrayBufferView* output =
+                    request->outputs->APIGet(itemByteLength.first.c_str());
+                if (output != nullptr) {
+                    memcpy(static_cast<int8_t*>(output->buffer) + output->byteOffset,
+                           outputBuffers[index].data() + request->offset * itemByteLength.second,
+                           request->batchSize * itemByteLength.second);
+                }
+                ++index;
+            }
+        }
+    }
+
+    void RequestBatcherBase::CloseBatch(Batch* batch) {
+        DAWN_ASSERT(!batch->closed);
+        batch->closed = true;
+        if (mOpenBatch == batch) {
+            mOpenBatch = nullptr;
+        }
+        mCondition.notify_all();
+    }
+
+    void RequestBatcherBase::Record(std::vector<uint64_t>* histogram, size_t value) {
+        if (histogram->size() <= value) {
+            histogram->resize(value + 1, 0);
+        }
+        ++(*histogram)[value];
+    }
+
+}  // namespace webnn_native
@@ -0,0 +1,85 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_REQUEST_BATCHER_H_
+#define WEBNN_NATIVE_REQUEST_BATCHER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "common/RefCounted.h"
+#include "webnn_native/Graph.h"
+#include "webnn_native/NamedInputs.h"
+#include "webnn_native/NamedOutputs.h"
+#include "webnn_native/WebnnNative.h"
+
+namespace webnn_native {
+
+    // There is no batcher thread, the first request of a batch computes it. It waits for the
+    // other requests until the batch is full or maxDelay has passed, and the others wait until
+    // it has scattered the outputs back.
+    class RequestBatcherBase {
+      public:
+        RequestBatcherBase(GraphBase* graph, const RequestBatcherOptions& options);
+
+        MLComputeGraphStatus Compute(NamedInputsBase* inputs, NamedOutputsBase* outputs);
+        RequestBatcherStats GetStats();
+
+      private:
+        struct Request {
+            NamedInputsBase* inputs;
+            NamedOutputsBase* outputs;
+            // The items of the request and the first of them in its batch.
+            int32_t batchSize;
+            int32_t offset;
+            MLComputeGraphStatus status;
+            bool done;
+        };
+        struct Batch {
+            std::vector<Request*> requests;
+            int32_t batchSize = 0;
+            // Whether no more requests join the batch.
+            bool closed = false;
+        };
+
+        // Returns the number of items of the request, or 0 when its inputs and outputs don't fit
+        // the layout of a batch.
+        int32_t GetBatchSize(NamedInputsBase* inputs, NamedOutputsBase* outputs) const;
+        // The batches are padded to the next power of two up to maxBatchSize, so that graphs are
+        // built for few batch sizes.
+        int32_t GetPaddedBatchSize(int32_t batchSize) const;
+        // Computes the batch and sets the status of its requests.
+        void ComputeBatch(Batch* batch);
+        // Called with mMutex held.
+        void CloseBatch(Batch* batch);
+        void Record(std::vector<uint64_t>* histogram, size_t value);
+
+        Ref<GraphBase> mGraph;
+        const BatchItemLayout* mLayout;
+        RequestBatcherOptions mOptions;
+
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        // The batch the next requests join, or null.
+        Batch* mOpenBatch = nullptr;
+        // The requests of the batches which haven't started to compute.
+        size_t mWaitingCount = 0;
+        RequestBatcherStats mStats;
+    };
+
+}  // namespace webnn_native
+
+#endif  // WEBNN_NATIVE_REQUEST_BATCHER_H_
@@ -42,4 +42,30 @@ namespace webnn_native { namespace utils {
                 DAWN_UNREACHABLE();
         }
     }
+
+    void ComputeImplicitPaddingForConvTransposeAutoPad(ml::AutoPad autoPad,
+                                                       int32_t dilation,
+                                                       int32_t inputSize,
+                                                       int32_t filterSize,
+                                                       int32_t stride,
+                                                       int32_t outputPadding,
+                                                       int32_t& paddingBegin,
+                                                       int32_t& paddingEnd) {
+        int32_t outSize = inputSize * stride;
+        int32_t dilatedFilter = (filterSize - 1) * dilation + 1;
+        int32_t neededOutput = (inputSize - 1) * stride + dilatedFilter + outputPadding;
+        int32_t totalPadding = neededOutput > outSize ? neededOutput - outSize : 0;
+        switch (autoPad) {
+            case ml::AutoPad::SameUpper:
+                paddingBegin = totalPadding / 2;
+                paddingEnd = (totalPadding + 1) / 2;
+                break;
+            case ml::AutoPad::SameLower:
+                paddingBegin = (totalPadding + 1) / 2;
+                paddingEnd = totalPadding / 2;
+                break;
+            default:
+                DAWN_UNREACHABLE();
+        }
+    }
 }}  // namespace webnn_native::utils
\ No newline at end of file
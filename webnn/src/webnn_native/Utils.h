@@ -25,6 +25,16 @@ namespace webnn_native { namespace utils {
                                           int32_t stride,
                                           int32_t& paddingBegin,
                                           int32_t& paddingEnd);
+    // The implicit padding of a transposed convolution, whose output is |stride| times as large
+    // as its input.
+    void ComputeImplicitPaddingForConvTransposeAutoPad(ml::AutoPad autoPad,
+                                                       int32_t dilation,
+                                                       int32_t inputSize,
+                                                       int32_t filterSize,
+                                                       int32_t stride,
+                                                       int32_t outputPadding,
+                                                       int32_t& paddingBegin,
+                                                       int32_t& paddingEnd);
 }}  // namespace webnn_native::utils
 
 #endif  // WEBNN_NATIVE_OPERATOR_H_
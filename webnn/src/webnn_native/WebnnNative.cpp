@@ -18,8 +18,11 @@
 #include <memory>
 
 #include "common/Assert.h"
+#include "webnn_native/ConstantPool.h"
 #include "webnn_native/Context.h"
+#include "webnn_native/Graph.h"
 #include "webnn_native/Instance.h"
+#include "webnn_native/RequestBatcher.h"
 
 #if defined(_WIN32)
 #    include <crtdbg.h>
@@ -80,4 +83,52 @@ namespace webnn_native {
         return GetProcsAutogen();
     }
 
+    ConstantPoolStats GetConstantPoolStats() {
+        return ConstantPool::Get()->GetStats();
+    }
+
+    ComputeCopyStats GetComputeCopyStats(MLGraph graph) {
+        return reinterpret_cast<GraphBase*>(graph)->GetComputeCopyStats();
+    }
+
+    GraphOptimizationStats GetGraphOptimizationStats(MLGraph graph) {
+        return reinterpret_cast<GraphBase*>(graph)->GetOptimizationStats();
+    }
+
+    std::vector<OperatorProfile> GetOperatorProfiles(MLGraph graph) {
+        Profiler* profiler = reinterpret_cast<GraphBase*>(graph)->GetProfiler();
+        if (profiler == nullptr) {
+            return {};
+        }
+        return profiler->GetOperatorProfiles();
+    }
+
+    std::string GetChromeTrace(MLGraph graph) {
+        Profiler* profiler = reinterpret_cast<GraphBase*>(graph)->GetProfiler();
+        if (profiler == nullptr) {
+            return {};
+        }
+        return profiler->GetChromeTrace();
+    }
+
+    // RequestBatcher
+
+    RequestBatcher::RequestBatcher(MLGraph graph, const RequestBatcherOptions& options)
+        : mImpl(new RequestBatcherBase(reinterpret_cast<GraphBase*>(graph), options)) {
+    }
+
+    RequestBatcher::~RequestBatcher() {
+        delete mImpl;
+        mImpl = nullptr;
+    }
+
+    MLComputeGraphStatus RequestBatcher::Compute(MLNamedInputs inputs, MLNamedOutputs outputs) {
+        return mImpl->Compute(reinterpret_cast<NamedInputsBase*>(inputs),
+                              reinterpret_cast<NamedOutputsBase*>(outputs));
+    }
+
+    RequestBatcherStats RequestBatcher::GetStats() const {
+        return mImpl->GetStats();
+    }
+
 }  // namespace webnn_native
@@ -0,0 +1,68 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/cpu/ContextCPU.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "common/Log.h"
+#include "common/RefCounted.h"
+#include "webnn_native/cpu/GraphCPU.h"
+
+namespace webnn_native { namespace cpu {
+
+    Context::Context(ContextOptions const* options) : ContextBase(options) {
+        const ContextOptions contextOptions = GetContextOptions();
+        // The computes of a graph share its buffers and run one at a time, so the stream count
+        // doesn't apply and the whole pool serves each compute. The inter-op thread count splits
+        // it between the independent operators of a compute instead.
+        if (contextOptions.threadPinning == ml::ThreadPinning::Numa) {
+            dawn::WarningLog() << "NUMA pinning isn't supported, the threads are left unpinned.";
+        }
+        if (contextOptions.precisionHint == ml::PrecisionHint::Float16 ||
+            contextOptions.precisionHint == ml::PrecisionHint::Bfloat16) {
+            dawn::WarningLog() << "The CPU backend only computes in float32.";
+        }
+        // The threads are split between the lanes, each of which computes one operator at a time
+        // with the threads of its own pool, whose calling thread is a thread of the inter-op pool.
+        const bool pinThreads = contextOptions.threadPinning == ml::ThreadPinning::Cores;
+        const uint32_t threadCount = contextOptions.threadCount != 0
+                                         ? contextOptions.threadCount
+                                         : std::max(1u, std::thread::hardware_concurrency());
+        const uint32_t laneCount =
+            std::max(1u, std::min(contextOptions.interOpThreadCount, threadCount));
+        const uint32_t laneThreadCount = threadCount / laneCount;
+        for (uint32_t i = 0; i < laneCount; ++i) {
+            mLanePools.emplace_back(
+                new ThreadPool(laneThreadCount, pinThreads, i * laneThreadCount));
+        }
+        if (laneCount > 1) {
+            mInterOpPool.reset(new ThreadPool(laneCount));
+        }
+    }
+
+    std::vector<ThreadPool*> Context::GetLanePools() const {
+        std::vector<ThreadPool*> lanePools;
+        for (auto& pool : mLanePools) {
+            lanePools.push_back(pool.get());
+        }
+        return lanePools;
+    }
+
+    GraphBase* Context::CreateGraphImpl() {
+        return new Graph(this);
+    }
+
+}}  // namespace webnn_native::cpu
@@ -0,0 +1,53 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_CPU_CONTEXT_CPU_H_
+#define WEBNN_NATIVE_CPU_CONTEXT_CPU_H_
+
+#include <memory>
+#include <vector>
+
+#include "webnn_native/Context.h"
+#include "webnn_native/cpu/ThreadPoolCPU.h"
+
+namespace webnn_native { namespace cpu {
+
+    class Context : public ContextBase {
+      public:
+        explicit Context(ContextOptions const* options);
+        ~Context() override = default;
+
+        // The pools are shared by all the graphs of the context. The pool of the first lane
+        // also serves the work done at build time.
+        ThreadPool* GetThreadPool() {
+            return mLanePools[0].get();
+        }
+        // The pools of the lanes computing independent operators at once, a single one unless
+        // the inter-op thread count is more than 1.
+        std::vector<ThreadPool*> GetLanePools() const;
+        // The pool whose threads drive the lanes, or null for a single lane.
+        ThreadPool* GetInterOpPool() {
+            return mInterOpPool.get();
+        }
+
+      private:
+        GraphBase* CreateGraphImpl() override;
+
+        std::vector<std::unique_ptr<ThreadPool>> mLanePools;
+        std::unique_ptr<ThreadPool> mInterOpPool;
+    };
+
+}}  // namespace webnn_native::cpu
+
+#endif  // WEBNN_NATIVE_CPU_CONTEXT_CPU_H_
@@ -0,0 +1,1350 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/cpu/GraphCPU.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/Assert.h"
+#include "common/Log.h"
+#include "dawn_native/ErrorData.h"
+#include "webnn_native/BindingSet.h"
+#include "webnn_native/ConstantPool.h"
+#include "webnn_native/NamedInputs.h"
+#include "webnn_native/NamedOutputs.h"
+#include "webnn_native/Profiler.h"
+#include "webnn_native/Utils.h"
+
+namespace webnn_native { namespace cpu {
+
+    namespace {
+
+        using kernels::Activation;
+        using kernels::ActivationType;
+        using kernels::Shape;
+
+        const std::vector<int32_t> kNhwcToNchw = {0, 3, 1, 2};
+        const std::vector<int32_t> kNchwToNhwc = {0, 2, 3, 1};
+
+        Activation GetActivation(const FusionOperatorBase* activation) {
+            Activation cpuActivation;
+            if (activation == nullptr) {
+                return cpuActivation;
+            }
+            switch (activation->GetFusionType()) {
+                case FusionType::Clamp: {
+                    auto clamp = reinterpret_cast<const op::FusionClamp*>(activation);
+                    cpuActivation.type = ActivationType::Clamp;
+                    cpuActivation.minValue = clamp->GetMinValue();
+                    cpuActivation.maxValue = clamp->GetMaxValue();
+                    break;
+                }
+                case FusionType::HardSwish:
+                    cpuActivation.type = ActivationType::HardSwish;
+                    break;
+                case FusionType::LeakyRelu:
+                    cpuActivation.type = ActivationType::LeakyRelu;
+                    cpuActivation.alpha =
+                        reinterpret_cast<const op::FusionLeakyRelu*>(activation)->GetAlpha();
+                    break;
+                case FusionType::Relu:
+                    cpuActivation.type = ActivationType::Relu;
+                    break;
+                case FusionType::Sigmoid:
+                    cpuActivation.type = ActivationType::Sigmoid;
+                    break;
+                case FusionType::Tanh:
+                    cpuActivation.type = ActivationType::Tanh;
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+            return cpuActivation;
+        }
+
+        // The permutation from |layout| to oihw.
+        std::vector<int32_t> FilterToOihw(ml::FilterOperandLayout layout) {
+            switch (layout) {
+                case ml::FilterOperandLayout::Oihw:
+                    return {};
+                case ml::FilterOperandLayout::Hwio:
+                    return {3, 2, 0, 1};
+                case ml::FilterOperandLayout::Ohwi:
+                    return {0, 3, 1, 2};
+                case ml::FilterOperandLayout::Ihwo:
+                    return {3, 0, 1, 2};
+                default:
+                    UNREACHABLE();
+                    return {};
+            }
+        }
+
+        // Resolves the begin and end padding of the height and width of a convolution or pooling
+        // window, in the order of the options. A transposed convolution passes its
+        // |outputPadding|.
+        std::vector<int32_t> ResolvePadding(ml::AutoPad autoPad,
+                                            const int32_t* padding,
+                                            const int32_t* strides,
+                                            const int32_t* dilations,
+                                            int32_t inputHeight,
+                                            int32_t inputWidth,
+                                            int32_t filterHeight,
+                                            int32_t filterWidth,
+                                            const int32_t* outputPadding = nullptr) {
+            std::vector<int32_t> resolved(padding, padding + 4);
+            if (autoPad != ml::AutoPad::Explicit && outputPadding != nullptr) {
+                utils::ComputeImplicitPaddingForConvTransposeAutoPad(
+                    autoPad, dilations[0], inputHeight, filterHeight, strides[0],
+                    outputPadding[0], resolved[0], resolved[1]);
+                utils::ComputeImplicitPaddingForConvTransposeAutoPad(
+                    autoPad, dilations[1], inputWidth, filterWidth, strides[1], outputPadding[1],
+                    resolved[2], resolved[3]);
+            } else if (autoPad != ml::AutoPad::Explicit) {
+                utils::ComputeImplicitPaddingForAutoPad(autoPad, dilations[0], inputHeight,
+                                                        filterHeight, strides[0], resolved[0],
+                                                        resolved[1]);
+                utils::ComputeImplicitPaddingForAutoPad(autoPad, dilations[1], inputWidth,
+                                                        filterWidth, strides[1], resolved[2],
+                                                        resolved[3]);
+            }
+            return resolved;
+        }
+
+    }  // anonymous namespace
+
+    Graph::Graph(Context* context)
+        : GraphBase(context),
+          mThreadPool(context->GetThreadPool()),
+          mInterOpPool(context->GetInterOpPool()),
+          mLanePools(context->GetLanePools()) {
+    }
+
+    MaybeError Graph::CheckBuffer(const OperandBase* operand) {
+        if (mOperandBufferMap.find(operand) != mOperandBufferMap.end()) {
+            return {};
+        }
+        auto dequantization = mDequantizations.find(operand);
+        if (dequantization == mDequantizations.end()) {
+            return DAWN_UNIMPLEMENTED_ERROR("The CPU backend only supports float32 operands.");
+        }
+        // The map never erases, so the operation can keep a pointer to the dequantization.
+        const Dequantization* d = &dequantization->second;
+        const size_t count = kernels::SizeOfShape(d->shape);
+        if (d->isConstant) {
+            std::vector<float> values(count);
+            kernels::DequantizeLinear(mThreadPool, d->input, d->isSigned, count, d->channels,
+                                      d->inner, d->scales.data(), d->zeroPoints.data(),
+                                      values.data());
+            mOperandBufferMap[operand] = PoolConstant(values.data(), d->shape);
+            return {};
+        }
+        float* output = CreateBuffer(operand);
+        AddOperation("DequantizeLinear", count * (1 + sizeof(float)), {d->input}, {output},
+                     [=](ThreadPool* pool) {
+                         kernels::DequantizeLinear(pool, d->input, d->isSigned, count, d->channels,
+                                                   d->inner, d->scales.data(), d->zeroPoints.data(),
+                                                   output);
+                     });
+        return {};
+    }
+
+    MaybeError Graph::CheckInputs(const OperatorBase* op) {
+        for (auto& input : op->Inputs()) {
+            DAWN_TRY(CheckBuffer(input.Get()));
+        }
+        return {};
+    }
+
+    const Graph::Dequantization* Graph::GetDequantization(const OperandBase* operand) const {
+        auto dequantization = mDequantizations.find(operand);
+        return dequantization != mDequantizations.end() ? &dequantization->second : nullptr;
+    }
+
+    float* Graph::GetBuffer(const OperandBase* operand) const {
+        DAWN_ASSERT(mOperandBufferMap.find(operand) != mOperandBufferMap.end());
+        return mOperandBufferMap.at(operand);
+    }
+
+    float* Graph::AllocateBuffer(size_t count) {
+        mBuffers.emplace_back(std::max<size_t>(count, 1));
+        return mBuffers.back().data();
+    }
+
+    float* Graph::CreateBuffer(const OperandBase* operand) {
+        float* buffer = AllocateBuffer(kernels::SizeOfShape(operand->Shape()));
+        mOperandBufferMap[operand] = buffer;
+        return buffer;
+    }
+
+    void* Graph::CreateQuantizedBuffer(const OperandBase* operand) {
+        const size_t count = kernels::SizeOfShape(operand->Shape());
+        mQuantizedBuffers.emplace_back(std::max<size_t>(count, 1));
+        void* buffer = mQuantizedBuffers.back().data();
+        mQuantizedBufferMap[operand] = buffer;
+        return buffer;
+    }
+
+    int16_t* Graph::AllocateWidenedBuffer(size_t count) {
+        mWidenedBuffers.emplace_back(std::max<size_t>(count, 1));
+        return mWidenedBuffers.back().data();
+    }
+
+    void Graph::AliasBuffer(const OperandBase* input, const OperandBase* output) {
+        mOperandBufferMap[output] = GetBuffer(input);
+    }
+
+    void Graph::AddOperation(const char* kernel,
+                             uint64_t byteLength,
+                             const std::vector<const void*>& reads,
+                             const std::vector<const void*>& writes,
+                             std::function<void(ThreadPool*)> operation) {
+        const size_t index = mOperations.size();
+        for (const void* buffer : reads) {
+            auto writers = buffer != nullptr ? mWriters.find(buffer) : mWriters.end();
+            if (writers == mWriters.end()) {
+                continue;
+            }
+            for (size_t writer : writers->second) {
+                // The dependents stay sorted, an operation reading a buffer twice is only
+                // counted once.
+                std::vector<size_t>& dependents = mOperations[writer].dependents;
+                if (dependents.empty() || dependents.back() != index) {
+                    dependents.push_back(index);
+                }
+            }
+        }
+        for (const void* buffer : writes) {
+            if (buffer != nullptr) {
+                mWriters[buffer].push_back(index);
+            }
+        }
+        mOperations.push_back({kernel, byteLength, std::move(operation), {}});
+    }
+
+    uint64_t Graph::GetByteLength(const OperatorBase* op) const {
+        // The operands without a float32 buffer are read as int8 or uint8.
+        auto byteLengthOf = [this](const OperandBase* operand) {
+            const bool isFloat = mOperandBufferMap.find(operand) != mOperandBufferMap.end();
+            return kernels::SizeOfShape(operand->Shape()) * (isFloat ? sizeof(float) : 1);
+        };
+        uint64_t byteLength = 0;
+        for (auto& input : op->Inputs()) {
+            byteLength += byteLengthOf(input.Get());
+        }
+        for (auto& output : op->Outputs()) {
+            byteLength += byteLengthOf(output);
+        }
+        return byteLength;
+    }
+
+    float* Graph::PoolConstant(const float* data, const Shape& shape) {
+        std::shared_ptr<const PooledConstant> pooled = ConstantPool::Get()->Acquire(
+            ml::OperandType::Float32, shape, data, kernels::SizeOfShape(shape) * sizeof(float));
+        // The pooled bytes are never written, the operations only read the constants.
+        float* buffer = static_cast<float*>(const_cast<void*>(pooled->GetData()));
+        mPooledConstants.push_back(std::move(pooled));
+        mConstantBuffers.insert(buffer);
+        return buffer;
+    }
+
+    const void* Graph::PoolConstant(ml::OperandType type,
+                                    const void* data,
+                                    const Shape& shape,
+                                    size_t byteLength) {
+        std::shared_ptr<const PooledConstant> pooled =
+            ConstantPool::Get()->Acquire(type, shape, data, byteLength);
+        const void* buffer = pooled->GetData();
+        mPooledConstants.push_back(std::move(pooled));
+        mConstantBuffers.insert(buffer);
+        return buffer;
+    }
+
+    float* Graph::TransposeBuffer(const float* input,
+                                  const Shape& shape,
+                                  const std::vector<int32_t>& permutation) {
+        if (mConstantBuffers.find(input) != mConstantBuffers.end()) {
+            std::vector<float> output(kernels::SizeOfShape(shape));
+            kernels::Transpose(mThreadPool, input, shape, permutation, output.data());
+            Shape outputShape(shape.size());
+            for (size_t i = 0; i < shape.size(); ++i) {
+                outputShape[i] = shape[permutation[i]];
+            }
+            return PoolConstant(output.data(), outputShape);
+        }
+        float* output = AllocateBuffer(kernels::SizeOfShape(shape));
+        const size_t byteLength = 2 * kernels::SizeOfShape(shape) * sizeof(float);
+        AddOperation("Transpose", byteLength, {input}, {output},
+                     [input, shape, permutation, output](ThreadPool* pool) {
+                         kernels::Transpose(pool, input, shape, permutation, output);
+                     });
+        return output;
+    }
+
+    float* Graph::Permute(const OperandBase* operand, const std::vector<int32_t>& permutation) {
+        float* input = GetBuffer(operand);
+        if (permutation.empty()) {
+            return input;
+        }
+        return TransposeBuffer(input, operand->Shape(), permutation);
+    }
+
+    const int16_t* Graph::WidenConstant(const Dequantization& dequantization,
+                                        const std::vector<int32_t>& permutation) {
+        DAWN_ASSERT(dequantization.isConstant);
+        Shape shape = dequantization.shape;
+        const size_t count = kernels::SizeOfShape(shape);
+        std::vector<int16_t> widened(count);
+        kernels::WidenQuantized(mThreadPool, dequantization.input, dequantization.isSigned, count,
+                                dequantization.channels, dequantization.inner,
+                                dequantization.zeroPoints.data(), widened.data());
+        if (!permutation.empty()) {
+            std::vector<int16_t> permuted(count);
+            kernels::Transpose(mThreadPool, widened.data(), shape, permutation, permuted.data());
+            widened = std::move(permuted);
+            Shape inputShape = shape;
+            for (size_t i = 0; i < shape.size(); ++i) {
+                shape[i] = inputShape[permutation[i]];
+            }
+        }
+        // The pool compares the bytes, the 16-bit type only tags the widened values.
+        return static_cast<const int16_t*>(PoolConstant(ml::OperandType::Float16, widened.data(),
+                                                        shape, count * sizeof(int16_t)));
+    }
+
+    const int16_t* Graph::WidenInput(const Dequantization& dequantization) {
+        if (dequantization.isConstant) {
+            return WidenConstant(dequantization, {});
+        }
+        const Dequantization* d = &dequantization;
+        const size_t count = kernels::SizeOfShape(d->shape);
+        int16_t* output = AllocateWidenedBuffer(count);
+        AddOperation("WidenQuantized", count * (1 + sizeof(int16_t)), {d->input}, {output},
+                     [=](ThreadPool* pool) {
+                         kernels::WidenQuantized(pool, d->input, d->isSigned, count, d->channels,
+                                                 d->inner, d->zeroPoints.data(), output);
+                     });
+        return output;
+    }
+
+    MaybeError Graph::AddConstant(const op::Constant* constant) {
+        const OperandDescriptor* desc = constant->GetOperandDescriptor();
+        const OperandBase* operand = constant->PrimaryOutput();
+        if (desc->type == ml::OperandType::Int8 || desc->type == ml::OperandType::Uint8) {
+            size_t byteLength = kernels::SizeOfShape(operand->Shape());
+            if (constant->GetByteLength() < byteLength) {
+                return DAWN_VALIDATION_ERROR("The constant buffer is too small.");
+            }
+            mQuantizedBufferMap[operand] = const_cast<void*>(
+                PoolConstant(desc->type, constant->GetBuffer(), operand->Shape(), byteLength));
+            return {};
+        }
+        // Other types are only read at build time, e.g. the padding of pad.
+        if (desc->type != ml::OperandType::Float32) {
+            return {};
+        }
+        size_t byteLength = kernels::SizeOfShape(operand->Shape()) * sizeof(float);
+        if (constant->GetByteLength() < byteLength) {
+            return DAWN_VALIDATION_ERROR("The constant buffer is too small.");
+        }
+        mOperandBufferMap[operand] =
+            PoolConstant(static_cast<const float*>(constant->GetBuffer()), operand->Shape());
+        return {};
+    }
+
+    MaybeError Graph::AddInput(const op::Input* input) {
+        const OperandDescriptor* desc = input->GetOperandDescriptor();
+        const OperandBase* operand = input->PrimaryOutput();
+        if (desc->type == ml::OperandType::Int8 || desc->type == ml::OperandType::Uint8) {
+            mInputs[input->GetName()] = {CreateQuantizedBuffer(operand),
+                                         kernels::SizeOfShape(operand->Shape())};
+            return {};
+        }
+        if (desc->type != ml::OperandType::Float32) {
+            return DAWN_UNIMPLEMENTED_ERROR("The CPU backend only supports float32 inputs.");
+        }
+        float* buffer = CreateBuffer(operand);
+        mInputs[input->GetName()] = {buffer,
+                                     kernels::SizeOfShape(operand->Shape()) * sizeof(float)};
+        return {};
+    }
+
+    MaybeError Graph::AddOutput(const std::string& name, const OperandBase* output) {
+        auto quantized = mQuantizedBufferMap.find(output);
+        if (quantized != mQuantizedBufferMap.end()) {
+            mOutputs[name] = {quantized->second, kernels::SizeOfShape(output->Shape())};
+            return {};
+        }
+        if (mOperandBufferMap.find(output) == mOperandBufferMap.end() &&
+            GetDequantization(output) == nullptr) {
+            return DAWN_UNIMPLEMENTED_ERROR("The CPU backend only supports float32 outputs.");
+        }
+        DAWN_TRY(CheckBuffer(output));
+        mOutputs[name] = {GetBuffer(output),
+                          kernels::SizeOfShape(output->Shape()) * sizeof(float)};
+        return {};
+    }
+
+    MaybeError Graph::AddBatchNorm(const op::BatchNorm* batchNorm) {
+        DAWN_TRY(CheckInputs(batchNorm));
+        auto inputs = batchNorm->Inputs();
+        DAWN_ASSERT(inputs.size() >= 3 && inputs.size() <= 5);
+        const BatchNormOptions* options = batchNorm->GetOptions();
+        const float* input = GetBuffer(inputs[0].Get());
+        const float* mean = GetBuffer(inputs[1].Get());
+        const float* variance = GetBuffer(inputs[2].Get());
+        size_t index = 3;
+        const float* scale = options->scale != nullptr ? GetBuffer(inputs[index++].Get()) : nullptr;
+        const float* bias = options->bias != nullptr ? GetBuffer(inputs[index++].Get()) : nullptr;
+        Shape inputShape = inputs[0]->Shape();
+        size_t axis = options->axis;
+        if (axis >= inputShape.size()) {
+            return DAWN_VALIDATION_ERROR("The axis of batchNorm is out of range.");
+        }
+        float epsilon = options->epsilon;
+        Activation activation = GetActivation(options->activation);
+        float* output = CreateBuffer(batchNorm->PrimaryOutput());
+        AddOperation("BatchNorm", GetByteLength(batchNorm), {input, mean, variance, scale, bias},
+                     {output}, [=](ThreadPool* pool) {
+                         kernels::BatchNorm(pool, input, inputShape, axis, mean, variance, scale,
+                                            bias, epsilon, activation, output);
+                     });
+        return {};
+    }
+
+    MaybeError Graph::AddBinary(const op::Binary* binary) {
+        DAWN_ASSERT(binary->Inputs().size() == 2);
+        const OperandBase* aOperand = binary->Inputs()[0].Get();
+        const OperandBase* bOperand = binary->Inputs()[1].Get();
+        if (binary->GetType() == op::BinaryOpType::kMatMul &&
+            CanComputeQuantizedGemm(aOperand, bOperand, false, false)) {
+            return AddQuantizedGemm(aOperand, bOperand, false, 1.0f, nullptr, 0.0f,
+                                    binary->PrimaryOutput());
+        }
+        DAWN_TRY(CheckInputs(binary));
+        const float* a = GetBuffer(aOperand);
+        const float* b = GetBuffer(bOperand);
+        Shape aShape = aOperand->Shape(), bShape = bOperand->Shape();
+        Shape outputShape = binary->PrimaryOutput()->Shape();
+        float* output = CreateBuffer(binary->PrimaryOutput());
+
+        kernels::BinaryType type;
+        switch (binary->GetType()) {
+            case op::BinaryOpType::kMatMul:
+                AddOperation("MatMul", GetByteLength(binary), {a, b}, {output},
+                             [=](ThreadPool* pool) {
+                                 kernels::MatMul(pool, a, aShape, b, bShape, output);
+                             });
+                return {};
+            case op::BinaryOpType::kAdd:
+                type = kernels::BinaryType::Add;
+                break;
+            case op::BinaryOpType::kSub:
+                type = kernels::BinaryType::Sub;
+                break;
+            case op::BinaryOpType::kMul:
+                type = kernels::BinaryType::Mul;
+                break;
+            case op::BinaryOpType::kDiv:
+                type = kernels::BinaryType::Div;
+                break;
+            case op::BinaryOpType::kMax:
+                type = kernels::BinaryType::Max;
+                break;
+            case op::BinaryOpType::kMin:
+                type = kernels::BinaryType::Min;
+                break;
+            case op::BinaryOpType::kPower:
+                type = kernels::BinaryType::Power;
+                break;
+            default:
+                return DAWN_UNIMPLEMENTED_ERROR("The binary op type isn't supported.");
+        }
+        AddOperation("Binary", GetByteLength(binary), {a, b}, {output}, [=](ThreadPool* pool) {
+            kernels::Binary(pool, type, a, aShape, b, bShape, output, outputShape);
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddConv2d(const op::Conv2d* conv2d) {
+        auto inputsOperand = conv2d->Inputs();
+        DAWN_ASSERT(inputsOperand.size() == 2 || inputsOperand.size() == 3);
+        const Conv2dOptions* options = conv2d->GetOptions();
+        const bool nhwc = options->inputLayout == ml::InputOperandLayout::Nhwc;
+
+        // The kernel works on nchw inputs and oihw filters, or ohwi filters when transposed.
+        Shape inputShape = inputsOperand[0]->Shape();
+        Shape filterShape = inputsOperand[1]->Shape();
+        Shape outputShape = conv2d->PrimaryOutput()->Shape();
+        if (nhwc) {
+            inputShape = {inputShape[0], inputShape[3], inputShape[1], inputShape[2]};
+            outputShape = {outputShape[0], outputShape[3], outputShape[1], outputShape[2]};
+        }
+        std::vector<int32_t> permutation = FilterToOihw(options->filterLayout);
+        if (!permutation.empty()) {
+            Shape shape = filterShape;
+            for (size_t i = 0; i < 4; ++i) {
+                filterShape[i] = shape[permutation[i]];
+            }
+        }
+
+        kernels::Conv2dParams params;
+        params.batches = inputShape[0];
+        params.inputChannels = inputShape[1];
+        params.inputHeight = inputShape[2];
+        params.inputWidth = inputShape[3];
+        params.outputChannels = outputShape[1];
+        params.outputHeight = outputShape[2];
+        params.outputWidth = outputShape[3];
+        params.filterHeight = filterShape[2];
+        params.filterWidth = filterShape[3];
+        params.strideHeight = options->strides[0];
+        params.strideWidth = options->strides[1];
+        params.dilationHeight = options->dilations[0];
+        params.dilationWidth = options->dilations[1];
+        params.groups = options->groups;
+        params.transpose = options->transpose;
+        std::vector<int32_t> padding = ResolvePadding(
+            options->autoPad, options->padding, options->strides, options->dilations,
+            params.inputHeight, params.inputWidth, params.filterHeight, params.filterWidth,
+            options->transpose ? options->outputPadding : nullptr);
+        params.paddingTop = padding[0];
+        params.paddingLeft = padding[2];
+
+        if (CanComputeQuantizedConv2d(conv2d)) {
+            return AddQuantizedConv2d(conv2d, params);
+        }
+        DAWN_TRY(CheckInputs(conv2d));
+        const float* input = Permute(inputsOperand[0].Get(), nhwc ? kNhwcToNchw : Shape());
+        const float* filter = Permute(inputsOperand[1].Get(), permutation);
+        if (options->transpose) {
+            filter = TransposeBuffer(filter, filterShape, kNchwToNhwc);
+        }
+        const float* bias =
+            options->bias != nullptr ? GetBuffer(inputsOperand[2].Get()) : nullptr;
+        Activation activation = GetActivation(options->activation);
+        float* output = nhwc ? AllocateBuffer(kernels::SizeOfShape(outputShape))
+                             : CreateBuffer(conv2d->PrimaryOutput());
+        AddOperation("Conv2d", GetByteLength(conv2d), {input, filter, bias}, {output},
+                     [=](ThreadPool* pool) {
+                         kernels::Conv2d(pool, params, input, filter, bias, activation, output);
+                     });
+        if (nhwc) {
+            float* nhwcOutput = CreateBuffer(conv2d->PrimaryOutput());
+            AddOperation("Transpose", 2 * kernels::SizeOfShape(outputShape) * sizeof(float),
+                         {output}, {nhwcOutput}, [=](ThreadPool* pool) {
+                             kernels::Transpose(pool, output, outputShape, kNchwToNhwc, nhwcOutput);
+                         });
+        }
+        return {};
+    }
+
+    bool Graph::CanComputeQuantizedConv2d(const op::Conv2d* conv2d) const {
+        const Conv2dOptions* options = conv2d->GetOptions();
+        const Dequantization* input = GetDequantization(conv2d->Inputs()[0].Get());
+        const Dequantization* filter = GetDequantization(conv2d->Inputs()[1].Get());
+        if (input == nullptr || filter == nullptr || options->transpose || input->axis != -1 ||
+            !filter->isConstant) {
+            return false;
+        }
+        // The axis of the output channels in the filter layout.
+        const int32_t outputAxis = options->filterLayout == ml::FilterOperandLayout::Hwio ||
+                                           options->filterLayout == ml::FilterOperandLayout::Ihwo
+                                       ? 3
+                                       : 0;
+        return filter->axis == -1 || filter->axis == outputAxis;
+    }
+
+    MaybeError Graph::AddQuantizedConv2d(const op::Conv2d* conv2d,
+                                         const kernels::Conv2dParams& params) {
+        auto inputsOperand = conv2d->Inputs();
+        const Conv2dOptions* options = conv2d->GetOptions();
+        const bool nhwc = options->inputLayout == ml::InputOperandLayout::Nhwc;
+        const Dequantization& inputDequantization = mDequantizations.at(inputsOperand[0].Get());
+        const Dequantization& filterDequantization = mDequantizations.at(inputsOperand[1].Get());
+        const float* bias = nullptr;
+        if (options->bias != nullptr) {
+            DAWN_TRY(CheckBuffer(inputsOperand[2].Get()));
+            bias = GetBuffer(inputsOperand[2].Get());
+        }
+
+        // The filters are widened and packed once, the scales of the output channels fold the
+        // input scale in.
+        const int16_t* filter =
+            WidenConstant(filterDequantization, FilterToOihw(options->filterLayout));
+        std::vector<float> scales(params.outputChannels);
+        for (int32_t o = 0; o < params.outputChannels; ++o) {
+            scales[o] = inputDequantization.scales[0] *
+                        filterDequantization.scales[filterDequantization.axis == -1 ? 0 : o];
+        }
+        const int16_t* input = WidenInput(inputDequantization);
+        if (nhwc) {
+            Shape shape = inputDequantization.shape;
+            int16_t* nchwInput = AllocateWidenedBuffer(kernels::SizeOfShape(shape));
+            AddOperation("Transpose", 2 * kernels::SizeOfShape(shape) * sizeof(int16_t), {input},
+                         {nchwInput}, [=](ThreadPool* pool) {
+                             kernels::Transpose(pool, input, shape, kNhwcToNchw, nchwInput);
+                         });
+            input = nchwInput;
+        }
+
+        Activation activation = GetActivation(options->activation);
+        Shape outputShape = {params.batches, params.outputChannels, params.outputHeight,
+                             params.outputWidth};
+        float* output = nhwc ? AllocateBuffer(kernels::SizeOfShape(outputShape))
+                             : CreateBuffer(conv2d->PrimaryOutput());
+        AddOperation("QuantizedConv2d", GetByteLength(conv2d), {input, filter, bias}, {output},
+                     [=](ThreadPool* pool) {
+                         kernels::QuantizedConv2d(pool, params, input, filter, scales.data(), bias,
+                                                  activation, output);
+                     });
+        if (nhwc) {
+            float* nhwcOutput = CreateBuffer(conv2d->PrimaryOutput());
+            AddOperation("Transpose", 2 * kernels::SizeOfShape(outputShape) * sizeof(float),
+                         {output}, {nhwcOutput}, [=](ThreadPool* pool) {
+                             kernels::Transpose(pool, output, outputShape, kNchwToNhwc, nhwcOutput);
+                         });
+        }
+        return {};
+    }
+
+    MaybeError Graph::AddGru(const op::Gru* gru) {
+        DAWN_TRY(CheckInputs(gru));
+        auto inputs = gru->Inputs();
+        const GruOptions* options = gru->GetOptions();
+        Shape inputShape = inputs[0]->Shape();
+        Shape weightShape = inputs[1]->Shape();
+
+        kernels::GruParams params;
+        params.steps = gru->GetSteps();
+        params.batchSize = inputShape[1];
+        params.inputSize = inputShape[2];
+        params.hiddenSize = gru->GetHiddenSize();
+        params.numDirections = weightShape[0];
+        params.resetAfter = options->resetAfter;
+        params.zrnLayout = options->layout == ml::RecurrentNetworkWeightLayout::Zrn;
+        params.backwardOnly = options->direction == ml::RecurrentNetworkDirection::Backward;
+        auto activations = gru->GetActivations();
+        params.gateActivation = GetActivation(activations->mOperators[0].Get());
+        params.candidateActivation = GetActivation(activations->mOperators[1].Get());
+
+        const float* input = GetBuffer(inputs[0].Get());
+        const float* weight = GetBuffer(inputs[1].Get());
+        const float* recurrentWeight = GetBuffer(inputs[2].Get());
+        size_t index = 3;
+        const float* bias = options->bias != nullptr ? GetBuffer(inputs[index++].Get()) : nullptr;
+        const float* recurrentBias =
+            options->recurrentBias != nullptr ? GetBuffer(inputs[index++].Get()) : nullptr;
+        const float* initialHiddenState =
+            options->initialHiddenState != nullptr ? GetBuffer(inputs[index++].Get()) : nullptr;
+        float* output = CreateBuffer(gru->Outputs()[0]);
+        float* sequence = options->returnSequence ? CreateBuffer(gru->Outputs()[1]) : nullptr;
+        // The projections of the input are only used inside the kernel, so the scratch buffer
+        // is allocated once with the graph.
+        float* projection = AllocateBuffer(params.steps * params.batchSize * 3 * params.hiddenSize);
+        if (options->stateful) {
+            // The output isn't written by any other operation and outlives the compute, so it
+            // keeps the hidden state for the next one.
+            AddOperation("Gru", GetByteLength(gru),
+                         {input, weight, recurrentWeight, bias, recurrentBias, initialHiddenState},
+                         {output, sequence}, [=](ThreadPool* pool) {
+                             const float* state = mStateReset ? initialHiddenState : output;
+                             kernels::Gru(pool, params, input, weight, recurrentWeight, bias,
+                                          recurrentBias, state, output, sequence, projection);
+                         });
+            return {};
+        }
+        AddOperation("Gru", GetByteLength(gru),
+                     {input, weight, recurrentWeight, bias, recurrentBias, initialHiddenState},
+                     {output, sequence}, [=](ThreadPool* pool) {
+                         kernels::Gru(pool, params, input, weight, recurrentWeight, bias,
+                                      recurrentBias, initialHiddenState, output, sequence,
+                                      projection);
+                     });
+        return {};
+    }
+
+    MaybeError Graph::AddPad(const op::Pad* pad) {
+        auto inputsOperand = pad->Inputs();
+        DAWN_ASSERT(inputsOperand.size() == 2);
+        DAWN_TRY(CheckBuffer(inputsOperand[0].Get()));
+        const OperatorBase* paddingOperator = inputsOperand[1]->Operator();
+        if (dynamic_cast<const op::Constant*>(paddingOperator) == nullptr) {
+            return DAWN_INTERNAL_ERROR("The padding constant is not found.");
+        }
+        const op::Constant* paddingConstant = static_cast<const op::Constant*>(paddingOperator);
+        Shape inputShape = inputsOperand[0]->Shape();
+        const uint32_t* paddingData = static_cast<const uint32_t*>(paddingConstant->GetBuffer());
+        std::vector<int32_t> padding(paddingData, paddingData + 2 * inputShape.size());
+
+        kernels::PaddingMode mode;
+        const PadOptions* options = pad->GetOptions();
+        switch (options->mode) {
+            case ml::PaddingMode::Constant:
+                mode = kernels::PaddingMode::Constant;
+                break;
+            case ml::PaddingMode::Edge:
+                mode = kernels::PaddingMode::Edge;
+                break;
+            case ml::PaddingMode::Reflection:
+                mode = kernels::PaddingMode::Reflection;
+                break;
+            case ml::PaddingMode::Symmetric:
+                mode = kernels::PaddingMode::Symmetric;
+                break;
+            default:
+                return DAWN_INTERNAL_ERROR("The padding mode isn't supported.");
+        }
+        float value = options->value;
+        const float* input = GetBuffer(inputsOperand[0].Get());
+        Shape outputShape = pad->PrimaryOutput()->Shape();
+        float* output = CreateBuffer(pad->PrimaryOutput());
+        AddOperation("Pad", GetByteLength(pad), {input}, {output}, [=](ThreadPool* pool) {
+            kernels::Pad(pool, mode, value, input, inputShape, padding, output, outputShape);
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddPool2d(const op::Pool2d* pool2d) {
+        DAWN_TRY(CheckInputs(pool2d));
+        DAWN_ASSERT(pool2d->Inputs().size() == 1);
+        const OperandBase* inputOperand = pool2d->Inputs()[0].Get();
+        const Pool2dOptions* options = pool2d->GetOptions();
+        const bool nhwc = options->layout == ml::InputOperandLayout::Nhwc;
+        const float* input = Permute(inputOperand, nhwc ? kNhwcToNchw : Shape());
+        Shape inputShape = inputOperand->Shape();
+        Shape outputShape = pool2d->PrimaryOutput()->Shape();
+        if (nhwc) {
+            inputShape = {inputShape[0], inputShape[3], inputShape[1], inputShape[2]};
+            outputShape = {outputShape[0], outputShape[3], outputShape[1], outputShape[2]};
+        }
+
+        kernels::Pool2dParams params;
+        params.batches = inputShape[0];
+        params.channels = inputShape[1];
+        params.inputHeight = inputShape[2];
+        params.inputWidth = inputShape[3];
+        params.outputHeight = outputShape[2];
+        params.outputWidth = outputShape[3];
+        params.windowHeight =
+            options->windowDimensions != nullptr ? options->windowDimensions[0] : inputShape[2];
+        params.windowWidth =
+            options->windowDimensions != nullptr ? options->windowDimensions[1] : inputShape[3];
+        params.strideHeight = options->strides[0];
+        params.strideWidth = options->strides[1];
+        params.dilationHeight = options->dilations[0];
+        params.dilationWidth = options->dilations[1];
+        std::vector<int32_t> padding = ResolvePadding(
+            options->autoPad, options->padding, options->strides, options->dilations,
+            params.inputHeight, params.inputWidth, params.windowHeight, params.windowWidth);
+        params.paddingTop = padding[0];
+        params.paddingLeft = padding[2];
+
+        kernels::PoolType type;
+        switch (pool2d->GetType()) {
+            case op::Pool2dType::kAveragePool2d:
+                type = kernels::PoolType::Average;
+                break;
+            case op::Pool2dType::kL2Pool2d:
+                type = kernels::PoolType::L2;
+                break;
+            case op::Pool2dType::kMaxPool2d:
+                type = kernels::PoolType::Max;
+                break;
+            default:
+                return DAWN_INTERNAL_ERROR("This pool2d type is not supported.");
+        }
+        float* output = nhwc ? AllocateBuffer(kernels::SizeOfShape(outputShape))
+                             : CreateBuffer(pool2d->PrimaryOutput());
+        AddOperation("Pool2d", GetByteLength(pool2d), {input}, {output}, [=](ThreadPool* pool) {
+            kernels::Pool2d(pool, type, params, input, output);
+        });
+        if (nhwc) {
+            float* nhwcOutput = CreateBuffer(pool2d->PrimaryOutput());
+            AddOperation("Transpose", 2 * kernels::SizeOfShape(outputShape) * sizeof(float),
+                         {output}, {nhwcOutput}, [=](ThreadPool* pool) {
+                             kernels::Transpose(pool, output, outputShape, kNchwToNhwc, nhwcOutput);
+                         });
+        }
+        return {};
+    }
+
+    MaybeError Graph::AddReduce(const op::Reduce* reduce) {
+        DAWN_TRY(CheckInputs(reduce));
+        DAWN_ASSERT(reduce->Inputs().size() == 1);
+        const OperandBase* inputOperand = reduce->Inputs()[0].Get();
+        const ReduceOptions* options = reduce->GetOptions();
+        std::vector<int32_t> axes(options->axes, options->axes + options->axesCount);
+
+        kernels::ReduceType type;
+        switch (reduce->GetType()) {
+            case op::ReduceType::kReduceL1:
+                type = kernels::ReduceType::L1;
+                break;
+            case op::ReduceType::kReduceL2:
+                type = kernels::ReduceType::L2;
+                break;
+            case op::ReduceType::kReduceMax:
+                type = kernels::ReduceType::Max;
+                break;
+            case op::ReduceType::kReduceMean:
+                type = kernels::ReduceType::Mean;
+                break;
+            case op::ReduceType::kReduceMin:
+                type = kernels::ReduceType::Min;
+                break;
+            case op::ReduceType::kReduceProduct:
+                type = kernels::ReduceType::Product;
+                break;
+            case op::ReduceType::kReduceSum:
+                type = kernels::ReduceType::Sum;
+                break;
+            default:
+                return DAWN_INTERNAL_ERROR("The reduce op type isn't supported.");
+        }
+        // The reduced dimensions are kept by the kernel, dropping them doesn't change the layout.
+        const float* input = GetBuffer(inputOperand);
+        Shape inputShape = inputOperand->Shape();
+        float* output = CreateBuffer(reduce->PrimaryOutput());
+        AddOperation("Reduce", GetByteLength(reduce), {input}, {output}, [=](ThreadPool* pool) {
+            kernels::Reduce(pool, type, input, inputShape, axes, output);
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddResample2d(const op::Resample2d* resample2d) {
+        DAWN_TRY(CheckInputs(resample2d));
+        DAWN_ASSERT(resample2d->Inputs().size() == 1);
+        const OperandBase* inputOperand = resample2d->Inputs()[0].Get();
+        Shape inputShape = inputOperand->Shape();
+        Shape outputShape = resample2d->GetOutputShape();
+        int32_t axis = resample2d->GetAxes()[0];
+        // The scales are derived from the sizes when the sizes were given.
+        std::vector<float> scales = resample2d->GetScales();
+        for (size_t i = 0; i < 2; ++i) {
+            if (int32_t(inputShape[axis + i] * scales[i]) != outputShape[axis + i]) {
+                scales[i] = float(outputShape[axis + i]) / inputShape[axis + i];
+            }
+        }
+        const bool linear = resample2d->GetOptions()->mode == ml::InterpolationMode::Linear;
+        const float* input = GetBuffer(inputOperand);
+        float* output = CreateBuffer(resample2d->PrimaryOutput());
+        AddOperation("Resample2d", GetByteLength(resample2d), {input}, {output},
+                     [=](ThreadPool* pool) {
+                         kernels::Resample2d(pool, linear, input, inputShape, axis, scales, output,
+                                             outputShape);
+                     });
+        return {};
+    }
+
+    MaybeError Graph::AddReshape(const op::Reshape* reshape) {
+        DAWN_TRY(CheckInputs(reshape));
+        DAWN_ASSERT(reshape->Inputs().size() == 1);
+        AliasBuffer(reshape->Inputs()[0].Get(), reshape->PrimaryOutput());
+        return {};
+    }
+
+    MaybeError Graph::AddSlice(const op::Slice* slice) {
+        DAWN_TRY(CheckInputs(slice));
+        DAWN_ASSERT(slice->Inputs().size() == 1);
+        const OperandBase* inputOperand = slice->Inputs()[0].Get();
+        Shape inputShape = inputOperand->Shape();
+        std::vector<int32_t> starts(inputShape.size(), 0);
+        std::vector<int32_t> sliceStarts = slice->GetStarts();
+        std::vector<int32_t> axes = slice->GetAxes();
+        for (size_t i = 0; i < sliceStarts.size(); ++i) {
+            int32_t axis = axes.empty() ? i : axes[i];
+            if (axis < 0) {
+                axis += inputShape.size();
+            }
+            starts[axis] =
+                sliceStarts[i] < 0 ? sliceStarts[i] + inputShape[axis] : sliceStarts[i];
+        }
+        const float* input = GetBuffer(inputOperand);
+        Shape outputShape = slice->PrimaryOutput()->Shape();
+        float* output = CreateBuffer(slice->PrimaryOutput());
+        AddOperation("Slice", GetByteLength(slice), {input}, {output}, [=](ThreadPool* pool) {
+            kernels::Slice(pool, input, inputShape, starts, output, outputShape);
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddSplit(const op::Split* split) {
+        DAWN_TRY(CheckInputs(split));
+        DAWN_ASSERT(split->Inputs().size() == 1);
+        const OperandBase* inputOperand = split->Inputs()[0].Get();
+        Shape inputShape = inputOperand->Shape();
+        int32_t axis = split->GetAxis();
+        if (axis < 0) {
+            axis += inputShape.size();
+        }
+        const float* input = GetBuffer(inputOperand);
+        int32_t offset = 0;
+        for (auto outputOperand : split->Outputs()) {
+            std::vector<int32_t> starts(inputShape.size(), 0);
+            starts[axis] = offset;
+            Shape outputShape = outputOperand->Shape();
+            offset += outputShape[axis];
+            float* output = CreateBuffer(outputOperand);
+            AddOperation("Slice", 2 * kernels::SizeOfShape(outputShape) * sizeof(float), {input},
+                         {output}, [=](ThreadPool* pool) {
+                             kernels::Slice(pool, input, inputShape, starts, output, outputShape);
+                         });
+        }
+        return {};
+    }
+
+    MaybeError Graph::AddSqueeze(const op::Squeeze* squeeze) {
+        DAWN_TRY(CheckInputs(squeeze));
+        DAWN_ASSERT(squeeze->Inputs().size() == 1);
+        AliasBuffer(squeeze->Inputs()[0].Get(), squeeze->PrimaryOutput());
+        return {};
+    }
+
+    MaybeError Graph::AddTranspose(const op::Transpose* transpose) {
+        DAWN_TRY(CheckInputs(transpose));
+        DAWN_ASSERT(transpose->Inputs().size() == 1);
+        const OperandBase* inputOperand = transpose->Inputs()[0].Get();
+        const float* input = GetBuffer(inputOperand);
+        Shape inputShape = inputOperand->Shape();
+        std::vector<int32_t> permutation = transpose->GetPermutation();
+        float* output = CreateBuffer(transpose->PrimaryOutput());
+        AddOperation("Transpose", GetByteLength(transpose), {input}, {output},
+                     [=](ThreadPool* pool) {
+                         kernels::Transpose(pool, input, inputShape, permutation, output);
+                     });
+        return {};
+    }
+
+    MaybeError Graph::AddUnary(const op::Unary* unary) {
+        DAWN_TRY(CheckInputs(unary));
+        DAWN_ASSERT(unary->Inputs().size() == 1);
+        const OperandBase* inputOperand = unary->Inputs()[0].Get();
+        const float* input = GetBuffer(inputOperand);
+        Shape inputShape = inputOperand->Shape();
+        size_t count = kernels::SizeOfShape(inputShape);
+        float* output = CreateBuffer(unary->PrimaryOutput());
+
+        Activation activation;
+        kernels::UnaryType type;
+        switch (unary->GetType()) {
+            case op::UnaryOpType::kAbs:
+                type = kernels::UnaryType::Abs;
+                break;
+            case op::UnaryOpType::kCeil:
+                type = kernels::UnaryType::Ceil;
+                break;
+            case op::UnaryOpType::kCos:
+                type = kernels::UnaryType::Cos;
+                break;
+            case op::UnaryOpType::kExp:
+                type = kernels::UnaryType::Exp;
+                break;
+            case op::UnaryOpType::kFloor:
+                type = kernels::UnaryType::Floor;
+                break;
+            case op::UnaryOpType::kLog:
+                type = kernels::UnaryType::Log;
+                break;
+            case op::UnaryOpType::kNeg:
+                type = kernels::UnaryType::Neg;
+                break;
+            case op::UnaryOpType::kSin:
+                type = kernels::UnaryType::Sin;
+                break;
+            case op::UnaryOpType::kTan:
+                type = kernels::UnaryType::Tan;
+                break;
+            case op::UnaryOpType::kHardSwish:
+                activation.type = ActivationType::HardSwish;
+                break;
+            case op::UnaryOpType::kLeakyRelu:
+                activation.type = ActivationType::LeakyRelu;
+                activation.alpha = reinterpret_cast<const op::LeakyRelu*>(unary)->GetAlpha();
+                break;
+            case op::UnaryOpType::kRelu:
+                activation.type = ActivationType::Relu;
+                break;
+            case op::UnaryOpType::kSigmoid:
+                activation.type = ActivationType::Sigmoid;
+                break;
+            case op::UnaryOpType::kTanh:
+                activation.type = ActivationType::Tanh;
+                break;
+            case op::UnaryOpType::kSoftmax: {
+                size_t columns = inputShape.empty() ? 1 : inputShape.back();
+                AddOperation("Softmax", GetByteLength(unary), {input}, {output},
+                             [=](ThreadPool* pool) {
+                                 kernels::Softmax(pool, input, output, count / columns, columns);
+                             });
+                return {};
+            }
+            default:
+                return DAWN_UNIMPLEMENTED_ERROR("The unary op type isn't supported.");
+        }
+        if (activation.type != ActivationType::None) {
+            AddOperation("Activate", GetByteLength(unary), {input}, {output},
+                         [=](ThreadPool* pool) {
+                             kernels::Activate(pool, activation, input, output, count);
+                         });
+        } else {
+            AddOperation("Unary", GetByteLength(unary), {input}, {output}, [=](ThreadPool* pool) {
+                kernels::Unary(pool, type, input, output, count);
+            });
+        }
+        return {};
+    }
+
+    MaybeError Graph::AddLeakyRelu(const op::LeakyRelu* leakyRelu) {
+        return AddUnary(leakyRelu);
+    }
+
+    MaybeError Graph::AddConcat(const op::Concat* concat) {
+        DAWN_TRY(CheckInputs(concat));
+        DAWN_ASSERT(concat->Inputs().size() >= 1);
+        size_t axis = concat->GetAxis();
+        Shape outputShape = concat->PrimaryOutput()->Shape();
+        float* output = CreateBuffer(concat->PrimaryOutput());
+        int32_t offset = 0;
+        for (auto& inputOperand : concat->Inputs()) {
+            const float* input = GetBuffer(inputOperand.Get());
+            Shape inputShape = inputOperand->Shape();
+            const size_t byteLength = 2 * kernels::SizeOfShape(inputShape) * sizeof(float);
+            AddOperation("CopyAlongAxis", byteLength, {input}, {output}, [=](ThreadPool* pool) {
+                kernels::CopyAlongAxis(pool, input, inputShape, output, outputShape, axis,
+                                       offset);
+            });
+            offset += inputShape[axis];
+        }
+        return {};
+    }
+
+    MaybeError Graph::AddGemm(const op::Gemm* gemm) {
+        auto inputs = gemm->Inputs();
+        DAWN_ASSERT(inputs.size() == 2 || inputs.size() == 3);
+        const GemmOptions* options = gemm->GetOptions();
+        if (CanComputeQuantizedGemm(inputs[0].Get(), inputs[1].Get(), options->aTranspose,
+                                    options->bTranspose)) {
+            return AddQuantizedGemm(inputs[0].Get(), inputs[1].Get(), options->bTranspose,
+                                    options->alpha, inputs.size() == 3 ? inputs[2].Get() : nullptr,
+                                    options->beta, gemm->PrimaryOutput());
+        }
+        DAWN_TRY(CheckInputs(gemm));
+        Shape aShape = inputs[0]->Shape();
+        Shape outputShape = gemm->PrimaryOutput()->Shape();
+        const size_t M = outputShape[0], N = outputShape[1];
+        const size_t K = options->aTranspose ? aShape[0] : aShape[1];
+        const bool aTranspose = options->aTranspose, bTranspose = options->bTranspose;
+        const float alpha = options->alpha;
+        // The c operand is broadcast into the output which then accumulates alpha * A * B.
+        const float beta = inputs.size() == 3 ? options->beta : 0.0f;
+        const float* a = GetBuffer(inputs[0].Get());
+        const float* b = GetBuffer(inputs[1].Get());
+        const float* c = inputs.size() == 3 ? GetBuffer(inputs[2].Get()) : nullptr;
+        Shape cShape = inputs.size() == 3 ? inputs[2]->Shape() : Shape();
+        float* output = CreateBuffer(gemm->PrimaryOutput());
+        AddOperation("Gemm", GetByteLength(gemm), {a, b, c}, {output}, [=](ThreadPool* pool) {
+            if (c != nullptr) {
+                kernels::Broadcast(pool, c, cShape, output, outputShape);
+            }
+            kernels::Gemm(pool, aTranspose, bTranspose, M, N, K, alpha, a, b, beta, output);
+        });
+        return {};
+    }
+
+    bool Graph::CanComputeQuantizedGemm(const OperandBase* a,
+                                        const OperandBase* b,
+                                        bool aTranspose,
+                                        bool bTranspose) const {
+        const Dequantization* aDequantization = GetDequantization(a);
+        const Dequantization* bDequantization = GetDequantization(b);
+        if (aDequantization == nullptr || bDequantization == nullptr || aTranspose ||
+            aDequantization->axis != -1 || !bDequantization->isConstant ||
+            a->Shape().size() != 2 || b->Shape().size() != 2) {
+            return false;
+        }
+        return bDequantization->axis == -1 || bDequantization->axis == (bTranspose ? 0 : 1);
+    }
+
+    MaybeError Graph::AddQuantizedGemm(const OperandBase* a,
+                                       const OperandBase* b,
+                                       bool bTranspose,
+                                       float alpha,
+                                       const OperandBase* c,
+                                       float beta,
+                                       const OperandBase* output) {
+        const Dequantization& aDequantization = mDequantizations.at(a);
+        const Dequantization& bDequantization = mDequantizations.at(b);
+        Shape outputShape = output->Shape();
+        const size_t M = outputShape[0], N = outputShape[1], K = a->Shape()[1];
+        const float* cBuffer = nullptr;
+        Shape cShape;
+        if (c != nullptr) {
+            DAWN_TRY(CheckBuffer(c));
+            cBuffer = GetBuffer(c);
+            cShape = c->Shape();
+        } else {
+            beta = 0.0f;
+        }
+
+        // b is widened and transposed to [K, N] once, alpha and the scales of a and b fold into
+        // the scales of the columns.
+        const int16_t* bWidened =
+            WidenConstant(bDequantization, bTranspose ? std::vector<int32_t>({1, 0})
+                                                      : std::vector<int32_t>());
+        std::vector<float> columnScales(N);
+        for (size_t n = 0; n < N; ++n) {
+            columnScales[n] = alpha * aDequantization.scales[0] *
+                              bDequantization.scales[bDequantization.axis == -1 ? 0 : n];
+        }
+        const int16_t* aWidened = WidenInput(aDequantization);
+        float* result = CreateBuffer(output);
+        const size_t byteLength = (M * K + K * N) * sizeof(int16_t) +
+                                  (kernels::SizeOfShape(cShape) + M * N) * sizeof(float);
+        AddOperation("QuantizedGemm", byteLength, {aWidened, bWidened, cBuffer}, {result},
+                     [=](ThreadPool* pool) {
+                         if (cBuffer != nullptr) {
+                             kernels::Broadcast(pool, cBuffer, cShape, result, outputShape);
+                         }
+                         kernels::QuantizedGemm(pool, M, N, K, aWidened, bWidened, nullptr,
+                                                columnScales.data(), beta, result);
+                     });
+        return {};
+    }
+
+    MaybeError Graph::AddClamp(const op::Clamp* clamp) {
+        DAWN_TRY(CheckInputs(clamp));
+        DAWN_ASSERT(clamp->Inputs().size() == 1);
+        const OperandBase* inputOperand = clamp->Inputs()[0].Get();
+        Activation activation;
+        activation.type = ActivationType::Clamp;
+        activation.minValue = clamp->GetMinValue();
+        activation.maxValue = clamp->GetMaxValue();
+        const float* input = GetBuffer(inputOperand);
+        size_t count = kernels::SizeOfShape(inputOperand->Shape());
+        float* output = CreateBuffer(clamp->PrimaryOutput());
+        AddOperation("Activate", GetByteLength(clamp), {input}, {output}, [=](ThreadPool* pool) {
+            kernels::Activate(pool, activation, input, output, count);
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddInstanceNorm(const op::InstanceNorm* instanceNorm) {
+        DAWN_TRY(CheckInputs(instanceNorm));
+        auto inputs = instanceNorm->Inputs();
+        DAWN_ASSERT(inputs.size() >= 1 && inputs.size() <= 3);
+        const InstanceNormOptions* options = instanceNorm->GetOptions();
+        const float* input = GetBuffer(inputs[0].Get());
+        size_t index = 1;
+        const float* scale = options->scale != nullptr ? GetBuffer(inputs[index++].Get()) : nullptr;
+        const float* bias = options->bias != nullptr ? GetBuffer(inputs[index++].Get()) : nullptr;
+        Shape inputShape = inputs[0]->Shape();
+        const bool nhwc = options->layout == ml::InputOperandLayout::Nhwc;
+        float epsilon = options->epsilon;
+        float* output = CreateBuffer(instanceNorm->PrimaryOutput());
+        AddOperation("InstanceNorm", GetByteLength(instanceNorm), {input, scale, bias}, {output},
+                     [=](ThreadPool* pool) {
+                         kernels::InstanceNorm(pool, input, inputShape, nhwc, scale, bias, epsilon,
+                                               output);
+                     });
+        return {};
+    }
+
+    MaybeError Graph::AddQuantize(const op::Quantize* quantize) {
+        auto inputs = quantize->Inputs();
+        DAWN_ASSERT(inputs.size() == 3);
+        auto scaleConstant = dynamic_cast<const op::Constant*>(inputs[1]->Operator());
+        auto zeroPointConstant = dynamic_cast<const op::Constant*>(inputs[2]->Operator());
+        if (scaleConstant == nullptr || zeroPointConstant == nullptr) {
+            return DAWN_UNIMPLEMENTED_ERROR(
+                "The CPU backend only supports constant scales and zero points.");
+        }
+        const size_t channels = kernels::SizeOfShape(inputs[1]->Shape());
+        if (scaleConstant->GetByteLength() < channels * sizeof(float) ||
+            zeroPointConstant->GetByteLength() < channels) {
+            return DAWN_VALIDATION_ERROR("The constant buffer is too small.");
+        }
+        std::vector<float> scales(channels);
+        memcpy(scales.data(), scaleConstant->GetBuffer(), channels * sizeof(float));
+        const bool isSigned = inputs[2]->Type() == ml::OperandType::Int8;
+        std::vector<int32_t> zeroPoints(channels);
+        for (size_t i = 0; i < channels; ++i) {
+            zeroPoints[i] =
+                isSigned ? static_cast<const int8_t*>(zeroPointConstant->GetBuffer())[i]
+                         : static_cast<const uint8_t*>(zeroPointConstant->GetBuffer())[i];
+        }
+
+        const OperandBase* inputOperand = inputs[0].Get();
+        Shape shape = inputOperand->Shape();
+        const int32_t axis = quantize->IsPerChannel() ? quantize->GetOptions()->axis : -1;
+        size_t inner = 1;
+        for (size_t i = axis + 1; axis != -1 && i < shape.size(); ++i) {
+            inner *= shape[i];
+        }
+        const size_t count = kernels::SizeOfShape(shape);
+
+        if (quantize->GetType() == op::QuantizeType::kQuantizeLinear) {
+            DAWN_TRY(CheckBuffer(inputOperand));
+            const float* input = GetBuffer(inputOperand);
+            void* output = CreateQuantizedBuffer(quantize->PrimaryOutput());
+            AddOperation("QuantizeLinear", GetByteLength(quantize), {input}, {output},
+                         [=](ThreadPool* pool) {
+                             kernels::QuantizeLinear(pool, input, count, channels, inner,
+                                                     scales.data(), zeroPoints.data(), isSigned,
+                                                     output);
+                         });
+            return {};
+        }
+
+        // The dequantization is only computed when an operator reads the float32 values, the
+        // integer kernels read the quantized ones instead.
+        auto quantized = mQuantizedBufferMap.find(inputOperand);
+        if (quantized == mQuantizedBufferMap.end()) {
+            return DAWN_INTERNAL_ERROR("The quantized buffer is not found.");
+        }
+        Dequantization& dequantization = mDequantizations[quantize->PrimaryOutput()];
+        dequantization.input = quantized->second;
+        dequantization.isSigned = isSigned;
+        dequantization.isConstant =
+            mConstantBuffers.find(quantized->second) != mConstantBuffers.end();
+        dequantization.shape = shape;
+        dequantization.axis = axis;
+        dequantization.channels = channels;
+        dequantization.inner = inner;
+        dequantization.scales = std::move(scales);
+        dequantization.zeroPoints = std::move(zeroPoints);
+        return {};
+    }
+
+    MaybeError Graph::Finish() {
+        if (mInputs.empty()) {
+            return DAWN_VALIDATION_ERROR("Model inputs must be set.");
+        }
+        return {};
+    }
+
+    bool Graph::SupportsFusedActivation(FusionType type) const {
+        return true;
+    }
+
+    MaybeError Graph::CompileImpl() {
+        mWriters.clear();
+        if (mLanePools.size() > 1) {
+            std::vector<std::vector<size_t>> dependents;
+            for (auto& operation : mOperations) {
+                dependents.push_back(operation.dependents);
+            }
+            mScheduler.reset(new Scheduler(std::move(dependents)));
+        }
+        return {};
+    }
+
+    MLComputeGraphStatus Graph::ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
+        const auto& namedInputs = inputs->GetRecords();
+        std::vector<const Input*> boundInputs;
+        boundInputs.reserve(mInputs.size());
+        for (auto& input : mInputs) {
+            auto namedInput = namedInputs.find(input.first);
+            boundInputs.push_back(namedInput != namedInputs.end() ? namedInput->second : nullptr);
+        }
+        const auto& namedOutputs = outputs->GetRecords();
+        std::vector<const ArrayBufferView*> boundOutputs;
+        boundOutputs.reserve(mOutputs.size());
+        for (auto& output : mOutputs) {
+            auto namedOutput = namedOutputs.find(output.first);
+            boundOutputs.push_back(namedOutput != namedOutputs.end() ? namedOutput->second
+                                                                     : nullptr);
+        }
+        return Run(boundInputs.data(), boundOutputs.data());
+    }
+
+    MLComputeGraphStatus Graph::ComputeWithBindingsImpl(const BindingSetBase* bindings) {
+        // The maps are ordered by name like the bindings.
+        if (bindings->GetInputs().size() != mInputs.size() ||
+            bindings->GetOutputs().size() != mOutputs.size()) {
+            dawn::ErrorLog() << "The bindings don't match the inputs and outputs of the graph.";
+            return MLComputeGraphStatus_Error;
+        }
+        return Run(bindings->GetInputs().data(), bindings->GetOutputs().data());
+    }
+
+    void Graph::ResetStateImpl() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStateReset = true;
+    }
+
+    MLComputeGraphStatus Graph::Run(const Input* const* inputs,
+                                    const ArrayBufferView* const* outputs) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        // The inputs and the outputs are always copied to the buffers of the graph.
+        uint64_t copiedBytes = 0;
+        size_t index = 0;
+        for (auto& input : mInputs) {
+            // All the inputs must be set.
+            const Input* boundInput = inputs[index++];
+            if (boundInput == nullptr) {
+                dawn::ErrorLog() << "The input must be set.";
+                return MLComputeGraphStatus_Error;
+            }
+            const ArrayBufferView& resource = boundInput->resource;
+            if (resource.byteLength < input.second.byteLength) {
+                dawn::ErrorLog() << "The size of input " << input.first << " is too small.";
+                return MLComputeGraphStatus_Error;
+            }
+            memcpy(input.second.buffer, static_cast<int8_t*>(resource.buffer) + resource.byteOffset,
+                   input.second.byteLength);
+            copiedBytes += input.second.byteLength;
+        }
+
+        Profiler* profiler = GetProfiler();
+        auto run = [this, profiler](size_t index, ThreadPool* pool) {
+            const Operation& operation = mOperations[index];
+            if (profiler == nullptr) {
+                operation.run(pool);
+                return;
+            }
+            // The lanes run the operations on their own threads, so they are traced with their
+            // index.
+            profiler->BeginOperator(index, operation.kernel, operation.byteLength);
+            operation.run(pool);
+            profiler->EndOperator(index, operation.kernel);
+        };
+        if (mScheduler != nullptr) {
+            mScheduler->Run(mInterOpPool, mLanePools, run);
+        } else {
+            for (size_t i = 0; i < mOperations.size(); ++i) {
+                run(i, mThreadPool);
+            }
+        }
+        mStateReset = false;
+
+        index = 0;
+        for (auto& output : mOutputs) {
+            const ArrayBufferView* outputBuffer = outputs[index++];
+            if (outputBuffer == nullptr) {
+                continue;
+            }
+            if (outputBuffer->byteLength < output.second.byteLength) {
+                dawn::ErrorLog() << "The size of output " << output.first << " is too small.";
+                return MLComputeGraphStatus_Error;
+            }
+            memcpy(static_cast<int8_t*>(outputBuffer->buffer) + outputBuffer->byteOffset,
+                   output.second.buffer, output.second.byteLength);
+            copiedBytes += output.second.byteLength;
+        }
+        RecordCopiedBytes(copiedBytes);
+        return MLComputeGraphStatus_Success;
+    }
+
+}}  // namespace webnn_native::cpu
@@ -0,0 +1,225 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_CPU_GRAPH_CPU_H_
+#define WEBNN_NATIVE_CPU_GRAPH_CPU_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "webnn_native/ConstantPool.h"
+#include "webnn_native/Graph.h"
+#include "webnn_native/Operand.h"
+#include "webnn_native/cpu/ContextCPU.h"
+#include "webnn_native/cpu/KernelsCPU.h"
+#include "webnn_native/cpu/SchedulerCPU.h"
+#include "webnn_native/ops/BatchNorm.h"
+#include "webnn_native/ops/Binary.h"
+#include "webnn_native/ops/Clamp.h"
+#include "webnn_native/ops/Concat.h"
+#include "webnn_native/ops/Constant.h"
+#include "webnn_native/ops/Conv2d.h"
+#include "webnn_native/ops/Gemm.h"
+#include "webnn_native/ops/Gru.h"
+#include "webnn_native/ops/Input.h"
+#include "webnn_native/ops/InstanceNorm.h"
+#include "webnn_native/ops/LeakyRelu.h"
+#include "webnn_native/ops/Pad.h"
+#include "webnn_native/ops/Pool2d.h"
+#include "webnn_native/ops/Quantize.h"
+#include "webnn_native/ops/Reduce.h"
+#include "webnn_native/ops/Resample2d.h"
+#include "webnn_native/ops/Reshape.h"
+#include "webnn_native/ops/Slice.h"
+#include "webnn_native/ops/Split.h"
+#include "webnn_native/ops/Squeeze.h"
+#include "webnn_native/ops/Transpose.h"
+#include "webnn_native/ops/Unary.h"
+
+namespace webnn_native { namespace cpu {
+
+    class Graph : public GraphBase {
+      public:
+        explicit Graph(Context* context);
+        ~Graph() override = default;
+
+        virtual MaybeError AddConstant(const op::Constant* constant) override;
+        virtual MaybeError AddInput(const op::Input* input) override;
+        virtual MaybeError AddOutput(const std::string& name, const OperandBase* output) override;
+        virtual MaybeError AddBatchNorm(const op::BatchNorm* batchNorm) override;
+        virtual MaybeError AddBinary(const op::Binary* binary) override;
+        virtual MaybeError AddConv2d(const op::Conv2d* conv2d) override;
+        virtual MaybeError AddGru(const op::Gru* gru) override;
+        virtual MaybeError AddPad(const op::Pad* pad) override;
+        virtual MaybeError AddPool2d(const op::Pool2d* pool2d) override;
+        virtual MaybeError AddReduce(const op::Reduce* reduce) override;
+        virtual MaybeError AddResample2d(const op::Resample2d* resample2d) override;
+        virtual MaybeError AddReshape(const op::Reshape* reshape) override;
+        virtual MaybeError AddSlice(const op::Slice* slice) override;
+        virtual MaybeError AddSplit(const op::Split* split) override;
+        virtual MaybeError AddSqueeze(const op::Squeeze* squeeze) override;
+        virtual MaybeError AddTranspose(const op::Transpose* transpose) override;
+        virtual MaybeError AddUnary(const op::Unary* unary) override;
+        virtual MaybeError AddLeakyRelu(const op::LeakyRelu* leakyRelu) override;
+        virtual MaybeError AddConcat(const op::Concat* concat) override;
+        virtual MaybeError AddGemm(const op::Gemm* gemm) override;
+        virtual MaybeError AddClamp(const op::Clamp* clamp) override;
+        virtual MaybeError AddInstanceNorm(const op::InstanceNorm* instanceNorm) override;
+        virtual MaybeError AddQuantize(const op::Quantize* quantize) override;
+        virtual MaybeError Finish() override;
+        bool SupportsFusedActivation(FusionType type) const override;
+
+      private:
+        MaybeError CompileImpl() override;
+        MLComputeGraphStatus ComputeImpl(NamedInputsBase* inputs,
+                                         NamedOutputsBase* outputs) override;
+        MLComputeGraphStatus ComputeWithBindingsImpl(const BindingSetBase* bindings) override;
+        // Computes with the resources of mInputs and mOutputs in order, the outputs which aren't
+        // read being null.
+        MLComputeGraphStatus Run(const Input* const* inputs, const ArrayBufferView* const* outputs);
+        void ResetStateImpl() override;
+
+        // A dequantizeLinear, whose float32 values are only computed once an operator other than
+        // the integer kernels reads them.
+        struct Dequantization {
+            const void* input;
+            bool isSigned;
+            bool isConstant;
+            kernels::Shape shape;
+            // The axis of the scales and the zero points, or -1 for a single value.
+            int32_t axis;
+            size_t channels;
+            size_t inner;
+            std::vector<float> scales;
+            std::vector<int32_t> zeroPoints;
+        };
+
+        // Returns an error unless |operand| has a float32 buffer, adding the dequantization of
+        // a pending dequantizeLinear if needed.
+        MaybeError CheckBuffer(const OperandBase* operand);
+        // Returns an error unless every input of |op| has a float32 buffer.
+        MaybeError CheckInputs(const OperatorBase* op);
+        float* GetBuffer(const OperandBase* operand) const;
+        // Returns the pending dequantizeLinear producing |operand|, or null.
+        const Dequantization* GetDequantization(const OperandBase* operand) const;
+        // Allocates the buffer of |operand| from its shape.
+        float* CreateBuffer(const OperandBase* operand);
+        // Allocates a scratch buffer owned by the graph.
+        float* AllocateBuffer(size_t count);
+        // Allocates the int8 or uint8 buffer of |operand| from its shape.
+        void* CreateQuantizedBuffer(const OperandBase* operand);
+        // Allocates a buffer of widened quantized values owned by the graph.
+        int16_t* AllocateWidenedBuffer(size_t count);
+        // Shares the buffer of |input| with |output|, used by the layout-only operations.
+        void AliasBuffer(const OperandBase* input, const OperandBase* output);
+        // Appends |operation| to the execution list, which runs it with the pool of the lane
+        // computing it. The name of its kernel and the bytes it reads and writes label it in the
+        // traces when profiling. It depends on the operations writing the buffers it |reads|,
+        // null ones are skipped, and every buffer is written by the operations of a single
+        // operator since the operators come in topological order and the buffers aren't reused.
+        void AddOperation(const char* kernel,
+                          uint64_t byteLength,
+                          const std::vector<const void*>& reads,
+                          const std::vector<const void*>& writes,
+                          std::function<void(ThreadPool*)> operation);
+        // Returns the bytes of the inputs and the outputs of |op|.
+        uint64_t GetByteLength(const OperatorBase* op) const;
+        // Returns the copy of the constant |data| in the constant pool, which is shared with the
+        // graphs of the other contexts holding the same bytes.
+        float* PoolConstant(const float* data, const kernels::Shape& shape);
+        const void* PoolConstant(ml::OperandType type,
+                                 const void* data,
+                                 const kernels::Shape& shape,
+                                 size_t byteLength);
+        // Returns |input| transposed by |permutation|. A constant is transposed at build time and
+        // the packed result is pooled like the constants.
+        float* TransposeBuffer(const float* input,
+                               const kernels::Shape& shape,
+                               const std::vector<int32_t>& permutation);
+        // Returns |operand| permuted by |permutation|, or its own buffer for an empty one.
+        float* Permute(const OperandBase* operand, const std::vector<int32_t>& permutation);
+        // Returns the values of |dequantization| widened at build time, which must be constant,
+        // and permuted by |permutation| unless it is empty.
+        const int16_t* WidenConstant(const Dequantization& dequantization,
+                                     const std::vector<int32_t>& permutation);
+        // Returns the buffer widened from |dequantization| before each compute.
+        const int16_t* WidenInput(const Dequantization& dequantization);
+
+        // The integer kernels compute the operators reading dequantized int8 or uint8 tensors
+        // from the quantized values. The input must be quantized as a whole and the constant
+        // filter or b along the output channels at most.
+        bool CanComputeQuantizedConv2d(const op::Conv2d* conv2d) const;
+        MaybeError AddQuantizedConv2d(const op::Conv2d* conv2d,
+                                      const kernels::Conv2dParams& params);
+        bool CanComputeQuantizedGemm(const OperandBase* a,
+                                     const OperandBase* b,
+                                     bool aTranspose,
+                                     bool bTranspose) const;
+        MaybeError AddQuantizedGemm(const OperandBase* a,
+                                    const OperandBase* b,
+                                    bool bTranspose,
+                                    float alpha,
+                                    const OperandBase* c,
+                                    float beta,
+                                    const OperandBase* output);
+
+        ThreadPool* mThreadPool;
+        ThreadPool* mInterOpPool;
+        std::vector<ThreadPool*> mLanePools;
+
+        // The buffers are never resized once allocated, so the raw pointers captured by the
+        // operations stay valid when the outer vector grows.
+        std::vector<std::vector<float>> mBuffers;
+        std::map<const OperandBase*, float*> mOperandBufferMap;
+        std::set<const void*> mConstantBuffers;
+        std::vector<std::vector<int8_t>> mQuantizedBuffers;
+        std::map<const OperandBase*, void*> mQuantizedBufferMap;
+        std::vector<std::vector<int16_t>> mWidenedBuffers;
+        std::map<const OperandBase*, Dequantization> mDequantizations;
+        std::vector<std::shared_ptr<const PooledConstant>> mPooledConstants;
+
+        struct Binding {
+            void* buffer;
+            size_t byteLength;
+        };
+        std::map<std::string, Binding> mInputs;
+        std::map<std::string, Binding> mOutputs;
+
+        struct Operation {
+            const char* kernel;
+            uint64_t byteLength;
+            std::function<void(ThreadPool*)> run;
+            // The operations reading what this one writes.
+            std::vector<size_t> dependents;
+        };
+        std::vector<Operation> mOperations;
+        // The operations writing each buffer, only used while building.
+        std::map<const void*, std::vector<size_t>> mWriters;
+        // Computes the independent operations at once when the context has several lanes.
+        std::unique_ptr<Scheduler> mScheduler;
+
+        // The buffers are owned by the graph, so concurrent computes are serialized.
+        std::mutex mMutex;
+        // Whether the stateful grus start from their initial hidden state on the next compute
+        // rather than from their output of the previous one, guarded by mMutex.
+        bool mStateReset = true;
+    };
+
+}}  // namespace webnn_native::cpu
+
+#endif  // WEBNN_NATIVE_CPU_GRAPH_CPU_H_
@@ -0,0 +1,1612 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/cpu/KernelsCPU.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "common/Assert.h"
+
+#if defined(_MSC_VER)
+#    define WEBNN_RESTRICT __restrict
+#else
+#    define WEBNN_RESTRICT __restrict__
+#endif
+
+namespace webnn_native { namespace cpu { namespace kernels {
+
+    namespace {
+
+        // The minimum number of elements handed to one task of the thread pool.
+        constexpr size_t kElementGrain = 4096;
+
+        // Tile of C computed by one task of the GEMM.
+        constexpr size_t kGemmRowBlock = 4;
+        constexpr size_t kGemmColumnBlock = 256;
+
+        enum ScratchSlot {
+            kScratchGemmA = 0,
+            kScratchGemmB,
+            kScratchConv2d,
+            kScratchGru,
+            kScratchSlotCount,
+        };
+
+        // Per-thread scratch memory that grows to the largest request and is kept around so
+        // that steady state inference doesn't allocate.
+        template <typename T = float>
+        T* GetScratch(ScratchSlot slot, size_t count) {
+            thread_local std::vector<T> tScratch[kScratchSlotCount];
+            if (tScratch[slot].size() < count) {
+                tScratch[slot].resize(count);
+            }
+            return tScratch[slot].data();
+        }
+
+        size_t ElementGrain(size_t elementsPerItem) {
+            return std::max<size_t>(1, kElementGrain / std::max<size_t>(1, elementsPerItem));
+        }
+
+        std::vector<size_t> StridesOf(const Shape& shape) {
+            std::vector<size_t> strides(shape.size());
+            size_t stride = 1;
+            for (size_t i = shape.size(); i-- > 0;) {
+                strides[i] = stride;
+                stride *= shape[i];
+            }
+            return strides;
+        }
+
+        // Strides of |shape| when broadcast to a tensor of |rank| dimensions, broadcast
+        // dimensions get a stride of 0.
+        std::vector<size_t> BroadcastStridesOf(const Shape& shape, size_t rank) {
+            std::vector<size_t> strides(rank, 0);
+            std::vector<size_t> shapeStrides = StridesOf(shape);
+            size_t offset = rank - shape.size();
+            for (size_t i = 0; i < shape.size(); ++i) {
+                strides[offset + i] = shape[i] == 1 ? 0 : shapeStrides[i];
+            }
+            return strides;
+        }
+
+        // The range [begin, end) of output positions o for which o * stride + offset lies in
+        // [0, size).
+        void ValidRange(int32_t offset,
+                        int32_t stride,
+                        int32_t size,
+                        int32_t outputSize,
+                        int32_t& begin,
+                        int32_t& end) {
+            begin = offset >= 0 ? 0 : (-offset + stride - 1) / stride;
+            int32_t last = size - 1 - offset;
+            end = last < 0 ? 0 : last / stride + 1;
+            begin = std::min(begin, outputSize);
+            end = std::max(begin, std::min(end, outputSize));
+        }
+
+        template <typename Function>
+        void ParallelMap(ThreadPool* pool,
+                         const float* input,
+                         float* output,
+                         size_t count,
+                         Function function) {
+            pool->ParallelFor(
+                count,
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        output[i] = function(input[i]);
+                    }
+                },
+                kElementGrain);
+        }
+
+        template <typename Function>
+        void BinaryLoop(ThreadPool* pool,
+                        Function function,
+                        const float* a,
+                        const Shape& aShape,
+                        const float* b,
+                        const Shape& bShape,
+                        float* output,
+                        const Shape& outputShape) {
+            const size_t rank = outputShape.size();
+            size_t count = SizeOfShape(outputShape);
+            if (count == 0) {
+                return;
+            }
+            // A scalar output has no inner dimension to broadcast along.
+            if (rank == 0) {
+                output[0] = function(a[0], b[0]);
+                return;
+            }
+            size_t aCount = SizeOfShape(aShape), bCount = SizeOfShape(bShape);
+            if (aCount == count && bCount == count) {
+                pool->ParallelFor(
+                    count,
+                    [&](size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; ++i) {
+                            output[i] = function(a[i], b[i]);
+                        }
+                    },
+                    kElementGrain);
+                return;
+            }
+            if (aCount == count && bCount == 1) {
+                const float scalar = b[0];
+                pool->ParallelFor(
+                    count,
+                    [&](size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; ++i) {
+                            output[i] = function(a[i], scalar);
+                        }
+                    },
+                    kElementGrain);
+                return;
+            }
+
+            std::vector<size_t> aStrides = BroadcastStridesOf(aShape, rank);
+            std::vector<size_t> bStrides = BroadcastStridesOf(bShape, rank);
+            const size_t inner = outputShape[rank - 1];
+            const size_t aInnerStride = aStrides[rank - 1], bInnerStride = bStrides[rank - 1];
+            pool->ParallelFor(
+                count / inner,
+                [&](size_t begin, size_t end) {
+                    for (size_t row = begin; row < end; ++row) {
+                        size_t index = row, aOffset = 0, bOffset = 0;
+                        for (size_t d = rank - 1; d-- > 0;) {
+                            size_t coordinate = index % outputShape[d];
+                            index /= outputShape[d];
+                            aOffset += coordinate * aStrides[d];
+                            bOffset += coordinate * bStrides[d];
+                        }
+                        const float* WEBNN_RESTRICT aRow = a + aOffset;
+                        const float* WEBNN_RESTRICT bRow = b + bOffset;
+                        float* WEBNN_RESTRICT outputRow = output + row * inner;
+                        if (aInnerStride != 0 && bInnerStride != 0) {
+                            for (size_t j = 0; j < inner; ++j) {
+                                outputRow[j] = function(aRow[j], bRow[j]);
+                            }
+                        } else if (aInnerStride != 0) {
+                            const float scalar = bRow[0];
+                            for (size_t j = 0; j < inner; ++j) {
+                                outputRow[j] = function(aRow[j], scalar);
+                            }
+                        } else if (bInnerStride != 0) {
+                            const float scalar = aRow[0];
+                            for (size_t j = 0; j < inner; ++j) {
+                                outputRow[j] = function(scalar, bRow[j]);
+                            }
+                        } else {
+                            std::fill(outputRow, outputRow + inner, function(aRow[0], bRow[0]));
+                        }
+                    }
+                },
+                ElementGrain(inner));
+        }
+
+        template <typename T>
+        void TransposeElements(ThreadPool* pool,
+                               const T* input,
+                               const Shape& inputShape,
+                               const std::vector<int32_t>& permutation,
+                               T* output) {
+            const size_t rank = inputShape.size();
+            std::vector<size_t> inputStrides = StridesOf(inputShape);
+            Shape outputShape(rank);
+            std::vector<size_t> strides(rank);
+            for (size_t i = 0; i < rank; ++i) {
+                outputShape[i] = inputShape[permutation[i]];
+                strides[i] = inputStrides[permutation[i]];
+            }
+            const size_t count = SizeOfShape(outputShape);
+            if (count == 0) {
+                return;
+            }
+            const size_t inner = rank == 0 ? 1 : outputShape[rank - 1];
+            const size_t innerStride = rank == 0 ? 1 : strides[rank - 1];
+            pool->ParallelFor(
+                count / inner,
+                [&](size_t begin, size_t end) {
+                    for (size_t row = begin; row < end; ++row) {
+                        size_t index = row, offset = 0;
+                        for (size_t d = rank - 1; d-- > 0;) {
+                            offset += (index % outputShape[d]) * strides[d];
+                            index /= outputShape[d];
+                        }
+                        const T* WEBNN_RESTRICT source = input + offset;
+                        T* WEBNN_RESTRICT destination = output + row * inner;
+                        for (size_t j = 0; j < inner; ++j) {
+                            destination[j] = source[j * innerStride];
+                        }
+                    }
+                },
+                ElementGrain(inner));
+        }
+
+        // Computes a tile of at most kGemmRowBlock rows of C. a is row-major with |lda| and b
+        // with |ldb|.
+        void GemmTile(size_t rows,
+                      size_t columns,
+                      size_t K,
+                      float alpha,
+                      const float* a,
+                      size_t lda,
+                      const float* b,
+                      size_t ldb,
+                      float beta,
+                      float* c,
+                      size_t ldc) {
+            for (size_t r = 0; r < rows; ++r) {
+                float* row = c + r * ldc;
+                if (beta == 0.0f) {
+                    std::fill(row, row + columns, 0.0f);
+                } else if (beta != 1.0f) {
+                    for (size_t j = 0; j < columns; ++j) {
+                        row[j] *= beta;
+                    }
+                }
+            }
+            if (rows == kGemmRowBlock) {
+                // Stream each row of B once for four rows of C.
+                float* WEBNN_RESTRICT c0 = c;
+                float* WEBNN_RESTRICT c1 = c + ldc;
+                float* WEBNN_RESTRICT c2 = c + 2 * ldc;
+                float* WEBNN_RESTRICT c3 = c + 3 * ldc;
+                for (size_t k = 0; k < K; ++k) {
+                    const float a0 = alpha * a[k];
+                    const float a1 = alpha * a[lda + k];
+                    const float a2 = alpha * a[2 * lda + k];
+                    const float a3 = alpha * a[3 * lda + k];
+                    const float* WEBNN_RESTRICT bRow = b + k * ldb;
+                    for (size_t j = 0; j < columns; ++j) {
+                        const float value = bRow[j];
+                        c0[j] += a0 * value;
+                        c1[j] += a1 * value;
+                        c2[j] += a2 * value;
+                        c3[j] += a3 * value;
+                    }
+                }
+                return;
+            }
+            for (size_t r = 0; r < rows; ++r) {
+                float* WEBNN_RESTRICT row = c + r * ldc;
+                for (size_t k = 0; k < K; ++k) {
+                    const float scale = alpha * a[r * lda + k];
+                    if (scale == 0.0f) {
+                        continue;
+                    }
+                    const float* WEBNN_RESTRICT bRow = b + k * ldb;
+                    for (size_t j = 0; j < columns; ++j) {
+                        row[j] += scale * bRow[j];
+                    }
+                }
+            }
+        }
+
+        // The integer counterpart of GemmTile, which accumulates in int32 and scales the sums
+        // into C. |rowScales| and |columnScales| start at the tile and may be null.
+        void QuantizedGemmTile(size_t rows,
+                               size_t columns,
+                               size_t K,
+                               const int16_t* a,
+                               size_t lda,
+                               const int16_t* b,
+                               size_t ldb,
+                               const float* rowScales,
+                               const float* columnScales,
+                               float beta,
+                               float* c,
+                               size_t ldc) {
+            int32_t sums[kGemmRowBlock][kGemmColumnBlock] = {};
+            for (size_t k = 0; k < K; ++k) {
+                const int16_t* WEBNN_RESTRICT bRow = b + k * ldb;
+                for (size_t r = 0; r < rows; ++r) {
+                    const int32_t value = a[r * lda + k];
+                    if (value == 0) {
+                        continue;
+                    }
+                    int32_t* WEBNN_RESTRICT sum = sums[r];
+                    for (size_t j = 0; j < columns; ++j) {
+                        sum[j] += value * bRow[j];
+                    }
+                }
+            }
+            for (size_t r = 0; r < rows; ++r) {
+                const float rowScale = rowScales != nullptr ? rowScales[r] : 1.0f;
+                float* WEBNN_RESTRICT row = c + r * ldc;
+                for (size_t j = 0; j < columns; ++j) {
+                    const float scale =
+                        columnScales != nullptr ? rowScale * columnScales[j] : rowScale;
+                    const float value = scale * static_cast<float>(sums[r][j]);
+                    row[j] = beta == 0.0f ? value : value + beta * row[j];
+                }
+            }
+        }
+
+        // Also used for the widened quantized values, whose padding is 0 as well.
+        template <typename T>
+        void Im2Col(ThreadPool* pool,
+                    const Conv2dParams& params,
+                    int32_t channels,
+                    const T* input,
+                    T* col) {
+            const int32_t kernelArea = params.filterHeight * params.filterWidth;
+            const size_t inputArea = params.inputHeight * params.inputWidth;
+            const size_t outputArea = params.outputHeight * params.outputWidth;
+            pool->ParallelFor(
+                channels * kernelArea,
+                [&](size_t begin, size_t end) {
+                    for (size_t row = begin; row < end; ++row) {
+                        const int32_t channel = row / kernelArea;
+                        const int32_t kh = (row / params.filterWidth) % params.filterHeight;
+                        const int32_t kw = row % params.filterWidth;
+                        const T* source = input + channel * inputArea;
+                        T* destination = col + row * outputArea;
+                        int32_t owBegin, owEnd;
+                        ValidRange(kw * params.dilationWidth - params.paddingLeft,
+                                   params.strideWidth, params.inputWidth, params.outputWidth,
+                                   owBegin, owEnd);
+                        for (int32_t oh = 0; oh < params.outputHeight; ++oh) {
+                            T* WEBNN_RESTRICT d = destination + oh * params.outputWidth;
+                            const int32_t ih = oh * params.strideHeight - params.paddingTop +
+                                               kh * params.dilationHeight;
+                            if (ih < 0 || ih >= params.inputHeight) {
+                                std::fill(d, d + params.outputWidth, T(0));
+                                continue;
+                            }
+                            const T* WEBNN_RESTRICT s =
+                                source + ih * params.inputWidth - params.paddingLeft +
+                                kw * params.dilationWidth;
+                            std::fill(d, d + owBegin, T(0));
+                            for (int32_t ow = owBegin; ow < owEnd; ++ow) {
+                                d[ow] = s[ow * params.strideWidth];
+                            }
+                            std::fill(d + owEnd, d + params.outputWidth, T(0));
+                        }
+                    }
+                },
+                ElementGrain(outputArea));
+        }
+
+        // Direct convolution for groups == inputChannels == outputChannels, where the GEMM
+        // would degenerate to a single row.
+        void DepthwiseConv2d(ThreadPool* pool,
+                             const Conv2dParams& params,
+                             const float* input,
+                             const float* filter,
+                             const float* bias,
+                             const Activation& activation,
+                             float* output) {
+            const size_t inputArea = params.inputHeight * params.inputWidth;
+            const size_t outputArea = params.outputHeight * params.outputWidth;
+            const size_t kernelArea = params.filterHeight * params.filterWidth;
+            pool->ParallelFor(
+                params.batches * params.outputChannels,
+                [&](size_t begin, size_t end) {
+                    for (size_t plane = begin; plane < end; ++plane) {
+                        const size_t c = plane % params.outputChannels;
+                        const float* x = input + plane * inputArea;
+                        const float* w = filter + c * kernelArea;
+                        float* y = output + plane * outputArea;
+                        std::fill(y, y + outputArea, bias != nullptr ? bias[c] : 0.0f);
+                        for (int32_t kh = 0; kh < params.filterHeight; ++kh) {
+                            for (int32_t kw = 0; kw < params.filterWidth; ++kw) {
+                                const float weight = w[kh * params.filterWidth + kw];
+                                const int32_t columnOffset =
+                                    kw * params.dilationWidth - params.paddingLeft;
+                                int32_t owBegin, owEnd;
+                                ValidRange(columnOffset, params.strideWidth, params.inputWidth,
+                                           params.outputWidth, owBegin, owEnd);
+                                for (int32_t oh = 0; oh < params.outputHeight; ++oh) {
+                                    const int32_t ih = oh * params.strideHeight -
+                                                       params.paddingTop +
+                                                       kh * params.dilationHeight;
+                                    if (ih < 0 || ih >= params.inputHeight) {
+                                        continue;
+                                    }
+                                    const float* WEBNN_RESTRICT s =
+                                        x + ih * params.inputWidth + columnOffset;
+                                    float* WEBNN_RESTRICT d = y + oh * params.outputWidth;
+                                    for (int32_t ow = owBegin; ow < owEnd; ++ow) {
+                                        d[ow] += weight * s[ow * params.strideWidth];
+                                    }
+                                }
+                            }
+                        }
+                        ApplyActivation(activation, y, outputArea);
+                    }
+                },
+                ElementGrain(outputArea * kernelArea));
+        }
+
+        void BiasAndActivation(ThreadPool* pool,
+                               size_t planes,
+                               size_t channels,
+                               size_t area,
+                               const float* bias,
+                               const Activation& activation,
+                               float* output) {
+            if (bias == nullptr && activation.type == ActivationType::None) {
+                return;
+            }
+            pool->ParallelFor(
+                planes,
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        float* WEBNN_RESTRICT plane = output + i * area;
+                        if (bias != nullptr) {
+                            const float value = bias[i % channels];
+                            for (size_t j = 0; j < area; ++j) {
+                                plane[j] += value;
+                            }
+                        }
+                        ApplyActivation(activation, plane, area);
+                    }
+                },
+                ElementGrain(area));
+        }
+
+        float ActivationValue(const Activation& activation, float x) {
+            switch (activation.type) {
+                case ActivationType::None:
+                    return x;
+                case ActivationType::Clamp:
+                    return std::min(std::max(x, activation.minValue), activation.maxValue);
+                case ActivationType::HardSwish:
+                    return x * std::min(std::max(x + 3.0f, 0.0f), 6.0f) / 6.0f;
+                case ActivationType::LeakyRelu:
+                    return x < 0.0f ? activation.alpha * x : x;
+                case ActivationType::Relu:
+                    return std::max(x, 0.0f);
+                case ActivationType::Sigmoid:
+                    return 1.0f / (1.0f + std::exp(-x));
+                case ActivationType::Tanh:
+                    return std::tanh(x);
+            }
+            UNREACHABLE();
+            return x;
+        }
+
+        // Computes one step of one direction of a GRU. |hidden| is [batch, hiddenSize] and
+        // updated in place, |xw| holds x * W^T + bias for the step.
+        void GruCell(ThreadPool* pool,
+                     const GruParams& params,
+                     const float* xw,
+                     const float* recurrentWeight,
+                     const float* recurrentBias,
+                     float* hidden) {
+            const size_t batchSize = params.batchSize, hiddenSize = params.hiddenSize;
+            const size_t gateSize = 3 * hiddenSize;
+            const size_t zOffset = params.zrnLayout ? 0 : hiddenSize;
+            const size_t rOffset = params.zrnLayout ? hiddenSize : 0;
+            const size_t nOffset = 2 * hiddenSize;
+            float* hr = GetScratch(kScratchGru, batchSize * gateSize + batchSize * hiddenSize);
+            float* resetHidden = hr + batchSize * gateSize;
+
+            // hr = h * R^T, [batch, 3 * hiddenSize].
+            Gemm(pool, false, true, batchSize, gateSize, hiddenSize, 1.0f, hidden,
+                 recurrentWeight, 0.0f, hr);
+            for (size_t b = 0; b < batchSize; ++b) {
+                float* row = hr + b * gateSize;
+                if (recurrentBias != nullptr) {
+                    for (size_t j = 0; j < gateSize; ++j) {
+                        row[j] += recurrentBias[j];
+                    }
+                }
+                const float* x = xw + b * gateSize;
+                for (size_t j = 0; j < hiddenSize; ++j) {
+                    row[zOffset + j] = ActivationValue(params.gateActivation,
+                                                       x[zOffset + j] + row[zOffset + j]);
+                    row[rOffset + j] = ActivationValue(params.gateActivation,
+                                                       x[rOffset + j] + row[rOffset + j]);
+                }
+            }
+            if (!params.resetAfter) {
+                // The candidate is computed from (r . h) * Rn^T + Rbn instead.
+                for (size_t b = 0; b < batchSize; ++b) {
+                    for (size_t j = 0; j < hiddenSize; ++j) {
+                        resetHidden[b * hiddenSize + j] =
+                            hr[b * gateSize + rOffset + j] * hidden[b * hiddenSize + j];
+                    }
+                }
+                float* candidate = GetScratch(kScratchGemmA, batchSize * hiddenSize);
+                Gemm(pool, false, true, batchSize, hiddenSize, hiddenSize, 1.0f, resetHidden,
+                     recurrentWeight + nOffset * hiddenSize, 0.0f, candidate);
+                for (size_t b = 0; b < batchSize; ++b) {
+                    for (size_t j = 0; j < hiddenSize; ++j) {
+                        hr[b * gateSize + nOffset + j] =
+                            candidate[b * hiddenSize + j] +
+                            (recurrentBias != nullptr ? recurrentBias[nOffset + j] : 0.0f);
+                    }
+                }
+            }
+            for (size_t b = 0; b < batchSize; ++b) {
+                const float* row = hr + b * gateSize;
+                const float* x = xw + b * gateSize;
+                float* h = hidden + b * hiddenSize;
+                for (size_t j = 0; j < hiddenSize; ++j) {
+                    const float z = row[zOffset + j];
+                    const float recurrent =
+                        params.resetAfter ? row[rOffset + j] * row[nOffset + j] : row[nOffset + j];
+                    const float n =
+                        ActivationValue(params.candidateActivation, x[nOffset + j] + recurrent);
+                    h[j] = (1.0f - z) * n + z * h[j];
+                }
+            }
+        }
+
+    }  // anonymous namespace
+
+    size_t SizeOfShape(const Shape& shape) {
+        size_t size = 1;
+        for (auto dimension : shape) {
+            size *= dimension;
+        }
+        return size;
+    }
+
+    void ApplyActivation(const Activation& activation, float* data, size_t count) {
+        switch (activation.type) {
+            case ActivationType::None:
+                return;
+            case ActivationType::Clamp: {
+                const float minValue = activation.minValue, maxValue = activation.maxValue;
+                for (size_t i = 0; i < count; ++i) {
+                    data[i] = std::min(std::max(data[i], minValue), maxValue);
+                }
+                return;
+            }
+            case ActivationType::Relu:
+                for (size_t i = 0; i < count; ++i) {
+                    data[i] = std::max(data[i], 0.0f);
+                }
+                return;
+            case ActivationType::LeakyRelu: {
+                const float alpha = activation.alpha;
+                for (size_t i = 0; i < count; ++i) {
+                    data[i] = data[i] < 0.0f ? alpha * data[i] : data[i];
+                }
+                return;
+            }
+            default:
+                for (size_t i = 0; i < count; ++i) {
+                    data[i] = ActivationValue(activation, data[i]);
+                }
+                return;
+        }
+    }
+
+    void Gemm(ThreadPool* pool,
+              bool aTranspose,
+              bool bTranspose,
+              size_t M,
+              size_t N,
+              size_t K,
+              float alpha,
+              const float* a,
+              const float* b,
+              float beta,
+              float* c) {
+        if (M == 0 || N == 0) {
+            return;
+        }
+        // Pack transposed operands so that the tiles stream contiguous rows of both.
+        if (aTranspose) {
+            float* packed = GetScratch(kScratchGemmA, M * K);
+            Transpose(pool, a, {int32_t(K), int32_t(M)}, {1, 0}, packed);
+            a = packed;
+        }
+        if (bTranspose) {
+            float* packed = GetScratch(kScratchGemmB, K * N);
+            Transpose(pool, b, {int32_t(N), int32_t(K)}, {1, 0}, packed);
+            b = packed;
+        }
+        const size_t rowBlocks = (M + kGemmRowBlock - 1) / kGemmRowBlock;
+        const size_t columnBlocks = (N + kGemmColumnBlock - 1) / kGemmColumnBlock;
+        pool->ParallelFor(
+            rowBlocks * columnBlocks,
+            [&](size_t begin, size_t end) {
+                for (size_t tile = begin; tile < end; ++tile) {
+                    const size_t row = (tile / columnBlocks) * kGemmRowBlock;
+                    const size_t column = (tile % columnBlocks) * kGemmColumnBlock;
+                    GemmTile(std::min(kGemmRowBlock, M - row),
+                             std::min(kGemmColumnBlock, N - column), K, alpha, a + row * K, K,
+                             b + column, N, beta, c + row * N + column, N);
+                }
+            },
+            ElementGrain(kGemmRowBlock * kGemmColumnBlock * std::max<size_t>(K, 1) / 16));
+    }
+
+    void Binary(ThreadPool* pool,
+                BinaryType type,
+                const float* a,
+                const Shape& aShape,
+                const float* b,
+                const Shape& bShape,
+                float* output,
+                const Shape& outputShape) {
+        switch (type) {
+            case BinaryType::Add:
+                BinaryLoop(
+                    pool, [](float x, float y) { return x + y; }, a, aShape, b, bShape, output,
+                    outputShape);
+                break;
+            case BinaryType::Sub:
+                BinaryLoop(
+                    pool, [](float x, float y) { return x - y; }, a, aShape, b, bShape, output,
+                    outputShape);
+                break;
+            case BinaryType::Mul:
+                BinaryLoop(
+                    pool, [](float x, float y) { return x * y; }, a, aShape, b, bShape, output,
+                    outputShape);
+                break;
+            case BinaryType::Div:
+                BinaryLoop(
+                    pool, [](float x, float y) { return x / y; }, a, aShape, b, bShape, output,
+                    outputShape);
+                break;
+            case BinaryType::Max:
+                BinaryLoop(
+                    pool, [](float x, float y) { return std::max(x, y); }, a, aShape, b, bShape,
+                    output, outputShape);
+                break;
+            case BinaryType::Min:
+                BinaryLoop(
+                    pool, [](float x, float y) { return std::min(x, y); }, a, aShape, b, bShape,
+                    output, outputShape);
+                break;
+            case BinaryType::Power:
+                BinaryLoop(
+                    pool, [](float x, float y) { return std::pow(x, y); }, a, aShape, b, bShape,
+                    output, outputShape);
+                break;
+        }
+    }
+
+    void Broadcast(ThreadPool* pool,
+                   const float* input,
+                   const Shape& inputShape,
+                   float* output,
+                   const Shape& outputShape) {
+        BinaryLoop(
+            pool, [](float x, float) { return x; }, input, inputShape, input, inputShape, output,
+            outputShape);
+    }
+
+    void MatMul(ThreadPool* pool,
+                const float* a,
+                const Shape& aShape,
+                const float* b,
+                const Shape& bShape,
+                float* output) {
+        // A 1-D a is promoted to a row and a 1-D b to a column.
+        Shape aMatrix = aShape, bMatrix = bShape;
+        if (aMatrix.size() == 1) {
+            aMatrix.insert(aMatrix.begin(), 1);
+        }
+        if (bMatrix.size() == 1) {
+            bMatrix.push_back(1);
+        }
+        const size_t M = aMatrix[aMatrix.size() - 2], K = aMatrix[aMatrix.size() - 1];
+        const size_t N = bMatrix[bMatrix.size() - 1];
+        Shape aBatch(aMatrix.begin(), aMatrix.end() - 2);
+        Shape bBatch(bMatrix.begin(), bMatrix.end() - 2);
+        const size_t rank = std::max(aBatch.size(), bBatch.size());
+        Shape batchShape(rank);
+        for (size_t i = 0; i < rank; ++i) {
+            int32_t aDim = i < rank - aBatch.size() ? 1 : aBatch[i - (rank - aBatch.size())];
+            int32_t bDim = i < rank - bBatch.size() ? 1 : bBatch[i - (rank - bBatch.size())];
+            batchShape[i] = std::max(aDim, bDim);
+        }
+        const size_t batchCount = SizeOfShape(batchShape);
+        if (batchCount == 1) {
+            Gemm(pool, false, false, M, N, K, 1.0f, a, b, 0.0f, output);
+            return;
+        }
+        std::vector<size_t> aStrides = BroadcastStridesOf(aBatch, rank);
+        std::vector<size_t> bStrides = BroadcastStridesOf(bBatch, rank);
+        // Small matrices are spread over the pool by batch, large ones parallelize inside the
+        // GEMM because nested calls into the pool run inline.
+        pool->ParallelFor(
+            batchCount,
+            [&](size_t begin, size_t end) {
+                for (size_t batch = begin; batch < end; ++batch) {
+                    size_t index = batch, aOffset = 0, bOffset = 0;
+                    for (size_t d = rank; d-- > 0;) {
+                        size_t coordinate = index % batchShape[d];
+                        index /= batchShape[d];
+                        aOffset += coordinate * aStrides[d];
+                        bOffset += coordinate * bStrides[d];
+                    }
+                    Gemm(pool, false, false, M, N, K, 1.0f, a + aOffset * M * K,
+                         b + bOffset * K * N, 0.0f, output + batch * M * N);
+                }
+            },
+            1);
+    }
+
+    void Unary(ThreadPool* pool, UnaryType type, const float* input, float* output, size_t count) {
+        switch (type) {
+            case UnaryType::Abs:
+                ParallelMap(pool, input, output, count, [](float x) { return std::fabs(x); });
+                break;
+            case UnaryType::Ceil:
+                ParallelMap(pool, input, output, count, [](float x) { return std::ceil(x); });
+                break;
+            case UnaryType::Cos:
+                ParallelMap(pool, input, output, count, [](float x) { return std::cos(x); });
+                break;
+            case UnaryType::Exp:
+                ParallelMap(pool, input, output, count, [](float x) { return std::exp(x); });
+                break;
+            case UnaryType::Floor:
+                ParallelMap(pool, input, output, count, [](float x) { return std::floor(x); });
+                break;
+            case UnaryType::Log:
+                ParallelMap(pool, input, output, count, [](float x) { return std::log(x); });
+                break;
+            case UnaryType::Neg:
+                ParallelMap(pool, input, output, count, [](float x) { return -x; });
+                break;
+            case UnaryType::Sin:
+                ParallelMap(pool, input, output, count, [](float x) { return std::sin(x); });
+                break;
+            case UnaryType::Tan:
+                ParallelMap(pool, input, output, count, [](float x) { return std::tan(x); });
+                break;
+        }
+    }
+
+    void Activate(ThreadPool* pool,
+                  const Activation& activation,
+                  const float* input,
+                  float* output,
+                  size_t count) {
+        pool->ParallelFor(
+            count,
+            [&](size_t begin, size_t end) {
+                if (output != input) {
+                    memcpy(output + begin, input + begin, (end - begin) * sizeof(float));
+                }
+                ApplyActivation(activation, output + begin, end - begin);
+            },
+            kElementGrain);
+    }
+
+    void Softmax(ThreadPool* pool, const float* input, float* output, size_t rows, size_t columns) {
+        pool->ParallelFor(
+            rows,
+            [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    const float* WEBNN_RESTRICT x = input + row * columns;
+                    float* WEBNN_RESTRICT y = output + row * columns;
+                    const float maxValue = *std::max_element(x, x + columns);
+                    float sum = 0.0f;
+                    for (size_t j = 0; j < columns; ++j) {
+                        y[j] = std::exp(x[j] - maxValue);
+                        sum += y[j];
+                    }
+                    const float scale = 1.0f / sum;
+                    for (size_t j = 0; j < columns; ++j) {
+                        y[j] *= scale;
+                    }
+                }
+            },
+            ElementGrain(columns));
+    }
+
+    void Transpose(ThreadPool* pool,
+                   const float* input,
+                   const Shape& inputShape,
+                   const std::vector<int32_t>& permutation,
+                   float* output) {
+        TransposeElements(pool, input, inputShape, permutation, output);
+    }
+
+    void Transpose(ThreadPool* pool,
+                   const int16_t* input,
+                   const Shape& inputShape,
+                   const std::vector<int32_t>& permutation,
+                   int16_t* output) {
+        TransposeElements(pool, input, inputShape, permutation, output);
+    }
+
+    void Conv2d(ThreadPool* pool,
+                const Conv2dParams& params,
+                const float* input,
+                const float* filter,
+                const float* bias,
+                const Activation& activation,
+                float* output) {
+        const int32_t groups = params.groups;
+        const size_t inputChannelsPerGroup = params.inputChannels / groups;
+        const size_t outputChannelsPerGroup = params.outputChannels / groups;
+        const size_t kernelArea = params.filterHeight * params.filterWidth;
+        const size_t inputArea = params.inputHeight * params.inputWidth;
+        const size_t outputArea = params.outputHeight * params.outputWidth;
+
+        if (!params.transpose && groups == params.inputChannels &&
+            groups == params.outputChannels) {
+            DepthwiseConv2d(pool, params, input, filter, bias, activation, output);
+            return;
+        }
+
+        if (params.transpose) {
+            // The GEMM produces, per input pixel, the contribution to each (o, kh, kw) which is
+            // then scattered into the output planes.
+            const size_t colRows = outputChannelsPerGroup * kernelArea;
+            float* col = GetScratch(kScratchConv2d, colRows * inputArea);
+            for (int32_t n = 0; n < params.batches; ++n) {
+                for (int32_t g = 0; g < groups; ++g) {
+                    const float* x =
+                        input + (n * params.inputChannels + g * inputChannelsPerGroup) * inputArea;
+                    const float* w = filter + g * colRows * inputChannelsPerGroup;
+                    float* y =
+                        output +
+                        (n * params.outputChannels + g * outputChannelsPerGroup) * outputArea;
+                    Gemm(pool, false, false, colRows, inputArea, inputChannelsPerGroup, 1.0f, w,
+                         x, 0.0f, col);
+                    pool->ParallelFor(
+                        outputChannelsPerGroup,
+                        [&](size_t begin, size_t end) {
+                            for (size_t o = begin; o < end; ++o) {
+                                float* plane = y + o * outputArea;
+                                std::fill(plane, plane + outputArea, 0.0f);
+                                for (int32_t kh = 0; kh < params.filterHeight; ++kh) {
+                                    for (int32_t kw = 0; kw < params.filterWidth; ++kw) {
+                                        const float* source =
+                                            col + ((o * params.filterHeight + kh) *
+                                                       params.filterWidth +
+                                                   kw) *
+                                                      inputArea;
+                                        const int32_t columnOffset =
+                                            kw * params.dilationWidth - params.paddingLeft;
+                                        int32_t iwBegin, iwEnd;
+                                        ValidRange(columnOffset, params.strideWidth,
+                                                   params.outputWidth, params.inputWidth, iwBegin,
+                                                   iwEnd);
+                                        for (int32_t ih = 0; ih < params.inputHeight; ++ih) {
+                                            const int32_t oh = ih * params.strideHeight -
+                                                               params.paddingTop +
+                                                               kh * params.dilationHeight;
+                                            if (oh < 0 || oh >= params.outputHeight) {
+                                                continue;
+                                            }
+                                            float* d =
+                                                plane + oh * params.outputWidth + columnOffset;
+                                            const float* s = source + ih * params.inputWidth;
+                                            for (int32_t iw = iwBegin; iw < iwEnd; ++iw) {
+                                                d[iw * params.strideWidth] += s[iw];
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                        },
+                        1);
+                }
+            }
+        } else {
+            const size_t colRows = inputChannelsPerGroup * kernelArea;
+            const bool pointwise =
+                kernelArea == 1 && params.strideHeight == 1 && params.strideWidth == 1 &&
+                params.paddingTop == 0 && params.paddingLeft == 0 &&
+                params.inputHeight == params.outputHeight &&
+                params.inputWidth == params.outputWidth;
+            float* col = pointwise ? nullptr : GetScratch(kScratchConv2d, colRows * outputArea);
+            for (int32_t n = 0; n < params.batches; ++n) {
+                for (int32_t g = 0; g < groups; ++g) {
+                    const float* x =
+                        input + (n * params.inputChannels + g * inputChannelsPerGroup) * inputArea;
+                    const float* w = filter + g * outputChannelsPerGroup * colRows;
+                    float* y =
+                        output +
+                        (n * params.outputChannels + g * outputChannelsPerGroup) * outputArea;
+                    if (!pointwise) {
+                        Im2Col(pool, params, inputChannelsPerGroup, x, col);
+                        x = col;
+                    }
+                    Gemm(pool, false, false, outputChannelsPerGroup, outputArea, colRows, 1.0f, w,
+                         x, 0.0f, y);
+                }
+            }
+        }
+        BiasAndActivation(pool, params.batches * params.outputChannels, params.outputChannels,
+                          outputArea, bias, activation, output);
+    }
+
+    void QuantizeLinear(ThreadPool* pool,
+                        const float* input,
+                        size_t count,
+                        size_t channels,
+                        size_t inner,
+                        const float* scales,
+                        const int32_t* zeroPoints,
+                        bool isSigned,
+                        void* output) {
+        const float lowest = isSigned ? -128.0f : 0.0f;
+        const float highest = isSigned ? 127.0f : 255.0f;
+        pool->ParallelFor(
+            count,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const size_t c = (i / inner) % channels;
+                    // The ties are rounded to even like the other runtimes do.
+                    const float value = std::min(
+                        std::max(std::nearbyint(input[i] / scales[c]) + zeroPoints[c], lowest),
+                        highest);
+                    if (isSigned) {
+                        static_cast<int8_t*>(output)[i] = static_cast<int8_t>(value);
+                    } else {
+                        static_cast<uint8_t*>(output)[i] = static_cast<uint8_t>(value);
+                    }
+                }
+            },
+            kElementGrain);
+    }
+
+    void DequantizeLinear(ThreadPool* pool,
+                          const void* input,
+                          bool isSigned,
+                          size_t count,
+                          size_t channels,
+                          size_t inner,
+                          const float* scales,
+                          const int32_t* zeroPoints,
+                          float* output) {
+        pool->ParallelFor(
+            count,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const size_t c = (i / inner) % channels;
+                    const int32_t value = isSigned ? static_cast<const int8_t*>(input)[i]
+                                                   : static_cast<const uint8_t*>(input)[i];
+                    output[i] = static_cast<float>(value - zeroPoints[c]) * scales[c];
+                }
+            },
+            kElementGrain);
+    }
+
+    void WidenQuantized(ThreadPool* pool,
+                        const void* input,
+                        bool isSigned,
+                        size_t count,
+                        size_t channels,
+                        size_t inner,
+                        const int32_t* zeroPoints,
+                        int16_t* output) {
+        pool->ParallelFor(
+            count,
+            [&](size_t begin, size_t end) {
+                if (channels == 1) {
+                    const int32_t zeroPoint = zeroPoints[0];
+                    if (isSigned) {
+                        const int8_t* WEBNN_RESTRICT source = static_cast<const int8_t*>(input);
+                        for (size_t i = begin; i < end; ++i) {
+                            output[i] = static_cast<int16_t>(source[i] - zeroPoint);
+                        }
+                    } else {
+                        const uint8_t* WEBNN_RESTRICT source = static_cast<const uint8_t*>(input);
+                        for (size_t i = begin; i < end; ++i) {
+                            output[i] = static_cast<int16_t>(source[i] - zeroPoint);
+                        }
+                    }
+                    return;
+                }
+                for (size_t i = begin; i < end; ++i) {
+                    const int32_t value = isSigned ? static_cast<const int8_t*>(input)[i]
+                                                   : static_cast<const uint8_t*>(input)[i];
+                    output[i] = static_cast<int16_t>(value - zeroPoints[(i / inner) % channels]);
+                }
+            },
+            kElementGrain);
+    }
+
+    void QuantizedGemm(ThreadPool* pool,
+                       size_t M,
+                       size_t N,
+                       size_t K,
+                       const int16_t* a,
+                       const int16_t* b,
+                       const float* rowScales,
+                       const float* columnScales,
+                       float beta,
+                       float* c) {
+        if (M == 0 || N == 0) {
+            return;
+        }
+        const size_t rowBlocks = (M + kGemmRowBlock - 1) / kGemmRowBlock;
+        const size_t columnBlocks = (N + kGemmColumnBlock - 1) / kGemmColumnBlock;
+        pool->ParallelFor(
+            rowBlocks * columnBlocks,
+            [&](size_t begin, size_t end) {
+                for (size_t tile = begin; tile < end; ++tile) {
+                    const size_t row = (tile / columnBlocks) * kGemmRowBlock;
+                    const size_t column = (tile % columnBlocks) * kGemmColumnBlock;
+                    QuantizedGemmTile(std::min(kGemmRowBlock, M - row),
+                                      std::min(kGemmColumnBlock, N - column), K, a + row * K, K,
+                                      b + column, N,
+                                      rowScales != nullptr ? rowScales + row : nullptr,
+                                      columnScales != nullptr ? columnScales + column : nullptr,
+                                      beta, c + row * N + column, N);
+                }
+            },
+            ElementGrain(kGemmRowBlock * kGemmColumnBlock * std::max<size_t>(K, 1) / 16));
+    }
+
+    void QuantizedConv2d(ThreadPool* pool,
+                         const Conv2dParams& params,
+                         const int16_t* input,
+                         const int16_t* filter,
+                         const float* scales,
+                         const float* bias,
+                         const Activation& activation,
+                         float* output) {
+        DAWN_ASSERT(!params.transpose);
+        const int32_t groups = params.groups;
+        const size_t inputChannelsPerGroup = params.inputChannels / groups;
+        const size_t outputChannelsPerGroup = params.outputChannels / groups;
+        const size_t kernelArea = params.filterHeight * params.filterWidth;
+        const size_t inputArea = params.inputHeight * params.inputWidth;
+        const size_t outputArea = params.outputHeight * params.outputWidth;
+        const size_t colRows = inputChannelsPerGroup * kernelArea;
+        const bool pointwise =
+            kernelArea == 1 && params.strideHeight == 1 && params.strideWidth == 1 &&
+            params.paddingTop == 0 && params.paddingLeft == 0 &&
+            params.inputHeight == params.outputHeight && params.inputWidth == params.outputWidth;
+        int16_t* col =
+            pointwise ? nullptr : GetScratch<int16_t>(kScratchConv2d, colRows * outputArea);
+        for (int32_t n = 0; n < params.batches; ++n) {
+            for (int32_t g = 0; g < groups; ++g) {
+                const int16_t* x =
+                    input + (n * params.inputChannels + g * inputChannelsPerGroup) * inputArea;
+                const int16_t* w = filter + g * outputChannelsPerGroup * colRows;
+                float* y =
+                    output + (n * params.outputChannels + g * outputChannelsPerGroup) * outputArea;
+                if (!pointwise) {
+                    Im2Col(pool, params, inputChannelsPerGroup, x, col);
+                    x = col;
+                }
+                QuantizedGemm(pool, outputChannelsPerGroup, outputArea, colRows, w, x,
+                              scales + g * outputChannelsPerGroup, nullptr, 0.0f, y);
+            }
+        }
+        BiasAndActivation(pool, params.batches * params.outputChannels, params.outputChannels,
+                          outputArea, bias, activation, output);
+    }
+
+    void Pool2d(ThreadPool* pool,
+                PoolType type,
+                const Pool2dParams& params,
+                const float* input,
+                float* output) {
+        const size_t inputArea = params.inputHeight * params.inputWidth;
+        const size_t outputArea = params.outputHeight * params.outputWidth;
+        pool->ParallelFor(
+            params.batches * params.channels,
+            [&](size_t begin, size_t end) {
+                for (size_t plane = begin; plane < end; ++plane) {
+                    const float* x = input + plane * inputArea;
+                    float* y = output + plane * outputArea;
+                    for (int32_t oh = 0; oh < params.outputHeight; ++oh) {
+                        int32_t khBegin, khEnd;
+                        ValidRange(oh * params.strideHeight - params.paddingTop,
+                                   params.dilationHeight, params.inputHeight,
+                                   params.windowHeight, khBegin, khEnd);
+                        for (int32_t ow = 0; ow < params.outputWidth; ++ow) {
+                            int32_t kwBegin, kwEnd;
+                            ValidRange(ow * params.strideWidth - params.paddingLeft,
+                                       params.dilationWidth, params.inputWidth,
+                                       params.windowWidth, kwBegin, kwEnd);
+                            float value = type == PoolType::Max
+                                              ? std::numeric_limits<float>::lowest()
+                                              : 0.0f;
+                            for (int32_t kh = khBegin; kh < khEnd; ++kh) {
+                                const float* row =
+                                    x + (oh * params.strideHeight - params.paddingTop +
+                                         kh * params.dilationHeight) *
+                                            params.inputWidth +
+                                    ow * params.strideWidth - params.paddingLeft;
+                                for (int32_t kw = kwBegin; kw < kwEnd; ++kw) {
+                                    const float element = row[kw * params.dilationWidth];
+                                    switch (type) {
+                                        case PoolType::Average:
+                                            value += element;
+                                            break;
+                                        case PoolType::L2:
+                                            value += element * element;
+                                            break;
+                                        case PoolType::Max:
+                                            value = std::max(value, element);
+                                            break;
+                                    }
+                                }
+                            }
+                            // The average and the L2 norm are over the elements of the window
+                            // in the input, the padding isn't counted.
+                            if (type != PoolType::Max) {
+                                const int32_t count = (khEnd - khBegin) * (kwEnd - kwBegin);
+                                value = count > 0 ? value / count : 0.0f;
+                            }
+                            if (type == PoolType::L2) {
+                                value = std::sqrt(value);
+                            }
+                            y[oh * params.outputWidth + ow] = value;
+                        }
+                    }
+                }
+            },
+            ElementGrain(outputArea * params.windowHeight * params.windowWidth));
+    }
+
+    void Reduce(ThreadPool* pool,
+                ReduceType type,
+                const float* input,
+                const Shape& inputShape,
+                const std::vector<int32_t>& axes,
+                float* output) {
+        const size_t rank = inputShape.size();
+        std::vector<size_t> inputStrides = StridesOf(inputShape);
+        std::vector<bool> reduced(rank, false);
+        for (auto axis : axes) {
+            reduced[axis < 0 ? axis + rank : axis] = true;
+        }
+        Shape outputShape = inputShape, reducedShape;
+        std::vector<size_t> reducedStrides;
+        for (size_t i = 0; i < rank; ++i) {
+            if (reduced[i]) {
+                outputShape[i] = 1;
+                reducedShape.push_back(inputShape[i]);
+                reducedStrides.push_back(inputStrides[i]);
+            }
+        }
+        // Offsets of every element of the reduced sub-space relative to its first element.
+        std::vector<size_t> offsets(SizeOfShape(reducedShape));
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            size_t index = i, offset = 0;
+            for (size_t d = reducedShape.size(); d-- > 0;) {
+                offset += (index % reducedShape[d]) * reducedStrides[d];
+                index /= reducedShape[d];
+            }
+            offsets[i] = offset;
+        }
+        const size_t outputCount = SizeOfShape(outputShape);
+        pool->ParallelFor(
+            outputCount,
+            [&](size_t begin, size_t end) {
+                for (size_t o = begin; o < end; ++o) {
+                    size_t index = o, base = 0;
+                    for (size_t d = rank; d-- > 0;) {
+                        base += (index % outputShape[d]) * inputStrides[d];
+                        index /= outputShape[d];
+                    }
+                    const float* x = input + base;
+                    float value;
+                    switch (type) {
+                        case ReduceType::L1:
+                            value = 0.0f;
+                            for (size_t offset : offsets) {
+                                value += std::fabs(x[offset]);
+                            }
+                            break;
+                        case ReduceType::L2:
+                            value = 0.0f;
+                            for (size_t offset : offsets) {
+                                value += x[offset] * x[offset];
+                            }
+                            value = std::sqrt(value);
+                            break;
+                        case ReduceType::Max:
+                            value = std::numeric_limits<float>::lowest();
+                            for (size_t offset : offsets) {
+                                value = std::max(value, x[offset]);
+                            }
+                            break;
+                        case ReduceType::Min:
+                            value = std::numeric_limits<float>::max();
+                            for (size_t offset : offsets) {
+                                value = std::min(value, x[offset]);
+                            }
+                            break;
+                        case ReduceType::Product:
+                            value = 1.0f;
+                            for (size_t offset : offsets) {
+                                value *= x[offset];
+                            }
+                            break;
+                        case ReduceType::Mean:
+                        case ReduceType::Sum:
+                            value = 0.0f;
+                            for (size_t offset : offsets) {
+                                value += x[offset];
+                            }
+                            if (type == ReduceType::Mean) {
+                                value /= offsets.size();
+                            }
+                            break;
+                    }
+                    output[o] = value;
+                }
+            },
+            ElementGrain(offsets.size()));
+    }
+
+    void Resample2d(ThreadPool* pool,
+                    bool linear,
+                    const float* input,
+                    const Shape& inputShape,
+                    int32_t axis,
+                    const std::vector<float>& scales,
+                    float* output,
+                    const Shape& outputShape) {
+        size_t outer = 1, inner = 1;
+        for (int32_t i = 0; i < axis; ++i) {
+            outer *= inputShape[i];
+        }
+        for (size_t i = axis + 2; i < inputShape.size(); ++i) {
+            inner *= inputShape[i];
+        }
+        const int32_t inputHeight = inputShape[axis], inputWidth = inputShape[axis + 1];
+        const int32_t outputHeight = outputShape[axis], outputWidth = outputShape[axis + 1];
+
+        // Source coordinates use the half pixel transformation, nearest neighbor rounds halves
+        // down.
+        struct Tap {
+            int32_t first;
+            int32_t second;
+            float weight;
+        };
+        auto computeTaps = [linear](int32_t outputSize, int32_t inputSize, float scale) {
+            std::vector<Tap> taps(outputSize);
+            for (int32_t o = 0; o < outputSize; ++o) {
+                float source = (o + 0.5f) / scale - 0.5f;
+                if (linear) {
+                    source = std::min(std::max(source, 0.0f), float(inputSize - 1));
+                    int32_t first = int32_t(std::floor(source));
+                    taps[o] = {first, std::min(first + 1, inputSize - 1), source - first};
+                } else {
+                    int32_t nearest = source - std::floor(source) == 0.5f
+                                          ? int32_t(std::floor(source))
+                                          : int32_t(std::round(source));
+                    nearest = std::min(std::max(nearest, 0), inputSize - 1);
+                    taps[o] = {nearest, nearest, 0.0f};
+                }
+            }
+            return taps;
+        };
+        const std::vector<Tap> rowTaps = computeTaps(outputHeight, inputHeight, scales[0]);
+        const std::vector<Tap> columnTaps = computeTaps(outputWidth, inputWidth, scales[1]);
+
+        pool->ParallelFor(
+            outer * outputHeight,
+            [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    const size_t o = row / outputHeight;
+                    const Tap& rowTap = rowTaps[row % outputHeight];
+                    const float* x = input + o * inputHeight * inputWidth * inner;
+                    const float* top = x + rowTap.first * inputWidth * inner;
+                    const float* bottom = x + rowTap.second * inputWidth * inner;
+                    float* y = output + row * outputWidth * inner;
+                    for (int32_t ow = 0; ow < outputWidth; ++ow) {
+                        const Tap& columnTap = columnTaps[ow];
+                        float* WEBNN_RESTRICT d = y + ow * inner;
+                        if (!linear) {
+                            memcpy(d, top + columnTap.first * inner, inner * sizeof(float));
+                            continue;
+                        }
+                        const float* WEBNN_RESTRICT topLeft = top + columnTap.first * inner;
+                        const float* WEBNN_RESTRICT topRight = top + columnTap.second * inner;
+                        const float* WEBNN_RESTRICT bottomLeft = bottom + columnTap.first * inner;
+                        const float* WEBNN_RESTRICT bottomRight =
+                            bottom + columnTap.second * inner;
+                        const float dy = rowTap.weight, dx = columnTap.weight;
+                        for (size_t i = 0; i < inner; ++i) {
+                            const float upper = topLeft[i] + (topRight[i] - topLeft[i]) * dx;
+                            const float lower =
+                                bottomLeft[i] + (bottomRight[i] - bottomLeft[i]) * dx;
+                            d[i] = upper + (lower - upper) * dy;
+                        }
+                    }
+                }
+            },
+            ElementGrain(outputWidth * inner));
+    }
+
+    void Pad(ThreadPool* pool,
+             PaddingMode mode,
+             float value,
+             const float* input,
+             const Shape& inputShape,
+             const std::vector<int32_t>& padding,
+             float* output,
+             const Shape& outputShape) {
+        const size_t rank = inputShape.size();
+        std::vector<size_t> inputStrides = StridesOf(inputShape);
+        // Maps an output coordinate of dimension d to the input, -1 when it reads the constant.
+        auto mapCoordinate = [&](size_t d, int32_t coordinate) -> int32_t {
+            const int32_t size = inputShape[d];
+            int32_t i = coordinate - padding[2 * d];
+            if (i >= 0 && i < size) {
+                return i;
+            }
+            switch (mode) {
+                case PaddingMode::Constant:
+                    return -1;
+                case PaddingMode::Edge:
+                    return std::min(std::max(i, 0), size - 1);
+                case PaddingMode::Reflection:
+                    if (size == 1) {
+                        return 0;
+                    }
+                    while (i < 0 || i >= size) {
+                        i = i < 0 ? -i : 2 * (size - 1) - i;
+                    }
+                    return i;
+                case PaddingMode::Symmetric:
+                    while (i < 0 || i >= size) {
+                        i = i < 0 ? -i - 1 : 2 * size - 1 - i;
+                    }
+                    return i;
+            }
+            UNREACHABLE();
+            return -1;
+        };
+        const int32_t inner = outputShape[rank - 1];
+        std::vector<int32_t> innerMap(inner);
+        for (int32_t j = 0; j < inner; ++j) {
+            innerMap[j] = mapCoordinate(rank - 1, j);
+        }
+        const size_t rows = SizeOfShape(outputShape) / inner;
+        pool->ParallelFor(
+            rows,
+            [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    float* y = output + row * inner;
+                    size_t index = row, offset = 0;
+                    bool outside = false;
+                    for (size_t d = rank - 1; d-- > 0;) {
+                        int32_t coordinate = mapCoordinate(d, index % outputShape[d]);
+                        index /= outputShape[d];
+                        if (coordinate < 0) {
+                            outside = true;
+                            break;
+                        }
+                        offset += coordinate * inputStrides[d];
+                    }
+                    if (outside) {
+                        std::fill(y, y + inner, value);
+                        continue;
+                    }
+                    const float* x = input + offset;
+                    for (int32_t j = 0; j < inner; ++j) {
+                        y[j] = innerMap[j] < 0 ? value : x[innerMap[j]];
+                    }
+                }
+            },
+            ElementGrain(inner));
+    }
+
+    void Slice(ThreadPool* pool,
+               const float* input,
+               const Shape& inputShape,
+               const std::vector<int32_t>& starts,
+               float* output,
+               const Shape& outputShape) {
+        const size_t rank = inputShape.size();
+        std::vector<size_t> inputStrides = StridesOf(inputShape);
+        size_t startOffset = 0;
+        for (size_t d = 0; d < rank; ++d) {
+            startOffset += starts[d] * inputStrides[d];
+        }
+        const size_t inner = outputShape[rank - 1];
+        pool->ParallelFor(
+            SizeOfShape(outputShape) / inner,
+            [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    size_t index = row, offset = startOffset;
+                    for (size_t d = rank - 1; d-- > 0;) {
+                        offset += (index % outputShape[d]) * inputStrides[d];
+                        index /= outputShape[d];
+                    }
+                    memcpy(output + row * inner, input + offset, inner * sizeof(float));
+                }
+            },
+            ElementGrain(inner));
+    }
+
+    void CopyAlongAxis(ThreadPool* pool,
+                       const float* input,
+                       const Shape& inputShape,
+                       float* output,
+                       const Shape& outputShape,
+                       size_t axis,
+                       int32_t offset) {
+        // Both tensors are viewed as [outer, axis * inner], each outer row is one block copy.
+        size_t outer = 1, inner = 1;
+        for (size_t i = 0; i < axis; ++i) {
+            outer *= inputShape[i];
+        }
+        for (size_t i = axis + 1; i < inputShape.size(); ++i) {
+            inner *= inputShape[i];
+        }
+        const size_t block = inputShape[axis] * inner;
+        const size_t outputRow = outputShape[axis] * inner;
+        pool->ParallelFor(
+            outer,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    memcpy(output + i * outputRow + offset * inner, input + i * block,
+                           block * sizeof(float));
+                }
+            },
+            ElementGrain(block));
+    }
+
+    void BatchNorm(ThreadPool* pool,
+                   const float* input,
+                   const Shape& inputShape,
+                   size_t axis,
+                   const float* mean,
+                   const float* variance,
+                   const float* scale,
+                   const float* bias,
+                   float epsilon,
+                   const Activation& activation,
+                   float* output) {
+        const size_t channels = inputShape[axis];
+        // Fold the statistics into a per channel multiply and add.
+        std::vector<float> multiplier(channels), addend(channels);
+        for (size_t c = 0; c < channels; ++c) {
+            multiplier[c] = (scale != nullptr ? scale[c] : 1.0f) / std::sqrt(variance[c] + epsilon);
+            addend[c] = (bias != nullptr ? bias[c] : 0.0f) - mean[c] * multiplier[c];
+        }
+        size_t inner = 1;
+        for (size_t i = axis + 1; i < inputShape.size(); ++i) {
+            inner *= inputShape[i];
+        }
+        const size_t count = SizeOfShape(inputShape);
+        if (inner == 1) {
+            // Channels last, one row per pixel.
+            pool->ParallelFor(
+                count / channels,
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        const float* WEBNN_RESTRICT x = input + i * channels;
+                        float* WEBNN_RESTRICT y = output + i * channels;
+                        for (size_t c = 0; c < channels; ++c) {
+                            y[c] = x[c] * multiplier[c] + addend[c];
+                        }
+                        ApplyActivation(activation, y, channels);
+                    }
+                },
+                ElementGrain(channels));
+        } else {
+            pool->ParallelFor(
+                count / inner,
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        const float* WEBNN_RESTRICT x = input + i * inner;
+                        float* WEBNN_RESTRICT y = output + i * inner;
+                        const float m = multiplier[i % channels], a = addend[i % channels];
+                        for (size_t j = 0; j < inner; ++j) {
+                            y[j] = x[j] * m + a;
+                        }
+                        ApplyActivation(activation, y, inner);
+                    }
+                },
+                ElementGrain(inner));
+        }
+    }
+
+    void InstanceNorm(ThreadPool* pool,
+                      const float* input,
+                      const Shape& inputShape,
+                      bool nhwc,
+                      const float* scale,
+                      const float* bias,
+                      float epsilon,
+                      float* output) {
+        const size_t batches = inputShape[0];
+        const size_t channels = nhwc ? inputShape[3] : inputShape[1];
+        const size_t area = nhwc ? inputShape[1] * inputShape[2] : inputShape[2] * inputShape[3];
+        // Elements of one channel are contiguous in nchw and |channels| apart in nhwc.
+        const size_t channelStride = nhwc ? 1 : area;
+        const size_t elementStride = nhwc ? channels : 1;
+        pool->ParallelFor(
+            batches * channels,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const size_t n = i / channels, c = i % channels;
+                    const size_t base = n * channels * area + c * channelStride;
+                    const float* x = input + base;
+                    float* y = output + base;
+                    float mean = 0.0f;
+                    for (size_t j = 0; j < area; ++j) {
+                        mean += x[j * elementStride];
+                    }
+                    mean /= area;
+                    float variance = 0.0f;
+                    for (size_t j = 0; j < area; ++j) {
+                        const float difference = x[j * elementStride] - mean;
+                        variance += difference * difference;
+                    }
+                    variance /= area;
+                    const float multiplier =
+                        (scale != nullptr ? scale[c] : 1.0f) / std::sqrt(variance + epsilon);
+                    const float addend = (bias != nullptr ? bias[c] : 0.0f) - mean * multiplier;
+                    for (size_t j = 0; j < area; ++j) {
+                        y[j * elementStride] = x[j * elementStride] * multiplier + addend;
+                    }
+                }
+            },
+            ElementGrain(area));
+    }
+
+    void Gru(ThreadPool* pool,
+             const GruParams& params,
+             const float* input,
+             const float* weight,
+             const float* recurrentWeight,
+             const float* bias,
+             const float* recurrentBias,
+             const float* initialHiddenState,
+             float* output,
+             float* sequence,
+             float* projection) {
+        const size_t steps = params.steps, batchSize = params.batchSize;
+        const size_t inputSize = params.inputSize, hiddenSize = params.hiddenSize;
+        const size_t gateSize = 3 * hiddenSize;
+        const size_t stateSize = batchSize * hiddenSize;
+        // The input projections of all steps don't depend on the state, so they are computed
+        // up front by one large GEMM per direction.
+        float* xw = projection;
+        for (int32_t d = 0; d < params.numDirections; ++d) {
+            const bool backward = params.backwardOnly || d == 1;
+            const float* w = weight + d * gateSize * inputSize;
+            const float* r = recurrentWeight + d * gateSize * hiddenSize;
+            const float* b = bias != nullptr ? bias + d * gateSize : nullptr;
+            const float* rb = recurrentBias != nullptr ? recurrentBias + d * gateSize : nullptr;
+            Gemm(pool, false, true, steps * batchSize, gateSize, inputSize, 1.0f, input, w, 0.0f,
+                 xw);
+            if (b != nullptr) {
+                for (size_t row = 0; row < steps * batchSize; ++row) {
+                    float* x = xw + row * gateSize;
+                    for (size_t j = 0; j < gateSize; ++j) {
+                        x[j] += b[j];
+                    }
+                }
+            }
+            float* hidden = output + d * stateSize;
+            // The hidden state a previous call left in the output is already in place.
+            if (initialHiddenState == nullptr) {
+                std::fill(hidden, hidden + stateSize, 0.0f);
+            } else if (initialHiddenState != output) {
+                memcpy(hidden, initialHiddenState + d * stateSize, stateSize * sizeof(float));
+            }
+            for (size_t step = 0; step < steps; ++step) {
+                const size_t t = backward ? steps - 1 - step : step;
+                GruCell(pool, params, xw + t * batchSize * gateSize, r, rb, hidden);
+                if (sequence != nullptr) {
+                    memcpy(sequence + (t * params.numDirections + d) * stateSize, hidden,
+                           stateSize * sizeof(float));
+                }
+            }
+        }
+    }
+
+}}}  // namespace webnn_native::cpu::kernels
@@ -0,0 +1,356 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_CPU_KERNELS_CPU_H_
+#define WEBNN_NATIVE_CPU_KERNELS_CPU_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "webnn_native/cpu/ThreadPoolCPU.h"
+
+// Float32 kernels of the CPU backend and the integer kernels of the quantized tensors. All
+// tensors are dense and row-major, 4-D image tensors are in nchw and filters in oihw unless
+// stated otherwise; the graph converts other layouts before calling in. The inner loops are
+// written over contiguous memory so that the compiler can vectorize them, and the outer loops
+// are split across the thread pool.
+namespace webnn_native { namespace cpu { namespace kernels {
+
+    using Shape = std::vector<int32_t>;
+
+    size_t SizeOfShape(const Shape& shape);
+
+    enum class ActivationType {
+        None,
+        Clamp,
+        HardSwish,
+        LeakyRelu,
+        Relu,
+        Sigmoid,
+        Tanh,
+    };
+
+    struct Activation {
+        ActivationType type = ActivationType::None;
+        float minValue = std::numeric_limits<float>::lowest();
+        float maxValue = std::numeric_limits<float>::max();
+        float alpha = 0.01f;
+    };
+
+    // Applies |activation| in place. Serial, meant to be called from inside a parallel range.
+    void ApplyActivation(const Activation& activation, float* data, size_t count);
+
+    // C[M, N] = alpha * op(A) * op(B) + beta * C, op(A) is [M, K] and op(B) is [K, N]. A and B are
+    // [K, M] and [N, K] respectively when transposed. C is not read when beta is 0.
+    void Gemm(ThreadPool* pool,
+              bool aTranspose,
+              bool bTranspose,
+              size_t M,
+              size_t N,
+              size_t K,
+              float alpha,
+              const float* a,
+              const float* b,
+              float beta,
+              float* c);
+
+    enum class BinaryType { Add, Sub, Mul, Div, Max, Min, Power };
+
+    // Element-wise binary with bidirectional broadcasting to |outputShape|.
+    void Binary(ThreadPool* pool,
+                BinaryType type,
+                const float* a,
+                const Shape& aShape,
+                const float* b,
+                const Shape& bShape,
+                float* output,
+                const Shape& outputShape);
+
+    // Copies |input| into |output| broadcasting it to |outputShape|.
+    void Broadcast(ThreadPool* pool,
+                   const float* input,
+                   const Shape& inputShape,
+                   float* output,
+                   const Shape& outputShape);
+
+    // Matrix product with numpy matmul semantics for 1-D inputs and broadcast batch dimensions.
+    void MatMul(ThreadPool* pool,
+                const float* a,
+                const Shape& aShape,
+                const float* b,
+                const Shape& bShape,
+                float* output);
+
+    enum class UnaryType {
+        Abs,
+        Ceil,
+        Cos,
+        Exp,
+        Floor,
+        Log,
+        Neg,
+        Sin,
+        Tan,
+    };
+
+    void Unary(ThreadPool* pool, UnaryType type, const float* input, float* output, size_t count);
+
+    // Runs |activation| element-wise from |input| to |output|, which may alias.
+    void Activate(ThreadPool* pool,
+                  const Activation& activation,
+                  const float* input,
+                  float* output,
+                  size_t count);
+
+    // Softmax over the last dimension of a [rows, columns] tensor.
+    void Softmax(ThreadPool* pool, const float* input, float* output, size_t rows, size_t columns);
+
+    void Transpose(ThreadPool* pool,
+                   const float* input,
+                   const Shape& inputShape,
+                   const std::vector<int32_t>& permutation,
+                   float* output);
+
+    void Transpose(ThreadPool* pool,
+                   const int16_t* input,
+                   const Shape& inputShape,
+                   const std::vector<int32_t>& permutation,
+                   int16_t* output);
+
+    struct Conv2dParams {
+        int32_t batches;
+        int32_t inputChannels;
+        int32_t inputHeight;
+        int32_t inputWidth;
+        int32_t outputChannels;
+        int32_t outputHeight;
+        int32_t outputWidth;
+        int32_t filterHeight;
+        int32_t filterWidth;
+        int32_t strideHeight;
+        int32_t strideWidth;
+        int32_t dilationHeight;
+        int32_t dilationWidth;
+        int32_t paddingTop;
+        int32_t paddingLeft;
+        int32_t groups;
+        bool transpose;
+    };
+
+    // Convolution of an nchw input. The filter is oihw, or packed as ohwi per group, that is
+    // [groups, outputChannels / groups, h, w, inputChannels / groups], for a transposed
+    // convolution. |bias| may be null.
+    void Conv2d(ThreadPool* pool,
+                const Conv2dParams& params,
+                const float* input,
+                const float* filter,
+                const float* bias,
+                const Activation& activation,
+                float* output);
+
+    // The quantized tensors hold int8 values, or uint8 ones when not |isSigned|, with a scale
+    // and a zero point per channel. The channel of element i is (i / inner) % channels, a
+    // tensor quantized as a whole has a single channel.
+
+    // q = clamp(round(x / scale) + zeroPoint), rounding the ties to even.
+    void QuantizeLinear(ThreadPool* pool,
+                        const float* input,
+                        size_t count,
+                        size_t channels,
+                        size_t inner,
+                        const float* scales,
+                        const int32_t* zeroPoints,
+                        bool isSigned,
+                        void* output);
+
+    // x = (q - zeroPoint) * scale.
+    void DequantizeLinear(ThreadPool* pool,
+                          const void* input,
+                          bool isSigned,
+                          size_t count,
+                          size_t channels,
+                          size_t inner,
+                          const float* scales,
+                          const int32_t* zeroPoints,
+                          float* output);
+
+    // Widens the quantized values to int16 minus their zero point, the operands of the integer
+    // kernels below. A zero point then pads with 0 and the products fit in int32 sums.
+    void WidenQuantized(ThreadPool* pool,
+                        const void* input,
+                        bool isSigned,
+                        size_t count,
+                        size_t channels,
+                        size_t inner,
+                        const int32_t* zeroPoints,
+                        int16_t* output);
+
+    // C[M, N] = rowScales[m] * columnScales[n] * A * B + beta * C over widened operands, with
+    // the products accumulated in int32. Either scales may be null for 1, C is not read when
+    // beta is 0.
+    void QuantizedGemm(ThreadPool* pool,
+                       size_t M,
+                       size_t N,
+                       size_t K,
+                       const int16_t* a,
+                       const int16_t* b,
+                       const float* rowScales,
+                       const float* columnScales,
+                       float beta,
+                       float* c);
+
+    // Convolution of a widened nchw input with a widened oihw filter into float32, |scales|
+    // holds the input scale times the filter scale of each output channel. Transposed
+    // convolutions aren't supported.
+    void QuantizedConv2d(ThreadPool* pool,
+                         const Conv2dParams& params,
+                         const int16_t* input,
+                         const int16_t* filter,
+                         const float* scales,
+                         const float* bias,
+                         const Activation& activation,
+                         float* output);
+
+    enum class PoolType { Average, L2, Max };
+
+    struct Pool2dParams {
+        int32_t batches;
+        int32_t channels;
+        int32_t inputHeight;
+        int32_t inputWidth;
+        int32_t outputHeight;
+        int32_t outputWidth;
+        int32_t windowHeight;
+        int32_t windowWidth;
+        int32_t strideHeight;
+        int32_t strideWidth;
+        int32_t dilationHeight;
+        int32_t dilationWidth;
+        int32_t paddingTop;
+        int32_t paddingLeft;
+    };
+
+    // Pooling of an nchw input, padded elements are excluded from the window.
+    void Pool2d(ThreadPool* pool,
+                PoolType type,
+                const Pool2dParams& params,
+                const float* input,
+                float* output);
+
+    enum class ReduceType { L1, L2, Max, Mean, Min, Product, Sum };
+
+    // Reduces |input| over |axes|, the output has the input rank with reduced dimensions of 1.
+    void Reduce(ThreadPool* pool,
+                ReduceType type,
+                const float* input,
+                const Shape& inputShape,
+                const std::vector<int32_t>& axes,
+                float* output);
+
+    // Scales along a pair of consecutive dimensions starting at |axis| of a 4-D tensor.
+    void Resample2d(ThreadPool* pool,
+                    bool linear,
+                    const float* input,
+                    const Shape& inputShape,
+                    int32_t axis,
+                    const std::vector<float>& scales,
+                    float* output,
+                    const Shape& outputShape);
+
+    enum class PaddingMode { Constant, Edge, Reflection, Symmetric };
+
+    // |padding| holds the begin and end padding of each dimension.
+    void Pad(ThreadPool* pool,
+             PaddingMode mode,
+             float value,
+             const float* input,
+             const Shape& inputShape,
+             const std::vector<int32_t>& padding,
+             float* output,
+             const Shape& outputShape);
+
+    // Copies the box of |outputShape| starting at |starts| out of |input|.
+    void Slice(ThreadPool* pool,
+               const float* input,
+               const Shape& inputShape,
+               const std::vector<int32_t>& starts,
+               float* output,
+               const Shape& outputShape);
+
+    // Copies |input| into |output| at |offset| along |axis|, the shapes match elsewhere.
+    void CopyAlongAxis(ThreadPool* pool,
+                       const float* input,
+                       const Shape& inputShape,
+                       float* output,
+                       const Shape& outputShape,
+                       size_t axis,
+                       int32_t offset);
+
+    // Batch normalization over |axis| 1 (nchw) or 3 (nhwc). |scale| and |bias| may be null.
+    void BatchNorm(ThreadPool* pool,
+                   const float* input,
+                   const Shape& inputShape,
+                   size_t axis,
+                   const float* mean,
+                   const float* variance,
+                   const float* scale,
+                   const float* bias,
+                   float epsilon,
+                   const Activation& activation,
+                   float* output);
+
+    // Instance normalization of a 4-D tensor. |scale| and |bias| may be null.
+    void InstanceNorm(ThreadPool* pool,
+                      const float* input,
+                      const Shape& inputShape,
+                      bool nhwc,
+                      const float* scale,
+                      const float* bias,
+                      float epsilon,
+                      float* output);
+
+    struct GruParams {
+        int32_t steps;
+        int32_t batchSize;
+        int32_t inputSize;
+        int32_t hiddenSize;
+        int32_t numDirections;
+        bool resetAfter;
+        // The gates are ordered update, reset, new when true and reset, update, new otherwise.
+        bool zrnLayout;
+        bool backwardOnly;
+        Activation gateActivation;
+        Activation candidateActivation;
+    };
+
+    // |bias|, |recurrentBias|, |initialHiddenState| and |sequence| may be null.
+    // |initialHiddenState| may also be |output|, holding the state a previous call left.
+    // |projection| is scratch memory of steps * batchSize * 3 * hiddenSize values.
+    void Gru(ThreadPool* pool,
+             const GruParams& params,
+             const float* input,
+             const float* weight,
+             const float* recurrentWeight,
+             const float* bias,
+             const float* recurrentBias,
+             const float* initialHiddenState,
+             float* output,
+             float* sequence,
+             float* projection);
+
+}}}  // namespace webnn_native::cpu::kernels
+
+#endif  // WEBNN_NATIVE_CPU_KERNELS_CPU_H_
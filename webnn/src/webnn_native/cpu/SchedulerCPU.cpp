@@ -0,0 +1,104 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/cpu/SchedulerCPU.h"
+
+#include "common/Assert.h"
+
+namespace webnn_native { namespace cpu {
+
+    Scheduler::Scheduler(std::vector<std::vector<size_t>> dependents)
+        : mDependents(std::move(dependents)), mDependencyCounts(mDependents.size(), 0) {
+        for (size_t i = 0; i < mDependents.size(); ++i) {
+            for (size_t dependent : mDependents[i]) {
+                DAWN_ASSERT(dependent > i && dependent < mDependents.size());
+                ++mDependencyCounts[dependent];
+            }
+        }
+    }
+
+    void Scheduler::Run(ThreadPool* interOpPool,
+                        const std::vector<ThreadPool*>& lanePools,
+                        const std::function<void(size_t, ThreadPool*)>& run) {
+        DAWN_ASSERT(!lanePools.empty());
+        const size_t laneCount = lanePools.size();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQueues.assign(laneCount, std::deque<size_t>());
+            mPendingCounts = mDependencyCounts;
+            mRemaining = mDependents.size();
+            // The operations ready from the start are dealt to the lanes in turn.
+            size_t lane = 0;
+            for (size_t i = 0; i < mPendingCounts.size(); ++i) {
+                if (mPendingCounts[i] == 0) {
+                    mQueues[lane].push_back(i);
+                    lane = (lane + 1) % laneCount;
+                }
+            }
+        }
+        // A lane returns once all the operations are done, so a lane that starts late, or the
+        // only one when the inter-op pool is busy and runs the lanes inline, still sees them all.
+        interOpPool->ParallelFor(
+            laneCount, [&](size_t begin, size_t) { RunLane(begin, lanePools[begin], run); }, 1);
+    }
+
+    void Scheduler::RunLane(size_t lane,
+                            ThreadPool* pool,
+                            const std::function<void(size_t, ThreadPool*)>& run) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (mRemaining != 0) {
+            size_t operation;
+            if (!TakeOperation(lane, &operation)) {
+                mReadyCondition.wait(lock);
+                continue;
+            }
+            lock.unlock();
+            run(operation, pool);
+            lock.lock();
+
+            --mRemaining;
+            size_t readyCount = 0;
+            for (size_t dependent : mDependents[operation]) {
+                if (--mPendingCounts[dependent] == 0) {
+                    mQueues[lane].push_back(dependent);
+                    ++readyCount;
+                }
+            }
+            // This lane takes one of the ready operations itself, the idle lanes are woken for
+            // the others or to return.
+            if (mRemaining == 0 || readyCount > 1) {
+                mReadyCondition.notify_all();
+            }
+        }
+    }
+
+    bool Scheduler::TakeOperation(size_t lane, size_t* operation) {
+        std::deque<size_t>& queue = mQueues[lane];
+        if (!queue.empty()) {
+            *operation = queue.back();
+            queue.pop_back();
+            return true;
+        }
+        for (size_t i = 1; i < mQueues.size(); ++i) {
+            std::deque<size_t>& victim = mQueues[(lane + i) % mQueues.size()];
+            if (!victim.empty()) {
+                *operation = victim.front();
+                victim.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+}}  // namespace webnn_native::cpu
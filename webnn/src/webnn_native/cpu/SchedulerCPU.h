@@ -0,0 +1,70 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_CPU_SCHEDULER_CPU_H_
+#define WEBNN_NATIVE_CPU_SCHEDULER_CPU_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "webnn_native/cpu/ThreadPoolCPU.h"
+
+namespace webnn_native { namespace cpu {
+
+    // Runs the operations of a graph on several lanes at once, each of which computes one
+    // operation at a time with the threads of its own pool. An operation is ready once all the
+    // operations it depends on are done, it then goes to the back of the queue of the lane that
+    // finished the last of them. A lane takes the newest operation of its own queue, which likely
+    // reads what it just wrote, and steals the oldest one of another lane when its queue is empty.
+    class Scheduler {
+      public:
+        // |dependents[i]| lists the operations reading what operation i writes, which all come
+        // after it.
+        explicit Scheduler(std::vector<std::vector<size_t>> dependents);
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        // Runs every operation by calling |run(operation, pool)| with the pool of the lane it is
+        // computed on, one lane per pool of |lanePools| which the threads of |interOpPool| drive.
+        // Returns when all of them are done. Runs aren't reentrant.
+        void Run(ThreadPool* interOpPool,
+                 const std::vector<ThreadPool*>& lanePools,
+                 const std::function<void(size_t, ThreadPool*)>& run);
+
+      private:
+        void RunLane(size_t lane,
+                     ThreadPool* pool,
+                     const std::function<void(size_t, ThreadPool*)>& run);
+        // Pops the next operation for |lane| from its own queue or another one.
+        bool TakeOperation(size_t lane, size_t* operation);
+
+        std::vector<std::vector<size_t>> mDependents;
+        std::vector<size_t> mDependencyCounts;
+
+        // The state of a run, guarded by mMutex.
+        std::mutex mMutex;
+        std::condition_variable mReadyCondition;
+        std::vector<std::deque<size_t>> mQueues;
+        std::vector<size_t> mPendingCounts;
+        size_t mRemaining = 0;
+    };
+
+}}  // namespace webnn_native::cpu
+
+#endif  // WEBNN_NATIVE_CPU_SCHEDULER_CPU_H_
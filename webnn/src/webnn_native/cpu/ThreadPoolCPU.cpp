@@ -0,0 +1,151 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/cpu/ThreadPoolCPU.h"
+
+#include <algorithm>
+
+#include "common/Log.h"
+#include "common/Platform.h"
+
+#if defined(DAWN_PLATFORM_LINUX)
+#    include <pthread.h>
+#    include <sched.h>
+#endif
+
+namespace webnn_native { namespace cpu {
+
+    namespace {
+        // The pool whose chunks the thread is running, set on the workers and on a dispatching
+        // thread while it runs chunks, so that a kernel calling back into the same pool runs
+        // serially instead of deadlocking. A worker of the inter-op pool may still dispatch into
+        // the pool of its lane.
+        thread_local const ThreadPool* tCurrentPool = nullptr;
+
+        void PinThread(std::thread& thread, uint32_t core) {
+#if defined(DAWN_PLATFORM_LINUX)
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(core, &cpuSet);
+            if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet) != 0) {
+                dawn::WarningLog() << "Failed to pin a worker thread to core " << core << ".";
+            }
+#else
+            dawn::WarningLog() << "Pinning the worker threads isn't supported on this platform.";
+#endif
+        }
+    }  // anonymous namespace
+
+    ThreadPool::ThreadPool(uint32_t threadCount, bool pinThreads, uint32_t firstCore)
+        : mThreadCount(threadCount), mNextChunk(0) {
+        uint32_t coreCount = std::max(1u, std::thread::hardware_concurrency());
+        if (mThreadCount == 0) {
+            mThreadCount = coreCount;
+        }
+        mWorkers.reserve(mThreadCount - 1);
+        for (uint32_t i = 1; i < mThreadCount; ++i) {
+            mWorkers.emplace_back(&ThreadPool::WorkerLoop, this);
+            // The first core is left to the calling thread.
+            if (pinThreads) {
+                PinThread(mWorkers.back(), (firstCore + i) % coreCount);
+            }
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mExit = true;
+        }
+        mWorkCondition.notify_all();
+        for (auto& worker : mWorkers) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::ParallelFor(size_t count,
+                                 const std::function<void(size_t, size_t)>& fn,
+                                 size_t grain) {
+        if (count == 0) {
+            return;
+        }
+        grain = std::max<size_t>(grain, 1);
+        if (mWorkers.empty() || count <= grain || tCurrentPool == this) {
+            fn(0, count);
+            return;
+        }
+        std::unique_lock<std::mutex> dispatchLock(mDispatchMutex, std::try_to_lock);
+        if (!dispatchLock.owns_lock()) {
+            fn(0, count);
+            return;
+        }
+
+        // Over-decompose a little so that uneven chunks still balance across the threads.
+        size_t chunkCount = std::min((count + grain - 1) / grain, size_t(mThreadCount) * 4);
+        size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFunction = &fn;
+            mCount = count;
+            mChunkSize = chunkSize;
+            mChunkCount = (count + chunkSize - 1) / chunkSize;
+            mNextChunk.store(0);
+            mPendingWorkers = mWorkers.size();
+            ++mGeneration;
+        }
+        mWorkCondition.notify_all();
+
+        const ThreadPool* outerPool = tCurrentPool;
+        tCurrentPool = this;
+        RunChunks();
+        tCurrentPool = outerPool;
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDoneCondition.wait(lock, [this] { return mPendingWorkers == 0; });
+        mFunction = nullptr;
+    }
+
+    void ThreadPool::WorkerLoop() {
+        tCurrentPool = this;
+        uint64_t generation = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mWorkCondition.wait(
+                    lock, [this, generation] { return mExit || mGeneration != generation; });
+                if (mExit) {
+                    return;
+                }
+                generation = mGeneration;
+            }
+            RunChunks();
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (--mPendingWorkers == 0) {
+                    mDoneCondition.notify_one();
+                }
+            }
+        }
+    }
+
+    void ThreadPool::RunChunks() {
+        size_t chunk;
+        while ((chunk = mNextChunk.fetch_add(1)) < mChunkCount) {
+            size_t begin = chunk * mChunkSize;
+            size_t end = std::min(mCount, begin + mChunkSize);
+            (*mFunction)(begin, end);
+        }
+    }
+
+}}  // namespace webnn_native::cpu
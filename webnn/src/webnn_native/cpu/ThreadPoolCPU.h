@@ -0,0 +1,82 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_CPU_THREADPOOL_CPU_H_
+#define WEBNN_NATIVE_CPU_THREADPOOL_CPU_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace webnn_native { namespace cpu {
+
+    // A fixed size pool of worker threads used by the CPU kernels for intra-op parallelism. The
+    // calling thread always takes part in the work, so a pool of N threads runs N - 1 workers.
+    class ThreadPool {
+      public:
+        // A thread count of 0 uses the number of hardware threads. Pinned workers are bound to
+        // one core each from |firstCore| on where the platform supports it, so that the pools of
+        // the inter-op lanes keep to disjoint cores.
+        explicit ThreadPool(uint32_t threadCount = 0,
+                            bool pinThreads = false,
+                            uint32_t firstCore = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        uint32_t GetThreadCount() const {
+            return mThreadCount;
+        }
+
+        // Splits [0, count) into ranges of at least |grain| items and runs |fn(begin, end)| for
+        // each of them, returning when all of them are done. Nested calls into the same pool, or
+        // calls made while another thread owns the pool, run inline on the calling thread.
+        void ParallelFor(size_t count,
+                         const std::function<void(size_t, size_t)>& fn,
+                         size_t grain = 1);
+
+      private:
+        void WorkerLoop();
+        void RunChunks();
+
+        uint32_t mThreadCount;
+        std::vector<std::thread> mWorkers;
+
+        // Serializes ParallelFor callers.
+        std::mutex mDispatchMutex;
+
+        std::mutex mMutex;
+        std::condition_variable mWorkCondition;
+        std::condition_variable mDoneCondition;
+        uint64_t mGeneration = 0;
+        bool mExit = false;
+
+        // The job being dispatched.
+        const std::function<void(size_t, size_t)>* mFunction = nullptr;
+        size_t mCount = 0;
+        size_t mChunkSize = 0;
+        size_t mChunkCount = 0;
+        std::atomic<size_t> mNextChunk;
+        size_t mPendingWorkers = 0;
+    };
+
+}}  // namespace webnn_native::cpu
+
+#endif  // WEBNN_NATIVE_CPU_THREADPOOL_CPU_H_
@@ -14,12 +14,24 @@
 
 #include "webnn_native/onednn/ContextDNNL.h"
 
+#include "common/Log.h"
 #include "common/RefCounted.h"
 #include "webnn_native/onednn/GraphDNNL.h"
 
 namespace webnn_native { namespace onednn {
 
-    Context::Context() : mEngine(nullptr) {
+    Context::Context(ContextOptions const* options) : ContextBase(options), mEngine(nullptr) {
+        // The thread count is applied by the graphs on the OpenMP runtime, the other threading
+        // options are owned by the environment of the runtime, e.g. OMP_PROC_BIND. The precision
+        // hint is applied by the graphs to the convolutions and matmuls. The primitives run one
+        // at a time on a single stream, since the OpenMP teams of primitives executed at once
+        // would oversubscribe the cores.
+        const ContextOptions contextOptions = GetContextOptions();
+        if (contextOptions.streamCount != 0 || contextOptions.interOpThreadCount > 1 ||
+            contextOptions.threadPinning != ml::ThreadPinning::Default) {
+            dawn::WarningLog() << "The oneDNN backend ignores the stream count, the inter-op "
+                                  "thread count and thread pinning.";
+        }
     }
 
     Context::~Context() {
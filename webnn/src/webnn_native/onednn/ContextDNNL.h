@@ -23,7 +23,7 @@ namespace webnn_native { namespace onednn {
 
     class Context : public ContextBase {
       public:
-        Context();
+        explicit Context(ContextOptions const* options = nullptr);
         ~Context() override;
 
         dnnl_status_t CreateEngine(dnnl_engine_kind_t engineKind = dnnl_cpu);
@@ -19,10 +19,18 @@
 #include "common/Assert.h"
 #include "common/Log.h"
 #include "dawn_native/ErrorData.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+#include "webnn_native/FusionOperator.h"
+#include "webnn_native/MemoryPlanner.h"
 #include "webnn_native/NamedInputs.h"
 #include "webnn_native/NamedOutputs.h"
 #include "webnn_native/Operand.h"
 #include "webnn_native/Utils.h"
+#include "webnn_native/ops/LeakyRelu.h"
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+#    include <omp.h>
+#endif
 
 #define FAILED(status) (((dnnl_status_t)(status)) != dnnl_success)
 
@@ -100,6 +108,10 @@ namespace webnn_native { namespace onednn {
                 dnnlDataType = dnnl_f16;
             } else if (operandType == ml::OperandType::Int32) {
                 dnnlDataType = dnnl_s32;
+            } else if (operandType == ml::OperandType::Int8) {
+                dnnlDataType = dnnl_s8;
+            } else if (operandType == ml::OperandType::Uint8) {
+                dnnlDataType = dnnl_u8;
             } else {
                 return dnnl_invalid_arguments;
             }
@@ -190,10 +202,6 @@ namespace webnn_native { namespace onednn {
             return AccessMemory(const_cast<void*>(value), size, mem, WRITE);
         }
 
-        dnnl_status_t ReadFromMemory(void* buffer, size_t size, dnnl_memory_t mem) {
-            return AccessMemory(buffer, size, mem, READ);
-        }
-
         dnnl_status_t CreateDnnlMemory(dnnl_engine_t engine,
                                        const OperandDescriptor* desc,
                                        dnnl_memory_t* memory,
@@ -283,9 +291,228 @@ namespace webnn_native { namespace onednn {
             cDims = cNewDims;
             return dnnl_success;
         }
+
+        // Reads the constant scales and zero points of |quantize|.
+        dnnl_status_t GetQuantizationParams(const op::Quantize* quantize,
+                                            std::vector<float>& scales,
+                                            std::vector<int32_t>& zeroPoints) {
+            auto scaleConstant =
+                dynamic_cast<const op::Constant*>(quantize->Inputs()[1]->Operator());
+            auto zeroPointConstant =
+                dynamic_cast<const op::Constant*>(quantize->Inputs()[2]->Operator());
+            if (scaleConstant == nullptr || zeroPointConstant == nullptr) {
+                dawn::ErrorLog() << "oneDNN only supports constant scales and zero points.";
+                return dnnl_unimplemented;
+            }
+            const size_t count = scaleConstant->GetByteLength() / sizeof(float);
+            if (zeroPointConstant->GetByteLength() < count) {
+                return dnnl_invalid_arguments;
+            }
+            const float* scaleData = static_cast<const float*>(scaleConstant->GetBuffer());
+            scales.assign(scaleData, scaleData + count);
+            zeroPoints.resize(count);
+            const bool isSigned = quantize->Inputs()[2]->Type() == ml::OperandType::Int8;
+            for (size_t i = 0; i < count; ++i) {
+                zeroPoints[i] =
+                    isSigned ? static_cast<const int8_t*>(zeroPointConstant->GetBuffer())[i]
+                             : static_cast<const uint8_t*>(zeroPointConstant->GetBuffer())[i];
+            }
+            return dnnl_success;
+        }
+
+        // The reorders and the convolutions only take a common zero point.
+        dnnl_status_t SetZeroPoint(dnnl_primitive_attr_t attr,
+                                   int arg,
+                                   const std::vector<int32_t>& zeroPoints) {
+            for (auto zeroPoint : zeroPoints) {
+                if (zeroPoint != zeroPoints[0]) {
+                    dawn::ErrorLog() << "oneDNN only supports a common zero point.";
+                    return dnnl_unimplemented;
+                }
+            }
+            if (zeroPoints[0] == 0) {
+                return dnnl_success;
+            }
+            return dnnl_primitive_attr_set_zero_points(attr, arg, 1, 0, zeroPoints.data());
+        }
+
+        // The output scales of an int8 primitive are the input scale times the weight scale of
+        // each output channel, which is the element along |outputAxis| of the weights. The
+        // weights must be quantized around 0.
+        dnnl_status_t GetInt8OutputScales(const op::Quantize* inputDequantization,
+                                          const op::Quantize* weightsDequantization,
+                                          int32_t outputAxis,
+                                          std::vector<float>& outputScales,
+                                          std::vector<int32_t>& inputZeroPoints) {
+            std::vector<float> inputScales, weightsScales;
+            std::vector<int32_t> weightsZeroPoints;
+            DNNL_TRY(GetQuantizationParams(inputDequantization, inputScales, inputZeroPoints));
+            DNNL_TRY(
+                GetQuantizationParams(weightsDequantization, weightsScales, weightsZeroPoints));
+            if (inputDequantization->IsPerChannel() ||
+                (weightsDequantization->IsPerChannel() &&
+                 weightsDequantization->GetOptions()->axis != outputAxis)) {
+                dawn::ErrorLog() << "oneDNN only supports per output channel weight scales.";
+                return dnnl_unimplemented;
+            }
+            for (auto zeroPoint : weightsZeroPoints) {
+                if (zeroPoint != 0) {
+                    dawn::ErrorLog() << "oneDNN only supports symmetric weights.";
+                    return dnnl_unimplemented;
+                }
+            }
+            outputScales.resize(weightsScales.size());
+            for (size_t i = 0; i < weightsScales.size(); ++i) {
+                outputScales[i] = inputScales[0] * weightsScales[i];
+            }
+            return dnnl_success;
+        }
+
+        // Reads the values of the constant |operand| at build time. The user buffers of the
+        // constants aren't necessarily aligned.
+        template <typename T>
+        dnnl_status_t GetConstantValues(const OperandBase* operand, std::vector<T>& values) {
+            auto constant = dynamic_cast<const op::Constant*>(operand->Operator());
+            if (constant == nullptr) {
+                dawn::ErrorLog() << "oneDNN only supports constant weights and parameters.";
+                return dnnl_unimplemented;
+            }
+            values.resize(constant->GetByteLength() / sizeof(T));
+            memcpy(values.data(), constant->GetBuffer(), values.size() * sizeof(T));
+            return dnnl_success;
+        }
+
+        // The primitives take the channels at axis 1, so the nhwc operands are viewed as nchw
+        // over the same memory, whatever its format.
+        dnnl_status_t ViewNhwcAsNchw(const dnnl_memory_desc_t* nhwcDesc,
+                                     dnnl_memory_desc_t* nchwDesc) {
+            const int permute[] = {0, 2, 3, 1};
+            return dnnl_memory_desc_permute_axes(nchwDesc, nhwcDesc, permute);
+        }
+
+        dnnl_status_t ViewNchwAsNhwc(const dnnl_memory_desc_t* nchwDesc,
+                                     dnnl_memory_desc_t* nhwcDesc) {
+            const int permute[] = {0, 3, 1, 2};
+            return dnnl_memory_desc_permute_axes(nhwcDesc, nchwDesc, permute);
+        }
+
+        dnnl_status_t GetPlainMemoryDesc(const std::vector<int32_t>& shape,
+                                         dnnl_data_type_t dataType,
+                                         dnnl_memory_desc_t* desc) {
+            std::vector<dnnl_dim_t> dims;
+            dnnl_format_tag_t tag;
+            DNNL_TRY(GetDnnlDimsAndFormartTag(shape.data(), shape.size(), dims, tag));
+            return dnnl_memory_desc_init_by_tag(desc, dims.size(), dims.data(), dataType, tag);
+        }
+
+        dnnl_status_t GetEltwiseParams(const FusionOperatorBase* activation,
+                                       dnnl_alg_kind_t& algKind,
+                                       float& alpha,
+                                       float& beta) {
+            alpha = 0;
+            beta = 0;
+            switch (activation->GetFusionType()) {
+                case FusionType::Clamp: {
+                    auto clamp = static_cast<const op::FusionClamp*>(activation);
+                    algKind = dnnl_eltwise_clip;
+                    alpha = clamp->GetMinValue();
+                    beta = clamp->GetMaxValue();
+                    break;
+                }
+                case FusionType::Relu:
+                    algKind = dnnl_eltwise_relu;
+                    break;
+                case FusionType::Sigmoid:
+                    algKind = dnnl_eltwise_logistic;
+                    break;
+                case FusionType::LeakyRelu:
+                    algKind = dnnl_eltwise_relu;
+                    alpha = static_cast<const op::FusionLeakyRelu*>(activation)->GetAlpha();
+                    break;
+                case FusionType::HardSwish:
+                    algKind = dnnl_eltwise_hardswish;
+                    break;
+                case FusionType::Tanh:
+                    algKind = dnnl_eltwise_tanh;
+                    break;
+                default:
+                    return dnnl_unimplemented;
+            }
+            return dnnl_success;
+        }
+
+        dnnl_status_t GetUnaryEltwiseParams(const op::Unary* unary,
+                                            dnnl_alg_kind_t& algKind,
+                                            float& alpha,
+                                            float& beta) {
+            alpha = 0;
+            beta = 0;
+            switch (unary->GetType()) {
+                case op::UnaryOpType::kHardSwish:
+                    algKind = dnnl_eltwise_hardswish;
+                    break;
+                case op::UnaryOpType::kLeakyRelu:
+                    algKind = dnnl_eltwise_relu;
+                    alpha = static_cast<const op::LeakyRelu*>(unary)->GetAlpha();
+                    break;
+                case op::UnaryOpType::kRelu:
+                    algKind = dnnl_eltwise_relu;
+                    break;
+                case op::UnaryOpType::kSigmoid:
+                    algKind = dnnl_eltwise_logistic;
+                    break;
+                case op::UnaryOpType::kTanh:
+                    algKind = dnnl_eltwise_tanh;
+                    break;
+                default:
+                    return dnnl_unimplemented;
+            }
+            return dnnl_success;
+        }
+
+        // Whether |add| adds a bias broadcast along the channels to the output of |conv2d|, which
+        // the convolution can take instead.
+        bool IsBiasAdd(const op::Binary* add, const op::Conv2d* conv2d) {
+            if (add->GetType() != op::BinaryOpType::kAdd) {
+                return false;
+            }
+            const OperandBase* output = conv2d->PrimaryOutput();
+            const OperandBase* bias = add->Inputs()[0].Get() == output ? add->Inputs()[1].Get()
+                                                                       : add->Inputs()[0].Get();
+            if (dynamic_cast<const op::Constant*>(bias->Operator()) == nullptr) {
+                return false;
+            }
+            const std::vector<int32_t> outputShape = output->Shape();
+            const size_t channelAxis =
+                conv2d->GetOptions()->inputLayout == ml::InputOperandLayout::Nchw ? 1 : 3;
+            const std::vector<int32_t> biasShape = bias->Shape();
+            if (biasShape.size() > outputShape.size()) {
+                return false;
+            }
+            const size_t leadingDimensions = outputShape.size() - biasShape.size();
+            for (size_t i = 0; i < outputShape.size(); ++i) {
+                const int32_t dimension =
+                    i < leadingDimensions ? 1 : biasShape[i - leadingDimensions];
+                const int32_t expected = i == channelAxis ? outputShape[i] : 1;
+                if (dimension != expected) {
+                    return false;
+                }
+            }
+            return true;
+        }
     }  // anonymous namespace
 
     Graph::Graph(Context* context) : GraphBase(context) {
+        switch (context->GetContextOptions().precisionHint) {
+            case ml::PrecisionHint::Bfloat16:
+                mComputeDataType = dnnl_bf16;
+                break;
+            case ml::PrecisionHint::Float16:
+                mComputeDataType = dnnl_f16;
+                break;
+            default:
+                break;
+        }
     }
 
     Graph::~Graph() {
@@ -299,10 +526,20 @@ namespace webnn_native { namespace onednn {
 
     MaybeError Graph::AddConstant(const op::Constant* constant) {
         const OperandDescriptor* desc = constant->GetOperandDescriptor();
+        std::shared_ptr<const PooledConstant> pooled = ConstantPool::Get()->Acquire(
+            desc->type, constant->PrimaryOutput()->Shape(), constant->GetBuffer(),
+            constant->GetByteLength());
+        // The memory reads the pooled bytes in place, which the primitives never write.
         dnnl_memory_t memory;
-        DAWN_TRY(CreateDnnlMemory(GetEngine(), desc, &memory, constant->GetBuffer(),
-                                  constant->GetByteLength()));
+        DAWN_TRY(CreateDnnlMemory(GetEngine(), desc, &memory));
         mMemories.push_back(memory);
+        const dnnl_memory_desc_t* md;
+        DAWN_TRY(GetMemoryDesc(memory, &md));
+        if (dnnl_memory_desc_get_size(md) > pooled->GetByteLength()) {
+            return DAWN_VALIDATION_ERROR("The constant buffer is too small.");
+        }
+        DAWN_TRY(dnnl_memory_set_data_handle(memory, const_cast<void*>(pooled->GetData())));
+        mPooledConstants.push_back(std::move(pooled));
         mConstantMemories.insert(memory);
         mOperandMemoryMap.insert(std::make_pair(constant->PrimaryOutput(), memory));
         return {};
@@ -318,63 +555,275 @@ namespace webnn_native { namespace onednn {
         return {};
     }
 
+    dnnl_status_t Graph::AppendPostOps(const std::vector<const OperatorInfo*>& postOps,
+                                       const OperandBase* output,
+                                       bool nhwc,
+                                       dnnl_post_ops_t postops,
+                                       std::vector<dnnl_exec_arg_t>& args,
+                                       dnnl_memory_t* sumMemory) {
+        const size_t rank = output->Shape().size();
+        for (auto postOp : postOps) {
+            switch (postOp->opType) {
+                case OperatorType::CLAMP: {
+                    auto clamp = static_cast<const op::Clamp*>(postOp->op);
+                    DNNL_TRY(dnnl_post_ops_append_eltwise(postops, 1.0, dnnl_eltwise_clip,
+                                                          clamp->GetMinValue(),
+                                                          clamp->GetMaxValue()));
+                    break;
+                }
+                case OperatorType::UNARY: {
+                    dnnl_alg_kind_t algKind;
+                    float alpha, beta;
+                    DNNL_TRY(GetUnaryEltwiseParams(static_cast<const op::Unary*>(postOp->op),
+                                                   algKind, alpha, beta));
+                    DNNL_TRY(dnnl_post_ops_append_eltwise(postops, 1.0, algKind, alpha, beta));
+                    break;
+                }
+                case OperatorType::BINARY: {
+                    auto binary = static_cast<const op::Binary*>(postOp->op);
+                    const OperandBase* other = binary->Inputs()[0].Get() == output
+                                                   ? binary->Inputs()[1].Get()
+                                                   : binary->Inputs()[0].Get();
+                    dnnl_memory_t otherMemory;
+                    const dnnl_memory_desc_t* otherMemoryDesc;
+                    DNNL_TRY(GetOperandMemory(other, &otherMemory, &otherMemoryDesc));
+                    // The sum overwrites the other operand, which nothing reads afterwards and
+                    // which isn't a memory of the user.
+                    if (sumMemory != nullptr && postOp == postOps.front() &&
+                        binary->GetType() == op::BinaryOpType::kAdd &&
+                        other->Shape() == output->Shape() && HasSoleUse(other) &&
+                        mIntermediateMemories.find(otherMemory) != mIntermediateMemories.end()) {
+                        DNNL_TRY(dnnl_post_ops_append_sum(postops, 1.0));
+                        *sumMemory = otherMemory;
+                        break;
+                    }
+                    // The other operand is broadcast to the output along its leading dimensions.
+                    const std::vector<dnnl_dim_t> dims = ExpandDimensions(
+                        std::vector<dnnl_dim_t>(otherMemoryDesc->dims,
+                                                otherMemoryDesc->dims + otherMemoryDesc->ndims),
+                        rank);
+                    dnnl_memory_desc_t expandedMemoryDesc;
+                    DNNL_TRY(dnnl_memory_desc_reshape(&expandedMemoryDesc, otherMemoryDesc,
+                                                      dims.size(), dims.data()));
+                    dnnl_memory_desc_t nchwMemoryDesc;
+                    if (nhwc) {
+                        DNNL_TRY(ViewNhwcAsNchw(&expandedMemoryDesc, &nchwMemoryDesc));
+                        expandedMemoryDesc = nchwMemoryDesc;
+                    }
+                    const dnnl_alg_kind_t algKind = binary->GetType() == op::BinaryOpType::kAdd
+                                                        ? dnnl_binary_add
+                                                        : dnnl_binary_mul;
+                    DNNL_TRY(dnnl_post_ops_append_binary(postops, algKind, &expandedMemoryDesc));
+                    args.push_back(
+                        {DNNL_ARG_ATTR_MULTIPLE_POST_OP(dnnl_post_ops_len(postops) - 1) |
+                             DNNL_ARG_SRC_1,
+                         otherMemory});
+                    break;
+                }
+                default:
+                    return dnnl_unimplemented;
+            }
+            output = postOp->op->PrimaryOutput();
+        }
+        return dnnl_success;
+    }
+
     dnnl_status_t Graph::BuildPrimitives() {
         if (mOperandsToBuild.empty()) {
             dawn::ErrorLog() << "No operators to build.";
             return dnnl_invalid_arguments;
         }
-        auto& info = mOperandsToBuild[0];
-        if (mOperandsToBuild.size() == 1) {
-            if (info.opType == OperatorType::UNARY) {
-                DNNL_TRY(AddUnaryImpl(reinterpret_cast<const op::Unary*>(info.op)));
-            } else if (info.opType == OperatorType::CLAMP) {
-                DNNL_TRY(AddClampImpl(reinterpret_cast<const op::Clamp*>(info.op)));
-            } else if (info.opType == OperatorType::BINARY) {
-                DNNL_TRY(AddBinaryImpl(reinterpret_cast<const op::Binary*>(info.op)));
-            } else if (info.opType == OperatorType::CONV2D) {
-                DNNL_TRY(AddConv2dImpl(reinterpret_cast<const op::Conv2d*>(info.op)));
-            } else if (info.opType == OperatorType::POOL2D) {
-                DNNL_TRY(AddPool2dImpl(reinterpret_cast<const op::Pool2d*>(info.op)));
-            } else {
-                return dnnl_unimplemented;
+        // The uses of the operands, the outputs included, and the operators reading them.
+        std::map<const OperandBase*, const OperatorInfo*> consumers;
+        for (auto& info : mOperandsToBuild) {
+            for (auto& input : info.op->Inputs()) {
+                ++mOperandUseCounts[input.Get()];
+                consumers[input.Get()] = &info;
             }
-        } else if (info.opType == OperatorType::CONV2D) {
-            // Try to fuse add and clamp into conv2d
-            const op::Conv2d* conv2d = reinterpret_cast<const op::Conv2d*>(info.op);
-            if (mOperandsToBuild.size() > 3) {
-                dawn::ErrorLog() << "Cannot fuse conv2d subgraph with more than 3 ops.";
-                return dnnl_invalid_arguments;
+        }
+        for (auto& output : mOutputOperands) {
+            ++mOperandUseCounts[output.second];
+        }
+        auto getSoleConsumer = [&](const OperandBase* operand) -> const OperatorInfo* {
+            auto consumer = consumers.find(operand);
+            return HasSoleUse(operand) && consumer != consumers.end() ? consumer->second : nullptr;
+        };
+
+        // The dequantizeLinear ops of both the input and the weights of a conv2d, a gemm or a
+        // matmul are folded into an int8 primitive, the other quantizeLinear and
+        // dequantizeLinear ops are reorders.
+        std::map<const OperandBase*, const op::Quantize*> dequantizations;
+        for (auto& info : mOperandsToBuild) {
+            if (info.opType == OperatorType::QUANTIZE) {
+                auto quantize = static_cast<const op::Quantize*>(info.op);
+                if (quantize->GetType() == op::QuantizeType::kDequantizeLinear) {
+                    dequantizations[quantize->PrimaryOutput()] = quantize;
+                }
+            }
+        }
+        auto getDequantization = [&](const OperandBase* operand) -> const op::Quantize* {
+            auto dequantization = dequantizations.find(operand);
+            if (dequantization == dequantizations.end() || !HasSoleUse(operand)) {
+                return nullptr;
             }
-            const op::Binary* add = nullptr;
-            const op::FusionClamp* clamp = nullptr;
-            for (size_t i = 1; i < mOperandsToBuild.size(); ++i) {
-                auto& postOp = mOperandsToBuild[i];
-                if (postOp.opType == OperatorType::BINARY &&
-                    reinterpret_cast<const op::Binary*>(postOp.op)->GetType() ==
-                        op::BinaryOpType::kAdd) {
-                    add = reinterpret_cast<const op::Binary*>(postOp.op);
-                } else if (postOp.opType == OperatorType::CLAMP) {
-                    clamp = reinterpret_cast<const op::FusionClamp*>(postOp.op);
+            return dequantization->second;
+        };
+        std::set<const OperatorBase*> fusedOps;
+        std::map<const OperatorBase*, std::pair<const op::Quantize*, const op::Quantize*>>
+            int8Operators;
+        for (auto& info : mOperandsToBuild) {
+            const bool matmul =
+                info.opType == OperatorType::BINARY &&
+                static_cast<const op::Binary*>(info.op)->GetType() == op::BinaryOpType::kMatMul;
+            if (info.opType == OperatorType::CONV2D || info.opType == OperatorType::GEMM ||
+                matmul) {
+                auto inputDequantization = getDequantization(info.op->Inputs()[0].Get());
+                auto weightsDequantization = getDequantization(info.op->Inputs()[1].Get());
+                if (inputDequantization != nullptr && weightsDequantization != nullptr) {
+                    fusedOps.insert(inputDequantization);
+                    fusedOps.insert(weightsDequantization);
+                    int8Operators[info.op] =
+                        std::make_pair(inputDequantization, weightsDequantization);
                 }
             }
-            if ((mOperandsToBuild.size() == 2 && !add && !clamp) ||
-                (mOperandsToBuild.size() == 3 && (!add || !clamp))) {
-                dawn::ErrorLog() << "Failed to fuse conv2d subgraph.";
-                return dnnl_invalid_arguments;
+        }
+        auto getInt8Dequantizations = [&](const OperatorBase* op) {
+            auto int8Operator = int8Operators.find(op);
+            return int8Operator != int8Operators.end()
+                       ? int8Operator->second
+                       : std::pair<const op::Quantize*, const op::Quantize*>(nullptr, nullptr);
+        };
+
+        // The eltwise operators following a primitive, and the adds and muls of operands that
+        // are already built, are appended to its post-ops as long as nothing else reads their
+        // inputs, which saves a pass over the memory of each of them.
+        auto isPostOp = [&](const OperatorInfo* info, const OperandBase* input) {
+            switch (info->opType) {
+                case OperatorType::CLAMP:
+                    return true;
+                case OperatorType::UNARY: {
+                    dnnl_alg_kind_t algKind;
+                    float alpha, beta;
+                    return GetUnaryEltwiseParams(static_cast<const op::Unary*>(info->op), algKind,
+                                                 alpha, beta) == dnnl_success;
+                }
+                case OperatorType::BINARY: {
+                    auto binary = static_cast<const op::Binary*>(info->op);
+                    const OperandBase* other = binary->Inputs()[0].Get() == input
+                                                   ? binary->Inputs()[1].Get()
+                                                   : binary->Inputs()[0].Get();
+                    return (binary->GetType() == op::BinaryOpType::kAdd ||
+                            binary->GetType() == op::BinaryOpType::kMul) &&
+                           other != input &&
+                           mOperandMemoryMap.find(other) != mOperandMemoryMap.end() &&
+                           binary->PrimaryOutput()->Shape() == input->Shape();
+                }
+                default:
+                    return false;
+            }
+        };
+        auto getPostOps = [&](const OperatorBase* op) {
+            std::vector<const OperatorInfo*> postOps;
+            const OperandBase* output = op->PrimaryOutput();
+            const OperatorInfo* consumer = getSoleConsumer(output);
+            while (consumer != nullptr && isPostOp(consumer, output)) {
+                fusedOps.insert(consumer->op);
+                postOps.push_back(consumer);
+                output = consumer->op->PrimaryOutput();
+                consumer = getSoleConsumer(output);
+            }
+            return postOps;
+        };
+
+        for (auto& info : mOperandsToBuild) {
+            if (fusedOps.find(info.op) != fusedOps.end()) {
+                continue;
+            }
+            switch (info.opType) {
+                case OperatorType::BATCH_NORM:
+                    DNNL_TRY(AddBatchNormImpl(static_cast<const op::BatchNorm*>(info.op)));
+                    break;
+                case OperatorType::BINARY: {
+                    // The matmuls of vectors reinterpret their output, which the post-ops
+                    // wouldn't broadcast to.
+                    auto binary = static_cast<const op::Binary*>(info.op);
+                    const bool vectors = binary->GetType() == op::BinaryOpType::kMatMul &&
+                                         (binary->Inputs()[0]->Shape().size() == 1 ||
+                                          binary->Inputs()[1]->Shape().size() == 1);
+                    auto dequantizations = getInt8Dequantizations(binary);
+                    DNNL_TRY(AddBinaryImpl(binary,
+                                           vectors ? std::vector<const OperatorInfo*>()
+                                                   : getPostOps(binary),
+                                           dequantizations.first, dequantizations.second));
+                    break;
+                }
+                case OperatorType::CLAMP:
+                    DNNL_TRY(AddClampImpl(static_cast<const op::Clamp*>(info.op)));
+                    break;
+                case OperatorType::CONCAT:
+                    DNNL_TRY(AddConcatImpl(static_cast<const op::Concat*>(info.op)));
+                    break;
+                case OperatorType::CONV2D: {
+                    auto conv2d = static_cast<const op::Conv2d*>(info.op);
+                    auto dequantizations = getInt8Dequantizations(conv2d);
+                    DNNL_TRY(AddConv2dImpl(conv2d, getPostOps(conv2d), dequantizations.first,
+                                           dequantizations.second));
+                    break;
+                }
+                case OperatorType::GEMM: {
+                    auto gemm = static_cast<const op::Gemm*>(info.op);
+                    auto dequantizations = getInt8Dequantizations(gemm);
+                    DNNL_TRY(AddGemmImpl(gemm, getPostOps(gemm), dequantizations.first,
+                                         dequantizations.second));
+                    break;
+                }
+                case OperatorType::GRU:
+                    DNNL_TRY(AddGruImpl(static_cast<const op::Gru*>(info.op)));
+                    break;
+                case OperatorType::INSTANCE_NORM:
+                    DNNL_TRY(AddInstanceNormImpl(static_cast<const op::InstanceNorm*>(info.op)));
+                    break;
+                case OperatorType::PAD:
+                    DNNL_TRY(AddPadImpl(static_cast<const op::Pad*>(info.op)));
+                    break;
+                case OperatorType::POOL2D: {
+                    auto pool2d = static_cast<const op::Pool2d*>(info.op);
+                    DNNL_TRY(AddPool2dImpl(pool2d, getPostOps(pool2d)));
+                    break;
+                }
+                case OperatorType::QUANTIZE:
+                    DNNL_TRY(AddQuantizeImpl(static_cast<const op::Quantize*>(info.op)));
+                    break;
+                case OperatorType::REDUCE:
+                    DNNL_TRY(AddReduceImpl(static_cast<const op::Reduce*>(info.op)));
+                    break;
+                case OperatorType::RESAMPLE2D:
+                    DNNL_TRY(AddResample2dImpl(static_cast<const op::Resample2d*>(info.op)));
+                    break;
+                case OperatorType::RESHAPE:
+                    DNNL_TRY(AddReshapeImpl(info.op));
+                    break;
+                case OperatorType::SLICE:
+                    DNNL_TRY(AddSliceImpl(static_cast<const op::Slice*>(info.op)));
+                    break;
+                case OperatorType::SPLIT:
+                    DNNL_TRY(AddSplitImpl(static_cast<const op::Split*>(info.op)));
+                    break;
+                case OperatorType::TRANSPOSE:
+                    DNNL_TRY(AddTransposeImpl(static_cast<const op::Transpose*>(info.op)));
+                    break;
+                case OperatorType::UNARY:
+                    DNNL_TRY(AddUnaryImpl(static_cast<const op::Unary*>(info.op)));
+                    break;
+                default:
+                    return dnnl_unimplemented;
             }
-            DNNL_TRY(AddConv2dImpl(conv2d, add, clamp));
-        } else {
-            return dnnl_unimplemented;
         }
         return dnnl_success;
     }
 
     MaybeError Graph::AddOutput(const std::string& name, const OperandBase* output) {
-        DAWN_TRY(BuildPrimitives());
-        DAWN_ASSERT(mOperandMemoryMap.find(output) != mOperandMemoryMap.end());
-        dnnl_memory_t plainOutputMemory;
-        DAWN_TRY(ReorderToPlainFormat(mOperandMemoryMap.at(output), &plainOutputMemory));
-        mOutputMemoryMap.insert(std::make_pair(name, plainOutputMemory));
+        mOutputOperands.push_back(std::make_pair(name, output));
         return {};
     }
 
@@ -383,16 +832,30 @@ namespace webnn_native { namespace onednn {
         return {};
     }
 
-    dnnl_status_t Graph::AddBinaryImpl(const op::Binary* binary) {
+    dnnl_status_t Graph::AddBinaryImpl(const op::Binary* binary,
+                                       const std::vector<const OperatorInfo*>& postOps,
+                                       const op::Quantize* aDequantization,
+                                       const op::Quantize* bDequantization) {
         DAWN_ASSERT(binary->Inputs().size() == 2);
-        DAWN_ASSERT(mOperandMemoryMap.find(binary->Inputs()[0].Get()) != mOperandMemoryMap.end());
-        dnnl_memory_t aMemory = mOperandMemoryMap.at(binary->Inputs()[0].Get());
+        const bool quantized = aDequantization != nullptr;
+        DAWN_ASSERT(quantized == (bDequantization != nullptr));
+        DAWN_ASSERT(!quantized || binary->GetType() == op::BinaryOpType::kMatMul);
+        const OperandBase* aOperand =
+            quantized ? aDequantization->Inputs()[0].Get() : binary->Inputs()[0].Get();
+        DAWN_ASSERT(mOperandMemoryMap.find(aOperand) != mOperandMemoryMap.end());
+        dnnl_memory_t aMemory = mOperandMemoryMap.at(aOperand);
         const dnnl_memory_desc_t* aMemoryDesc;
         DNNL_TRY(GetMemoryDesc(aMemory, &aMemoryDesc));
-        DAWN_ASSERT(mOperandMemoryMap.find(binary->Inputs()[1].Get()) != mOperandMemoryMap.end());
-        dnnl_memory_t bMemory = mOperandMemoryMap.at(binary->Inputs()[1].Get());
+        const OperandBase* bOperand =
+            quantized ? bDequantization->Inputs()[0].Get() : binary->Inputs()[1].Get();
+        DAWN_ASSERT(mOperandMemoryMap.find(bOperand) != mOperandMemoryMap.end());
+        dnnl_memory_t bMemory = mOperandMemoryMap.at(bOperand);
         const dnnl_memory_desc_t* bMemoryDesc;
         DNNL_TRY(GetMemoryDesc(bMemory, &bMemoryDesc));
+        if (quantized && bMemoryDesc->data_type != dnnl_s8) {
+            dawn::ErrorLog() << "oneDNN only supports int8 weights.";
+            return dnnl_unimplemented;
+        }
         std::vector<dnnl_dim_t> aDims(aMemoryDesc->dims, aMemoryDesc->dims + aMemoryDesc->ndims);
         std::vector<dnnl_dim_t> bDims(bMemoryDesc->dims, bMemoryDesc->dims + bMemoryDesc->ndims);
         std::vector<dnnl_dim_t> cDims;
@@ -467,22 +930,58 @@ namespace webnn_native { namespace onednn {
                                               bDims.data()));
             bMemoryDesc = &bBroadcastedMemoryDesc;
         }
+        // An int8 matmul reads the quantized a and b and writes float32.
         dnnl_memory_desc_t cInitDesc;
         DNNL_TRY(dnnl_memory_desc_init_by_tag(&cInitDesc, cDims.size(), cDims.data(),
-                                              aMemoryDesc->data_type, dnnl_format_tag_any));
+                                              quantized ? dnnl_f32 : aMemoryDesc->data_type,
+                                              dnnl_format_tag_any));
+        dnnl_primitive_attr_t attr = nullptr;
+        if (quantized) {
+            // The output scales follow the columns of b, a 1-D b has a single column.
+            std::vector<float> outputScales;
+            std::vector<int32_t> aZeroPoints;
+            DNNL_TRY(GetInt8OutputScales(aDequantization, bDequantization,
+                                         bRank == 1 ? -1 : bRank - 1, outputScales,
+                                         aZeroPoints));
+            DNNL_TRY(dnnl_primitive_attr_create(&attr));
+            DNNL_TRY(dnnl_primitive_attr_set_output_scales(
+                attr, outputScales.size(), outputScales.size() == 1 ? 0 : 1 << (cDims.size() - 1),
+                outputScales.data()));
+            DNNL_TRY(SetZeroPoint(attr, DNNL_ARG_SRC, aZeroPoints));
+        }
+        std::vector<dnnl_exec_arg_t> postOpArgs;
+        if (!postOps.empty()) {
+            dnnl_post_ops_t postops;
+            DNNL_TRY(dnnl_post_ops_create(&postops));
+            DNNL_TRY(AppendPostOps(postOps, binary->PrimaryOutput(), false, postops, postOpArgs));
+            if (attr == nullptr) {
+                DNNL_TRY(dnnl_primitive_attr_create(&attr));
+            }
+            DNNL_TRY(dnnl_primitive_attr_set_post_ops(attr, postops));
+            DNNL_TRY(dnnl_post_ops_destroy(postops));
+        }
         dnnl_primitive_desc_t primitiveDesc;
         dnnl_data_type_t dataType = aMemoryDesc->data_type;
         if (binary->GetType() == op::BinaryOpType::kMatMul) {
-            dnnl_memory_desc_t aInitDesc;
-            DNNL_TRY(dnnl_memory_desc_init_by_tag(&aInitDesc, aDims.size(), aDims.data(), dataType,
-                                                  dnnl_format_tag_any));
-            dnnl_memory_desc_t bInitDesc;
-            DNNL_TRY(dnnl_memory_desc_init_by_tag(&bInitDesc, bDims.size(), bDims.data(), dataType,
-                                                  dnnl_format_tag_any));
-            dnnl_matmul_desc_t matmulDesc;
-            DNNL_TRY(dnnl_matmul_desc_init(&matmulDesc, &aInitDesc, &bInitDesc, NULL, &cInitDesc));
-            DNNL_TRY(
-                dnnl_primitive_desc_create(&primitiveDesc, &matmulDesc, NULL, GetEngine(), NULL));
+            // Like the convolutions, a and b may be reordered to the reduced precision while c
+            // stays in f32.
+            auto createPrimitiveDesc = [&](dnnl_data_type_t aType, dnnl_data_type_t bType) {
+                dnnl_memory_desc_t aInitDesc;
+                DNNL_TRY(dnnl_memory_desc_init_by_tag(&aInitDesc, aDims.size(), aDims.data(),
+                                                      aType, dnnl_format_tag_any));
+                dnnl_memory_desc_t bInitDesc;
+                DNNL_TRY(dnnl_memory_desc_init_by_tag(&bInitDesc, bDims.size(), bDims.data(),
+                                                      bType, dnnl_format_tag_any));
+                dnnl_matmul_desc_t matmulDesc;
+                DNNL_TRY(
+                    dnnl_matmul_desc_init(&matmulDesc, &aInitDesc, &bInitDesc, NULL, &cInitDesc));
+                return dnnl_primitive_desc_create(&primitiveDesc, &matmulDesc, attr, GetEngine(),
+                                                  NULL);
+            };
+            if (quantized || dataType != dnnl_f32 || mComputeDataType == dnnl_f32 ||
+                createPrimitiveDesc(mComputeDataType, mComputeDataType) != dnnl_success) {
+                DNNL_TRY(createPrimitiveDesc(dataType, bMemoryDesc->data_type));
+            }
             const dnnl_memory_desc_t* input0InternalMemoryDesc =
                 dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_src_md, 0);
             DNNL_TRY(ReorderIfNeeded(aMemoryDesc, aMemory, input0InternalMemoryDesc, &aMemory));
@@ -502,13 +1001,16 @@ namespace webnn_native { namespace onednn {
             DNNL_TRY(
                 dnnl_binary_desc_init(&binaryDesc, algKind, aMemoryDesc, bMemoryDesc, &cInitDesc));
             DNNL_TRY(
-                dnnl_primitive_desc_create(&primitiveDesc, &binaryDesc, NULL, GetEngine(), NULL));
+                dnnl_primitive_desc_create(&primitiveDesc, &binaryDesc, attr, GetEngine(), NULL));
+        }
+        if (attr) {
+            DNNL_TRY(dnnl_primitive_attr_destroy(attr));
         }
         dnnl_memory_t cMemory;
         dnnl_primitive_t primitive;
         const dnnl_memory_desc_t* cMemoryDesc =
             dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_dst_md, 0);
-        DNNL_TRY(dnnl_memory_create(&cMemory, cMemoryDesc, GetEngine(), DNNL_MEMORY_ALLOCATE));
+        DNNL_TRY(CreateIntermediateMemory(cMemoryDesc, &cMemory));
         DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
         DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
         std::vector<dnnl_exec_arg_t> args;
@@ -517,9 +1019,12 @@ namespace webnn_native { namespace onednn {
         } else {
             args = {{DNNL_ARG_SRC_0, aMemory}, {DNNL_ARG_SRC_1, bMemory}, {DNNL_ARG_DST, cMemory}};
         }
+        args.insert(args.end(), postOpArgs.begin(), postOpArgs.end());
         mOperations.push_back({primitive, args});
         mMemories.push_back(cMemory);
-        mOperandMemoryMap.insert(std::make_pair(binary->PrimaryOutput(), cMemory));
+        const OperandBase* output =
+            postOps.empty() ? binary->PrimaryOutput() : postOps.back()->op->PrimaryOutput();
+        mOperandMemoryMap.insert(std::make_pair(output, cMemory));
         if (cRank != 0 && cRank < cMemoryDesc->ndims) {
             std::vector<dnnl_dim_t> cDims(cMemoryDesc->dims,
                                           cMemoryDesc->dims + cMemoryDesc->ndims);
@@ -538,36 +1043,40 @@ namespace webnn_native { namespace onednn {
     }
 
     dnnl_status_t Graph::AddConv2dImpl(const op::Conv2d* conv2d,
-                                       const op::Binary* add,
-                                       const op::FusionClamp* clamp) {
+                                       const std::vector<const OperatorInfo*>& postOps,
+                                       const op::Quantize* inputDequantization,
+                                       const op::Quantize* filterDequantization) {
         DAWN_ASSERT(conv2d->Inputs().size() == 2 || conv2d->Inputs().size() == 3);
-        const OperandBase* inputOperand = conv2d->Inputs()[0].Get();
+        const bool quantized = inputDequantization != nullptr;
+        DAWN_ASSERT(quantized == (filterDequantization != nullptr));
+        const OperandBase* inputOperand = quantized ? inputDequantization->Inputs()[0].Get()
+                                                    : conv2d->Inputs()[0].Get();
         DAWN_ASSERT(mOperandMemoryMap.find(inputOperand) != mOperandMemoryMap.end());
         dnnl_memory_t inputMemory = mOperandMemoryMap.at(inputOperand);
         const dnnl_memory_desc_t* inputMemoryDesc;
         DNNL_TRY(GetMemoryDesc(inputMemory, &inputMemoryDesc));
         std::vector<dnnl_dim_t> inputDims;
         const Conv2dOptions* options = conv2d->GetOptions();
+        if (options->transpose) {
+            dawn::ErrorLog() << "oneDNN doesn't support the transposed conv2d.";
+            return dnnl_unimplemented;
+        }
+        const bool nhwc = options->inputLayout == ml::InputOperandLayout::Nhwc;
         const dnnl_memory_desc_t* actualInputMemoryDesc;
         dnnl_memory_desc_t transposedInputMemoryDesc;
-        if (options->inputLayout == ml::InputOperandLayout::Nhwc) {
-            const int permute[] = {0, 2, 3, 1};
-            DNNL_TRY(dnnl_memory_desc_permute_axes(&transposedInputMemoryDesc, inputMemoryDesc,
-                                                   permute));
+        if (nhwc) {
+            // logical dimension is always in {NCHW}, the physical layout is the one of the input
+            DNNL_TRY(ViewNhwcAsNchw(inputMemoryDesc, &transposedInputMemoryDesc));
             inputDims.assign(transposedInputMemoryDesc.dims,
                              transposedInputMemoryDesc.dims + transposedInputMemoryDesc.ndims);
-            // logical dimension is always in {NCHW}
-            // physical layout is nhwc for input
-            DNNL_TRY(dnnl_memory_desc_init_by_tag(&transposedInputMemoryDesc, inputDims.size(),
-                                                  inputDims.data(), inputMemoryDesc->data_type,
-                                                  dnnl_nhwc));
             actualInputMemoryDesc = &transposedInputMemoryDesc;
         } else {
             inputDims.assign(inputMemoryDesc->dims, inputMemoryDesc->dims + inputMemoryDesc->ndims);
             actualInputMemoryDesc = inputMemoryDesc;
         }
 
-        const OperandBase* filterOperand = conv2d->Inputs()[1].Get();
+        const OperandBase* filterOperand = quantized ? filterDequantization->Inputs()[0].Get()
+                                                     : conv2d->Inputs()[1].Get();
         DAWN_ASSERT(mOperandMemoryMap.find(filterOperand) != mOperandMemoryMap.end());
         dnnl_memory_t filterMemory = mOperandMemoryMap.at(filterOperand);
         const dnnl_memory_desc_t* filterMemoryDesc;
@@ -646,20 +1155,13 @@ namespace webnn_native { namespace onednn {
             actualFilterMemoryDesc = &newFilterMemoryDesc;
         }
 
-        dnnl_data_type_t dataType = actualInputMemoryDesc->data_type;
-        dnnl_memory_desc_t inputInitDesc;
-        DNNL_TRY(dnnl_memory_desc_init_by_tag(&inputInitDesc, inputDims.size(), inputDims.data(),
-                                              dataType, dnnl_format_tag_any));
-
-        dnnl_memory_desc_t filterInitDesc;
-        if (options->groups == 1) {
-            DNNL_TRY(dnnl_memory_desc_init_by_tag(&filterInitDesc, filterDims.size(),
-                                                  filterDims.data(), dataType,
-                                                  dnnl_format_tag_any));
-        } else {
-            DNNL_TRY(dnnl_memory_desc_init_by_tag(&filterInitDesc, groupFilterDims.size(),
-                                                  groupFilterDims.data(), dataType,
-                                                  dnnl_format_tag_any));
+        // An int8 convolution reads the quantized input and filter and writes float32.
+        const dnnl_data_type_t inputDataType = actualInputMemoryDesc->data_type;
+        const dnnl_data_type_t filterDataType = actualFilterMemoryDesc->data_type;
+        const dnnl_data_type_t dataType = quantized ? dnnl_f32 : inputDataType;
+        if (quantized && filterDataType != dnnl_s8) {
+            dawn::ErrorLog() << "oneDNN only supports int8 filters.";
+            return dnnl_unimplemented;
         }
         std::vector<dnnl_dim_t> strides = {options->strides[0], options->strides[1]};
         // Non-dilated convolution is defined by setting the dilation parameters to 0
@@ -695,52 +1197,117 @@ namespace webnn_native { namespace onednn {
             int ker_range = 1 + (ker - 1) * (dil + 1);
             outputDims[i] = (src - ker_range + pad_l + pad_r) / str + 1;
         }
-        dnnl_memory_desc_t outputInitDesc;
-        DNNL_TRY(dnnl_memory_desc_init_by_tag(&outputInitDesc, outputDims.size(), outputDims.data(),
-                                              dataType, dnnl_format_tag_any));
-
-        // dnnl_memory_desc_t biasInitDesc;
+        // The bias is either the one of the options or the one added by the first post-op,
+        // which is broadcast along the channels.
         dnnl_memory_t biasMemory = nullptr;
-        const dnnl_memory_desc_t* biasMemoryDesc;
-        if (add) {
-            DAWN_ASSERT(add->Inputs().size() == 2);
-            OperandBase* biasOperand = nullptr;
-            if (conv2d->PrimaryOutput() == add->Inputs()[0].Get()) {
-                biasOperand = add->Inputs()[1].Get();
-            } else if (conv2d->PrimaryOutput() == add->Inputs()[1].Get()) {
-                biasOperand = add->Inputs()[0].Get();
-            } else {
-                dawn::ErrorLog() << "The add is not fusable.";
-                return dnnl_invalid_arguments;
-            }
-
-            DAWN_ASSERT(mOperandMemoryMap.find(biasOperand) != mOperandMemoryMap.end());
-            biasMemory = mOperandMemoryMap.at(biasOperand);
-            DNNL_TRY(GetMemoryDesc(biasMemory, &biasMemoryDesc));
+        dnnl_memory_desc_t biasMemoryDesc;
+        const OperandBase* biasOperand = nullptr;
+        const OperandBase* output = conv2d->PrimaryOutput();
+        auto postOp = postOps.begin();
+        if (conv2d->Inputs().size() == 3) {
+            biasOperand = conv2d->Inputs()[2].Get();
+        } else if (options->activation == nullptr && postOp != postOps.end() &&
+                   (*postOp)->opType == OperatorType::BINARY &&
+                   IsBiasAdd(static_cast<const op::Binary*>((*postOp)->op), conv2d)) {
+            auto add = (*postOp)->op;
+            biasOperand = add->Inputs()[0].Get() == output ? add->Inputs()[1].Get()
+                                                           : add->Inputs()[0].Get();
+            output = add->PrimaryOutput();
+            ++postOp;
+        }
+        if (biasOperand != nullptr) {
+            const dnnl_memory_desc_t* desc;
+            DNNL_TRY(GetOperandMemory(biasOperand, &biasMemory, &desc));
+            DNNL_TRY(dnnl_memory_desc_reshape(&biasMemoryDesc, desc, 1, &outputDims[1]));
         }
 
         dnnl_primitive_attr_t attr = nullptr;
         dnnl_post_ops_t postops = nullptr;
-        if (clamp) {
-            float outputMin = -std::numeric_limits<float>::infinity();
-            float outputMax = +std::numeric_limits<float>::infinity();
-            outputMin = clamp->GetMinValue();
-            outputMax = clamp->GetMaxValue();
-            DNNL_TRY(dnnl_post_ops_create(&postops));
-            DNNL_TRY(dnnl_post_ops_append_eltwise(postops, 1.0, dnnl_eltwise_clip, outputMin,
-                                                  outputMax));
+        if (quantized) {
+            const ml::FilterOperandLayout layout = options->filterLayout;
+            const int32_t outputAxis = layout == ml::FilterOperandLayout::Hwio ||
+                                               layout == ml::FilterOperandLayout::Ihwo
+                                           ? 3
+                                           : 0;
+            std::vector<float> outputScales;
+            std::vector<int32_t> inputZeroPoints;
+            DNNL_TRY(GetInt8OutputScales(inputDequantization, filterDequantization, outputAxis,
+                                         outputScales, inputZeroPoints));
             DNNL_TRY(dnnl_primitive_attr_create(&attr));
+            DNNL_TRY(dnnl_primitive_attr_set_output_scales(attr, outputScales.size(),
+                                                           outputScales.size() == 1 ? 0 : 1 << 1,
+                                                           outputScales.data()));
+            DNNL_TRY(SetZeroPoint(attr, DNNL_ARG_SRC, inputZeroPoints));
+        }
+        // A residual add may accumulate into the memory of its other operand, which becomes
+        // the destination of the convolution.
+        std::vector<dnnl_exec_arg_t> postOpArgs;
+        dnnl_memory_t sumMemory = nullptr;
+        dnnl_memory_desc_t sumMemoryDesc;
+        if (options->activation != nullptr || postOp != postOps.end()) {
+            DNNL_TRY(dnnl_post_ops_create(&postops));
+            if (options->activation != nullptr) {
+                dnnl_alg_kind_t algKind;
+                float alpha, beta;
+                DNNL_TRY(GetEltwiseParams(options->activation, algKind, alpha, beta));
+                DNNL_TRY(dnnl_post_ops_append_eltwise(postops, 1.0, algKind, alpha, beta));
+            }
+            DNNL_TRY(AppendPostOps(std::vector<const OperatorInfo*>(postOp, postOps.end()), output,
+                                   nhwc, postops, postOpArgs,
+                                   options->activation == nullptr ? &sumMemory : nullptr));
+            if (attr == nullptr) {
+                DNNL_TRY(dnnl_primitive_attr_create(&attr));
+            }
             DNNL_TRY(dnnl_primitive_attr_set_post_ops(attr, postops));
         }
+        if (sumMemory != nullptr) {
+            const dnnl_memory_desc_t* desc;
+            DNNL_TRY(GetMemoryDesc(sumMemory, &desc));
+            if (nhwc) {
+                DNNL_TRY(ViewNhwcAsNchw(desc, &sumMemoryDesc));
+            } else {
+                sumMemoryDesc = *desc;
+            }
+        }
 
-        dnnl_convolution_desc_t convDesc;
-        DNNL_TRY(dnnl_dilated_convolution_forward_desc_init(
-            &convDesc, dnnl_forward, dnnl_convolution_direct, &inputInitDesc, &filterInitDesc,
-            add ? biasMemoryDesc : NULL, &outputInitDesc, strides.data(), dilates.data(),
-            padding_l.data(), padding_r.data()));
+        // The reduced precision reorders the float32 input and filter to bf16 or f16, the
+        // filter once at build time. It falls back to f32 where the primitive isn't available.
+        auto createPrimitiveDesc = [&](dnnl_data_type_t inputType, dnnl_data_type_t filterType,
+                                       dnnl_primitive_desc_t* primitiveDesc) {
+            dnnl_memory_desc_t inputInitDesc;
+            DNNL_TRY(dnnl_memory_desc_init_by_tag(&inputInitDesc, inputDims.size(),
+                                                  inputDims.data(), inputType,
+                                                  dnnl_format_tag_any));
+            dnnl_memory_desc_t filterInitDesc;
+            if (options->groups == 1) {
+                DNNL_TRY(dnnl_memory_desc_init_by_tag(&filterInitDesc, filterDims.size(),
+                                                      filterDims.data(), filterType,
+                                                      dnnl_format_tag_any));
+            } else {
+                DNNL_TRY(dnnl_memory_desc_init_by_tag(&filterInitDesc, groupFilterDims.size(),
+                                                      groupFilterDims.data(), filterType,
+                                                      dnnl_format_tag_any));
+            }
+            dnnl_memory_desc_t outputInitDesc = sumMemoryDesc;
+            if (sumMemory == nullptr) {
+                DNNL_TRY(dnnl_memory_desc_init_by_tag(&outputInitDesc, outputDims.size(),
+                                                      outputDims.data(), dataType,
+                                                      dnnl_format_tag_any));
+            }
+            dnnl_convolution_desc_t convDesc;
+            DNNL_TRY(dnnl_dilated_convolution_forward_desc_init(
+                &convDesc, dnnl_forward, dnnl_convolution_direct, &inputInitDesc,
+                &filterInitDesc, biasMemory ? &biasMemoryDesc : NULL, &outputInitDesc,
+                strides.data(), dilates.data(), padding_l.data(), padding_r.data()));
+            return dnnl_primitive_desc_create(primitiveDesc, &convDesc, attr, GetEngine(), NULL);
+        };
         dnnl_primitive_desc_t primitiveDesc;
-        DNNL_TRY(dnnl_primitive_desc_create(&primitiveDesc, &convDesc, clamp ? attr : NULL,
-                                            GetEngine(), NULL));
+        const bool reduced =
+            !quantized && inputDataType == dnnl_f32 && mComputeDataType != dnnl_f32;
+        if (!reduced || createPrimitiveDesc(mComputeDataType, mComputeDataType, &primitiveDesc) !=
+                            dnnl_success) {
+            DNNL_TRY(createPrimitiveDesc(inputDataType, filterDataType, &primitiveDesc));
+        }
 
         if (attr) {
             DNNL_TRY(dnnl_primitive_attr_destroy(attr));
@@ -762,9 +1329,11 @@ namespace webnn_native { namespace onednn {
                                  &filterInternalMemory));
         const dnnl_memory_desc_t* outputMemoryDesc =
             dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_dst_md, 0);
-        dnnl_memory_t outputMemory;
-        DNNL_TRY(
-            dnnl_memory_create(&outputMemory, outputMemoryDesc, GetEngine(), DNNL_MEMORY_ALLOCATE));
+        dnnl_memory_t outputMemory = sumMemory;
+        if (sumMemory == nullptr) {
+            DNNL_TRY(CreateIntermediateMemory(outputMemoryDesc, &outputMemory));
+            mMemories.push_back(outputMemory);
+        }
 
         dnnl_primitive_t primitive;
         DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
@@ -772,41 +1341,25 @@ namespace webnn_native { namespace onednn {
         std::vector<dnnl_exec_arg_t> args = {{DNNL_ARG_SRC, inputInternalMemory},
                                              {DNNL_ARG_WEIGHTS, filterInternalMemory},
                                              {DNNL_ARG_DST, outputMemory}};
-        if (add) {
+        if (biasMemory) {
             args.push_back({DNNL_ARG_BIAS, biasMemory});
         }
+        args.insert(args.end(), postOpArgs.begin(), postOpArgs.end());
         mOperations.push_back({primitive, args});
-        mMemories.push_back(outputMemory);
 
-        const OperandBase* output =
-            add ? reinterpret_cast<const OperandBase*>(add->PrimaryOutput())
-                : reinterpret_cast<const OperandBase*>(conv2d->PrimaryOutput());
-
-        if (options->inputLayout == ml::InputOperandLayout::Nhwc) {
-            // reorder the output from primitive query layout to nhwc
-            dnnl_memory_desc_t finalOutputMemoryDesc;
-            DNNL_TRY(dnnl_memory_desc_init_by_tag(&finalOutputMemoryDesc, outputDims.size(),
-                                                  outputDims.data(), dataType, dnnl_nhwc));
-            dnnl_memory_t finalOutputMemory;
-            DNNL_TRY(ReorderIfNeeded(outputMemoryDesc, outputMemory, &finalOutputMemoryDesc,
-                                     &finalOutputMemory));
-            mOperandMemoryMap.insert(std::make_pair(output, finalOutputMemory));
-
-            // transpose the output logical dims to nhwc
-            dnnl_memory_desc_t transposeOutputMemoryDesc;
-            std::vector<dnnl_dim_t> finalOutputDims(4);
-            finalOutputDims[0] = outputDims[0];
-            finalOutputDims[1] = outputDims[2];
-            finalOutputDims[2] = outputDims[3];
-            finalOutputDims[3] = outputDims[1];
-            DNNL_TRY(dnnl_memory_desc_init_by_tag(&transposeOutputMemoryDesc,
-                                                  finalOutputDims.size(), finalOutputDims.data(),
-                                                  dataType, dnnl_nchw));
-            mMemoryReinterprets.insert(
-                std::make_pair(finalOutputMemory, transposeOutputMemoryDesc));
-        } else {
-            mOperandMemoryMap.insert(std::make_pair(output, outputMemory));
+        if (nhwc && sumMemory == nullptr) {
+            // The output keeps the layout queried from the primitive, which is viewed as nhwc.
+            // The memory of a sum is already viewed so.
+            const dnnl_memory_desc_t* desc;
+            DNNL_TRY(GetMemoryDesc(outputMemory, &desc));
+            dnnl_memory_desc_t nhwcOutputMemoryDesc;
+            DNNL_TRY(ViewNchwAsNhwc(desc, &nhwcOutputMemoryDesc));
+            mMemoryReinterprets.insert(std::make_pair(outputMemory, nhwcOutputMemoryDesc));
         }
+        if (!postOps.empty()) {
+            output = postOps.back()->op->PrimaryOutput();
+        }
+        mOperandMemoryMap.insert(std::make_pair(output, outputMemory));
 
         return dnnl_success;
     }
@@ -816,21 +1369,23 @@ namespace webnn_native { namespace onednn {
         return {};
     }
 
-    dnnl_status_t Graph::AddPool2dImpl(const op::Pool2d* pool2d) {
+    dnnl_status_t Graph::AddPool2dImpl(const op::Pool2d* pool2d,
+                                       const std::vector<const OperatorInfo*>& postOps) {
         DAWN_ASSERT(pool2d->Inputs().size() == 1);
         const OperandBase* inputOperand = pool2d->Inputs()[0].Get();
         DAWN_ASSERT(mOperandMemoryMap.find(inputOperand) != mOperandMemoryMap.end());
         dnnl_memory_t inputMemory = mOperandMemoryMap.at(inputOperand);
         const dnnl_memory_desc_t* inputMemoryDesc;
         DNNL_TRY(GetMemoryDesc(inputMemory, &inputMemoryDesc));
+        const Pool2dOptions* options = pool2d->GetOptions();
+        dnnl_memory_desc_t nchwInputMemoryDesc;
+        if (options->layout == ml::InputOperandLayout::Nhwc) {
+            DNNL_TRY(ViewNhwcAsNchw(inputMemoryDesc, &nchwInputMemoryDesc));
+            inputMemoryDesc = &nchwInputMemoryDesc;
+        }
         std::vector<dnnl_dim_t> inputDims(inputMemoryDesc->dims,
                                           inputMemoryDesc->dims + inputMemoryDesc->ndims);
         dnnl_data_type_t dataType = inputMemoryDesc->data_type;
-        const Pool2dOptions* options = pool2d->GetOptions();
-        if (options->layout != ml::InputOperandLayout::Nchw) {
-            // FIXME(nhu): implement the nhwc layout.
-            return dnnl_unimplemented;
-        }
         std::vector<dnnl_dim_t> kernel;
         if (options->windowDimensions != nullptr) {
             kernel = {options->windowDimensions[0], options->windowDimensions[1]};
@@ -842,11 +1397,22 @@ namespace webnn_native { namespace onednn {
         std::vector<dnnl_dim_t> dilates = {options->dilations[0] == 1 ? 0 : options->dilations[0],
                                            options->dilations[1] == 1 ? 0 : options->dilations[1]};
 
-        std::vector<dnnl_dim_t> padding_l = {options->padding[0], options->padding[2]};
-        std::vector<dnnl_dim_t> padding_r = {options->padding[1], options->padding[3]};
+        int32_t paddingTop = options->padding[0];
+        int32_t paddingBottom = options->padding[1];
+        int32_t paddingLeft = options->padding[2];
+        int32_t paddingRight = options->padding[3];
+        if (options->autoPad != ml::AutoPad::Explicit) {
+            utils::ComputeImplicitPaddingForAutoPad(options->autoPad, options->dilations[0],
+                                                    inputDims[2], kernel[0], strides[0],
+                                                    paddingTop, paddingBottom);
+            utils::ComputeImplicitPaddingForAutoPad(options->autoPad, options->dilations[1],
+                                                    inputDims[3], kernel[1], strides[1],
+                                                    paddingLeft, paddingRight);
+        }
+        std::vector<dnnl_dim_t> padding_l = {paddingTop, paddingLeft};
+        std::vector<dnnl_dim_t> padding_r = {paddingBottom, paddingRight};
         std::vector<dnnl_dim_t> outputDims(4);
         outputDims[0] = inputDims[0];
-        // Assume input layout is oihw
         outputDims[1] = inputDims[1];
         for (int i = 2; i < 4; ++i) {
             int src = inputDims[i];
@@ -869,34 +1435,49 @@ namespace webnn_native { namespace onednn {
         } else {
             return dnnl_invalid_arguments;
         }
+        const bool nhwc = options->layout == ml::InputOperandLayout::Nhwc;
+        dnnl_primitive_attr_t attr = nullptr;
+        std::vector<dnnl_exec_arg_t> postOpArgs;
+        if (!postOps.empty()) {
+            dnnl_post_ops_t postops;
+            DNNL_TRY(dnnl_post_ops_create(&postops));
+            DNNL_TRY(AppendPostOps(postOps, pool2d->PrimaryOutput(), nhwc, postops, postOpArgs));
+            DNNL_TRY(dnnl_primitive_attr_create(&attr));
+            DNNL_TRY(dnnl_primitive_attr_set_post_ops(attr, postops));
+            DNNL_TRY(dnnl_post_ops_destroy(postops));
+        }
+        // The inference doesn't keep the indices of the maximums in a workspace.
         dnnl_pooling_v2_desc_t poolDesc;
-        DNNL_TRY(dnnl_pooling_v2_forward_desc_init(
-            &poolDesc, dnnl_forward, poolType, inputMemoryDesc, &outputInitDesc, strides.data(),
-            kernel.data(), dilates.data(), padding_l.data(), padding_r.data()));
+        DNNL_TRY(dnnl_pooling_v2_forward_desc_init(&poolDesc, dnnl_forward_inference, poolType,
+                                                   inputMemoryDesc, &outputInitDesc,
+                                                   strides.data(), kernel.data(), dilates.data(),
+                                                   padding_l.data(), padding_r.data()));
         dnnl_primitive_desc_t primitiveDesc;
-        DNNL_TRY(dnnl_primitive_desc_create(&primitiveDesc, &poolDesc, NULL, GetEngine(), NULL));
+        DNNL_TRY(dnnl_primitive_desc_create(&primitiveDesc, &poolDesc, attr, GetEngine(), NULL));
+        if (attr) {
+            DNNL_TRY(dnnl_primitive_attr_destroy(attr));
+        }
         const dnnl_memory_desc_t* outputMemoryDesc =
             dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_dst_md, 0);
         dnnl_memory_t outputMemory;
-        DNNL_TRY(
-            dnnl_memory_create(&outputMemory, outputMemoryDesc, GetEngine(), DNNL_MEMORY_ALLOCATE));
+        DNNL_TRY(CreateIntermediateMemory(outputMemoryDesc, &outputMemory));
         dnnl_primitive_t primitive;
         DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
         std::vector<dnnl_exec_arg_t> args = {{DNNL_ARG_SRC, inputMemory},
                                              {DNNL_ARG_DST, outputMemory}};
-        if (poolType == dnnl_pooling_max) {
-            const dnnl_memory_desc_t* workspaceMemoryDesc =
-                dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_workspace_md, 0);
-            dnnl_memory_t workspaceMemory;
-            DNNL_TRY(dnnl_memory_create(&workspaceMemory, workspaceMemoryDesc, GetEngine(),
-                                        DNNL_MEMORY_ALLOCATE));
-            args.push_back({DNNL_ARG_WORKSPACE, workspaceMemory});
-            mMemories.push_back(workspaceMemory);
-        }
+        args.insert(args.end(), postOpArgs.begin(), postOpArgs.end());
         DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
         mOperations.push_back({primitive, args});
         mMemories.push_back(outputMemory);
-        mOperandMemoryMap.insert(std::make_pair(pool2d->PrimaryOutput(), outputMemory));
+        if (nhwc) {
+            DNNL_TRY(GetMemoryDesc(outputMemory, &outputMemoryDesc));
+            dnnl_memory_desc_t nhwcOutputMemoryDesc;
+            DNNL_TRY(ViewNchwAsNhwc(outputMemoryDesc, &nhwcOutputMemoryDesc));
+            mMemoryReinterprets.insert(std::make_pair(outputMemory, nhwcOutputMemoryDesc));
+        }
+        const OperandBase* output =
+            postOps.empty() ? pool2d->PrimaryOutput() : postOps.back()->op->PrimaryOutput();
+        mOperandMemoryMap.insert(std::make_pair(output, outputMemory));
         return dnnl_success;
     }
 
@@ -915,10 +1496,12 @@ namespace webnn_native { namespace onednn {
         dnnl_primitive_desc_t primitiveDesc;
         dnnl_primitive_t primitive;
         dnnl_memory_t outputMemory;
-        if (unary->GetType() == op::UnaryOpType::kRelu) {
+        dnnl_alg_kind_t algKind;
+        float alpha, beta;
+        if (GetUnaryEltwiseParams(unary, algKind, alpha, beta) == dnnl_success) {
             dnnl_eltwise_desc_t eltWiseDesc;
-            DNNL_TRY(dnnl_eltwise_forward_desc_init(&eltWiseDesc, dnnl_forward, dnnl_eltwise_relu,
-                                                    inputMemoryDesc, 0, 0));
+            DNNL_TRY(dnnl_eltwise_forward_desc_init(&eltWiseDesc, dnnl_forward, algKind,
+                                                    inputMemoryDesc, alpha, beta));
             DNNL_TRY(dnnl_primitive_desc_create(&primitiveDesc, &eltWiseDesc, nullptr, GetEngine(),
                                                 nullptr));
         } else if (unary->GetType() == op::UnaryOpType::kSoftmax) {
@@ -932,8 +1515,7 @@ namespace webnn_native { namespace onednn {
         }
         const dnnl_memory_desc_t* outputMemoryDesc =
             dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_dst_md, 0);
-        DNNL_TRY(
-            dnnl_memory_create(&outputMemory, outputMemoryDesc, GetEngine(), DNNL_MEMORY_ALLOCATE));
+        DNNL_TRY(CreateIntermediateMemory(outputMemoryDesc, &outputMemory));
         DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
         DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
         mOperations.push_back(
@@ -943,6 +1525,60 @@ namespace webnn_native { namespace onednn {
         return dnnl_success;
     }
 
+    MaybeError Graph::AddQuantize(const op::Quantize* quantize) {
+        mOperandsToBuild.push_back({OperatorType::QUANTIZE, quantize});
+        return {};
+    }
+
+    dnnl_status_t Graph::AddQuantizeImpl(const op::Quantize* quantize) {
+        auto inputsOperand = quantize->Inputs();
+        DAWN_ASSERT(inputsOperand.size() == 3);
+        const OperandBase* inputOperand = inputsOperand[0].Get();
+        DAWN_ASSERT(mOperandMemoryMap.find(inputOperand) != mOperandMemoryMap.end());
+        dnnl_memory_t inputMemory = mOperandMemoryMap.at(inputOperand);
+        const dnnl_memory_desc_t* inputMemoryDesc;
+        DNNL_TRY(GetMemoryDesc(inputMemory, &inputMemoryDesc));
+        std::vector<float> scales;
+        std::vector<int32_t> zeroPoints;
+        DNNL_TRY(GetQuantizationParams(quantize, scales, zeroPoints));
+
+        // The reorder computes dst = scale * (src - srcZeroPoint) + dstZeroPoint.
+        const bool isQuantize = quantize->GetType() == op::QuantizeType::kQuantizeLinear;
+        const OperandBase* output = quantize->PrimaryOutput();
+        dnnl_data_type_t outputDataType;
+        DNNL_TRY(GetDnnlDataType(output->Type(), outputDataType));
+        const std::vector<int32_t> outputShape = output->Shape();
+        std::vector<dnnl_dim_t> outputDims;
+        dnnl_format_tag_t tag;
+        DNNL_TRY(GetDnnlDimsAndFormartTag(outputShape.data(), outputShape.size(), outputDims, tag));
+        dnnl_memory_desc_t outputMemoryDesc;
+        DNNL_TRY(dnnl_memory_desc_init_by_tag(&outputMemoryDesc, outputDims.size(),
+                                              outputDims.data(), outputDataType, tag));
+        for (auto& scale : scales) {
+            scale = isQuantize ? 1.0f / scale : scale;
+        }
+        const int mask = quantize->IsPerChannel() ? 1 << quantize->GetOptions()->axis : 0;
+        dnnl_primitive_attr_t attr;
+        DNNL_TRY(dnnl_primitive_attr_create(&attr));
+        DNNL_TRY(dnnl_primitive_attr_set_output_scales(attr, scales.size(), mask, scales.data()));
+        DNNL_TRY(SetZeroPoint(attr, isQuantize ? DNNL_ARG_DST : DNNL_ARG_SRC, zeroPoints));
+        dnnl_primitive_desc_t primitiveDesc;
+        DNNL_TRY(dnnl_reorder_primitive_desc_create(&primitiveDesc, inputMemoryDesc, GetEngine(),
+                                                    &outputMemoryDesc, GetEngine(), attr));
+        DNNL_TRY(dnnl_primitive_attr_destroy(attr));
+
+        dnnl_memory_t outputMemory;
+        DNNL_TRY(CreateIntermediateMemory(&outputMemoryDesc, &outputMemory));
+        dnnl_primitive_t primitive;
+        DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
+        DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
+        mOperations.push_back(
+            {primitive, {{DNNL_ARG_SRC, inputMemory}, {DNNL_ARG_DST, outputMemory}}});
+        mMemories.push_back(outputMemory);
+        mOperandMemoryMap.insert(std::make_pair(output, outputMemory));
+        return dnnl_success;
+    }
+
     MaybeError Graph::AddClamp(const op::Clamp* clamp) {
         mOperandsToBuild.push_back({OperatorType::CLAMP, clamp});
         return {};
@@ -969,8 +1605,7 @@ namespace webnn_native { namespace onednn {
                                             nullptr));
         const dnnl_memory_desc_t* outputMemoryDesc =
             dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_dst_md, 0);
-        DNNL_TRY(
-            dnnl_memory_create(&outputMemory, outputMemoryDesc, GetEngine(), DNNL_MEMORY_ALLOCATE));
+        DNNL_TRY(CreateIntermediateMemory(outputMemoryDesc, &outputMemory));
         DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
         DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
         mOperations.push_back(
@@ -980,51 +1615,1198 @@ namespace webnn_native { namespace onednn {
         return dnnl_success;
     }
 
-    MaybeError Graph::Finish() {
-        return {};
-    }
-
-    MaybeError Graph::CompileImpl() {
-        DAWN_TRY(dnnl_stream_create(&mStream, GetEngine(), dnnl_stream_default_flags));
+    MaybeError Graph::AddBatchNorm(const op::BatchNorm* batchNorm) {
+        mOperandsToBuild.push_back({OperatorType::BATCH_NORM, batchNorm});
         return {};
     }
 
-    MLComputeGraphStatus Graph::ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
-        for (auto& input : inputs->GetRecords()) {
-            dnnl_memory_t inputMemory = mInputMemoryMap.at(input.first);
-            COMPUTE_TRY(
-                dnnl_memory_set_data_handle_v2(inputMemory,
+    dnnl_status_t Graph::AddBatchNormImpl(const op::BatchNorm* batchNorm) {
+        auto inputsOperand = batchNorm->Inputs();
+        DAWN_ASSERT(inputsOperand.size() >= 3 && inputsOperand.size() <= 5);
+        const BatchNormOptions* options = batchNorm->GetOptions();
+        if (options->axis != 1 && options->axis != 3) {
+            dawn::ErrorLog() << "oneDNN only supports the channels at axis 1 or 3.";
+            return dnnl_unimplemented;
+        }
+        const bool nhwc = options->axis == 3;
+        dnnl_memory_t inputMemory;
+        const dnnl_memory_desc_t* inputMemoryDesc;
+        DNNL_TRY(GetOperandMemory(inputsOperand[0].Get(), &inputMemory, &inputMemoryDesc));
+        dnnl_memory_desc_t nchwInputMemoryDesc;
+        if (nhwc) {
+            DNNL_TRY(ViewNhwcAsNchw(inputMemoryDesc, &nchwInputMemoryDesc));
+            inputMemoryDesc = &nchwInputMemoryDesc;
+        }
+        const dnnl_dim_t channels = inputMemoryDesc->dims[1];
+        dnnl_memory_t meanMemory, varianceMemory;
+        const dnnl_memory_desc_t* desc;
+        DNNL_TRY(GetOperandMemory(inputsOperand[1].Get(), &meanMemory, &desc));
+        DNNL_TRY(GetOperandMemory(inputsOperand[2].Get(), &varianceMemory, &desc));
+
+        // The scale and the bias are packed into the weights of the primitive.
+        unsigned flags = dnnl_use_global_stats;
+        dnnl_memory_t scaleShiftMemory = nullptr;
+        if (options->scale != nullptr || options->bias != nullptr) {
+            std::vector<float> scaleShift(2 * channels);
+            std::fill(scaleShift.begin(), scaleShift.begin() + channels, 1.0f);
+            std::fill(scaleShift.begin() + channels, scaleShift.end(), 0.0f);
+            size_t index = 3;
+            std::vector<float> values;
+            if (options->scale != nullptr) {
+                DNNL_TRY(GetConstantValues(inputsOperand[index++].Get(), values));
+                if (values.size() != static_cast<size_t>(channels)) {
+                    return dnnl_invalid_arguments;
+                }
+                std::copy(values.begin(), values.end(), scaleShift.begin());
+            }
+            if (options->bias != nullptr) {
+                DNNL_TRY(GetConstantValues(inputsOperand[index++].Get(), values));
+                if (values.size() != static_cast<size_t>(channels)) {
+                    return dnnl_invalid_arguments;
+                }
+                std::copy(values.begin(), values.end(), scaleShift.begin() + channels);
+            }
+            const dnnl_dim_t dims[] = {2, channels};
+            dnnl_memory_desc_t scaleShiftMemoryDesc;
+            DNNL_TRY(dnnl_memory_desc_init_by_tag(&scaleShiftMemoryDesc, 2, dims, dnnl_f32,
+                                                  dnnl_ab));
+            DNNL_TRY(CreateConstantMemory(&scaleShiftMemoryDesc, scaleShift.data(),
+                                          scaleShift.size() * sizeof(float), &scaleShiftMemory));
+            flags |= dnnl_use_scaleshift;
+        }
+        const FusionOperatorBase* activation = options->activation;
+        if (activation != nullptr && activation->GetFusionType() == FusionType::Relu) {
+            flags |= dnnl_fuse_norm_relu;
+            activation = nullptr;
+        }
+
+        dnnl_batch_normalization_desc_t batchNormDesc;
+        DNNL_TRY(dnnl_batch_normalization_forward_desc_init(
+            &batchNormDesc, dnnl_forward_inference, inputMemoryDesc, options->epsilon, flags));
+        dnnl_primitive_desc_t primitiveDesc;
+        DNNL_TRY(
+            dnnl_primitive_desc_create(&primitiveDesc, &batchNormDesc, NULL, GetEngine(), NULL));
+        const dnnl_memory_desc_t* outputMemoryDesc =
+            dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_dst_md, 0);
+        dnnl_memory_t outputMemory;
+        DNNL_TRY(CreateIntermediateMemory(outputMemoryDesc, &outputMemory));
+        dnnl_primitive_t primitive;
+        DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
+        DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
+        std::vector<dnnl_exec_arg_t> args = {{DNNL_ARG_SRC, inputMemory},
+                                             {DNNL_ARG_MEAN, meanMemory},
+                                             {DNNL_ARG_VARIANCE, varianceMemory},
+                                             {DNNL_ARG_DST, outputMemory}};
+        if (scaleShiftMemory != nullptr) {
+            args.push_back({DNNL_ARG_WEIGHTS, scaleShiftMemory});
+        }
+        mOperations.push_back({primitive, args});
+        mMemories.push_back(outputMemory);
+        if (activation != nullptr) {
+            DNNL_TRY(AddActivationImpl(activation, outputMemory, &outputMemory));
+        }
+        if (nhwc) {
+            dnnl_memory_desc_t nhwcOutputMemoryDesc;
+            DNNL_TRY(GetMemoryDesc(outputMemory, &outputMemoryDesc));
+            DNNL_TRY(ViewNchwAsNhwc(outputMemoryDesc, &nhwcOutputMemoryDesc));
+            mMemoryReinterprets.insert(std::make_pair(outputMemory, nhwcOutputMemoryDesc));
+        }
+        mOperandMemoryMap.insert(std::make_pair(batchNorm->PrimaryOutput(), outputMemory));
+        return dnnl_success;
+    }
+
+    dnnl_status_t Graph::AddActivationImpl(const FusionOperatorBase* activation,
+                                           dnnl_memory_t inputMemory,
+                                           dnnl_memory_t* outputMemory) {
+        const dnnl_memory_desc_t* inputMemoryDesc;
+        DNNL_TRY(GetMemoryDesc(inputMemory, &inputMemoryDesc));
+        dnnl_alg_kind_t algKind;
+        float alpha, beta;
+        DNNL_TRY(GetEltwiseParams(activation, algKind, alpha, beta));
+        dnnl_eltwise_desc_t eltWiseDesc;
+        DNNL_TRY(dnnl_eltwise_forward_desc_init(&eltWiseDesc, dnnl_forward_inference, algKind,
+                                                inputMemoryDesc, alpha, beta));
+        dnnl_primitive_desc_t primitiveDesc;
+        DNNL_TRY(dnnl_primitive_desc_create(&primitiveDesc, &eltWiseDesc, nullptr, GetEngine(),
+                                            nullptr));
+        const dnnl_memory_desc_t* outputMemoryDesc =
+            dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_dst_md, 0);
+        DNNL_TRY(CreateIntermediateMemory(outputMemoryDesc, outputMemory));
+        dnnl_primitive_t primitive;
+        DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
+        DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
+        mOperations.push_back(
+            {primitive, {{DNNL_ARG_SRC, inputMemory}, {DNNL_ARG_DST, *outputMemory}}});
+        mMemories.push_back(*outputMemory);
+        return dnnl_success;
+    }
+
+    MaybeError Graph::AddConcat(const op::Concat* concat) {
+        mOperandsToBuild.push_back({OperatorType::CONCAT, concat});
+        return {};
+    }
+
+    dnnl_status_t Graph::AddConcatImpl(const op::Concat* concat) {
+        // The inputs are concatenated in their own formats, the primitive picks the one of the
+        // output.
+        std::vector<dnnl_memory_desc_t> inputMemoryDescs;
+        std::vector<dnnl_exec_arg_t> args;
+        for (auto& input : concat->Inputs()) {
+            dnnl_memory_t inputMemory;
+            const dnnl_memory_desc_t* inputMemoryDesc;
+            DNNL_TRY(GetOperandMemory(input.Get(), &inputMemory, &inputMemoryDesc));
+            args.push_back({static_cast<int>(DNNL_ARG_MULTIPLE_SRC + inputMemoryDescs.size()),
+                            inputMemory});
+            inputMemoryDescs.push_back(*inputMemoryDesc);
+        }
+        dnnl_primitive_desc_t primitiveDesc;
+        DNNL_TRY(dnnl_concat_primitive_desc_create(&primitiveDesc, NULL, inputMemoryDescs.size(),
+                                                   concat->GetAxis(), inputMemoryDescs.data(),
+                                                   NULL, GetEngine()));
+        const dnnl_memory_desc_t* outputMemoryDesc =
+            dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_dst_md, 0);
+        dnnl_memory_t outputMemory;
+        DNNL_TRY(CreateIntermediateMemory(outputMemoryDesc, &outputMemory));
+        dnnl_primitive_t primitive;
+        DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
+        DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
+        args.push_back({DNNL_ARG_DST, outputMemory});
+        mOperations.push_back({primitive, args});
+        mMemories.push_back(outputMemory);
+        mOperandMemoryMap.insert(std::make_pair(concat->PrimaryOutput(), outputMemory));
+        return dnnl_success;
+    }
+
+    MaybeError Graph::AddGemm(const op::Gemm* gemm) {
+        mOperandsToBuild.push_back({OperatorType::GEMM, gemm});
+        return {};
+    }
+
+    dnnl_status_t Graph::AddGemmImpl(const op::Gemm* gemm,
+                                     const std::vector<const OperatorInfo*>& postOps,
+                                     const op::Quantize* aDequantization,
+                                     const op::Quantize* bDequantization) {
+        auto inputsOperand = gemm->Inputs();
+        DAWN_ASSERT(inputsOperand.size() == 2 || inputsOperand.size() == 3);
+        const bool quantized = aDequantization != nullptr;
+        DAWN_ASSERT(quantized == (bDequantization != nullptr));
+        const GemmOptions* options = gemm->GetOptions();
+        // The transposed a and b are views of their memories, which the reorders to the
+        // formats of the matmul transpose.
+        const int transpose[] = {1, 0};
+        dnnl_memory_t aMemory;
+        const dnnl_memory_desc_t* aMemoryDesc;
+        DNNL_TRY(GetOperandMemory(
+            quantized ? aDequantization->Inputs()[0].Get() : inputsOperand[0].Get(), &aMemory,
+            &aMemoryDesc));
+        dnnl_memory_desc_t aTransposedMemoryDesc;
+        if (options->aTranspose) {
+            DNNL_TRY(dnnl_memory_desc_permute_axes(&aTransposedMemoryDesc, aMemoryDesc, transpose));
+            aMemoryDesc = &aTransposedMemoryDesc;
+        }
+        dnnl_memory_t bMemory;
+        const dnnl_memory_desc_t* bMemoryDesc;
+        DNNL_TRY(GetOperandMemory(
+            quantized ? bDequantization->Inputs()[0].Get() : inputsOperand[1].Get(), &bMemory,
+            &bMemoryDesc));
+        dnnl_memory_desc_t bTransposedMemoryDesc;
+        if (options->bTranspose) {
+            DNNL_TRY(dnnl_memory_desc_permute_axes(&bTransposedMemoryDesc, bMemoryDesc, transpose));
+            bMemoryDesc = &bTransposedMemoryDesc;
+        }
+        // An int8 gemm reads the quantized a and b and writes float32.
+        const dnnl_data_type_t inputDataType = aMemoryDesc->data_type;
+        const dnnl_data_type_t dataType = quantized ? dnnl_f32 : inputDataType;
+        if (quantized && bMemoryDesc->data_type != dnnl_s8) {
+            dawn::ErrorLog() << "oneDNN only supports int8 weights.";
+            return dnnl_unimplemented;
+        }
+        const std::vector<dnnl_dim_t> aDims(aMemoryDesc->dims, aMemoryDesc->dims + 2);
+        const std::vector<dnnl_dim_t> bDims(bMemoryDesc->dims, bMemoryDesc->dims + 2);
+        const std::vector<dnnl_dim_t> outputDims = {aDims[0], bDims[1]};
+
+        // The output is alpha * a * b scaled by the output scales, plus beta * c added by a
+        // binary post-op before the fused ones.
+        dnnl_primitive_attr_t attr;
+        DNNL_TRY(dnnl_primitive_attr_create(&attr));
+        if (quantized) {
+            // The output scales of an int8 gemm follow the columns of the transposed b.
+            std::vector<float> outputScales;
+            std::vector<int32_t> aZeroPoints;
+            DNNL_TRY(GetInt8OutputScales(aDequantization, bDequantization,
+                                         options->bTranspose ? 0 : 1, outputScales, aZeroPoints));
+            for (auto& scale : outputScales) {
+                scale *= options->alpha;
+            }
+            DNNL_TRY(dnnl_primitive_attr_set_output_scales(attr, outputScales.size(),
+                                                           outputScales.size() == 1 ? 0 : 1 << 1,
+                                                           outputScales.data()));
+            DNNL_TRY(SetZeroPoint(attr, DNNL_ARG_SRC, aZeroPoints));
+        } else if (options->alpha != 1.0f) {
+            DNNL_TRY(dnnl_primitive_attr_set_output_scales(attr, 1, 0, &options->alpha));
+        }
+        dnnl_memory_t cMemory = nullptr;
+        dnnl_post_ops_t postops = nullptr;
+        if (inputsOperand.size() == 3 && options->beta != 0.0f) {
+            const dnnl_memory_desc_t* desc;
+            DNNL_TRY(GetOperandMemory(inputsOperand[2].Get(), &cMemory, &desc));
+            DNNL_TRY(ReorderToPlainFormat(cMemory, &cMemory));
+            DNNL_TRY(GetMemoryDesc(cMemory, &desc));
+            std::vector<dnnl_dim_t> cDims =
+                ExpandDimensions(std::vector<dnnl_dim_t>(desc->dims, desc->dims + desc->ndims), 2);
+            dnnl_memory_desc_t cMemoryDesc;
+            DNNL_TRY(dnnl_memory_desc_reshape(&cMemoryDesc, desc, cDims.size(), cDims.data()));
+            if (options->beta != 1.0f) {
+                dnnl_primitive_attr_t scaleAttr;
+                DNNL_TRY(dnnl_primitive_attr_create(&scaleAttr));
+                DNNL_TRY(dnnl_primitive_attr_set_output_scales(scaleAttr, 1, 0, &options->beta));
+                dnnl_primitive_desc_t reorderDesc;
+                DNNL_TRY(dnnl_reorder_primitive_desc_create(
+                    &reorderDesc, &cMemoryDesc, GetEngine(), &cMemoryDesc, GetEngine(), scaleAttr));
+                DNNL_TRY(dnnl_primitive_attr_destroy(scaleAttr));
+                dnnl_memory_t scaledCMemory;
+                DNNL_TRY(CreateIntermediateMemory(&cMemoryDesc, &scaledCMemory));
+                dnnl_primitive_t reorder;
+                DNNL_TRY(dnnl_primitive_create(&reorder, reorderDesc));
+                DNNL_TRY(dnnl_primitive_desc_destroy(reorderDesc));
+                mOperations.push_back(
+                    {reorder, {{DNNL_ARG_SRC, cMemory}, {DNNL_ARG_DST, scaledCMemory}}});
+                mMemories.push_back(scaledCMemory);
+                cMemory = scaledCMemory;
+            }
+            DNNL_TRY(dnnl_post_ops_create(&postops));
+            DNNL_TRY(dnnl_post_ops_append_binary(postops, dnnl_binary_add, &cMemoryDesc));
+        }
+        std::vector<dnnl_exec_arg_t> postOpArgs;
+        if (!postOps.empty()) {
+            if (postops == nullptr) {
+                DNNL_TRY(dnnl_post_ops_create(&postops));
+            }
+            DNNL_TRY(AppendPostOps(postOps, gemm->PrimaryOutput(), false, postops, postOpArgs));
+        }
+        if (postops) {
+            DNNL_TRY(dnnl_primitive_attr_set_post_ops(attr, postops));
+        }
+
+        dnnl_memory_desc_t outputInitDesc;
+        DNNL_TRY(dnnl_memory_desc_init_by_tag(&outputInitDesc, outputDims.size(),
+                                              outputDims.data(), dataType, dnnl_format_tag_any));
+        dnnl_primitive_desc_t primitiveDesc;
+        auto createPrimitiveDesc = [&](dnnl_data_type_t aType, dnnl_data_type_t bType) {
+            dnnl_memory_desc_t aInitDesc;
+            DNNL_TRY(dnnl_memory_desc_init_by_tag(&aInitDesc, aDims.size(), aDims.data(), aType,
+                                                  dnnl_format_tag_any));
+            dnnl_memory_desc_t bInitDesc;
+            DNNL_TRY(dnnl_memory_desc_init_by_tag(&bInitDesc, bDims.size(), bDims.data(), bType,
+                                                  dnnl_format_tag_any));
+            dnnl_matmul_desc_t matmulDesc;
+            DNNL_TRY(
+                dnnl_matmul_desc_init(&matmulDesc, &aInitDesc, &bInitDesc, NULL, &outputInitDesc));
+            return dnnl_primitive_desc_create(&primitiveDesc, &matmulDesc, attr, GetEngine(),
+                                              NULL);
+        };
+        if (quantized || inputDataType != dnnl_f32 || mComputeDataType == dnnl_f32 ||
+            createPrimitiveDesc(mComputeDataType, mComputeDataType) != dnnl_success) {
+            DNNL_TRY(createPrimitiveDesc(inputDataType, bMemoryDesc->data_type));
+        }
+        DNNL_TRY(dnnl_primitive_attr_destroy(attr));
+        if (postops) {
+            DNNL_TRY(dnnl_post_ops_destroy(postops));
+        }
+        DNNL_TRY(ReorderIfNeeded(aMemoryDesc, aMemory,
+                                 dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_src_md, 0),
+                                 &aMemory));
+        DNNL_TRY(ReorderIfNeeded(
+            bMemoryDesc, bMemory,
+            dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_weights_md, 0), &bMemory));
+        const dnnl_memory_desc_t* outputMemoryDesc =
+            dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_dst_md, 0);
+        dnnl_memory_t outputMemory;
+        DNNL_TRY(CreateIntermediateMemory(outputMemoryDesc, &outputMemory));
+        dnnl_primitive_t primitive;
+        DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
+        DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
+        std::vector<dnnl_exec_arg_t> args = {{DNNL_ARG_SRC, aMemory},
+                                             {DNNL_ARG_WEIGHTS, bMemory},
+                                             {DNNL_ARG_DST, outputMemory}};
+        if (cMemory != nullptr) {
+            args.push_back({DNNL_ARG_ATTR_MULTIPLE_POST_OP(0) | DNNL_ARG_SRC_1, cMemory});
+        }
+        args.insert(args.end(), postOpArgs.begin(), postOpArgs.end());
+        mOperations.push_back({primitive, args});
+        mMemories.push_back(outputMemory);
+        const OperandBase* output =
+            postOps.empty() ? gemm->PrimaryOutput() : postOps.back()->op->PrimaryOutput();
+        mOperandMemoryMap.insert(std::make_pair(output, outputMemory));
+        return dnnl_success;
+    }
+
+    MaybeError Graph::AddGru(const op::Gru* gru) {
+        mOperandsToBuild.push_back({OperatorType::GRU, gru});
+        return {};
+    }
+
+    dnnl_status_t Graph::AddGruImpl(const op::Gru* gru) {
+        auto inputsOperand = gru->Inputs();
+        const GruOptions* options = gru->GetOptions();
+        if (options->stateful) {
+            dawn::ErrorLog() << "oneDNN doesn't support the stateful gru.";
+            return dnnl_unimplemented;
+        }
+        Ref<OperatorArrayBase> activations = gru->GetActivations();
+        if (activations->APIGetOperator(0)->GetFusionType() != FusionType::Sigmoid ||
+            activations->APIGetOperator(1)->GetFusionType() != FusionType::Tanh) {
+            dawn::ErrorLog() << "oneDNN only supports the sigmoid and tanh activations of gru.";
+            return dnnl_unimplemented;
+        }
+        dnnl_memory_t inputMemory;
+        const dnnl_memory_desc_t* inputMemoryDesc;
+        DNNL_TRY(GetOperandMemory(inputsOperand[0].Get(), &inputMemory, &inputMemoryDesc));
+        const dnnl_dim_t steps = inputMemoryDesc->dims[0];
+        const dnnl_dim_t batchSize = inputMemoryDesc->dims[1];
+        const dnnl_dim_t inputSize = inputMemoryDesc->dims[2];
+        const dnnl_dim_t hiddenSize = gru->GetHiddenSize();
+        const dnnl_dim_t numDirections = inputsOperand[1]->Shape()[0];
+        dnnl_rnn_direction_t direction;
+        switch (options->direction) {
+            case ml::RecurrentNetworkDirection::Forward:
+                direction = dnnl_unidirectional_left2right;
+                break;
+            case ml::RecurrentNetworkDirection::Backward:
+                direction = dnnl_unidirectional_right2left;
+                break;
+            case ml::RecurrentNetworkDirection::Both:
+                direction = dnnl_bidirectional_concat;
+                break;
+            default:
+                return dnnl_invalid_arguments;
+        }
+
+        // The weights and the biases are rearranged at build time into the ldigo and ldgo
+        // formats of oneDNN, whose gates are in the update, reset, new order.
+        const bool zrn = options->layout == ml::RecurrentNetworkWeightLayout::Zrn;
+        const size_t gates[] = {zrn ? 0u : 1u, zrn ? 1u : 0u, 2u};
+        auto createWeightsMemory = [&](const OperandBase* operand, dnnl_dim_t size,
+                                       dnnl_memory_t* memory) {
+            std::vector<float> values;
+            DNNL_TRY(GetConstantValues(operand, values));
+            if (values.size() != static_cast<size_t>(numDirections * 3 * hiddenSize * size)) {
+                return dnnl_invalid_arguments;
+            }
+            std::vector<float> weights(values.size());
+            for (dnnl_dim_t d = 0; d < numDirections; ++d) {
+                for (dnnl_dim_t i = 0; i < size; ++i) {
+                    for (size_t g = 0; g < 3; ++g) {
+                        for (dnnl_dim_t h = 0; h < hiddenSize; ++h) {
+                            weights[((d * size + i) * 3 + g) * hiddenSize + h] =
+                                values[((d * 3 + gates[g]) * hiddenSize + h) * size + i];
+                        }
+                    }
+                }
+            }
+            const dnnl_dim_t dims[] = {1, numDirections, size, 3, hiddenSize};
+            dnnl_memory_desc_t desc;
+            DNNL_TRY(dnnl_memory_desc_init_by_tag(&desc, 5, dims, dnnl_f32, dnnl_abcde));
+            return CreateConstantMemory(&desc, weights.data(), weights.size() * sizeof(float),
+                                        memory);
+        };
+        dnnl_memory_t weightsLayerMemory, weightsIterMemory;
+        DNNL_TRY(createWeightsMemory(inputsOperand[1].Get(), inputSize, &weightsLayerMemory));
+        DNNL_TRY(createWeightsMemory(inputsOperand[2].Get(), hiddenSize, &weightsIterMemory));
+
+        // The linear before reset gru takes the recurrent bias of the new gate separately.
+        size_t index = 3;
+        const size_t biasSize = numDirections * 3 * hiddenSize;
+        std::vector<float> bias(biasSize, 0), recurrentBias(biasSize, 0);
+        if (options->bias != nullptr) {
+            DNNL_TRY(GetConstantValues(inputsOperand[index++].Get(), bias));
+        }
+        if (options->recurrentBias != nullptr) {
+            DNNL_TRY(GetConstantValues(inputsOperand[index++].Get(), recurrentBias));
+        }
+        if (bias.size() != biasSize || recurrentBias.size() != biasSize) {
+            return dnnl_invalid_arguments;
+        }
+        const dnnl_dim_t biasGates = options->resetAfter ? 4 : 3;
+        std::vector<float> biasValues(numDirections * biasGates * hiddenSize);
+        for (dnnl_dim_t d = 0; d < numDirections; ++d) {
+            for (dnnl_dim_t h = 0; h < hiddenSize; ++h) {
+                for (size_t g = 0; g < 3; ++g) {
+                    const size_t source = (d * 3 + gates[g]) * hiddenSize + h;
+                    const bool separate = options->resetAfter && g == 2;
+                    biasValues[(d * biasGates + g) * hiddenSize + h] =
+                        bias[source] + (separate ? 0 : recurrentBias[source]);
+                    if (separate) {
+                        biasValues[(d * biasGates + 3) * hiddenSize + h] = recurrentBias[source];
+                    }
+                }
+            }
+        }
+        const dnnl_dim_t biasDims[] = {1, numDirections, biasGates, hiddenSize};
+        dnnl_memory_desc_t biasMemoryDesc;
+        DNNL_TRY(dnnl_memory_desc_init_by_tag(&biasMemoryDesc, 4, biasDims, dnnl_f32, dnnl_abcd));
+        dnnl_memory_t biasMemory;
+        DNNL_TRY(CreateConstantMemory(&biasMemoryDesc, biasValues.data(),
+                                      biasValues.size() * sizeof(float), &biasMemory));
+
+        // The initial hidden state of [numDirections, batchSize, hiddenSize] is viewed with a
+        // single layer.
+        dnnl_memory_t initialHiddenStateMemory = nullptr;
+        dnnl_memory_desc_t initialHiddenStateMemoryDesc;
+        if (options->initialHiddenState != nullptr) {
+            const dnnl_memory_desc_t* desc;
+            DNNL_TRY(GetOperandMemory(inputsOperand[index++].Get(), &initialHiddenStateMemory,
+                                      &desc));
+            DNNL_TRY(ReorderToPlainFormat(initialHiddenStateMemory, &initialHiddenStateMemory));
+            DNNL_TRY(GetMemoryDesc(initialHiddenStateMemory, &desc));
+            const dnnl_dim_t dims[] = {1, numDirections, batchSize, hiddenSize};
+            DNNL_TRY(dnnl_memory_desc_reshape(&initialHiddenStateMemoryDesc, desc, 4, dims));
+        }
+
+        const dnnl_dim_t outputDims[] = {steps, batchSize, numDirections * hiddenSize};
+        dnnl_memory_desc_t outputMemoryDesc;
+        DNNL_TRY(dnnl_memory_desc_init_by_tag(&outputMemoryDesc, 3, outputDims,
+                                              inputMemoryDesc->data_type, dnnl_abc));
+        const dnnl_dim_t hiddenStateDims[] = {1, numDirections, batchSize, hiddenSize};
+        dnnl_memory_desc_t hiddenStateMemoryDesc;
+        DNNL_TRY(dnnl_memory_desc_init_by_tag(&hiddenStateMemoryDesc, 4, hiddenStateDims,
+                                              inputMemoryDesc->data_type, dnnl_abcd));
+        dnnl_memory_desc_t weightsLayerInitDesc, weightsIterInitDesc;
+        const dnnl_dim_t weightsLayerDims[] = {1, numDirections, inputSize, 3, hiddenSize};
+        DNNL_TRY(dnnl_memory_desc_init_by_tag(&weightsLayerInitDesc, 5, weightsLayerDims, dnnl_f32,
+                                              dnnl_format_tag_any));
+        const dnnl_dim_t weightsIterDims[] = {1, numDirections, hiddenSize, 3, hiddenSize};
+        DNNL_TRY(dnnl_memory_desc_init_by_tag(&weightsIterInitDesc, 5, weightsIterDims, dnnl_f32,
+                                              dnnl_format_tag_any));
+        dnnl_rnn_desc_t rnnDesc;
+        const dnnl_memory_desc_t* srcIterDesc =
+            initialHiddenStateMemory != nullptr ? &initialHiddenStateMemoryDesc : NULL;
+        if (options->resetAfter) {
+            DNNL_TRY(dnnl_lbr_gru_forward_desc_init(
+                &rnnDesc, dnnl_forward_inference, direction, inputMemoryDesc, srcIterDesc,
+                &weightsLayerInitDesc, &weightsIterInitDesc, &biasMemoryDesc, &outputMemoryDesc,
+                &hiddenStateMemoryDesc, dnnl_rnn_flags_undef));
+        } else {
+            DNNL_TRY(dnnl_gru_forward_desc_init(
+                &rnnDesc, dnnl_forward_inference, direction, inputMemoryDesc, srcIterDesc,
+                &weightsLayerInitDesc, &weightsIterInitDesc, &biasMemoryDesc, &outputMemoryDesc,
+                &hiddenStateMemoryDesc, dnnl_rnn_flags_undef));
+        }
+        dnnl_primitive_desc_t primitiveDesc;
+        DNNL_TRY(dnnl_primitive_desc_create(&primitiveDesc, &rnnDesc, NULL, GetEngine(), NULL));
+        const dnnl_memory_desc_t* weightsLayerMemoryDesc;
+        DNNL_TRY(GetMemoryDesc(weightsLayerMemory, &weightsLayerMemoryDesc));
+        DNNL_TRY(ReorderIfNeeded(
+            weightsLayerMemoryDesc, weightsLayerMemory,
+            dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_weights_md, 0),
+            &weightsLayerMemory));
+        const dnnl_memory_desc_t* weightsIterMemoryDesc;
+        DNNL_TRY(GetMemoryDesc(weightsIterMemory, &weightsIterMemoryDesc));
+        DNNL_TRY(ReorderIfNeeded(
+            weightsIterMemoryDesc, weightsIterMemory,
+            dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_weights_md, 1),
+            &weightsIterMemory));
+        dnnl_memory_t outputMemory, hiddenStateMemory;
+        DNNL_TRY(CreateIntermediateMemory(&outputMemoryDesc, &outputMemory));
+        DNNL_TRY(CreateIntermediateMemory(&hiddenStateMemoryDesc, &hiddenStateMemory));
+        dnnl_primitive_t primitive;
+        DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
+        DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
+        std::vector<dnnl_exec_arg_t> args = {{DNNL_ARG_SRC_LAYER, inputMemory},
+                                             {DNNL_ARG_WEIGHTS_LAYER, weightsLayerMemory},
+                                             {DNNL_ARG_WEIGHTS_ITER, weightsIterMemory},
+                                             {DNNL_ARG_BIAS, biasMemory},
+                                             {DNNL_ARG_DST_LAYER, outputMemory},
+                                             {DNNL_ARG_DST_ITER, hiddenStateMemory}};
+        if (initialHiddenStateMemory != nullptr) {
+            args.push_back({DNNL_ARG_SRC_ITER, initialHiddenStateMemory});
+        }
+        mOperations.push_back({primitive, args});
+        mMemories.push_back(outputMemory);
+        mMemories.push_back(hiddenStateMemory);
+
+        // The hidden state drops the layer, the sequence of [steps, batchSize, numDirections *
+        // hiddenSize] is transposed to [steps, numDirections, batchSize, hiddenSize].
+        const dnnl_dim_t finalHiddenStateDims[] = {numDirections, batchSize, hiddenSize};
+        dnnl_memory_desc_t finalHiddenStateMemoryDesc;
+        DNNL_TRY(dnnl_memory_desc_reshape(&finalHiddenStateMemoryDesc, &hiddenStateMemoryDesc, 3,
+                                          finalHiddenStateDims));
+        mMemoryReinterprets.insert(std::make_pair(hiddenStateMemory, finalHiddenStateMemoryDesc));
+        mOperandMemoryMap.insert(std::make_pair(gru->PrimaryOutput(), hiddenStateMemory));
+        if (options->returnSequence) {
+            const dnnl_dim_t sequenceDims[] = {steps, batchSize, numDirections, hiddenSize};
+            dnnl_memory_desc_t sequenceMemoryDesc;
+            DNNL_TRY(dnnl_memory_desc_reshape(&sequenceMemoryDesc, &outputMemoryDesc, 4,
+                                              sequenceDims));
+            const int permute[] = {0, 2, 1, 3};
+            dnnl_memory_desc_t transposedSequenceMemoryDesc;
+            DNNL_TRY(dnnl_memory_desc_permute_axes(&transposedSequenceMemoryDesc,
+                                                   &sequenceMemoryDesc, permute));
+            const std::vector<int32_t> sequenceShape = gru->Outputs()[1]->Shape();
+            dnnl_memory_desc_t plainSequenceMemoryDesc;
+            DNNL_TRY(GetPlainMemoryDesc(sequenceShape, inputMemoryDesc->data_type,
+                                        &plainSequenceMemoryDesc));
+            dnnl_memory_t sequenceMemory;
+            DNNL_TRY(ReorderIfNeeded(&transposedSequenceMemoryDesc, outputMemory,
+                                     &plainSequenceMemoryDesc, &sequenceMemory));
+            if (sequenceMemory == outputMemory) {
+                mMemoryReinterprets.insert(std::make_pair(outputMemory, plainSequenceMemoryDesc));
+            }
+            mOperandMemoryMap.insert(std::make_pair(gru->Outputs()[1], sequenceMemory));
+        }
+        return dnnl_success;
+    }
+
+    MaybeError Graph::AddInstanceNorm(const op::InstanceNorm* instanceNorm) {
+        mOperandsToBuild.push_back({OperatorType::INSTANCE_NORM, instanceNorm});
+        return {};
+    }
+
+    dnnl_status_t Graph::AddInstanceNormImpl(const op::InstanceNorm* instanceNorm) {
+        auto inputsOperand = instanceNorm->Inputs();
+        const InstanceNormOptions* options = instanceNorm->GetOptions();
+        const bool nhwc = options->layout == ml::InputOperandLayout::Nhwc;
+        dnnl_memory_t inputMemory;
+        const dnnl_memory_desc_t* inputMemoryDesc;
+        DNNL_TRY(GetOperandMemory(inputsOperand[0].Get(), &inputMemory, &inputMemoryDesc));
+        dnnl_memory_desc_t nchwInputMemoryDesc;
+        if (nhwc) {
+            DNNL_TRY(ViewNhwcAsNchw(inputMemoryDesc, &nchwInputMemoryDesc));
+            inputMemoryDesc = &nchwInputMemoryDesc;
+        }
+        const std::vector<dnnl_dim_t> inputDims(inputMemoryDesc->dims,
+                                                inputMemoryDesc->dims + inputMemoryDesc->ndims);
+        const dnnl_dim_t instances = inputDims[0] * inputDims[1];
+
+        // The instances are the channels of a batch normalization of a single batch, which
+        // computes their statistics. The batches are merged into the channels of the plain
+        // input.
+        dnnl_memory_desc_t batchMemoryDesc = *inputMemoryDesc;
+        if (inputDims[0] != 1) {
+            dnnl_memory_desc_t plainMemoryDesc;
+            DNNL_TRY(dnnl_memory_desc_init_by_tag(&plainMemoryDesc, inputDims.size(),
+                                                  inputDims.data(), inputMemoryDesc->data_type,
+                                                  dnnl_nchw));
+            DNNL_TRY(
+                ReorderIfNeeded(inputMemoryDesc, inputMemory, &plainMemoryDesc, &inputMemory));
+            const dnnl_dim_t dims[] = {1, instances, inputDims[2], inputDims[3]};
+            DNNL_TRY(dnnl_memory_desc_reshape(&batchMemoryDesc, &plainMemoryDesc, 4, dims));
+        }
+
+        unsigned flags = dnnl_normalization_flags_none;
+        dnnl_memory_t scaleShiftMemory = nullptr;
+        if (options->scale != nullptr || options->bias != nullptr) {
+            const dnnl_dim_t channels = inputDims[1];
+            std::vector<float> scale(channels, 1.0f), shift(channels, 0.0f);
+            size_t index = 1;
+            if (options->scale != nullptr) {
+                DNNL_TRY(GetConstantValues(inputsOperand[index++].Get(), scale));
+            }
+            if (options->bias != nullptr) {
+                DNNL_TRY(GetConstantValues(inputsOperand[index++].Get(), shift));
+            }
+            if (scale.size() != static_cast<size_t>(channels) ||
+                shift.size() != static_cast<size_t>(channels)) {
+                return dnnl_invalid_arguments;
+            }
+            std::vector<float> scaleShift(2 * instances);
+            for (dnnl_dim_t i = 0; i < instances; ++i) {
+                scaleShift[i] = scale[i % channels];
+                scaleShift[instances + i] = shift[i % channels];
+            }
+            const dnnl_dim_t dims[] = {2, instances};
+            dnnl_memory_desc_t scaleShiftMemoryDesc;
+            DNNL_TRY(dnnl_memory_desc_init_by_tag(&scaleShiftMemoryDesc, 2, dims, dnnl_f32,
+                                                  dnnl_ab));
+            DNNL_TRY(CreateConstantMemory(&scaleShiftMemoryDesc, scaleShift.data(),
+                                          scaleShift.size() * sizeof(float), &scaleShiftMemory));
+            flags |= dnnl_use_scaleshift;
+        }
+        dnnl_batch_normalization_desc_t batchNormDesc;
+        DNNL_TRY(dnnl_batch_normalization_forward_desc_init(
+            &batchNormDesc, dnnl_forward_inference, &batchMemoryDesc, options->epsilon, flags));
+        dnnl_primitive_desc_t primitiveDesc;
+        DNNL_TRY(
+            dnnl_primitive_desc_create(&primitiveDesc, &batchNormDesc, NULL, GetEngine(), NULL));
+        const dnnl_memory_desc_t* outputMemoryDesc =
+            dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_dst_md, 0);
+        dnnl_memory_t outputMemory;
+        DNNL_TRY(CreateIntermediateMemory(outputMemoryDesc, &outputMemory));
+        dnnl_memory_desc_t statisticsMemoryDesc;
+        DNNL_TRY(dnnl_memory_desc_init_by_tag(&statisticsMemoryDesc, 1, &instances, dnnl_f32,
+                                              dnnl_a));
+        dnnl_memory_t meanMemory, varianceMemory;
+        DNNL_TRY(CreateIntermediateMemory(&statisticsMemoryDesc, &meanMemory));
+        DNNL_TRY(CreateIntermediateMemory(&statisticsMemoryDesc, &varianceMemory));
+        dnnl_primitive_t primitive;
+        DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
+        DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
+        std::vector<dnnl_exec_arg_t> args = {{DNNL_ARG_SRC, inputMemory},
+                                             {DNNL_ARG_MEAN, meanMemory},
+                                             {DNNL_ARG_VARIANCE, varianceMemory},
+                                             {DNNL_ARG_DST, outputMemory}};
+        if (scaleShiftMemory != nullptr) {
+            args.push_back({DNNL_ARG_WEIGHTS, scaleShiftMemory});
+        }
+        mOperations.push_back({primitive, args});
+        mMemories.push_back(outputMemory);
+        mMemories.push_back(meanMemory);
+        mMemories.push_back(varianceMemory);
+
+        DNNL_TRY(GetMemoryDesc(outputMemory, &outputMemoryDesc));
+        dnnl_memory_desc_t finalOutputMemoryDesc = *outputMemoryDesc;
+        if (inputDims[0] != 1) {
+            DNNL_TRY(dnnl_memory_desc_reshape(&finalOutputMemoryDesc, outputMemoryDesc,
+                                              inputDims.size(), inputDims.data()));
+        }
+        if (nhwc) {
+            dnnl_memory_desc_t nchwOutputMemoryDesc = finalOutputMemoryDesc;
+            DNNL_TRY(ViewNchwAsNhwc(&nchwOutputMemoryDesc, &finalOutputMemoryDesc));
+        }
+        if (!dnnl_memory_desc_equal(&finalOutputMemoryDesc, outputMemoryDesc)) {
+            mMemoryReinterprets.insert(std::make_pair(outputMemory, finalOutputMemoryDesc));
+        }
+        mOperandMemoryMap.insert(std::make_pair(instanceNorm->PrimaryOutput(), outputMemory));
+        return dnnl_success;
+    }
+
+    MaybeError Graph::AddPad(const op::Pad* pad) {
+        mOperandsToBuild.push_back({OperatorType::PAD, pad});
+        return {};
+    }
+
+    dnnl_status_t Graph::AddPadImpl(const op::Pad* pad) {
+        auto inputsOperand = pad->Inputs();
+        DAWN_ASSERT(inputsOperand.size() == 2);
+        const PadOptions* options = pad->GetOptions();
+        if (options->mode != ml::PaddingMode::Constant) {
+            dawn::ErrorLog() << "oneDNN only supports the constant padding mode.";
+            return dnnl_unimplemented;
+        }
+        dnnl_memory_t inputMemory;
+        const dnnl_memory_desc_t* inputMemoryDesc;
+        DNNL_TRY(GetOperandMemory(inputsOperand[0].Get(), &inputMemory, &inputMemoryDesc));
+        if (inputMemoryDesc->data_type != dnnl_f32) {
+            return dnnl_unimplemented;
+        }
+        std::vector<int32_t> padding;
+        DNNL_TRY(GetConstantValues(inputsOperand[1].Get(), padding));
+        const int rank = inputMemoryDesc->ndims;
+        if (padding.size() != static_cast<size_t>(2 * rank)) {
+            return dnnl_invalid_arguments;
+        }
+        std::vector<dnnl_dim_t> offsets(rank);
+        for (int i = 0; i < rank; ++i) {
+            offsets[i] = padding[2 * i];
+        }
+
+        // The output has a memory of its own, whose padding is filled once at build time, and
+        // the input is reordered into its middle.
+        dnnl_memory_desc_t outputMemoryDesc;
+        DNNL_TRY(
+            GetPlainMemoryDesc(pad->PrimaryOutput()->Shape(), dnnl_f32, &outputMemoryDesc));
+        std::vector<float> values(dnnl_memory_desc_get_size(&outputMemoryDesc) / sizeof(float),
+                                  options->value);
+        dnnl_memory_t outputMemory;
+        DNNL_TRY(dnnl_memory_create(&outputMemory, &outputMemoryDesc, GetEngine(),
+                                    DNNL_MEMORY_ALLOCATE));
+        mMemories.push_back(outputMemory);
+        DNNL_TRY(WriteToMemory(values.data(), values.size() * sizeof(float), outputMemory));
+        dnnl_memory_desc_t subMemoryDesc;
+        DNNL_TRY(dnnl_memory_desc_init_submemory(&subMemoryDesc, &outputMemoryDesc,
+                                                 inputMemoryDesc->dims, offsets.data()));
+        DNNL_TRY(AddReorder(inputMemoryDesc, inputMemory, &subMemoryDesc, outputMemory));
+        mOperandMemoryMap.insert(std::make_pair(pad->PrimaryOutput(), outputMemory));
+        return dnnl_success;
+    }
+
+    MaybeError Graph::AddReduce(const op::Reduce* reduce) {
+        mOperandsToBuild.push_back({OperatorType::REDUCE, reduce});
+        return {};
+    }
+
+    dnnl_status_t Graph::AddReduceImpl(const op::Reduce* reduce) {
+        dnnl_memory_t inputMemory;
+        const dnnl_memory_desc_t* inputMemoryDesc;
+        DNNL_TRY(GetOperandMemory(reduce->Inputs()[0].Get(), &inputMemory, &inputMemoryDesc));
+        dnnl_alg_kind_t algKind;
+        float p = 0;
+        switch (reduce->GetType()) {
+            case op::ReduceType::kReduceL1:
+                algKind = dnnl_reduction_norm_lp_sum;
+                p = 1;
+                break;
+            case op::ReduceType::kReduceL2:
+                algKind = dnnl_reduction_norm_lp_sum;
+                p = 2;
+                break;
+            case op::ReduceType::kReduceMax:
+                algKind = dnnl_reduction_max;
+                break;
+            case op::ReduceType::kReduceMean:
+                algKind = dnnl_reduction_mean;
+                break;
+            case op::ReduceType::kReduceMin:
+                algKind = dnnl_reduction_min;
+                break;
+            case op::ReduceType::kReduceProduct:
+                algKind = dnnl_reduction_mul;
+                break;
+            case op::ReduceType::kReduceSum:
+                algKind = dnnl_reduction_sum;
+                break;
+            default:
+                return dnnl_unimplemented;
+        }
+        // The reduced dimensions are kept as 1 by the primitive, the output is reinterpreted
+        // without them.
+        const int rank = inputMemoryDesc->ndims;
+        std::vector<dnnl_dim_t> outputDims(inputMemoryDesc->dims, inputMemoryDesc->dims + rank);
+        const ReduceOptions* options = reduce->GetOptions();
+        if (options->axes == nullptr) {
+            std::fill(outputDims.begin(), outputDims.end(), 1);
+        } else {
+            for (uint32_t i = 0; i < options->axesCount; ++i) {
+                outputDims[options->axes[i] < 0 ? options->axes[i] + rank : options->axes[i]] = 1;
+            }
+        }
+        std::vector<dnnl_dim_t> dims;
+        dnnl_format_tag_t tag;
+        std::vector<int32_t> keptShape(outputDims.begin(), outputDims.end());
+        DNNL_TRY(GetDnnlDimsAndFormartTag(keptShape.data(), keptShape.size(), dims, tag));
+        dnnl_memory_desc_t outputMemoryDesc;
+        DNNL_TRY(dnnl_memory_desc_init_by_tag(&outputMemoryDesc, outputDims.size(),
+                                              outputDims.data(), inputMemoryDesc->data_type, tag));
+        dnnl_reduction_desc_t reductionDesc;
+        DNNL_TRY(dnnl_reduction_desc_init(&reductionDesc, algKind, inputMemoryDesc,
+                                          &outputMemoryDesc, p, 0));
+        dnnl_primitive_desc_t primitiveDesc;
+        DNNL_TRY(
+            dnnl_primitive_desc_create(&primitiveDesc, &reductionDesc, NULL, GetEngine(), NULL));
+        dnnl_memory_t outputMemory;
+        DNNL_TRY(CreateIntermediateMemory(&outputMemoryDesc, &outputMemory));
+        dnnl_primitive_t primitive;
+        DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
+        DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
+        mOperations.push_back(
+            {primitive, {{DNNL_ARG_SRC, inputMemory}, {DNNL_ARG_DST, outputMemory}}});
+        mMemories.push_back(outputMemory);
+        if (!options->keepDimensions) {
+            const std::vector<int32_t> outputShape = reduce->PrimaryOutput()->Shape();
+            DNNL_TRY(GetDnnlDimsAndFormartTag(outputShape.data(), outputShape.size(), dims, tag));
+            dnnl_memory_desc_t reducedMemoryDesc;
+            DNNL_TRY(dnnl_memory_desc_reshape(&reducedMemoryDesc, &outputMemoryDesc, dims.size(),
+                                              dims.data()));
+            mMemoryReinterprets.insert(std::make_pair(outputMemory, reducedMemoryDesc));
+        }
+        mOperandMemoryMap.insert(std::make_pair(reduce->PrimaryOutput(), outputMemory));
+        return dnnl_success;
+    }
+
+    MaybeError Graph::AddResample2d(const op::Resample2d* resample2d) {
+        mOperandsToBuild.push_back({OperatorType::RESAMPLE2D, resample2d});
+        return {};
+    }
+
+    dnnl_status_t Graph::AddResample2dImpl(const op::Resample2d* resample2d) {
+        dnnl_memory_t inputMemory;
+        const dnnl_memory_desc_t* inputMemoryDesc;
+        DNNL_TRY(
+            GetOperandMemory(resample2d->Inputs()[0].Get(), &inputMemory, &inputMemoryDesc));
+        // The primitive resamples the spatial dimensions after the channels, so the axes 1 and 2
+        // are those of a nhwc input.
+        const std::vector<int32_t> axes = resample2d->GetAxes();
+        const bool nhwc = axes[0] == 1 && axes[1] == 2;
+        if (!nhwc && (axes[0] != 2 || axes[1] != 3)) {
+            dawn::ErrorLog() << "oneDNN only supports resampling the axes 2 and 3 or 1 and 2.";
+            return dnnl_unimplemented;
+        }
+        dnnl_memory_desc_t nchwInputMemoryDesc;
+        std::vector<int32_t> outputShape = resample2d->GetOutputShape();
+        if (nhwc) {
+            DNNL_TRY(ViewNhwcAsNchw(inputMemoryDesc, &nchwInputMemoryDesc));
+            inputMemoryDesc = &nchwInputMemoryDesc;
+            outputShape = {outputShape[0], outputShape[3], outputShape[1], outputShape[2]};
+        }
+        const std::vector<dnnl_dim_t> outputDims(outputShape.begin(), outputShape.end());
+        dnnl_memory_desc_t outputInitDesc;
+        DNNL_TRY(dnnl_memory_desc_init_by_tag(&outputInitDesc, outputDims.size(),
+                                              outputDims.data(), inputMemoryDesc->data_type,
+                                              dnnl_format_tag_any));
+        const dnnl_alg_kind_t algKind =
+            resample2d->GetOptions()->mode == ml::InterpolationMode::Linear
+                ? dnnl_resampling_linear
+                : dnnl_resampling_nearest;
+        dnnl_resampling_desc_t resamplingDesc;
+        DNNL_TRY(dnnl_resampling_forward_desc_init(&resamplingDesc, dnnl_forward_inference,
+                                                   algKind, NULL, inputMemoryDesc,
+                                                   &outputInitDesc));
+        dnnl_primitive_desc_t primitiveDesc;
+        DNNL_TRY(
+            dnnl_primitive_desc_create(&primitiveDesc, &resamplingDesc, NULL, GetEngine(), NULL));
+        const dnnl_memory_desc_t* outputMemoryDesc =
+            dnnl_primitive_desc_query_md(primitiveDesc, dnnl_query_dst_md, 0);
+        dnnl_memory_t outputMemory;
+        DNNL_TRY(CreateIntermediateMemory(outputMemoryDesc, &outputMemory));
+        dnnl_primitive_t primitive;
+        DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
+        DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
+        mOperations.push_back(
+            {primitive, {{DNNL_ARG_SRC, inputMemory}, {DNNL_ARG_DST, outputMemory}}});
+        mMemories.push_back(outputMemory);
+        if (nhwc) {
+            DNNL_TRY(GetMemoryDesc(outputMemory, &outputMemoryDesc));
+            dnnl_memory_desc_t nhwcOutputMemoryDesc;
+            DNNL_TRY(ViewNchwAsNhwc(outputMemoryDesc, &nhwcOutputMemoryDesc));
+            mMemoryReinterprets.insert(std::make_pair(outputMemory, nhwcOutputMemoryDesc));
+        }
+        mOperandMemoryMap.insert(std::make_pair(resample2d->PrimaryOutput(), outputMemory));
+        return dnnl_success;
+    }
+
+    MaybeError Graph::AddReshape(const op::Reshape* reshape) {
+        mOperandsToBuild.push_back({OperatorType::RESHAPE, reshape});
+        return {};
+    }
+
+    MaybeError Graph::AddSqueeze(const op::Squeeze* squeeze) {
+        mOperandsToBuild.push_back({OperatorType::RESHAPE, squeeze});
+        return {};
+    }
+
+    dnnl_status_t Graph::AddReshapeImpl(const OperatorBase* reshape) {
+        const OperandBase* inputOperand = reshape->Inputs()[0].Get();
+        dnnl_memory_t inputMemory;
+        const dnnl_memory_desc_t* inputMemoryDesc;
+        DNNL_TRY(GetOperandMemory(inputOperand, &inputMemory, &inputMemoryDesc));
+        dnnl_memory_t plainMemory;
+        DNNL_TRY(ReorderToPlainFormat(inputMemory, &plainMemory));
+        const dnnl_memory_desc_t* plainMemoryDesc;
+        DNNL_TRY(GetMemoryDesc(plainMemory, &plainMemoryDesc));
+        const std::vector<int32_t> outputShape = reshape->PrimaryOutput()->Shape();
+        std::vector<dnnl_dim_t> outputDims;
+        dnnl_format_tag_t tag;
+        DNNL_TRY(GetDnnlDimsAndFormartTag(outputShape.data(), outputShape.size(), outputDims, tag));
+        dnnl_memory_desc_t outputMemoryDesc;
+        DNNL_TRY(dnnl_memory_desc_reshape(&outputMemoryDesc, plainMemoryDesc, outputDims.size(),
+                                          outputDims.data()));
+        dnnl_memory_t outputMemory = plainMemory;
+        if (plainMemory != inputMemory || HasSoleUse(inputOperand)) {
+            // Nothing else reads the plain memory, which is reinterpreted in place.
+            mMemoryReinterprets[plainMemory] = outputMemoryDesc;
+        } else {
+            DNNL_TRY(CreateIntermediateMemory(&outputMemoryDesc, &outputMemory));
+            mMemories.push_back(outputMemory);
+            DNNL_TRY(AddReorder(&outputMemoryDesc, plainMemory, &outputMemoryDesc, outputMemory));
+        }
+        mOperandMemoryMap.insert(std::make_pair(reshape->PrimaryOutput(), outputMemory));
+        return dnnl_success;
+    }
+
+    MaybeError Graph::AddSlice(const op::Slice* slice) {
+        mOperandsToBuild.push_back({OperatorType::SLICE, slice});
+        return {};
+    }
+
+    dnnl_status_t Graph::AddSliceImpl(const op::Slice* slice) {
+        const OperandBase* input = slice->Inputs()[0].Get();
+        const std::vector<int32_t> inputShape = input->Shape();
+        const std::vector<int32_t> starts = slice->GetStarts();
+        std::vector<int32_t> axes = slice->GetAxes();
+        if (axes.empty()) {
+            for (size_t i = 0; i < starts.size(); ++i) {
+                axes.push_back(i);
+            }
+        }
+        std::vector<dnnl_dim_t> offsets(inputShape.size(), 0);
+        for (size_t i = 0; i < axes.size(); ++i) {
+            const int32_t axis = axes[i] < 0 ? axes[i] + inputShape.size() : axes[i];
+            offsets[axis] = starts[i] < 0 ? starts[i] + inputShape[axis] : starts[i];
+        }
+        return AddSubTensorImpl(input, slice->PrimaryOutput(), offsets);
+    }
+
+    MaybeError Graph::AddSplit(const op::Split* split) {
+        mOperandsToBuild.push_back({OperatorType::SPLIT, split});
+        return {};
+    }
+
+    dnnl_status_t Graph::AddSplitImpl(const op::Split* split) {
+        const OperandBase* input = split->Inputs()[0].Get();
+        const int32_t rank = input->Shape().size();
+        const int32_t axis = split->GetAxis() < 0 ? split->GetAxis() + rank : split->GetAxis();
+        std::vector<dnnl_dim_t> offsets(rank, 0);
+        for (auto& output : split->Outputs()) {
+            DNNL_TRY(AddSubTensorImpl(input, output, offsets));
+            offsets[axis] += output->Shape()[axis];
+        }
+        return dnnl_success;
+    }
+
+    dnnl_status_t Graph::AddSubTensorImpl(const OperandBase* input,
+                                          const OperandBase* output,
+                                          const std::vector<dnnl_dim_t>& offsets) {
+        dnnl_memory_t inputMemory;
+        const dnnl_memory_desc_t* inputMemoryDesc;
+        DNNL_TRY(GetOperandMemory(input, &inputMemory, &inputMemoryDesc));
+        const std::vector<int32_t> outputShape = output->Shape();
+        const std::vector<dnnl_dim_t> outputDims(outputShape.begin(), outputShape.end());
+        // The part of a blocked input is only described when it is aligned to the blocks,
+        // otherwise it is taken from the plain input.
+        dnnl_memory_desc_t subMemoryDesc;
+        if (dnnl_memory_desc_init_submemory(&subMemoryDesc, inputMemoryDesc, outputDims.data(),
+                                            offsets.data()) != dnnl_success) {
+            DNNL_TRY(ReorderToPlainFormat(inputMemory, &inputMemory));
+            DNNL_TRY(GetMemoryDesc(inputMemory, &inputMemoryDesc));
+            DNNL_TRY(dnnl_memory_desc_init_submemory(&subMemoryDesc, inputMemoryDesc,
+                                                     outputDims.data(), offsets.data()));
+        }
+        dnnl_memory_desc_t outputMemoryDesc;
+        DNNL_TRY(GetPlainMemoryDesc(outputShape, inputMemoryDesc->data_type, &outputMemoryDesc));
+        dnnl_memory_t outputMemory;
+        DNNL_TRY(CreateIntermediateMemory(&outputMemoryDesc, &outputMemory));
+        mMemories.push_back(outputMemory);
+        DNNL_TRY(AddReorder(&subMemoryDesc, inputMemory, &outputMemoryDesc, outputMemory));
+        mOperandMemoryMap.insert(std::make_pair(output, outputMemory));
+        return dnnl_success;
+    }
+
+    MaybeError Graph::AddTranspose(const op::Transpose* transpose) {
+        mOperandsToBuild.push_back({OperatorType::TRANSPOSE, transpose});
+        return {};
+    }
+
+    dnnl_status_t Graph::AddTransposeImpl(const op::Transpose* transpose) {
+        const OperandBase* inputOperand = transpose->Inputs()[0].Get();
+        dnnl_memory_t inputMemory;
+        const dnnl_memory_desc_t* inputMemoryDesc;
+        DNNL_TRY(GetOperandMemory(inputOperand, &inputMemory, &inputMemoryDesc));
+        // The output dimension i is the input dimension permutation[i], oneDNN takes the
+        // position of each input dimension in the output.
+        const std::vector<int32_t> permutation = transpose->GetPermutation();
+        std::vector<int> permute(permutation.size());
+        for (size_t i = 0; i < permutation.size(); ++i) {
+            permute[permutation[i]] = i;
+        }
+        dnnl_memory_desc_t transposedMemoryDesc;
+        DNNL_TRY(dnnl_memory_desc_permute_axes(&transposedMemoryDesc, inputMemoryDesc,
+                                               permute.data()));
+        dnnl_memory_desc_t outputMemoryDesc;
+        DNNL_TRY(GetPlainMemoryDesc(transpose->PrimaryOutput()->Shape(),
+                                    inputMemoryDesc->data_type, &outputMemoryDesc));
+        dnnl_memory_t outputMemory = inputMemory;
+        if (dnnl_memory_desc_equal(&transposedMemoryDesc, &outputMemoryDesc) &&
+            HasSoleUse(inputOperand)) {
+            // Only dimensions of 1 are moved, the memory is reinterpreted in place.
+            mMemoryReinterprets[inputMemory] = outputMemoryDesc;
+        } else {
+            DNNL_TRY(CreateIntermediateMemory(&outputMemoryDesc, &outputMemory));
+            mMemories.push_back(outputMemory);
+            DNNL_TRY(
+                AddReorder(&transposedMemoryDesc, inputMemory, &outputMemoryDesc, outputMemory));
+        }
+        mOperandMemoryMap.insert(std::make_pair(transpose->PrimaryOutput(), outputMemory));
+        return dnnl_success;
+    }
+
+    bool Graph::SupportsFusedOperators() const {
+        return false;
+    }
+
+    MaybeError Graph::Finish() {
+        DAWN_TRY(BuildPrimitives());
+        for (auto& output : mOutputOperands) {
+            DAWN_ASSERT(mOperandMemoryMap.find(output.second) != mOperandMemoryMap.end());
+            dnnl_memory_t plainOutputMemory;
+            DAWN_TRY(ReorderToPlainFormat(mOperandMemoryMap.at(output.second), &plainOutputMemory));
+            mOutputMemoryMap.insert(std::make_pair(output.first, plainOutputMemory));
+        }
+        return {};
+    }
+
+    MaybeError Graph::CompileImpl() {
+        DAWN_TRY(dnnl_stream_create(&mStream, GetEngine(), dnnl_stream_default_flags));
+        DAWN_TRY(PlanMemory());
+        if (GetProfiler() != nullptr) {
+            DAWN_TRY(LabelOperations());
+        }
+        return {};
+    }
+
+    dnnl_status_t Graph::LabelOperations() {
+        for (auto& op : mOperations) {
+            const_dnnl_primitive_desc_t primitiveDesc;
+            DNNL_TRY(dnnl_primitive_get_primitive_desc(op.primitive, &primitiveDesc));
+            dnnl_primitive_kind_t kind;
+            DNNL_TRY(dnnl_primitive_desc_query(primitiveDesc, dnnl_query_primitive_kind, 0, &kind));
+            const char* implementation;
+            DNNL_TRY(dnnl_primitive_desc_query(primitiveDesc, dnnl_query_impl_info_str, 0,
+                                               &implementation));
+            OperationLabel label = {dnnl_prim_kind2str(kind), implementation, 0};
+            for (auto& arg : op.args) {
+                const dnnl_memory_desc_t* desc;
+                DNNL_TRY(GetMemoryDesc(arg.memory, &desc));
+                label.byteLength += dnnl_memory_desc_get_size(desc);
+                if (arg.arg == DNNL_ARG_DST) {
+                    char format[256];
+                    if (dnnl_md2fmt_str(format, sizeof(format), desc) > 0) {
+                        label.kernel = label.kernel + " " + format;
+                    }
+                }
+            }
+            mOperationLabels.push_back(std::move(label));
+        }
+        return dnnl_success;
+    }
+
+    dnnl_status_t Graph::PlanMemory() {
+        // The steps are the positions of the primitives, the outputs are read after the last one.
+        MemoryPlanner planner;
+        std::map<dnnl_memory_t, size_t> bufferIds;
+        for (size_t i = 0; i < mOperations.size(); ++i) {
+            for (auto& arg : mOperations[i].args) {
+                if (mIntermediateMemories.find(arg.memory) == mIntermediateMemories.end()) {
+                    continue;
+                }
+                auto iter = bufferIds.find(arg.memory);
+                if (iter != bufferIds.end()) {
+                    planner.UseBuffer(iter->second, i);
+                    continue;
+                }
+                // Query the actual layout of the memory rather than its reinterpretation.
+                const dnnl_memory_desc_t* desc;
+                DNNL_TRY(dnnl_memory_get_memory_desc(arg.memory, &desc));
+                bufferIds[arg.memory] = planner.AddBuffer(dnnl_memory_desc_get_size(desc), i, i);
+            }
+        }
+        for (auto& output : mOutputMemoryMap) {
+            auto iter = bufferIds.find(output.second);
+            if (iter != bufferIds.end()) {
+                planner.UseBuffer(iter->second, mOperations.size());
+            }
+        }
+        planner.Plan();
+
+        const size_t alignment = 64;
+        mArena.resize(planner.GetArenaSize() + alignment);
+        uintptr_t address = reinterpret_cast<uintptr_t>(mArena.data());
+        int8_t* arena = mArena.data() + (alignment - address % alignment) % alignment;
+        for (auto& bufferId : bufferIds) {
+            DNNL_TRY(dnnl_memory_set_data_handle_v2(
+                bufferId.first, arena + planner.GetOffset(bufferId.second), mStream));
+        }
+        dawn::DebugLog() << "oneDNN graph plans " << planner.GetBufferCount()
+                         << " intermediate buffers into " << planner.GetArenaSize()
+                         << " bytes instead of " << planner.GetTotalSize() << " bytes.";
+        return dnnl_success;
+    }
+
+    MLComputeGraphStatus Graph::ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
+        std::lock_guard<std::mutex> lock(mMutex);
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+        // The OpenMP thread count belongs to the calling thread, which changes between the
+        // asynchronous computes.
+        uint32_t threadCount = GetContext()->GetContextOptions().threadCount;
+        if (threadCount != 0) {
+            omp_set_num_threads(threadCount);
+        }
+#endif
+        for (auto& input : inputs->GetRecords()) {
+            dnnl_memory_t inputMemory = mInputMemoryMap.at(input.first);
+            COMPUTE_TRY(
+                dnnl_memory_set_data_handle_v2(inputMemory,
                                                static_cast<int8_t*>(input.second->resource.buffer) +
                                                    input.second->resource.byteOffset,
                                                mStream));
         }
 
-        for (auto op : mOperations) {
-            COMPUTE_TRY(
-                dnnl_primitive_execute(op.primitive, mStream, op.args.size(), op.args.data()));
+        // The outputs written by a primitive in plain format are bound to the user buffers like
+        // the inputs, the planned memory is restored once the primitives are executed.
+        struct OutputBinding {
+            void* plannedHandle;
+            void* userHandle;
+        };
+        std::map<dnnl_memory_t, OutputBinding> outputBindings;
+        auto outputRecords = outputs->GetRecords();
+        for (auto& output : outputRecords) {
+            dnnl_memory_t outputMemory = mOutputMemoryMap.at(output.first);
+            if (mIntermediateMemories.find(outputMemory) == mIntermediateMemories.end() ||
+                outputBindings.find(outputMemory) != outputBindings.end()) {
+                continue;
+            }
+            const dnnl_memory_desc_t* outputMemoryDesc;
+            COMPUTE_TRY(dnnl_memory_get_memory_desc(outputMemory, &outputMemoryDesc));
+            if (output.second->byteLength < dnnl_memory_desc_get_size(outputMemoryDesc)) {
+                continue;
+            }
+            void* plannedHandle;
+            COMPUTE_TRY(dnnl_memory_get_data_handle(outputMemory, &plannedHandle));
+            void* userHandle =
+                static_cast<int8_t*>(output.second->buffer) + output.second->byteOffset;
+            outputBindings[outputMemory] = {plannedHandle, userHandle};
+        }
+        for (auto& binding : outputBindings) {
+            COMPUTE_TRY(dnnl_memory_set_data_handle_v2(binding.first, binding.second.userHandle,
+                                                       mStream));
         }
 
-        COMPUTE_TRY(dnnl_stream_wait(mStream));
-
-        std::vector<std::string> outputNames;
-        for (auto& output : outputs->GetRecords()) {
-            outputNames.push_back(output.first);
+        dnnl_status_t status = dnnl_success;
+        Profiler* profiler = GetProfiler();
+        for (size_t i = 0; i < mOperations.size() && !FAILED(status); ++i) {
+            const Operation& op = mOperations[i];
+            if (profiler == nullptr) {
+                status =
+                    dnnl_primitive_execute(op.primitive, mStream, op.args.size(), op.args.data());
+                continue;
+            }
+            // The stream is waited for in the event, so that it spans the primitive execution.
+            const OperationLabel& label = mOperationLabels[i];
+            TRACE_EVENT2(profiler, General, label.name.c_str(), "kernel", label.kernel.c_str(),
+                         "bytes", static_cast<unsigned long long>(label.byteLength));
+            status = dnnl_primitive_execute(op.primitive, mStream, op.args.size(), op.args.data());
+            if (!FAILED(status)) {
+                status = dnnl_stream_wait(mStream);
+            }
+        }
+        if (!FAILED(status)) {
+            status = dnnl_stream_wait(mStream);
+        }
+        for (auto& binding : outputBindings) {
+            COMPUTE_TRY(dnnl_memory_set_data_handle_v2(binding.first,
+                                                       binding.second.plannedHandle, mStream));
+        }
+        if (FAILED(status)) {
+            dawn::ErrorLog() << "Executing primitives returns oneDNN error: "
+                             << dnnl_status2str(status);
+            return MLComputeGraphStatus_Error;
         }
 
-        for (size_t i = 0; i < outputNames.size(); ++i) {
-            std::string outputName = outputNames[i];
-            dnnl_memory_t outputMemory = mOutputMemoryMap.at(outputName);
+        // Copy the other outputs, e.g. the ones that alias an input or another output, or whose
+        // user buffer is too small.
+        size_t copiedBytes = 0;
+        for (auto& output : outputRecords) {
+            dnnl_memory_t outputMemory = mOutputMemoryMap.at(output.first);
+            void* userHandle =
+                static_cast<int8_t*>(output.second->buffer) + output.second->byteOffset;
+            void* sourceHandle;
+            auto binding = outputBindings.find(outputMemory);
+            if (binding != outputBindings.end()) {
+                if (binding->second.userHandle == userHandle) {
+                    continue;
+                }
+                sourceHandle = binding->second.userHandle;
+            } else {
+                COMPUTE_TRY(dnnl_memory_get_data_handle(outputMemory, &sourceHandle));
+            }
             const dnnl_memory_desc_t* outputMemoryDesc;
-            COMPUTE_TRY(GetMemoryDesc(outputMemory, &outputMemoryDesc));
+            COMPUTE_TRY(dnnl_memory_get_memory_desc(outputMemory, &outputMemoryDesc));
             size_t bufferLength = dnnl_memory_desc_get_size(outputMemoryDesc);
-            void* outputBuffer = malloc(bufferLength);
-            COMPUTE_TRY(ReadFromMemory(outputBuffer, bufferLength, outputMemory));
-            const ArrayBufferView* output = outputs->GetRecords().at(outputName);
-            if (output->byteLength >= bufferLength) {
-                memcpy(static_cast<int8_t*>(output->buffer) + output->byteOffset, outputBuffer,
-                       bufferLength);
+            if (output.second->byteLength >= bufferLength) {
+                memcpy(userHandle, sourceHandle, bufferLength);
+                copiedBytes += bufferLength;
             }
         }
+        RecordCopiedBytes(copiedBytes);
         return MLComputeGraphStatus_Success;
     }
 
@@ -1032,6 +2814,13 @@ namespace webnn_native { namespace onednn {
         return reinterpret_cast<Context*>(GetContext())->GetEngine();
     }
 
+    dnnl_status_t Graph::CreateIntermediateMemory(const dnnl_memory_desc_t* desc,
+                                                  dnnl_memory_t* memory) {
+        DNNL_TRY(dnnl_memory_create(memory, desc, GetEngine(), DNNL_MEMORY_NONE));
+        mIntermediateMemories.insert(*memory);
+        return dnnl_success;
+    }
+
     dnnl_status_t Graph::GetMemoryDesc(dnnl_memory_t memory, const dnnl_memory_desc_t** desc) {
         if (mMemoryReinterprets.find(memory) != mMemoryReinterprets.end()) {
             *desc = &mMemoryReinterprets.at(memory);
@@ -1047,7 +2836,14 @@ namespace webnn_native { namespace onednn {
                                          dnnl_memory_t* userDstMem) {
         if (!dnnl_memory_desc_equal(srcDesc, dstDesc)) {
             dnnl_memory_t dstMem;
-            DNNL_TRY(dnnl_memory_create(&dstMem, dstDesc, GetEngine(), DNNL_MEMORY_ALLOCATE));
+            const bool constantSource = mConstantMemories.find(srcMem) != mConstantMemories.end();
+            if (constantSource) {
+                // Reordered constants are computed once here, so they can't be planned.
+                DNNL_TRY(dnnl_memory_create(&dstMem, dstDesc, GetEngine(), DNNL_MEMORY_ALLOCATE));
+                mConstantMemories.insert(dstMem);
+            } else {
+                DNNL_TRY(CreateIntermediateMemory(dstDesc, &dstMem));
+            }
             dnnl_primitive_desc_t reorderDesc;
             DNNL_TRY(dnnl_reorder_primitive_desc_create(&reorderDesc, srcDesc, GetEngine(), dstDesc,
                                                         GetEngine(), NULL));
@@ -1055,7 +2851,7 @@ namespace webnn_native { namespace onednn {
             DNNL_TRY(dnnl_primitive_create(&reorder, reorderDesc));
             DNNL_TRY(dnnl_primitive_desc_destroy(reorderDesc));
             std::vector<dnnl_exec_arg_t> args = {{DNNL_ARG_SRC, srcMem}, {DNNL_ARG_DST, dstMem}};
-            if (mConstantMemories.find(srcMem) != mConstantMemories.end()) {
+            if (constantSource) {
                 dnnl_stream_t stream;
                 DNNL_TRY(dnnl_stream_create(&stream, GetEngine(), dnnl_stream_default_flags));
 
@@ -1090,4 +2886,42 @@ namespace webnn_native { namespace onednn {
         return dnnl_success;
     }
 
+    dnnl_status_t Graph::AddReorder(const dnnl_memory_desc_t* srcDesc,
+                                    dnnl_memory_t srcMem,
+                                    const dnnl_memory_desc_t* dstDesc,
+                                    dnnl_memory_t dstMem) {
+        dnnl_primitive_desc_t reorderDesc;
+        DNNL_TRY(dnnl_reorder_primitive_desc_create(&reorderDesc, srcDesc, GetEngine(), dstDesc,
+                                                    GetEngine(), NULL));
+        dnnl_primitive_t reorder;
+        DNNL_TRY(dnnl_primitive_create(&reorder, reorderDesc));
+        DNNL_TRY(dnnl_primitive_desc_destroy(reorderDesc));
+        mOperations.push_back({reorder, {{DNNL_ARG_SRC, srcMem}, {DNNL_ARG_DST, dstMem}}});
+        return dnnl_success;
+    }
+
+    dnnl_status_t Graph::CreateConstantMemory(const dnnl_memory_desc_t* desc,
+                                              const void* data,
+                                              size_t size,
+                                              dnnl_memory_t* memory) {
+        DNNL_TRY(dnnl_memory_create(memory, desc, GetEngine(), DNNL_MEMORY_ALLOCATE));
+        mMemories.push_back(*memory);
+        DNNL_TRY(WriteToMemory(data, size, *memory));
+        mConstantMemories.insert(*memory);
+        return dnnl_success;
+    }
+
+    dnnl_status_t Graph::GetOperandMemory(const OperandBase* operand,
+                                          dnnl_memory_t* memory,
+                                          const dnnl_memory_desc_t** desc) {
+        DAWN_ASSERT(mOperandMemoryMap.find(operand) != mOperandMemoryMap.end());
+        *memory = mOperandMemoryMap.at(operand);
+        return GetMemoryDesc(*memory, desc);
+    }
+
+    bool Graph::HasSoleUse(const OperandBase* operand) const {
+        auto iter = mOperandUseCounts.find(operand);
+        return iter != mOperandUseCounts.end() && iter->second == 1;
+    }
+
 }}  // namespace webnn_native::onednn
@@ -16,20 +16,37 @@
 #define WEBNN_NATIVE_ONEDNN_MODEL_DNNL_H_
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <string>
+#include <vector>
 
 #include <dnnl.h>
 
+#include "webnn_native/ConstantPool.h"
 #include "webnn_native/Graph.h"
 #include "webnn_native/Operand.h"
 #include "webnn_native/onednn/ContextDNNL.h"
+#include "webnn_native/ops/BatchNorm.h"
 #include "webnn_native/ops/Binary.h"
 #include "webnn_native/ops/Clamp.h"
+#include "webnn_native/ops/Concat.h"
 #include "webnn_native/ops/Constant.h"
 #include "webnn_native/ops/Conv2d.h"
+#include "webnn_native/ops/Gemm.h"
+#include "webnn_native/ops/Gru.h"
 #include "webnn_native/ops/Input.h"
+#include "webnn_native/ops/InstanceNorm.h"
+#include "webnn_native/ops/Pad.h"
 #include "webnn_native/ops/Pool2d.h"
+#include "webnn_native/ops/Quantize.h"
+#include "webnn_native/ops/Reduce.h"
+#include "webnn_native/ops/Resample2d.h"
 #include "webnn_native/ops/Reshape.h"
+#include "webnn_native/ops/Slice.h"
+#include "webnn_native/ops/Split.h"
+#include "webnn_native/ops/Squeeze.h"
 #include "webnn_native/ops/Transpose.h"
 #include "webnn_native/ops/Unary.h"
 
@@ -43,29 +60,141 @@ namespace webnn_native { namespace onednn {
         virtual MaybeError AddConstant(const op::Constant* constant) override;
         virtual MaybeError AddInput(const op::Input* input) override;
         virtual MaybeError AddOutput(const std::string& name, const OperandBase* output) override;
+        virtual MaybeError AddBatchNorm(const op::BatchNorm* batchNorm) override;
         virtual MaybeError AddBinary(const op::Binary* binary) override;
+        virtual MaybeError AddConcat(const op::Concat* concat) override;
         virtual MaybeError AddConv2d(const op::Conv2d* conv2d) override;
+        virtual MaybeError AddGemm(const op::Gemm* gemm) override;
+        virtual MaybeError AddGru(const op::Gru* gru) override;
+        virtual MaybeError AddInstanceNorm(const op::InstanceNorm* instanceNorm) override;
+        virtual MaybeError AddPad(const op::Pad* pad) override;
         virtual MaybeError AddPool2d(const op::Pool2d* pool2d) override;
+        virtual MaybeError AddReduce(const op::Reduce* reduce) override;
+        virtual MaybeError AddResample2d(const op::Resample2d* resample2d) override;
+        virtual MaybeError AddReshape(const op::Reshape* reshape) override;
+        virtual MaybeError AddSqueeze(const op::Squeeze* squeeze) override;
+        virtual MaybeError AddSlice(const op::Slice* slice) override;
+        virtual MaybeError AddSplit(const op::Split* split) override;
+        virtual MaybeError AddTranspose(const op::Transpose* transpose) override;
         virtual MaybeError AddUnary(const op::Unary* unary) override;
         virtual MaybeError AddClamp(const op::Clamp* clamp) override;
+        virtual MaybeError AddQuantize(const op::Quantize* quantize) override;
+        // Builds the primitives of the operators in order, then reorders the outputs to the
+        // plain format.
         virtual MaybeError Finish() override;
+        // BuildPrimitives fuses the chains of eltwise operators, adds and muls following the
+        // convolutions, the matmuls, the gemms, the pools and the binary operators on its own.
+        bool SupportsFusedOperators() const override;
 
       private:
+        enum OperatorType {
+            BATCH_NORM,
+            BINARY,
+            CLAMP,
+            CONCAT,
+            CONV2D,
+            GEMM,
+            GRU,
+            INSTANCE_NORM,
+            PAD,
+            POOL2D,
+            QUANTIZE,
+            REDUCE,
+            RESAMPLE2D,
+            RESHAPE,
+            SLICE,
+            SPLIT,
+            TRANSPOSE,
+            UNARY
+        };
+        struct OperatorInfo {
+            OperatorType opType;
+            const OperatorBase* op;
+        };
+
+        // The dequantizations of the input and the filter make an int8 convolution, which
+        // reads their quantized memories and folds their scales into the output. |postOps| are
+        // the operators applied to the output in turn, the first of which may add the bias.
         dnnl_status_t AddConv2dImpl(const op::Conv2d* conv2d,
-                                    const op::Binary* add = nullptr,
-                                    const op::FusionClamp* clamp = nullptr);
-        dnnl_status_t AddBinaryImpl(const op::Binary* binary);
+                                    const std::vector<const OperatorInfo*>& postOps = {},
+                                    const op::Quantize* inputDequantization = nullptr,
+                                    const op::Quantize* filterDequantization = nullptr);
+        dnnl_status_t AddBatchNormImpl(const op::BatchNorm* batchNorm);
+        // The dequantizations of a and b make an int8 matmul like those of a convolution.
+        dnnl_status_t AddBinaryImpl(const op::Binary* binary,
+                                    const std::vector<const OperatorInfo*>& postOps = {},
+                                    const op::Quantize* aDequantization = nullptr,
+                                    const op::Quantize* bDequantization = nullptr);
         dnnl_status_t AddClampImpl(const op::Clamp* clamp);
-        dnnl_status_t AddPool2dImpl(const op::Pool2d* pool2d);
+        dnnl_status_t AddConcatImpl(const op::Concat* concat);
+        dnnl_status_t AddGemmImpl(const op::Gemm* gemm,
+                                  const std::vector<const OperatorInfo*>& postOps = {},
+                                  const op::Quantize* aDequantization = nullptr,
+                                  const op::Quantize* bDequantization = nullptr);
+        dnnl_status_t AddGruImpl(const op::Gru* gru);
+        dnnl_status_t AddInstanceNormImpl(const op::InstanceNorm* instanceNorm);
+        dnnl_status_t AddPadImpl(const op::Pad* pad);
+        dnnl_status_t AddPool2dImpl(const op::Pool2d* pool2d,
+                                    const std::vector<const OperatorInfo*>& postOps = {});
+        dnnl_status_t AddReduceImpl(const op::Reduce* reduce);
+        dnnl_status_t AddResample2dImpl(const op::Resample2d* resample2d);
+        // Reshapes and squeezes, which only change the dimensions of the plain input.
+        dnnl_status_t AddReshapeImpl(const OperatorBase* reshape);
+        dnnl_status_t AddSliceImpl(const op::Slice* slice);
+        dnnl_status_t AddSplitImpl(const op::Split* split);
+        dnnl_status_t AddTransposeImpl(const op::Transpose* transpose);
         dnnl_status_t AddUnaryImpl(const op::Unary* unary);
-
+        dnnl_status_t AddQuantizeImpl(const op::Quantize* quantize);
+        // Applies |activation| to |inputMemory| with an eltwise primitive.
+        dnnl_status_t AddActivationImpl(const FusionOperatorBase* activation,
+                                        dnnl_memory_t inputMemory,
+                                        dnnl_memory_t* outputMemory);
+        // Copies the part of |input| starting at |offsets| to |output|, for split and slice.
+        dnnl_status_t AddSubTensorImpl(const OperandBase* input,
+                                       const OperandBase* output,
+                                       const std::vector<dnnl_dim_t>& offsets);
+
+        // Appends |postOps| applied in turn to |output| to the post-ops of a primitive, whose
+        // destination is viewed as nchw when |nhwc|, and the other operands of the adds and the
+        // muls to |args|. When |sumMemory| isn't null, a leading add may instead accumulate into
+        // the memory of its other operand, which is returned in |sumMemory|.
+        dnnl_status_t AppendPostOps(const std::vector<const OperatorInfo*>& postOps,
+                                    const OperandBase* output,
+                                    bool nhwc,
+                                    dnnl_post_ops_t postops,
+                                    std::vector<dnnl_exec_arg_t>& args,
+                                    dnnl_memory_t* sumMemory = nullptr);
         dnnl_status_t BuildPrimitives();
 
         MaybeError CompileImpl() override;
         MLComputeGraphStatus ComputeImpl(NamedInputsBase* inputs,
                                          NamedOutputsBase* outputs) override;
+        // Plans the intermediate memories into mArena once all the primitives are known.
+        dnnl_status_t PlanMemory();
+        // Names the primitives traced when profiling after their kind, their implementation and
+        // the format of their destination.
+        dnnl_status_t LabelOperations();
         dnnl_engine_t GetEngine();
+        // Creates a memory without a data handle, which is assigned by PlanMemory.
+        dnnl_status_t CreateIntermediateMemory(const dnnl_memory_desc_t* desc,
+                                               dnnl_memory_t* memory);
+        // Creates a memory holding |data| computed at build time, e.g. the packed scale and
+        // shift of the normalizations.
+        dnnl_status_t CreateConstantMemory(const dnnl_memory_desc_t* desc,
+                                           const void* data,
+                                           size_t size,
+                                           dnnl_memory_t* memory);
         dnnl_status_t GetMemoryDesc(dnnl_memory_t memory, const dnnl_memory_desc_t** desc);
+        dnnl_status_t GetOperandMemory(const OperandBase* operand,
+                                       dnnl_memory_t* memory,
+                                       const dnnl_memory_desc_t** desc);
+        // Whether |operand| is only read by one operator and isn't an output, so that its
+        // memory may be reinterpreted in place.
+        bool HasSoleUse(const OperandBase* operand) const;
+        dnnl_status_t AddReorder(const dnnl_memory_desc_t* srcDesc,
+                                 dnnl_memory_t srcMem,
+                                 const dnnl_memory_desc_t* dstDesc,
+                                 dnnl_memory_t dstMem);
         dnnl_status_t ReorderIfNeeded(const dnnl_memory_desc_t* srcDesc,
                                       dnnl_memory_t srcMem,
                                       const dnnl_memory_desc_t* dstDesc,
@@ -74,18 +203,19 @@ namespace webnn_native { namespace onednn {
 
         std::vector<dnnl_memory_t> mMemories;
         std::set<dnnl_memory_t> mConstantMemories;
+        // The memories of the constants point into the pool, which keeps the bytes alive.
+        std::vector<std::shared_ptr<const PooledConstant>> mPooledConstants;
+        std::set<dnnl_memory_t> mIntermediateMemories;
+        std::vector<int8_t> mArena;
         std::map<dnnl_memory_t, dnnl_memory_desc_t> mMemoryReinterprets;
         std::map<const OperandBase*, dnnl_memory_t> mOperandMemoryMap;
         std::map<std::string, dnnl_memory_t> mInputMemoryMap;
         std::map<std::string, dnnl_memory_t> mOutputMemoryMap;
 
-        enum OperatorType { BINARY, CLAMP, CONV2D, POOL2D, UNARY };
-        struct OperatorInfo {
-            OperatorType opType;
-            const OperatorBase* op;
-        };
         // For op fusion
         std::vector<OperatorInfo> mOperandsToBuild;
+        std::vector<std::pair<std::string, const OperandBase*>> mOutputOperands;
+        std::map<const OperandBase*, size_t> mOperandUseCounts;
 
         typedef struct {
             dnnl_primitive_t primitive;
@@ -94,7 +224,23 @@ namespace webnn_native { namespace onednn {
 
         std::vector<Operation> mOperations;
 
+        struct OperationLabel {
+            std::string name;
+            std::string kernel;
+            uint64_t byteLength;
+        };
+        std::vector<OperationLabel> mOperationLabels;
+
         dnnl_stream_t mStream;
+
+        // The type of the sources and weights of the float32 convolutions and matmuls, which
+        // the precision hint of the context reduces to bf16 or f16. They still accumulate and
+        // write in f32.
+        dnnl_data_type_t mComputeDataType = dnnl_f32;
+
+        // The memories and the stream are owned by the graph, so concurrent computes are
+        // serialized.
+        std::mutex mMutex;
     };
 
 }}  // namespace webnn_native::onednn
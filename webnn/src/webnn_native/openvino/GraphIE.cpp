@@ -15,11 +15,20 @@
 #include "webnn_native/openvino/GraphIE.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "common/Assert.h"
 #include "common/Log.h"
 #include "dawn_native/ErrorData.h"
+#include "webnn_native/BindingSet.h"
+#include "webnn_native/GraphContentHasher.h"
+#include "webnn_native/GraphSerialization.h"
 #include "webnn_native/NamedInputs.h"
 #include "webnn_native/NamedOperands.h"
 #include "webnn_native/NamedOutputs.h"
@@ -177,6 +186,7 @@ namespace webnn_native { namespace ie {
                     break;
                 default:
                     WEBNN_ASSERT(0, "The OperatorType isn't supported.");
+                    status = IEStatusCode::GENERAL_ERROR;
             }
             return status;
         }
@@ -314,10 +324,115 @@ namespace webnn_native { namespace ie {
             }
             return status;
         }
+
+        // Binds user buffers to an infer request in place of the blobs it allocated, which are
+        // bound back when the compute ends so that the request never keeps a user buffer.
+        class BlobBindings {
+          public:
+            explicit BlobBindings(ie_infer_request_t* request) : mRequest(request) {
+            }
+
+            ~BlobBindings() {
+                for (auto& binding : mBindings) {
+                    ie_infer_request_set_blob(mRequest, binding.first.c_str(), binding.second);
+                }
+                for (auto blob : mBlobs) {
+                    ie_blob_free(&blob);
+                }
+            }
+
+            // Takes the ownership of a blob returned by the request.
+            void Own(ie_blob_t* blob) {
+                mBlobs.push_back(blob);
+            }
+
+            // Binds |buffer| to |name| with the desc of |blob|, the blob of the request. It
+            // returns false when the buffer isn't aligned to the element size or too small,
+            // leaving the data to be copied.
+            bool Bind(const char* name, ie_blob_t* blob, void* buffer, size_t byteLength) {
+                int size, byteSize;
+                if (ie_blob_size(blob, &size) != IEStatusCode::OK ||
+                    ie_blob_byte_size(blob, &byteSize) != IEStatusCode::OK || size <= 0 ||
+                    byteLength < static_cast<size_t>(byteSize) ||
+                    reinterpret_cast<uintptr_t>(buffer) % (byteSize / size) != 0) {
+                    return false;
+                }
+                tensor_desc_t desc;
+                if (ie_blob_get_dims(blob, &desc.dims) != IEStatusCode::OK ||
+                    ie_blob_get_layout(blob, &desc.layout) != IEStatusCode::OK ||
+                    ie_blob_get_precision(blob, &desc.precision) != IEStatusCode::OK) {
+                    return false;
+                }
+                ie_blob_t* userBlob;
+                if (ie_blob_make_memory_from_preallocated(&desc, buffer, byteSize, &userBlob) !=
+                    IEStatusCode::OK) {
+                    return false;
+                }
+                mBlobs.push_back(userBlob);
+                if (ie_infer_request_set_blob(mRequest, name, userBlob) != IEStatusCode::OK) {
+                    return false;
+                }
+                mBindings.push_back({name, blob});
+                return true;
+            }
+
+          private:
+            ie_infer_request_t* mRequest;
+            std::vector<std::pair<std::string, ie_blob_t*>> mBindings;
+            std::vector<ie_blob_t*> mBlobs;
+        };
+
+        // Maps the context options to the config keys of the device plugin, the zero counts
+        // and the default enums keep the defaults of the plugin.
+        std::vector<std::pair<std::string, std::string>> GetDeviceConfig(
+            const ContextOptions& options,
+            bool isGpu) {
+            std::vector<std::pair<std::string, std::string>> config;
+            if (isGpu) {
+                if (options.streamCount != 0) {
+                    config.push_back(
+                        {"GPU_THROUGHPUT_STREAMS", std::to_string(options.streamCount)});
+                }
+                return config;
+            }
+            if (options.threadCount != 0) {
+                config.push_back({"CPU_THREADS_NUM", std::to_string(options.threadCount)});
+            }
+            if (options.streamCount != 0) {
+                config.push_back({"CPU_THROUGHPUT_STREAMS", std::to_string(options.streamCount)});
+            }
+            switch (options.threadPinning) {
+                case ml::ThreadPinning::None:
+                    config.push_back({"CPU_BIND_THREAD", "NO"});
+                    break;
+                case ml::ThreadPinning::Cores:
+                    config.push_back({"CPU_BIND_THREAD", "YES"});
+                    break;
+                case ml::ThreadPinning::Numa:
+                    config.push_back({"CPU_BIND_THREAD", "NUMA"});
+                    break;
+                default:
+                    break;
+            }
+            switch (options.precisionHint) {
+                case ml::PrecisionHint::Float32:
+                    config.push_back({"ENFORCE_BF16", "NO"});
+                    break;
+                case ml::PrecisionHint::Bfloat16:
+                    config.push_back({"ENFORCE_BF16", "YES"});
+                    break;
+                case ml::PrecisionHint::Float16:
+                    dawn::WarningLog() << "The float16 precision hint isn't supported on CPU.";
+                    break;
+                default:
+                    break;
+            }
+            return config;
+        }
     }  // namespace
 
     Graph::Graph(Context* context)
-        : GraphBase(context), mInferEngineNetwork(nullptr), mInferEngineRequest(nullptr) {
+        : GraphBase(context), mInferEngineNetwork(nullptr) {
         mInferEngineCore = context->InferenceEngineCore();
     }
 
@@ -325,8 +440,8 @@ namespace webnn_native { namespace ie {
         if (mInferEngineNetwork) {
             ie_network_free(&mInferEngineNetwork);
         }
-        if (mInferEngineRequest) {
-            ie_infer_request_free(&mInferEngineRequest);
+        for (auto request : mInferEngineRequests) {
+            ie_infer_request_free(&request);
         }
         for (auto node : mGraphNodeMap) {
             ngraph_node_free(const_cast<ngraph_node_t**>(&node.second));
@@ -502,7 +617,7 @@ namespace webnn_native { namespace ie {
             ngraph_batch_norm_inference(inputNode, scaleNode, biasNode, meanNode, varianceNode,
                                         options->epsilon, &batchNormNode);
         DAWN_TRY(CheckStatusCode(status, "ngraph batch norm inference"));
-        ngraph_node_t* activationNode;
+        ngraph_node_t* activationNode = nullptr;
         status = AddActivationNode(batchNormNode, options->activation, &activationNode);
         DAWN_TRY(CheckStatusCode(status, "ngraph activation"));
         if (nhwc) {
@@ -698,7 +813,7 @@ namespace webnn_native { namespace ie {
             status = ngraph_add(conv2dNode, biasNode, &conv2dNode);
             DAWN_TRY(CheckStatusCode(status, "ngraph add"));
         }
-        ngraph_node_t* activationNode;
+        ngraph_node_t* activationNode = nullptr;
         status = AddActivationNode(conv2dNode, options->activation, &activationNode);
         DAWN_TRY(CheckStatusCode(status, "ngraph activation"));
         if (options->inputLayout == ml::InputOperandLayout::Nhwc) {
@@ -716,6 +831,9 @@ namespace webnn_native { namespace ie {
     MaybeError Graph::AddGru(const op::Gru* gru) {
         auto inputs = gru->Inputs();
         auto options = gru->GetOptions();
+        if (options->stateful) {
+            return DAWN_UNIMPLEMENTED_ERROR("The stateful gru isn't supported on OpenVINO.");
+        }
         // [steps, batch_size, input_size] => [batch_size, steps, input_size]
         std::vector<int64_t> order3D = std::vector<int64_t>{1, 0, 2};
         const ngraph_node_t* order3DNode =
@@ -1241,88 +1359,269 @@ namespace webnn_native { namespace ie {
         return {};
     }
 
+    MaybeError Graph::ResolveBlobNames() {
+        for (auto& input : mInputIdMap) {
+            char* inputName = nullptr;
+            IEStatusCode status =
+                ie_network_get_input_name(mInferEngineNetwork, input.second, &inputName);
+            DAWN_TRY(CheckStatusCode(status, "IE get input name"));
+            mInputBlobNames.push_back(inputName);
+            ie_network_name_free(&inputName);
+        }
+        // The names of the outputs are updated by TransposeSinking, so they are found by their
+        // index in the network.
+        for (auto& output : mOutputNameMap) {
+            auto originalName = mOriginalNameMap.find(output.second);
+            if (originalName == mOriginalNameMap.end()) {
+                return DAWN_INTERNAL_ERROR("The output " + output.first +
+                                           " isn't in the network.");
+            }
+            char* sinkingName = nullptr;
+            IEStatusCode status = ie_network_get_output_name(
+                mInferEngineNetwork, originalName->second, &sinkingName);
+            DAWN_TRY(CheckStatusCode(status, "IE get output name"));
+            mOutputBlobNames.push_back(sinkingName);
+            ie_network_name_free(&sinkingName);
+        }
+        return {};
+    }
+
+    bool Graph::CachesCompiledGraph() const {
+        return true;
+    }
+
     MaybeError Graph::CompileImpl() {
-        ml::DevicePreference devicePreference = GetContext()->GetContextOptions().devicePreference;
-        const char* deviceName = devicePreference == ml::DevicePreference::Gpu ? "GPU" : "CPU";
-
-        ie_config_t config = {NULL, NULL, NULL};
-        ie_executable_network_t* executableNetwork;
-        IEStatusCode status = ie_core_load_network(mInferEngineCore, mInferEngineNetwork,
-                                                   deviceName, &config, &executableNetwork);
-        DAWN_TRY(CheckStatusCode(status, "IE load network"));
-        status = ie_exec_network_create_infer_request(executableNetwork, &mInferEngineRequest);
-        DAWN_TRY(CheckStatusCode(status, "IE create infer request"));
+        DAWN_TRY(ResolveBlobNames());
+        const ContextOptions options = GetContext()->GetContextOptions();
+        const bool isGpu = options.devicePreference == ml::DevicePreference::Gpu;
+        const char* deviceName = isGpu ? "GPU" : "CPU";
+
+        // The config is a list terminated by an empty entry.
+        std::vector<std::pair<std::string, std::string>> deviceConfig =
+            GetDeviceConfig(options, isGpu);
+        // The graphs with a content hash are exported to the cache directory once compiled, keyed
+        // by the hash, the device and the config, so a graph built again from the same calls
+        // imports them instead of compiling. The serialized graph is written beside the blob,
+        // which is only imported by the graph it matches. The plugin keys the other ones, e.g.
+        // the graphs built for another batch size, by the network.
+        const std::string& cacheDirectory = GetContext()->GetCacheDirectory();
+        const GraphSerializer* serializedGraph = GetSerializedGraph();
+        std::string blobPath, graphPath;
+        if (!cacheDirectory.empty() && HasContentHash() && serializedGraph != nullptr) {
+            std::string configKey = deviceName;
+            for (auto& entry : deviceConfig) {
+                configKey += ";" + entry.first + "=" + entry.second;
+            }
+            std::ostringstream path;
+            path << cacheDirectory << "/" << std::hex << GetContentHash() << "-"
+                 << GraphContentHasher::HashBytes(configKey.data(), configKey.size());
+            blobPath = path.str() + ".blob";
+            graphPath = path.str() + ".graph";
+        } else if (!cacheDirectory.empty()) {
+            deviceConfig.push_back({"CACHE_DIR", cacheDirectory});
+        }
+        std::vector<ie_config_t> config(deviceConfig.size() + 1, {NULL, NULL, NULL});
+        for (size_t i = 0; i < deviceConfig.size(); ++i) {
+            config[i] = {deviceConfig[i].first.c_str(), deviceConfig[i].second.c_str(),
+                         &config[i + 1]};
+            dawn::DebugLog() << "Set " << deviceConfig[i].first << " to "
+                             << deviceConfig[i].second << " on " << deviceName;
+        }
+        ie_executable_network_t* executableNetwork = nullptr;
+        IEStatusCode status;
+        if (!blobPath.empty() && std::ifstream(blobPath).good()) {
+            if (!serializedGraph->MatchesFile(graphPath)) {
+                // E.g. another graph with the same hash exported the blob, which is replaced.
+                dawn::WarningLog() << "The graph cached in " << blobPath << " is another one.";
+            } else {
+                status = ie_core_import_network(mInferEngineCore, blobPath.c_str(), deviceName,
+                                                config.data(), &executableNetwork);
+                if (status == IEStatusCode::OK) {
+                    dawn::DebugLog() << "Imported the graph from " << blobPath;
+                } else {
+                    // E.g. the blob was exported by another version of the plugin.
+                    dawn::WarningLog() << "Failed to import " << blobPath
+                                       << ", compile it again.";
+                    executableNetwork = nullptr;
+                }
+            }
+        }
+        if (executableNetwork == nullptr) {
+            status = ie_core_load_network(mInferEngineCore, mInferEngineNetwork, deviceName,
+                                          config.data(), &executableNetwork);
+            DAWN_TRY(CheckStatusCode(status, "IE load network"));
+            if (!blobPath.empty()) {
+                // The graph is written once its blob is exported, so a partial export never
+                // matches.
+                std::remove(graphPath.c_str());
+                if (ie_core_export_network(executableNetwork, blobPath.c_str()) !=
+                    IEStatusCode::OK) {
+                    dawn::WarningLog() << "Failed to export the graph to " << blobPath;
+                } else {
+                    MaybeError maybeError = serializedGraph->WriteToFile(graphPath);
+                    if (maybeError.IsError()) {
+                        IgnoreErrors(std::move(maybeError));
+                        dawn::WarningLog() << "Failed to write the graph to " << graphPath;
+                    }
+                }
+            }
+        }
+        // The plugin reports how many requests keep all of its streams busy, which is one
+        // for the default latency configuration and follows the stream count otherwise.
+        ie_param_t param;
+        uint32_t requestCount = 1;
+        status = ie_exec_network_get_metric(executableNetwork,
+                                            "OPTIMAL_NUMBER_OF_INFER_REQUESTS", &param);
+        if (status == IEStatusCode::OK && param.number > 0) {
+            requestCount = param.number;
+        }
+        for (uint32_t i = 0; i < requestCount; ++i) {
+            ie_infer_request_t* request;
+            status = ie_exec_network_create_infer_request(executableNetwork, &request);
+            if (status != IEStatusCode::OK) {
+                ie_exec_network_free(&executableNetwork);
+                DAWN_TRY(CheckStatusCode(status, "IE create infer request"));
+            }
+            mInferEngineRequests.push_back(request);
+        }
+        mIdleInferEngineRequests = mInferEngineRequests;
         ie_exec_network_free(&executableNetwork);
+        dawn::DebugLog() << "Created " << requestCount << " infer requests on " << deviceName;
         return {};
     }
 
+    ie_infer_request_t* Graph::AcquireInferRequest() {
+        std::unique_lock<std::mutex> lock(mInferEngineRequestMutex);
+        mInferEngineRequestReleased.wait(lock,
+                                         [this] { return !mIdleInferEngineRequests.empty(); });
+        ie_infer_request_t* request = mIdleInferEngineRequests.back();
+        mIdleInferEngineRequests.pop_back();
+        return request;
+    }
+
+    void Graph::ReleaseInferRequest(ie_infer_request_t* request) {
+        {
+            std::lock_guard<std::mutex> lock(mInferEngineRequestMutex);
+            mIdleInferEngineRequests.push_back(request);
+        }
+        mInferEngineRequestReleased.notify_one();
+    }
+
     MLComputeGraphStatus Graph::ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
-        auto namedInputs = inputs->GetRecords();
+        const auto& namedInputs = inputs->GetRecords();
+        std::vector<const Input*> boundInputs;
+        boundInputs.reserve(mInputIdMap.size());
         for (auto& input : mInputIdMap) {
+            auto namedInput = namedInputs.find(input.first);
+            boundInputs.push_back(namedInput != namedInputs.end() ? namedInput->second : nullptr);
+        }
+        const auto& namedOutputs = outputs->GetRecords();
+        std::vector<const ArrayBufferView*> boundOutputs;
+        boundOutputs.reserve(mOutputNameMap.size());
+        for (auto& output : mOutputNameMap) {
+            auto namedOutput = namedOutputs.find(output.first);
+            boundOutputs.push_back(namedOutput != namedOutputs.end() ? namedOutput->second
+                                                                     : nullptr);
+        }
+        ie_infer_request_t* request = AcquireInferRequest();
+        MLComputeGraphStatus status =
+            ComputeWithRequest(request, boundInputs.data(), boundOutputs.data());
+        ReleaseInferRequest(request);
+        return status;
+    }
+
+    MLComputeGraphStatus Graph::ComputeWithBindingsImpl(const BindingSetBase* bindings) {
+        // The maps are ordered by name like the bindings.
+        if (bindings->GetInputs().size() != mInputBlobNames.size() ||
+            bindings->GetOutputs().size() != mOutputBlobNames.size()) {
+            dawn::ErrorLog() << "The bindings don't match the inputs and outputs of the graph.";
+            return MLComputeGraphStatus_Error;
+        }
+        ie_infer_request_t* request = AcquireInferRequest();
+        MLComputeGraphStatus status = ComputeWithRequest(request, bindings->GetInputs().data(),
+                                                         bindings->GetOutputs().data());
+        ReleaseInferRequest(request);
+        return status;
+    }
+
+    MLComputeGraphStatus Graph::ComputeWithRequest(ie_infer_request_t* request,
+                                                   const Input* const* inputs,
+                                                   const ArrayBufferView* const* outputs) {
+        // The user buffers are only bound to the request for this compute.
+        BlobBindings bindings(request);
+        uint64_t copiedBytes = 0;
+        for (size_t i = 0; i < mInputBlobNames.size(); ++i) {
             // All the inputs must be set.
-            if (namedInputs.find(input.first) == namedInputs.end()) {
+            if (inputs[i] == nullptr) {
                 dawn::ErrorLog() << "The input isn't set";
                 return MLComputeGraphStatus_Error;
             }
+            const char* inputName = mInputBlobNames[i].c_str();
             ie_blob_t* blob;
-            char* inputName = nullptr;
-            IEStatusCode status =
-                ie_network_get_input_name(mInferEngineNetwork, input.second, &inputName);
-            if (status != IEStatusCode::OK) {
-                dawn::ErrorLog() << "IE Failed to ie_network_get_input_name";
-                return MLComputeGraphStatus_Error;
-            }
-            status = ie_infer_request_get_blob(mInferEngineRequest, inputName, &blob);
+            IEStatusCode status = ie_infer_request_get_blob(request, inputName, &blob);
             if (status != IEStatusCode::OK) {
                 dawn::ErrorLog() << "IE Failed to ie_infer_request_get_blob";
                 return MLComputeGraphStatus_Error;
             }
+            bindings.Own(blob);
+            const ArrayBufferView& resource = inputs[i]->resource;
+            void* data = static_cast<int8_t*>(resource.buffer) + resource.byteOffset;
+            if (bindings.Bind(inputName, blob, data, resource.byteLength)) {
+                continue;
+            }
             ie_blob_buffer_t buffer;
             status = ie_blob_get_buffer(blob, &buffer);
             if (status != IEStatusCode::OK) {
                 dawn::ErrorLog() << "IE Failed to ie_blob_get_buffer";
                 return MLComputeGraphStatus_Error;
             }
-            auto& resource = namedInputs[input.first]->resource;
-            memcpy(buffer.buffer, static_cast<int8_t*>(resource.buffer) + resource.byteOffset,
-                   resource.byteLength);
+            memcpy(buffer.buffer, data, resource.byteLength);
+            copiedBytes += resource.byteLength;
+        }
+
+        // Bind the outputs to the user buffers, the other ones are copied after the compute.
+        std::vector<std::pair<const ArrayBufferView*, ie_blob_t*>> outputCopies;
+        for (size_t i = 0; i < mOutputBlobNames.size(); ++i) {
+            const ArrayBufferView* output = outputs[i];
+            if (output == nullptr) {
+                continue;
+            }
+            DAWN_ASSERT(output->buffer != nullptr && output->byteLength != 0);
+            const char* sinkingName = mOutputBlobNames[i].c_str();
+            ie_blob_t* outputBlob;
+            IEStatusCode status = ie_infer_request_get_blob(request, sinkingName, &outputBlob);
+            if (status != IEStatusCode::OK) {
+                dawn::ErrorLog() << "IE Failed to ie_infer_request_get_blob";
+                return MLComputeGraphStatus_Error;
+            }
+            bindings.Own(outputBlob);
+            void* data = static_cast<int8_t*>(output->buffer) + output->byteOffset;
+            if (!bindings.Bind(sinkingName, outputBlob, data, output->byteLength)) {
+                outputCopies.push_back({output, outputBlob});
+            }
         }
 
         // Compute the compiled model.
-        IEStatusCode code = ie_infer_request_infer(mInferEngineRequest);
+        IEStatusCode code = ie_infer_request_infer(request);
         if (code != IEStatusCode::OK) {
             dawn::ErrorLog() << "IE Failed to compute model";
             return MLComputeGraphStatus_Error;
         }
 
         // Get Data from nGraph with output.
-        for (auto namedOutput : outputs->GetRecords()) {
-            const ArrayBufferView* output = namedOutput.second;
-            DAWN_ASSERT(output->buffer != nullptr && output->byteLength != 0);
-            // Get output id with friendly name.
-            auto originalName = mOutputNameMap[namedOutput.first];
-            if (mOriginalNameMap.find(originalName) == mOriginalNameMap.end()) {
-                dawn::ErrorLog() << "IE Failed to compute model";
-                return MLComputeGraphStatus_Error;
-            }
-            char* sinkingName;
-            IEStatusCode status = ie_network_get_output_name(
-                mInferEngineNetwork, mOriginalNameMap[originalName], &sinkingName);
-            ie_blob_t* outputBlob;
-            status = ie_infer_request_get_blob(mInferEngineRequest, sinkingName, &outputBlob);
-            if (status != IEStatusCode::OK) {
-                dawn::ErrorLog() << "IE Failed to ie_infer_request_get_blob";
-                return MLComputeGraphStatus_Error;
-            }
+        for (auto& outputCopy : outputCopies) {
+            const ArrayBufferView* output = outputCopy.first;
             ie_blob_buffer_t outputBuffer;
-            status = ie_blob_get_cbuffer(outputBlob, &outputBuffer);
+            IEStatusCode status = ie_blob_get_cbuffer(outputCopy.second, &outputBuffer);
             int bufferLength;
-            status = ie_blob_byte_size(outputBlob, &bufferLength);
+            status = ie_blob_byte_size(outputCopy.second, &bufferLength);
             if (output->byteLength >= static_cast<size_t>(bufferLength)) {
                 memcpy(static_cast<int8_t*>(output->buffer) + output->byteOffset,
                        outputBuffer.cbuffer, bufferLength);
+                copiedBytes += bufferLength;
             }
         }
+        RecordCopiedBytes(copiedBytes);
 
         return MLComputeGraphStatus_Success;
     }
@@ -16,9 +16,12 @@
 #define WEBNN_NATIVE_IE_MODEL_IE_H_
 
 #include <ngraph_c_api.h>
+#include <condition_variable>
 #include <map>
+#include <mutex>
 #include <set>
 #include <unordered_set>
+#include <vector>
 
 #include "webnn_native/Error.h"
 #include "webnn_native/Graph.h"
@@ -76,11 +79,23 @@ namespace webnn_native { namespace ie {
         virtual MaybeError AddGemm(const op::Gemm* Gemm) override;
         virtual MaybeError AddInstanceNorm(const op::InstanceNorm* InstanceNorm) override;
         virtual MaybeError Finish() override;
+        bool CachesCompiledGraph() const override;
 
       private:
         MaybeError CompileImpl() override;
         MLComputeGraphStatus ComputeImpl(NamedInputsBase* inputs,
                                          NamedOutputsBase* outputs) override;
+        MLComputeGraphStatus ComputeWithBindingsImpl(const BindingSetBase* bindings) override;
+        // Computes with the resources of the inputs and the outputs in the order of their names,
+        // the outputs which aren't read being null.
+        MLComputeGraphStatus ComputeWithRequest(ie_infer_request_t* request,
+                                                const Input* const* inputs,
+                                                const ArrayBufferView* const* outputs);
+        // Resolves the names of the blobs of the inputs and the outputs in the network.
+        MaybeError ResolveBlobNames();
+        // Checks out an idle infer request, waiting for one when they are all in use.
+        ie_infer_request_t* AcquireInferRequest();
+        void ReleaseInferRequest(ie_infer_request_t* request);
 
         // Map the input name to IE internal input number.
         std::map<std::string, size_t> mInputIdMap;
@@ -90,6 +105,10 @@ namespace webnn_native { namespace ie {
         // The outputs will be optimized after TransposeSinking, the name of it also will be
         // updated, so the mOriginalNameMap is to get the index of output in network.
         std::map<std::string, size_t> mOriginalNameMap;
+        // The names of the blobs of the inputs and the outputs in the order of the maps above,
+        // which is the order of their names, so that a compute doesn't look them up.
+        std::vector<std::string> mInputBlobNames;
+        std::vector<std::string> mOutputBlobNames;
         // Map the operand to IE internal id
         std::map<const OperandBase*, std::string> mOperandIdMap;
         // store the constant operands
@@ -99,7 +118,12 @@ namespace webnn_native { namespace ie {
         std::vector<ngraph_node_t*> mGraphInputs;
         ie_core_t* mInferEngineCore;
         ie_network_t* mInferEngineNetwork;
-        ie_infer_request_t* mInferEngineRequest;
+        // The pool of infer requests created from the executable network, each compute
+        // checks out one of them so that concurrent computes run on their own CPU streams.
+        std::vector<ie_infer_request_t*> mInferEngineRequests;
+        std::vector<ie_infer_request_t*> mIdleInferEngineRequests;
+        std::mutex mInferEngineRequestMutex;
+        std::condition_variable mInferEngineRequestReleased;
     };
 
 }}  // namespace webnn_native::ie
@@ -41,6 +41,16 @@ namespace webnn_native { namespace op {
         mActivation = Ref<FusionOperatorBase>(mOptions.activation);
     }
 
+    OperatorBase* BatchNorm::Clone(GraphBuilderBase* builder,
+                                   const std::vector<Ref<OperandBase>>& inputs) const {
+        BatchNormOptions options = mOptions;
+        size_t index = 3;
+        options.scale = mOptions.scale != nullptr ? inputs[index++].Get() : nullptr;
+        options.bias = mOptions.bias != nullptr ? inputs[index++].Get() : nullptr;
+        return new BatchNorm(builder, inputs[0].Get(), inputs[1].Get(), inputs[2].Get(),
+                             &options);
+    }
+
     MaybeError BatchNorm::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
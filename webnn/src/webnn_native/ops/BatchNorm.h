@@ -35,6 +35,8 @@ namespace webnn_native { namespace op {
             return graph->AddBatchNorm(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
 
         BatchNormOptions const* GetOptions() const {
             return &mOptions;
@@ -44,7 +44,8 @@ namespace webnn_native { namespace op {
     }
 
     MaybeError Binary::CaculateMatMulShape() {
-        auto inputShapeA = mInputs[0]->Shape(), inputShapeB = mInputs[1]->Shape();
+        const auto& inputShapeA = mInputs[0]->Shape();
+        const auto& inputShapeB = mInputs[1]->Shape();
         auto rankA = inputShapeA.size(), rankB = inputShapeB.size();
         std::vector<int32_t> outputShape;
         if (rankA == 1 && rankB == 1) {
@@ -82,7 +83,8 @@ namespace webnn_native { namespace op {
     }
 
     MaybeError Binary::CaculateElementWiseBinaryShape() {
-        auto inputShapeA = mInputs[0]->Shape(), inputShapeB = mInputs[1]->Shape();
+        const auto& inputShapeA = mInputs[0]->Shape();
+        const auto& inputShapeB = mInputs[1]->Shape();
         std::vector<int32_t> outputShape;
         auto maybeError = BroadcastShape(inputShapeA, inputShapeB, outputShape);
         if (maybeError.IsError()) {
@@ -92,6 +94,11 @@ namespace webnn_native { namespace op {
         return {};
     }
 
+    OperatorBase* Binary::Clone(GraphBuilderBase* builder,
+                                const std::vector<Ref<OperandBase>>& inputs) const {
+        return new Binary(builder, mOpType, inputs[0].Get(), inputs[1].Get());
+    }
+
     MaybeError Binary::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
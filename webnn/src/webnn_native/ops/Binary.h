@@ -46,6 +46,8 @@ namespace webnn_native { namespace op {
         }
 
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
 
       private:
         MaybeError CaculateMatMulShape();
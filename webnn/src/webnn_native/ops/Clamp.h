@@ -53,6 +53,13 @@ namespace webnn_native { namespace op {
         MaybeError AddToGraph(GraphBase* graph) const override {
             return graph->AddClamp(this);
         }
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override {
+            ClampOptions options;
+            options.minValue = GetMinValue();
+            options.maxValue = GetMaxValue();
+            return new Clamp(builder, inputs[0].Get(), &options);
+        }
 
         MaybeError ValidateAndInferOutputInfo() override {
             MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
@@ -29,6 +29,11 @@ namespace webnn_native { namespace op {
         return {};
     }
 
+    OperatorBase* Concat::Clone(GraphBuilderBase* builder,
+                                const std::vector<Ref<OperandBase>>& inputs) const {
+        return new Concat(builder, inputs, mAxis);
+    }
+
     MaybeError Concat::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
@@ -40,7 +45,7 @@ namespace webnn_native { namespace op {
         }
 
         auto inputType = mInputs[0]->Type();
-        auto inputShape = mInputs[0]->Shape();
+        const auto& inputShape = mInputs[0]->Shape();
         auto inputRank = inputShape.size();
         for (auto& input : mInputs) {
             if (input->Type() != inputType) {
@@ -36,6 +36,8 @@ namespace webnn_native { namespace op {
             return mAxis;
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
 
       private:
         MaybeError CalculateShape();
@@ -15,6 +15,8 @@
 #ifndef WEBNN_NATIVE_OPS_CONSTANT_H_
 #define WEBNN_NATIVE_OPS_CONSTANT_H_
 
+#include <vector>
+
 #include "webnn_native/Graph.h"
 #include "webnn_native/Operand.h"
 
@@ -26,15 +28,23 @@ namespace webnn_native { namespace op {
                  const OperandDescriptor* desc,
                  const ArrayBufferView* arrayBuffer)
             : OperatorBase(builder) {
-            if (desc == nullptr || arrayBuffer == nullptr) {
-                return;
-            }
-            mDimensions.assign(desc->dimensions, desc->dimensions + desc->dimensionsCount);
-            mDescriptor.dimensions = mDimensions.data();
-            mDescriptor.dimensionsCount = mDimensions.size();
-            mDescriptor.type = desc->type;
-            mBuffer = static_cast<int8_t*>(arrayBuffer->buffer) + arrayBuffer->byteOffset;
-            mByteLength = arrayBuffer->byteLength;
+            Initialize(desc, arrayBuffer);
+        }
+        // The bytes stay valid as long as |bufferOwner|, like the mapping of a serialized graph.
+        Constant(GraphBuilderBase* builder,
+                 const OperandDescriptor* desc,
+                 const ArrayBufferView* arrayBuffer,
+                 Ref<RefCounted> bufferOwner)
+            : OperatorBase(builder), mBufferOwner(std::move(bufferOwner)) {
+            Initialize(desc, arrayBuffer);
+        }
+        // The constant owns the bytes, which are computed by the graph optimizer.
+        Constant(GraphBuilderBase* builder,
+                 const OperandDescriptor* desc,
+                 std::vector<int8_t> buffer)
+            : OperatorBase(builder), mOwnedBuffer(std::move(buffer)) {
+            ArrayBufferView arrayBuffer = {mOwnedBuffer.data(), mOwnedBuffer.size()};
+            Initialize(desc, &arrayBuffer);
         }
         ~Constant() override = default;
 
@@ -63,11 +73,35 @@ namespace webnn_native { namespace op {
             return mByteLength;
         }
 
+        // Copies the bytes, which the caller only has to keep until the graph is built, so that
+        // the constant can be added to a graph built later.
+        void RetainBuffer() {
+            if (mOwnedBuffer.empty() && mBufferOwner == nullptr && mBuffer != nullptr) {
+                const int8_t* bytes = static_cast<const int8_t*>(mBuffer);
+                mOwnedBuffer.assign(bytes, bytes + mByteLength);
+                mBuffer = mOwnedBuffer.data();
+            }
+        }
+
       private:
+        void Initialize(const OperandDescriptor* desc, const ArrayBufferView* arrayBuffer) {
+            if (desc == nullptr || arrayBuffer == nullptr) {
+                return;
+            }
+            mDimensions.assign(desc->dimensions, desc->dimensions + desc->dimensionsCount);
+            mDescriptor.dimensions = mDimensions.data();
+            mDescriptor.dimensionsCount = mDimensions.size();
+            mDescriptor.type = desc->type;
+            mBuffer = static_cast<int8_t*>(arrayBuffer->buffer) + arrayBuffer->byteOffset;
+            mByteLength = arrayBuffer->byteLength;
+        }
+
         OperandDescriptor mDescriptor;
         std::vector<int32_t> mDimensions;
-        void const* mBuffer;
-        size_t mByteLength;
+        void const* mBuffer = nullptr;
+        size_t mByteLength = 0;
+        std::vector<int8_t> mOwnedBuffer;
+        Ref<RefCounted> mBufferOwner;
     };
 
 }}  // namespace webnn_native::op
@@ -89,8 +89,8 @@ namespace webnn_native { namespace op {
     }
 
     MaybeError Conv2d::CalculateShape() {
-        auto inputShape = mInputs[0]->Shape();
-        auto filterShape = mInputs[1]->Shape();
+        const auto& inputShape = mInputs[0]->Shape();
+        const auto& filterShape = mInputs[1]->Shape();
 
         bool nchw = mOptions.inputLayout == ml::InputOperandLayout::Nchw;
         int32_t inputHeight = nchw ? inputShape[2] : inputShape[1];
@@ -134,7 +134,16 @@ namespace webnn_native { namespace op {
 
         int32_t paddingBeginningHeight = mPadding[0], paddingEndingHeight = mPadding[1],
                 paddingBeginningWidth = mPadding[2], paddingEndingWidth = mPadding[3];
-        if (mOptions.autoPad != ml::AutoPad::Explicit) {
+        if (mOptions.autoPad != ml::AutoPad::Explicit && mOptions.transpose) {
+            utils::ComputeImplicitPaddingForConvTransposeAutoPad(
+                mOptions.autoPad, mOptions.dilations[0], inputHeight, filterHeight,
+                mOptions.strides[0], mOutputPadding[0], paddingBeginningHeight,
+                paddingEndingHeight);
+            utils::ComputeImplicitPaddingForConvTransposeAutoPad(
+                mOptions.autoPad, mOptions.dilations[1], inputWidth, filterWidth,
+                mOptions.strides[1], mOutputPadding[1], paddingBeginningWidth,
+                paddingEndingWidth);
+        } else if (mOptions.autoPad != ml::AutoPad::Explicit) {
             utils::ComputeImplicitPaddingForAutoPad(mOptions.autoPad, mOptions.dilations[0],
                                                     inputHeight, filterHeight, mOptions.strides[0],
                                                     paddingBeginningHeight, paddingEndingHeight);
@@ -176,6 +185,13 @@ namespace webnn_native { namespace op {
         return {};
     }
 
+    OperatorBase* Conv2d::Clone(GraphBuilderBase* builder,
+                                const std::vector<Ref<OperandBase>>& inputs) const {
+        Conv2dOptions options = mOptions;
+        options.bias = inputs.size() > 2 ? inputs[2].Get() : nullptr;
+        return new Conv2d(builder, inputs[0].Get(), inputs[1].Get(), &options);
+    }
+
     MaybeError Conv2d::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
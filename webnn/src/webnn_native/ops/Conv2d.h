@@ -31,6 +31,8 @@ namespace webnn_native { namespace op {
 
         MaybeError AddToGraph(GraphBase* graph) const override;
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
         Conv2dOptions const* GetOptions() const;
 
       private:
@@ -37,8 +37,8 @@ namespace webnn_native { namespace op {
         // The first input 2-D tensor with shape [M, K] if aTranspose is false, or [K, M] if
         // aTranspose is true. The second input 2-D tensor with shape [K, N] if bTranspose is false,
         // or [N, K] if bTranspose is true.
-        auto inputAShape = mInputs[0]->Shape();
-        auto inputBShape = mInputs[1]->Shape();
+        const auto& inputAShape = mInputs[0]->Shape();
+        const auto& inputBShape = mInputs[1]->Shape();
         bool matMulSupported = (mOptions.aTranspose ? inputAShape[0] : inputAShape[1]) ==
                                (mOptions.bTranspose ? inputBShape[1] : inputBShape[0]);
         if (!matMulSupported) {
@@ -50,7 +50,7 @@ namespace webnn_native { namespace op {
         // The third input tensor c is either a scalar, or of the shape that is unidirectionally
         // broadcastable to the shape [M, N].
         if (mInputs.size() == 3) {
-            auto cShape = mInputs[2]->Shape();
+            const auto& cShape = mInputs[2]->Shape();
             if (cShape.size() > 2) {
                 return DAWN_VALIDATION_ERROR(
                     "The specified third input is either a scalar, or of the shape that is "
@@ -70,6 +70,13 @@ namespace webnn_native { namespace op {
         return {};
     }
 
+    OperatorBase* Gemm::Clone(GraphBuilderBase* builder,
+                              const std::vector<Ref<OperandBase>>& inputs) const {
+        GemmOptions options = mOptions;
+        options.c = inputs.size() > 2 ? inputs[2].Get() : nullptr;
+        return new Gemm(builder, inputs[0].Get(), inputs[1].Get(), &options);
+    }
+
     MaybeError Gemm::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
@@ -29,6 +29,8 @@ namespace webnn_native { namespace op {
             return graph->AddGemm(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
 
         GemmOptions const* GetOptions() const {
             return &mOptions;
@@ -27,7 +27,9 @@ namespace webnn_native { namespace op {
              int32_t steps,
              int32_t hiddenSize,
              GruOptions const* options)
-        : OperatorBase(builder, {input, weight, recurrentWeight}, options->returnSequence ? 2 : 1),
+        : OperatorBase(builder,
+                       {input, weight, recurrentWeight},
+                       options != nullptr && options->returnSequence ? 2 : 1),
           mSteps(steps),
           mHiddenSize(hiddenSize) {
         if (options != nullptr) {
@@ -52,8 +54,8 @@ namespace webnn_native { namespace op {
     }
 
     MaybeError Gru::CalculateShape() {
-        auto inputShape = mInputs[0]->Shape();
-        auto weightShape = mInputs[1]->Shape();
+        const auto& inputShape = mInputs[0]->Shape();
+        const auto& weightShape = mInputs[1]->Shape();
         mOutputs[0]->SetShape({weightShape[0], inputShape[1], static_cast<int32_t>(mHiddenSize)});
         if (mOptions.returnSequence) {
             mOutputs[1]->SetShape(
@@ -62,6 +64,19 @@ namespace webnn_native { namespace op {
         return {};
     }
 
+    OperatorBase* Gru::Clone(GraphBuilderBase* builder,
+                             const std::vector<Ref<OperandBase>>& inputs) const {
+        GruOptions options = mOptions;
+        size_t index = 3;
+        options.bias = mOptions.bias != nullptr ? inputs[index++].Get() : nullptr;
+        options.recurrentBias = mOptions.recurrentBias != nullptr ? inputs[index++].Get() : nullptr;
+        options.initialHiddenState =
+            mOptions.initialHiddenState != nullptr ? inputs[index++].Get() : nullptr;
+        options.activations = mActivations.Get();
+        return new Gru(builder, inputs[0].Get(), inputs[1].Get(), inputs[2].Get(), mSteps,
+                       mHiddenSize, &options);
+    }
+
     MaybeError Gru::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
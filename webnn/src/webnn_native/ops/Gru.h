@@ -38,6 +38,11 @@ namespace webnn_native { namespace op {
         }
 
         MaybeError ValidateAndInferOutputInfo() override;
+        bool IsStateful() const override {
+            return mOptions.stateful;
+        }
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
 
         GruOptions const* GetOptions() const {
             return &mOptions;
@@ -23,12 +23,18 @@
 
 namespace webnn_native { namespace op {
 
+    // A leading dimension of -1 declares a symbolic batch. The operand is inferred with a batch
+    // size of 1, and the graph is built again for the batch size bound when it is computed.
     class Input final : public OperatorBase {
       public:
         Input(GraphBuilderBase* builder, const std::string& name, const OperandDescriptor* desc)
             : OperatorBase(builder), mName(name) {
             mDescriptor.type = desc->type;
             mDimensions.assign(desc->dimensions, desc->dimensions + desc->dimensionsCount);
+            if (!mDimensions.empty() && mDimensions[0] == -1) {
+                mSymbolicBatch = true;
+                mDimensions[0] = 1;
+            }
             mDescriptor.dimensions = mDimensions.data();
             mDescriptor.dimensionsCount = mDimensions.size();
         }
@@ -52,10 +58,21 @@ namespace webnn_native { namespace op {
             return &mDescriptor;
         }
 
+        bool HasSymbolicBatch() const {
+            return mSymbolicBatch;
+        }
+
+        // The output shape follows once the operator is validated again.
+        void SetBatchSize(int32_t batchSize) {
+            DAWN_ASSERT(mSymbolicBatch);
+            mDimensions[0] = batchSize;
+        }
+
       private:
         std::string mName;
         OperandDescriptor mDescriptor;
         std::vector<int32_t> mDimensions;
+        bool mSymbolicBatch = false;
     };
 
 }}  // namespace webnn_native::op
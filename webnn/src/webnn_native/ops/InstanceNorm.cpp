@@ -37,6 +37,15 @@ namespace webnn_native { namespace op {
         }
     }
 
+    OperatorBase* InstanceNorm::Clone(GraphBuilderBase* builder,
+                                      const std::vector<Ref<OperandBase>>& inputs) const {
+        InstanceNormOptions options = mOptions;
+        size_t index = 1;
+        options.scale = mOptions.scale != nullptr ? inputs[index++].Get() : nullptr;
+        options.bias = mOptions.bias != nullptr ? inputs[index++].Get() : nullptr;
+        return new InstanceNorm(builder, inputs[0].Get(), &options);
+    }
+
     MaybeError InstanceNorm::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
@@ -31,6 +31,8 @@ namespace webnn_native { namespace op {
             return graph->AddInstanceNorm(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
 
         InstanceNormOptions const* GetOptions() const {
             return &mOptions;
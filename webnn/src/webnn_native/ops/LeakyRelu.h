@@ -41,6 +41,13 @@ namespace webnn_native { namespace op {
             : LeakyReluBase(options), Unary(builder, kLeakyRelu, input) {
         }
         ~LeakyRelu() override = default;
+
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override {
+            LeakyReluOptions options;
+            options.alpha = GetAlpha();
+            return new LeakyRelu(builder, inputs[0].Get(), &options);
+        }
     };
 
     class FusionLeakyRelu final : public LeakyReluBase, public FusionOperatorBase {
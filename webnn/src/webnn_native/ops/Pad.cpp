@@ -28,8 +28,8 @@ namespace webnn_native { namespace op {
     }
 
     MaybeError Pad::CalculateShape() {
-        auto inputShape = mInputs[0]->Shape();
-        auto paddingShape = mInputs[1]->Shape();
+        const auto& inputShape = mInputs[0]->Shape();
+        const auto& paddingShape = mInputs[1]->Shape();
         std::vector<int32_t> outputShape(inputShape.size());
         // TODO(mingming): Need to check whether padding is a constant.
         const op::Constant* padding = reinterpret_cast<const op::Constant*>(mInputs[1]->Operator());
@@ -44,14 +44,19 @@ namespace webnn_native { namespace op {
         return {};
     }
 
+    OperatorBase* Pad::Clone(GraphBuilderBase* builder,
+                             const std::vector<Ref<OperandBase>>& inputs) const {
+        return new Pad(builder, inputs[0].Get(), inputs[1].Get(), &mOptions);
+    }
+
     MaybeError Pad::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
             return maybeError;
         }
 
-        auto inputShape = mInputs[0]->Shape();
-        auto paddingShape = mInputs[1]->Shape();
+        const auto& inputShape = mInputs[0]->Shape();
+        const auto& paddingShape = mInputs[1]->Shape();
 
         if (paddingShape.size() != 2 || inputShape.size() != size_t(paddingShape[0]) ||
             paddingShape[1] != 2) {
@@ -33,6 +33,8 @@ namespace webnn_native { namespace op {
             return graph->AddPad(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
 
         PadOptions const* GetOptions() const {
             return &mOptions;
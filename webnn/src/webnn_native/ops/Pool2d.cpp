@@ -77,7 +77,7 @@ namespace webnn_native { namespace op {
     }
 
     MaybeError Pool2d::CalculateShape() {
-        auto inputShape = mInputs[0]->Shape();
+        const auto& inputShape = mInputs[0]->Shape();
         bool nchw = mOptions.layout == ml::InputOperandLayout::Nchw;
         int32_t inputHeight = nchw ? inputShape[2] : inputShape[1];
         int32_t inputWidth = nchw ? inputShape[3] : inputShape[2];
@@ -97,12 +97,14 @@ namespace webnn_native { namespace op {
                                                     paddingBeginningWidth, paddingEndingWidth);
         }
         // TODO(mingming): Support ceil and floor rounding types for pool2d.
+        int32_t dilatedWindowHeight = (windowHeight - 1) * mOptions.dilations[0] + 1;
+        int32_t dilatedWindowWidth = (windowWidth - 1) * mOptions.dilations[1] + 1;
         int32_t outputHeight =
-            1 + (inputHeight - windowHeight + paddingBeginningHeight + paddingEndingHeight) /
+            1 + (inputHeight - dilatedWindowHeight + paddingBeginningHeight + paddingEndingHeight) /
                     mStride[0];
-        int32_t outputWidth =
-            1 +
-            (inputWidth - windowWidth + paddingBeginningWidth + paddingEndingWidth) / mStride[1];
+        int32_t outputWidth = 1 + (inputWidth - dilatedWindowWidth + paddingBeginningWidth +
+                                   paddingEndingWidth) /
+                                      mStride[1];
 
         std::vector<int32_t> outputShape;
         int32_t batches = inputShape[0];
@@ -116,6 +118,11 @@ namespace webnn_native { namespace op {
         return {};
     }
 
+    OperatorBase* Pool2d::Clone(GraphBuilderBase* builder,
+                                const std::vector<Ref<OperandBase>>& inputs) const {
+        return new Pool2d(builder, mOpType, inputs[0].Get(), &mOptions);
+    }
+
     MaybeError Pool2d::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
@@ -36,6 +36,8 @@ namespace webnn_native { namespace op {
 
         MaybeError AddToGraph(GraphBase* graph) const override;
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
 
         Pool2dOptions const* GetOptions() const;
         Pool2dType GetType() const;
@@ -0,0 +1,101 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn_native/ops/Quantize.h"
+
+#include "webnn_native/Error.h"
+
+namespace webnn_native { namespace op {
+
+    namespace {
+        bool IsQuantizedType(ml::OperandType type) {
+            return type == ml::OperandType::Int8 || type == ml::OperandType::Uint8;
+        }
+
+        size_t GetElementCount(const std::vector<int32_t>& shape) {
+            size_t count = 1;
+            for (auto dimension : shape) {
+                count *= dimension;
+            }
+            return count;
+        }
+    }  // anonymous namespace
+
+    Quantize::Quantize(GraphBuilderBase* builder,
+                       QuantizeType opType,
+                       OperandBase* input,
+                       OperandBase* scale,
+                       OperandBase* zeroPoint,
+                       QuantizeLinearOptions const* options)
+        : OperatorBase(builder, {input, scale, zeroPoint}), mOpType(opType) {
+        mOptions.axis = options == nullptr ? 1 : options->axis;
+    }
+
+    bool Quantize::IsPerChannel() const {
+        return GetElementCount(mInputs[1]->Shape()) != 1;
+    }
+
+    OperatorBase* Quantize::Clone(GraphBuilderBase* builder,
+                                  const std::vector<Ref<OperandBase>>& inputs) const {
+        return new Quantize(builder, mOpType, inputs[0].Get(), inputs[1].Get(), inputs[2].Get(),
+                            &mOptions);
+    }
+
+    MaybeError Quantize::ValidateAndInferOutputInfo() {
+        MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
+        if (maybeError.IsError()) {
+            return maybeError;
+        }
+
+        const OperandBase* input = mInputs[0].Get();
+        const OperandBase* scale = mInputs[1].Get();
+        const OperandBase* zeroPoint = mInputs[2].Get();
+        if (scale->Type() != ml::OperandType::Float32) {
+            return DAWN_VALIDATION_ERROR("The scale is not a float32 tensor.");
+        }
+        if (!IsQuantizedType(zeroPoint->Type())) {
+            return DAWN_VALIDATION_ERROR("The zero point is not an int8 or uint8 tensor.");
+        }
+        if (mOpType == QuantizeType::kQuantizeLinear) {
+            if (input->Type() != ml::OperandType::Float32) {
+                return DAWN_VALIDATION_ERROR("The input of quantizeLinear is not float32.");
+            }
+        } else if (input->Type() != zeroPoint->Type()) {
+            return DAWN_VALIDATION_ERROR(
+                "The input of dequantizeLinear doesn't have the type of the zero point.");
+        }
+
+        if (scale->Shape() != zeroPoint->Shape()) {
+            return DAWN_VALIDATION_ERROR("The scale and the zero point have different shapes.");
+        }
+        // The per-channel values are a 1-D tensor of the size of the input along the axis.
+        if (IsPerChannel()) {
+            const std::vector<int32_t> inputShape = input->Shape();
+            const int32_t axis = mOptions.axis;
+            if (axis < 0 || axis >= static_cast<int32_t>(inputShape.size())) {
+                return DAWN_VALIDATION_ERROR("The axis is out of range.");
+            }
+            if (scale->Shape().size() != 1 || scale->Shape()[0] != inputShape[axis]) {
+                return DAWN_VALIDATION_ERROR(
+                    "The scale doesn't have the size of the input along the axis.");
+            }
+        }
+
+        mOutputs[0]->SetType(mOpType == QuantizeType::kQuantizeLinear ? zeroPoint->Type()
+                                                                        : ml::OperandType::Float32);
+        mOutputs[0]->SetShape(input->Shape());
+        return {};
+    }
+
+}}  // namespace webnn_native::op
@@ -0,0 +1,64 @@
+// Copyright 2021 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_OPS_QUANTIZE_H_
+#define WEBNN_NATIVE_OPS_QUANTIZE_H_
+
+#include "webnn_native/Graph.h"
+#include "webnn_native/Operand.h"
+
+namespace webnn_native { namespace op {
+
+    enum QuantizeType {
+        kQuantizeLinear = 0,
+        kDequantizeLinear,
+    };
+
+    // Converts between float32 and int8 or uint8 with q = clamp(round(x / scale) + zeroPoint)
+    // and x = (q - zeroPoint) * scale. The scale and the zero point hold one value for the whole
+    // tensor or one per element along the axis of the options.
+    class Quantize final : public OperatorBase {
+      public:
+        Quantize(GraphBuilderBase* builder,
+                 QuantizeType opType,
+                 OperandBase* input,
+                 OperandBase* scale,
+                 OperandBase* zeroPoint,
+                 QuantizeLinearOptions const* options);
+        ~Quantize() override = default;
+
+        MaybeError AddToGraph(GraphBase* graph) const override {
+            return graph->AddQuantize(this);
+        }
+        MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
+
+        QuantizeType GetType() const {
+            return mOpType;
+        }
+        QuantizeLinearOptions const* GetOptions() const {
+            return &mOptions;
+        }
+        // Whether the scale and the zero point hold one value per element along the axis.
+        bool IsPerChannel() const;
+
+      private:
+        QuantizeType mOpType;
+        QuantizeLinearOptions mOptions;
+    };
+
+}}  // namespace webnn_native::op
+
+#endif  // WEBNN_NATIVE_OPS_QUANTIZE_H_
@@ -44,6 +44,8 @@ namespace webnn_native { namespace op {
             return graph->AddReduce(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
 
         ReduceType GetType() const {
             return mOpType;
@@ -36,7 +36,7 @@ namespace webnn_native { namespace op {
     }
 
     MaybeError Resample2d::CalculateShape() {
-        auto inputShape = mInputs[0]->Shape();
+        const auto& inputShape = mInputs[0]->Shape();
         auto outputShape = inputShape;
         // When the target sizes are specified, the options.scales argument is ignored as the
         // scaling factor values are derived from the target sizes of each spatial dimension of
@@ -52,6 +52,18 @@ namespace webnn_native { namespace op {
         return {};
     }
 
+    OperatorBase* Resample2d::Clone(GraphBuilderBase* builder,
+                                    const std::vector<Ref<OperandBase>>& inputs) const {
+        Resample2dOptions options = mOptions;
+        options.scales = mScales.data();
+        options.scalesCount = mScales.size();
+        options.sizes = mSizes.empty() ? nullptr : mSizes.data();
+        options.sizesCount = mSizes.size();
+        options.axes = mAxes.data();
+        options.axesCount = mAxes.size();
+        return new Resample2d(builder, inputs[0].Get(), &options);
+    }
+
     MaybeError Resample2d::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
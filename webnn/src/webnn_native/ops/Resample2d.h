@@ -29,6 +29,8 @@ namespace webnn_native { namespace op {
             return graph->AddResample2d(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
 
         Resample2dOptions const* GetOptions() const {
             return &mOptions;
@@ -36,6 +38,9 @@ namespace webnn_native { namespace op {
         std::vector<float> GetScales() const {
             return mScales;
         }
+        std::vector<int32_t> GetSizes() const {
+            return mSizes;
+        }
         std::vector<int32_t> GetAxes() const {
             return mAxes;
         }
@@ -19,7 +19,7 @@
 namespace webnn_native { namespace op {
 
     MaybeError Reshape::CalculateShape() {
-        auto inputShape = mInputs[0]->Shape();
+        const auto& inputShape = mInputs[0]->Shape();
         uint32_t inputSize = 1, capacity = 1;
         for (auto dim : inputShape) {
             inputSize *= dim;
@@ -53,6 +53,11 @@ namespace webnn_native { namespace op {
         return {};
     }
 
+    OperatorBase* Reshape::Clone(GraphBuilderBase* builder,
+                                 const std::vector<Ref<OperandBase>>& inputs) const {
+        return new Reshape(builder, inputs[0].Get(), mNewShape.data(), mNewShape.size());
+    }
+
     MaybeError Reshape::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
@@ -36,6 +36,8 @@ namespace webnn_native { namespace op {
             return graph->AddReshape(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
         std::vector<int32_t> GetNewShape() const {
             return mNewShape;
         }
@@ -46,9 +46,17 @@ namespace webnn_native { namespace op {
         MaybeError AddToGraph(GraphBase* graph) const override {
             return graph->AddSlice(this);
         }
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override {
+            SliceOptions options;
+            options.axes = mAxes.empty() ? nullptr : mAxes.data();
+            options.axesCount = mAxes.size();
+            return new Slice(builder, inputs[0].Get(), mStarts.data(), mStarts.size(),
+                             mSizes.data(), mSizes.size(), &options);
+        }
 
         MaybeError CalculateShape() {
-            auto inputShape = mInputs[0]->Shape();
+            const auto& inputShape = mInputs[0]->Shape();
             auto outputShape = inputShape;
             std::vector<int32_t> axes;
             if (mAxes.empty()) {
@@ -38,9 +38,15 @@ namespace webnn_native { namespace op {
         MaybeError AddToGraph(GraphBase* graph) const override {
             return graph->AddSplit(this);
         }
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override {
+            SplitOptions options;
+            options.axis = mAxis;
+            return new Split(builder, inputs[0].Get(), mSplits.data(), mSplits.size(), &options);
+        }
 
         MaybeError CalculateShape() {
-            auto inputShape = mInputs[0]->Shape();
+            const auto& inputShape = mInputs[0]->Shape();
             auto outputShape = inputShape;
             size_t outputSize;
             auto axis = mAxis;
@@ -36,9 +36,16 @@ namespace webnn_native { namespace op {
         MaybeError AddToGraph(GraphBase* graph) const override {
             return graph->AddSqueeze(this);
         }
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override {
+            SqueezeOptions options;
+            options.axes = mAxes.empty() ? nullptr : mAxes.data();
+            options.axesCount = mAxes.size();
+            return new Squeeze(builder, inputs[0].Get(), &options);
+        }
 
         MaybeError CalculateShape() {
-            auto inputShape = mInputs[0]->Shape();
+            const auto& inputShape = mInputs[0]->Shape();
             auto inputRank = inputShape.size();
             std::vector<int32_t> outputShape;
 
@@ -79,7 +86,7 @@ namespace webnn_native { namespace op {
                 return maybeError;
             }
 
-            auto inputShape = mInputs[0]->Shape();
+            const auto& inputShape = mInputs[0]->Shape();
             for (size_t i = 0; i < mAxes.size(); ++i) {
                 if (mAxes[i] >= int32_t(inputShape.size()) || mAxes[i] < 0) {
                     return DAWN_VALIDATION_ERROR("Axes value is invalid.");
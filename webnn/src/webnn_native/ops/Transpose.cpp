@@ -21,7 +21,7 @@
 namespace webnn_native { namespace op {
 
     MaybeError Transpose::CalculateShape() {
-        auto inputShape = mInputs[0]->Shape();
+        const auto& inputShape = mInputs[0]->Shape();
         size_t rank = inputShape.size();
         std::vector<int32_t> outputShape(rank);
         for (size_t i = 0; i < rank; ++i) {
@@ -31,13 +31,21 @@ namespace webnn_native { namespace op {
         return {};
     }
 
+    OperatorBase* Transpose::Clone(GraphBuilderBase* builder,
+                                   const std::vector<Ref<OperandBase>>& inputs) const {
+        TransposeOptions options;
+        options.permutation = mPermutation.data();
+        options.permutationCount = mPermutation.size();
+        return new Transpose(builder, inputs[0].Get(), &options);
+    }
+
     MaybeError Transpose::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
             return maybeError;
         }
 
-        auto inputShape = mInputs[0]->Shape();
+        const auto& inputShape = mInputs[0]->Shape();
         // the number of values in the sequence must be the same as the rank of the input
         // tensor
         if (mPermutation.size() != inputShape.size()) {
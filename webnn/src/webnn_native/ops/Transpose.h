@@ -42,6 +42,8 @@ namespace webnn_native { namespace op {
             return graph->AddTranspose(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
 
         std::vector<int32_t> GetPermutation() const {
             return mPermutation;
@@ -18,6 +18,11 @@
 
 namespace webnn_native { namespace op {
 
+    OperatorBase* Unary::Clone(GraphBuilderBase* builder,
+                               const std::vector<Ref<OperandBase>>& inputs) const {
+        return new Unary(builder, mOpType, inputs[0].Get());
+    }
+
     MaybeError Unary::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
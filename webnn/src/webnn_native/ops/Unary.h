@@ -51,6 +51,8 @@ namespace webnn_native { namespace op {
             return graph->AddUnary(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        OperatorBase* Clone(GraphBuilderBase* builder,
+                            const std::vector<Ref<OperandBase>>& inputs) const override;
         UnaryOpType GetType() const {
             return mOpType;
         }